@@ -0,0 +1,96 @@
+/**
+ * @file append_vector_bench.cpp
+ * @brief Multi-writer journal appends with a scanning reader:
+ *        crab::Mutex<crab::StaticVector> vs. crab::AppendVector.
+ *
+ * Run with: ./append_vector_bench [--n=262144] [--threads=4]
+ */
+
+#include "bench_common.h"
+
+#include <crab/append_vector.h>
+#include <crab/mutex.h>
+#include <crab/static_vector.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kCapacity = 1 << 18;
+
+struct Event {
+    uint64_t timestamp;
+    uint64_t payload;
+};
+
+using Locked = crab::Mutex<crab::StaticVector<Event, kCapacity>>;
+using Journal = crab::AppendVector<Event, kCapacity>;
+
+// `threads` writers append `per_thread` events each while one reader
+// rescans everything published so far
+template<typename Push, typename Scan>
+void journal_run(std::size_t threads, std::size_t per_thread, Push&& push, Scan&& scan) {
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            crab_bench::do_not_optimize(scan());
+        }
+    });
+    std::vector<std::thread> writers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t] {
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                push(Event{i, t});
+            }
+        });
+    }
+    for (auto& w : writers) {
+        w.join();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", kCapacity));
+    const std::size_t threads = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "threads", 4));
+    const std::size_t per_thread = std::min(n, kCapacity) / threads;
+
+    std::printf("%zu writers + 1 reader, %zu appends per run\n", threads, per_thread * threads);
+
+    static Locked locked;
+    crab_bench::run("  crab::Mutex<StaticVector>", per_thread * threads, [&] {
+        locked.lock()->clear();
+        journal_run(threads, per_thread,
+            [&](const Event& e) { (void)locked.lock()->try_push_back(e); },
+            [&] {
+                auto guard = locked.lock();
+                uint64_t acc = 0;
+                for (const Event& e : *guard) {
+                    acc += e.payload;
+                }
+                return acc;
+            });
+    }, 9);
+
+    static Journal journal;
+    crab_bench::run("  crab::AppendVector", per_thread * threads, [&] {
+        journal.clear();
+        journal_run(threads, per_thread,
+            [&](const Event& e) { (void)journal.try_push(e); },
+            [&] {
+                uint64_t acc = 0;
+                for (const Event& e : journal.published()) {
+                    acc += e.payload;
+                }
+                return acc;
+            });
+    }, 9);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file bench_common.h
+ * @brief Minimal timing harness shared by the CrabLib benchmarks.
+ *
+ * No external dependencies: each benchmark repeats a body, keeps the
+ * median, and prints one line per case.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace crab_bench {
+
+/**
+ * @brief Prevent the compiler from discarding a computed value.
+ */
+template<typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Force pending memory writes to be considered observable.
+ */
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+/**
+ * @brief Time fn() and print the median nanoseconds per call and per item.
+ *
+ * @param name Case label
+ * @param items Items processed per call (for ns/item)
+ * @param fn Body to time
+ * @param reps Number of timed samples (median is reported)
+ * @return Median nanoseconds per call
+ */
+template<typename F>
+double run(const char* name, std::size_t items, F&& fn, int reps = 31) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kMaxReps = 101;
+    double samples[kMaxReps];
+    reps = std::min(std::max(reps, 1), kMaxReps);
+
+    fn();  // Warm caches and branch predictors
+
+    for (int r = 0; r < reps; ++r) {
+        const auto start = Clock::now();
+        fn();
+        const auto stop = Clock::now();
+        samples[r] = std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+    std::nth_element(samples, samples + reps / 2, samples + reps);
+    const double median = samples[reps / 2];
+
+    std::printf("%-40s %12.1f ns/op %10.3f ns/item\n",
+                name, median, items ? median / static_cast<double>(items) : 0.0);
+    return median;
+}
+
+/**
+ * @brief Read an integer option "--name=value" from argv, or return fallback.
+ */
+inline long arg_or(int argc, char** argv, const char* name, long fallback) {
+    const std::size_t len = std::strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--", 2) == 0 &&
+            std::strncmp(argv[i] + 2, name, len) == 0 && argv[i][2 + len] == '=') {
+            return std::strtol(argv[i] + 3 + len, nullptr, 10);
+        }
+    }
+    return fallback;
+}
+
+} // namespace crab_bench
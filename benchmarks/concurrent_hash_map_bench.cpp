@@ -0,0 +1,138 @@
+/**
+ * @file concurrent_hash_map_bench.cpp
+ * @brief Read-mostly symbol -> state map (99% find, 1% assign) scaled
+ *        from one thread to all cores: Mutex<std::unordered_map>,
+ *        std::shared_mutex + std::unordered_map, crab::ConcurrentHashMap.
+ *
+ * Run with: ./concurrent_hash_map_bench [--n=1000000] [--threads=0 (all cores)]
+ *
+ * ns/item is wall time over all threads' operations, so perfect scaling
+ * halves it each time the thread count doubles.
+ */
+
+#include "bench_common.h"
+
+#include <crab/concurrent_hash_map.h>
+#include <crab/mutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSymbols = 4096;
+
+struct State {
+    int64_t bid;
+    int64_t ask;
+    uint64_t seq;
+};
+
+struct SharedLockedMap {
+    mutable std::shared_mutex lock;
+    std::unordered_map<uint64_t, State> map;
+};
+
+// Op stream: symbol index, with the top bit marking a write
+std::vector<uint32_t> make_ops(std::size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint32_t> ops(n);
+    for (auto& op : ops) {
+        op = static_cast<uint32_t>(rng() % kSymbols) | (rng() % 100 == 0 ? 0x80000000u : 0);
+    }
+    return ops;
+}
+
+// Thread t of `threads` runs its contiguous share of the stream
+template<typename Op>
+void run_threads(const std::vector<uint32_t>& stream, std::size_t threads, Op&& op) {
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            const std::size_t begin = stream.size() * t / threads;
+            const std::size_t end = stream.size() * (t + 1) / threads;
+            int64_t acc = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                acc += op(stream[i] & 0x7FFFFFFFu, (stream[i] & 0x80000000u) != 0);
+            }
+            crab_bench::do_not_optimize(acc);
+        });
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 1000000));
+    std::size_t max_threads = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "threads", 0));
+    if (max_threads == 0) {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::vector<uint32_t> stream = make_ops(n, 1);
+
+    crab::Mutex<std::unordered_map<uint64_t, State>> locked;
+    SharedLockedMap shared;
+    static crab::ConcurrentHashMap<uint64_t, State, kSymbols> lock_free;
+    for (uint64_t s = 0; s < kSymbols; ++s) {
+        locked.lock()->emplace(s, State{});
+        shared.map.emplace(s, State{});
+        (void)lock_free.insert(s, State{});
+    }
+
+    std::printf("%zu symbols, 99%% reads, %zu ops per run\n", kSymbols, n);
+    for (std::size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        // Same total work at every thread count
+        const std::size_t ops = n;
+        std::printf("%zu thread%s\n", threads, threads == 1 ? "" : "s");
+
+        crab_bench::run("  crab::Mutex<std::unordered_map>", ops, [&] {
+            run_threads(stream, threads, [&](uint32_t sym, bool write) -> int64_t {
+                auto map = locked.lock();
+                State& st = map->find(sym)->second;
+                if (write) {
+                    st.seq += 1;
+                }
+                return st.bid;
+            });
+        }, 9);
+
+        crab_bench::run("  std::shared_mutex + unordered_map", ops, [&] {
+            run_threads(stream, threads, [&](uint32_t sym, bool write) -> int64_t {
+                if (write) {
+                    std::unique_lock<std::shared_mutex> guard(shared.lock);
+                    shared.map.find(sym)->second.seq += 1;
+                    return 0;
+                }
+                std::shared_lock<std::shared_mutex> guard(shared.lock);
+                return shared.map.find(sym)->second.bid;
+            });
+        }, 9);
+
+        crab_bench::run("  crab::ConcurrentHashMap", ops, [&] {
+            run_threads(stream, threads, [&](uint32_t sym, bool write) -> int64_t {
+                if (write) {
+                    lock_free.update(sym, [](State& st) { st.seq += 1; });
+                    return 0;
+                }
+                return lock_free.find(sym).unwrap().bid;
+            });
+        }, 9);
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+    return 0;
+}
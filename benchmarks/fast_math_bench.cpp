@@ -0,0 +1,68 @@
+/**
+ * @file fast_math_bench.cpp
+ * @brief Per-element libm calls vs. crab::fast_* bulk kernels.
+ *
+ * Run with: ./fast_math_bench [--n=4096]
+ */
+
+#include "bench_common.h"
+
+#include <crab/fast_math.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 4096));
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+
+    std::vector<float> x(n), pos(n), y(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = dist(rng);
+        pos[i] = std::fabs(x[i]) + 1e-3f;
+    }
+    crab::Slice<float> out(y.data(), n);
+
+    std::printf("active SIMD level = %d, %zu floats\n",
+                static_cast<int>(crab::simd::active_level()), n);
+
+    struct Case {
+        const char* name;
+        float (*libm)(float);
+        crab::Result<crab::Unit, crab::OutOfBounds> (*bulk)(crab::Slice<const float>, crab::Slice<float>);
+        const std::vector<float>* input;
+    };
+    const Case cases[] = {
+        {"exp", [](float v) { return std::exp(v); }, crab::fast_exp, &x},
+        {"log", [](float v) { return std::log(v); }, crab::fast_log, &pos},
+        {"sin", [](float v) { return std::sin(v); }, crab::fast_sin, &x},
+        {"cos", [](float v) { return std::cos(v); }, crab::fast_cos, &x},
+        {"tanh", [](float v) { return std::tanh(v); }, crab::fast_tanh, &x},
+        {"sigmoid", [](float v) { return 1.0f / (1.0f + std::exp(-v)); }, crab::fast_sigmoid, &x},
+    };
+
+    for (const Case& c : cases) {
+        const float* src = c.input->data();
+        crab::Slice<const float> in(src, n);
+        std::printf("%s\n", c.name);
+        crab_bench::run("  std:: per element", n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                y[i] = c.libm(src[i]);
+            }
+            crab_bench::clobber_memory();
+        });
+        crab::simd::set_level_cap(crab::simd::Level::Scalar);
+        crab_bench::run("  crab::fast_* (scalar)", n, [&] {
+            crab_bench::do_not_optimize(c.bulk(in, out));
+            crab_bench::clobber_memory();
+        });
+        crab::simd::set_level_cap(crab::simd::Level::Avx512);
+        crab_bench::run("  crab::fast_*", n, [&] {
+            crab_bench::do_not_optimize(c.bulk(in, out));
+            crab_bench::clobber_memory();
+        });
+    }
+    return 0;
+}
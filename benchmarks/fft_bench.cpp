@@ -0,0 +1,88 @@
+/**
+ * @file fft_bench.cpp
+ * @brief ns per transform: naive O(N^2) DFT vs. crab::Fft<N>.
+ *
+ * The DFT baseline uses a precomputed twiddle table, so it measures the
+ * arithmetic alone, not the cost of sin/cos.
+ * Run with: ./fft_bench
+ */
+
+#include "bench_common.h"
+
+#include <crab/fft.h>
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+namespace {
+
+using C = std::complex<float>;
+
+void naive_dft(const C* x, C* y, const C* w, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k) {
+        float re = 0.0f;
+        float im = 0.0f;
+        for (std::size_t j = 0; j < n; ++j) {
+            const C t = w[(j * k) & (n - 1)];
+            re += x[j].real() * t.real() - x[j].imag() * t.imag();
+            im += x[j].real() * t.imag() + x[j].imag() * t.real();
+        }
+        y[k] = C(re, im);
+    }
+}
+
+template<std::size_t N>
+void bench_size(std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<C> x(N);
+    std::vector<float> r(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        x[i] = C(dist(rng), dist(rng));
+        r[i] = dist(rng);
+    }
+    std::vector<C> w(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        const double t = -2.0 * 3.14159265358979323846 * static_cast<double>(i) / N;
+        w[i] = C(static_cast<float>(std::cos(t)), static_cast<float>(std::sin(t)));
+    }
+    std::vector<C> y(N);
+    std::vector<C> bins(N / 2 + 1);
+    crab::Slice<C> sy(y.data(), N);
+
+    std::printf("N = %zu\n", N);
+    crab_bench::run("  naive DFT", 1, [&] {
+        naive_dft(x.data(), y.data(), w.data(), N);
+        crab_bench::clobber_memory();
+    }, 5);
+    crab::simd::set_level_cap(crab::simd::Level::Scalar);
+    crab_bench::run("  crab::Fft forward (scalar)", 1, [&] {
+        y = x;
+        crab_bench::do_not_optimize(crab::Fft<N>::forward(sy));
+        crab_bench::clobber_memory();
+    });
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+    crab_bench::run("  crab::Fft forward", 1, [&] {
+        y = x;
+        crab_bench::do_not_optimize(crab::Fft<N>::forward(sy));
+        crab_bench::clobber_memory();
+    });
+    crab_bench::run("  crab::Fft forward_real", 1, [&] {
+        crab_bench::do_not_optimize(crab::Fft<N>::forward_real(
+            crab::Slice<const float>(r.data(), N), crab::Slice<C>(bins.data(), bins.size())));
+        crab_bench::clobber_memory();
+    });
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(3);
+    std::printf("active SIMD level = %d (ns/op is per transform)\n",
+                static_cast<int>(crab::simd::active_level()));
+    bench_size<256>(rng);
+    bench_size<1024>(rng);
+    bench_size<4096>(rng);
+    return 0;
+}
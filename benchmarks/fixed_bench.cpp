@@ -0,0 +1,84 @@
+/**
+ * @file fixed_bench.cpp
+ * @brief Q15 multiply-accumulate: scalar saturating loop vs. crab::mac_sat.
+ *
+ * Run with: ./fixed_bench [--n=4096]
+ */
+
+#include "bench_common.h"
+
+#include <crab/fixed.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+// The loop this replaces: widen, round, clamp, one element at a time
+void naive_mac(int16_t* acc, const int16_t* a, const int16_t* b, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        int32_t p = (int32_t{a[i]} * b[i] + (1 << 14)) >> 15;
+        p = p > 32767 ? 32767 : p;
+        int32_t s = acc[i] + p;
+        s = s > 32767 ? 32767 : (s < -32768 ? -32768 : s);
+        acc[i] = static_cast<int16_t>(s);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 4096));
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<float> f(n);
+    for (auto& v : f) {
+        v = dist(rng);
+    }
+    std::vector<crab::Q15> a(n), b(n), acc(n);
+    std::vector<int16_t> ra(n), rb(n), racc(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = crab::Q15::from_float(f[i]);
+        b[i] = crab::Q15::from_float(f[n - 1 - i] * 0.5f);
+        ra[i] = a[i].raw();
+        rb[i] = b[i].raw();
+    }
+    crab::Slice<const crab::Q15> sa(a.data(), n);
+    crab::Slice<const crab::Q15> sb(b.data(), n);
+    crab::Slice<crab::Q15> sacc(acc.data(), n);
+
+    std::printf("active SIMD level = %d, %zu Q15 elements\n",
+                static_cast<int>(crab::simd::active_level()), n);
+
+    std::printf("multiply-accumulate\n");
+    crab_bench::run("  naive int16 loop", n, [&] {
+        naive_mac(racc.data(), ra.data(), rb.data(), n);
+        crab_bench::clobber_memory();
+    });
+    crab::simd::set_level_cap(crab::simd::Level::Scalar);
+    crab_bench::run("  crab::mac_sat (scalar)", n, [&] {
+        crab_bench::do_not_optimize(crab::mac_sat(sacc, sa, sb));
+        crab_bench::clobber_memory();
+    });
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+    crab_bench::run("  crab::mac_sat", n, [&] {
+        crab_bench::do_not_optimize(crab::mac_sat(sacc, sa, sb));
+        crab_bench::clobber_memory();
+    });
+
+    std::printf("float -> Q15\n");
+    crab::Slice<crab::Q15> out(acc.data(), n);
+    crab::simd::set_level_cap(crab::simd::Level::Scalar);
+    crab_bench::run("  crab::to_fixed (scalar)", n, [&] {
+        crab_bench::do_not_optimize(crab::to_fixed(crab::Slice<const float>(f.data(), n), out));
+        crab_bench::clobber_memory();
+    });
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+    crab_bench::run("  crab::to_fixed", n, [&] {
+        crab_bench::do_not_optimize(crab::to_fixed(crab::Slice<const float>(f.data(), n), out));
+        crab_bench::clobber_memory();
+    });
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file interner_bench.cpp
+ * @brief Symbol lookup: std::unordered_map<std::string, uint32_t> vs.
+ *        crab::StringInterner, for topic-like keys.
+ *
+ * Run with: ./interner_bench [--n=65536]
+ */
+
+#include "bench_common.h"
+
+#include <crab/interner.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSymbols = 4096;
+
+using Interner = crab::StringInterner<kSymbols * 32, kSymbols>;
+
+crab::ConstByteSlice bytes_of(const std::string& s) {
+    return crab::ConstByteSlice(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 65536));
+    std::mt19937 rng(3);
+
+    std::vector<std::string> symbols(kSymbols);
+    char buf[32];
+    for (std::size_t i = 0; i < kSymbols; ++i) {
+        std::snprintf(buf, sizeof(buf), "md/eq/XNAS/SYM%05zu/bbo", i);
+        symbols[i] = buf;
+    }
+    std::vector<const std::string*> stream(n);
+    for (auto& s : stream) {
+        s = &symbols[rng() % kSymbols];
+    }
+
+    std::unordered_map<std::string, uint32_t> map;
+    static Interner interner;
+    for (std::size_t i = 0; i < kSymbols; ++i) {
+        map.emplace(symbols[i], static_cast<uint32_t>(i));
+        (void)interner.intern(bytes_of(symbols[i]));
+    }
+
+    std::printf("%zu symbols, %zu lookups\n", kSymbols, n);
+
+    std::printf("string -> id\n");
+    crab_bench::run("  std::unordered_map<std::string, uint32_t>", n, [&] {
+        uint32_t acc = 0;
+        for (const std::string* s : stream) {
+            acc += map.find(*s)->second;
+        }
+        crab_bench::do_not_optimize(acc);
+    });
+    crab_bench::run("  crab::StringInterner::find", n, [&] {
+        uint32_t acc = 0;
+        for (const std::string* s : stream) {
+            acc += interner.find(bytes_of(*s)).unwrap_or(0);
+        }
+        crab_bench::do_not_optimize(acc);
+    });
+
+    std::printf("equality of consecutive keys\n");
+    std::vector<uint32_t> ids(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ids[i] = interner.find(bytes_of(*stream[i])).unwrap_or(0);
+    }
+    crab_bench::run("  std::string ==", n, [&] {
+        std::size_t same = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            same += *stream[i] == *stream[i - 1];
+        }
+        crab_bench::do_not_optimize(same);
+    });
+    crab_bench::run("  interned id ==", n, [&] {
+        std::size_t same = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            same += ids[i] == ids[i - 1];
+        }
+        crab_bench::do_not_optimize(same);
+    });
+    return 0;
+}
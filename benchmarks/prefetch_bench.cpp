@@ -0,0 +1,248 @@
+/**
+ * @file prefetch_bench.cpp
+ * @brief Cache-miss-bound lookups: plain loops vs. prefetching traversals.
+ *
+ * Three workloads over tables much larger than the LLC:
+ * - random index lookups into a large Slice (for_each_indexed)
+ * - open-addressing hash probes (for_each_group)
+ * - pointer chasing through short chains of pooled nodes (amac)
+ *
+ * Run with: ./prefetch_bench [--mb=256] [--n=1000000] [--distance=16]
+ *                            [--group=16] [--width=16]
+ * Group and width are compile-time in the library; 4/8/16/32 are
+ * instantiated here.
+ */
+
+#include "bench_common.h"
+
+#include <crab/prefetch.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+// ============================================================================
+// Hash probes
+// ============================================================================
+
+struct Bucket {
+    uint64_t key;
+    uint64_t value;
+};
+
+struct HashTable {
+    std::vector<Bucket> buckets;
+    uint64_t mask;
+
+    const Bucket* home(uint64_t key) const {
+        return &buckets[(key * 0x9E3779B97F4A7C15ull >> 20) & mask];
+    }
+
+    // Linear probing; keys are never 0, 0 marks an empty bucket
+    uint64_t find(uint64_t key, const Bucket* b) const {
+        const Bucket* end = buckets.data() + buckets.size();
+        while (b->key != 0) {
+            if (b->key == key) {
+                return b->value;
+            }
+            if (++b == end) {
+                b = buckets.data();
+            }
+        }
+        return 0;
+    }
+};
+
+template<std::size_t Group>
+uint64_t probe_grouped(const HashTable& t, crab::Slice<const uint64_t> keys) {
+    uint64_t acc = 0;
+    crab::for_each_group<Group>(
+        keys, [&](uint64_t key) { return t.home(key); },
+        [&](uint64_t key, const Bucket* b) { acc += t.find(key, b); });
+    return acc;
+}
+
+// ============================================================================
+// Pointer chasing
+// ============================================================================
+
+struct Node {
+    uint64_t value;
+    const Node* next;
+    char pad[48];
+};
+
+struct ChainSum {
+    struct State {
+        const Node* node;
+    };
+    uint64_t acc = 0;
+
+    const void* start(State& s, const Node* const& head) {
+        s.node = head;
+        return head;
+    }
+    const void* step(State& s) {
+        acc += s.node->value;
+        s.node = s.node->next;
+        return s.node;
+    }
+};
+
+template<std::size_t Width>
+uint64_t chase_amac(crab::Slice<const Node* const> heads) {
+    ChainSum machine;
+    crab::amac<Width>(heads, machine);
+    return machine.acc;
+}
+
+template<template<std::size_t> class Fn, typename... Args>
+uint64_t dispatch_width(long width, Args&&... args) {
+    switch (width) {
+        case 4: return Fn<4>::run(args...);
+        case 8: return Fn<8>::run(args...);
+        case 32: return Fn<32>::run(args...);
+        default: return Fn<16>::run(args...);
+    }
+}
+
+template<std::size_t G>
+struct GroupedProbe {
+    static uint64_t run(const HashTable& t, crab::Slice<const uint64_t> keys) {
+        return probe_grouped<G>(t, keys);
+    }
+};
+
+template<std::size_t W>
+struct AmacChase {
+    static uint64_t run(crab::Slice<const Node* const> heads) {
+        return chase_amac<W>(heads);
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t mb = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "mb", 256));
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 1000000));
+    const std::size_t distance = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "distance", 16));
+    const long group = crab_bench::arg_or(argc, argv, "group", 16);
+    const long width = crab_bench::arg_or(argc, argv, "width", 16);
+    std::mt19937_64 rng(11);
+    char name[80];
+
+    // Random index lookups -------------------------------------------------
+    {
+        std::vector<uint64_t> table(mb * 1024 * 1024 / sizeof(uint64_t));
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            table[i] = i;
+        }
+        std::vector<uint32_t> idx(n);
+        for (auto& x : idx) {
+            x = static_cast<uint32_t>(rng() % table.size());
+        }
+        crab::Slice<const uint64_t> st(table.data(), table.size());
+        crab::Slice<const uint32_t> si(idx.data(), idx.size());
+
+        std::printf("index lookups: table=%zu MiB n=%zu\n", mb, n);
+        crab_bench::run("  plain loop", n, [&] {
+            uint64_t acc = 0;
+            for (uint32_t i : idx) {
+                acc += table[i];
+            }
+            crab_bench::do_not_optimize(acc);
+        }, 7);
+        std::snprintf(name, sizeof(name), "  for_each_indexed (distance=%zu)", distance);
+        crab_bench::run(name, n, [&] {
+            uint64_t acc = 0;
+            auto r = crab::for_each_indexed(st, si, distance, [&](uint64_t v) { acc += v; });
+            crab_bench::do_not_optimize(r);
+            crab_bench::do_not_optimize(acc);
+        }, 7);
+    }
+
+    // Hash probes ----------------------------------------------------------
+    {
+        HashTable t;
+        std::size_t buckets = 1;
+        while (buckets * sizeof(Bucket) < mb * 1024 * 1024) {
+            buckets <<= 1;
+        }
+        t.buckets.assign(buckets, Bucket{0, 0});
+        t.mask = buckets - 1;
+        std::vector<uint64_t> keys(n);
+        for (std::size_t i = 0; i < buckets / 2; ++i) {
+            const uint64_t key = rng() | 1;
+            const Bucket* b = t.home(key);
+            Bucket* w = &t.buckets[static_cast<std::size_t>(b - t.buckets.data())];
+            while (w->key != 0) {
+                w = (w + 1 == t.buckets.data() + buckets) ? t.buckets.data() : w + 1;
+            }
+            *w = Bucket{key, i};
+            if (i < n) {
+                keys[i] = key;
+            }
+        }
+        for (std::size_t i = buckets / 2; i < n; ++i) {
+            keys[i] = keys[rng() % (buckets / 2)];
+        }
+        std::shuffle(keys.begin(), keys.end(), rng);
+        crab::Slice<const uint64_t> sk(keys.data(), keys.size());
+
+        std::printf("hash probes: %zu buckets, load 0.5, n=%zu\n", buckets, n);
+        crab_bench::run("  plain loop", n, [&] {
+            uint64_t acc = 0;
+            for (uint64_t key : keys) {
+                acc += t.find(key, t.home(key));
+            }
+            crab_bench::do_not_optimize(acc);
+        }, 7);
+        std::snprintf(name, sizeof(name), "  for_each_group (group=%ld)", group);
+        crab_bench::run(name, n, [&] {
+            crab_bench::do_not_optimize(dispatch_width<GroupedProbe>(group, t, sk));
+        }, 7);
+    }
+
+    // Pointer chasing ------------------------------------------------------
+    {
+        constexpr std::size_t kChain = 8;
+        const std::size_t nodes = mb * 1024 * 1024 / sizeof(Node);
+        std::vector<Node> pool(nodes);
+        std::vector<uint32_t> order(nodes);
+        for (std::size_t i = 0; i < nodes; ++i) {
+            order[i] = static_cast<uint32_t>(i);
+        }
+        std::shuffle(order.begin(), order.end(), rng);
+        const std::size_t chains = nodes / kChain;
+        std::vector<const Node*> heads(chains);
+        for (std::size_t c = 0; c < chains; ++c) {
+            for (std::size_t j = 0; j < kChain; ++j) {
+                Node& node = pool[order[c * kChain + j]];
+                node.value = c + j;
+                node.next = j + 1 < kChain ? &pool[order[c * kChain + j + 1]] : nullptr;
+            }
+            heads[c] = &pool[order[c * kChain]];
+        }
+        const std::size_t count = std::min(chains, n / kChain);
+        crab::Slice<const Node* const> sh(heads.data(), count);
+
+        std::printf("pointer chasing: %zu chains of %zu nodes\n", count, kChain);
+        crab_bench::run("  plain loop", count * kChain, [&] {
+            uint64_t acc = 0;
+            for (std::size_t c = 0; c < count; ++c) {
+                for (const Node* p = heads[c]; p != nullptr; p = p->next) {
+                    acc += p->value;
+                }
+            }
+            crab_bench::do_not_optimize(acc);
+        }, 7);
+        std::snprintf(name, sizeof(name), "  amac (width=%ld)", width);
+        crab_bench::run(name, count * kChain, [&] {
+            crab_bench::do_not_optimize(dispatch_width<AmacChase>(width, sh));
+        }, 7);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file prefix_trie_bench.cpp
+ * @brief IPv4 longest-prefix match: linear scan over a StaticVector of
+ *        rules vs. crab::PrefixTrie, single and batched (amac) lookups.
+ *
+ * Run with: ./prefix_trie_bench [--n=65536] [--rules=512]
+ */
+
+#include "bench_common.h"
+
+#include <crab/prefix_trie.h>
+#include <crab/static_vector.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Rule {
+    uint32_t prefix;
+    uint32_t mask;
+    uint16_t hop;
+};
+
+constexpr std::size_t kMaxRules = 4096;
+
+using Table = crab::PrefixTrie<uint16_t, 65536, kMaxRules>;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 65536));
+    std::size_t rule_count = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "rules", 512));
+    rule_count = rule_count > kMaxRules ? kMaxRules : rule_count;
+    std::mt19937 rng(21);
+
+    // Mostly /16-/24 like a real table, plus a default route
+    static crab::StaticVector<Rule, kMaxRules> rules;
+    static Table trie;
+    rules.push_back(Rule{0, 0, 0});
+    (void)trie.insert(uint32_t{0}, 0, uint16_t{0});
+    while (rules.size() < rule_count) {
+        const uint32_t len = 8 + rng() % 25;
+        const uint32_t mask = ~0u << (32 - len);
+        const Rule r{static_cast<uint32_t>(rng()) & mask, mask, static_cast<uint16_t>(rules.size())};
+        if (trie.insert(r.prefix, len, r.hop).unwrap()) {
+            rules.push_back(r);
+        }
+    }
+
+    std::vector<uint32_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        // Half the keys land inside a rule
+        const Rule& r = rules[rng() % rules.size()];
+        keys[i] = i % 2 ? static_cast<uint32_t>(rng()) : (r.prefix | (static_cast<uint32_t>(rng()) & ~r.mask));
+    }
+    std::vector<uint16_t> out(n);
+
+    std::printf("%zu rules, %zu trie nodes, %zu lookups\n", rules.size(), trie.node_count(), n);
+
+    crab_bench::run("  linear scan (most specific wins)", n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            uint16_t hop = 0;
+            uint32_t best = 0;
+            for (const Rule& r : rules) {
+                if ((keys[i] & r.mask) == r.prefix && r.mask >= best) {
+                    best = r.mask;
+                    hop = r.hop;
+                }
+            }
+            out[i] = hop;
+        }
+        crab_bench::clobber_memory();
+    });
+    crab_bench::run("  crab::PrefixTrie::longest_prefix", n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            auto hop = trie.longest_prefix(keys[i]);
+            out[i] = hop.is_some() ? hop.unwrap().get() : uint16_t{0};
+        }
+        crab_bench::clobber_memory();
+    });
+    crab_bench::run("  crab::PrefixTrie::longest_prefix_batch", n, [&] {
+        crab_bench::do_not_optimize(trie.longest_prefix_batch(
+            crab::Slice<const uint32_t>(keys), crab::Slice<uint16_t>(out), uint16_t{0}));
+        crab_bench::clobber_memory();
+    });
+    return 0;
+}
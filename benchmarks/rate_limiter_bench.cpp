@@ -0,0 +1,98 @@
+/**
+ * @file rate_limiter_bench.cpp
+ * @brief Shared throttle check: token bucket in crab::Mutex vs.
+ *        crab::RateLimiter vs. crab::ShardedRateLimiter, across threads.
+ *
+ * Run with: ./rate_limiter_bench [--n=1000000] [--threads=4]
+ */
+
+#include "bench_common.h"
+
+#include <crab/mutex.h>
+#include <crab/rate_limiter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The token bucket the lock-free limiters replace
+struct LockedBucket {
+    double tokens;
+    double burst;
+    double per_ns;
+    uint64_t last;
+
+    // `now` is read before the lock, so another thread may already have
+    // moved `last` past it; that counts as no time elapsed
+    bool try_acquire(uint64_t now) {
+        if (now > last) {
+            tokens = std::min(burst, tokens + double(now - last) * per_ns);
+            last = now;
+        }
+        if (tokens < 1.0) {
+            return false;
+        }
+        tokens -= 1.0;
+        return true;
+    }
+};
+
+// Each thread makes `per_thread` checks; returns tokens granted
+template<typename F>
+uint64_t hammer(std::size_t threads, std::size_t per_thread, F&& check) {
+    std::vector<std::thread> pool;
+    std::atomic<uint64_t> granted{0};
+    for (std::size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&] {
+            uint64_t mine = 0;
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                mine += check() ? 1 : 0;
+            }
+            granted += mine;
+        });
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+    return granted.load();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 1000000));
+    const std::size_t threads = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "threads", 4));
+    const std::size_t per_thread = n / threads;
+
+    // Open: nearly every check is granted. Throttled: nearly every check is refused.
+    const double rates[2] = {1e9, 1e3};
+    const char* labels[2] = {"open (1e9/s)", "throttled (1e3/s)"};
+
+    std::printf("%zu threads, %zu checks per run\n", threads, per_thread * threads);
+    for (int r = 0; r < 2; ++r) {
+        std::printf("%s\n", labels[r]);
+
+        crab::Mutex<LockedBucket> locked(LockedBucket{1000.0, 1000.0, rates[r] * 1e-9, crab::SteadyClock::now()});
+        crab_bench::run("  crab::Mutex<TokenBucket>", per_thread * threads, [&] {
+            crab_bench::do_not_optimize(hammer(threads, per_thread, [&] {
+                const uint64_t now = crab::SteadyClock::now();
+                return locked.lock()->try_acquire(now);
+            }));
+        }, 9);
+
+        crab::RateLimiter<> limiter(rates[r], 1000);
+        crab_bench::run("  crab::RateLimiter", per_thread * threads, [&] {
+            crab_bench::do_not_optimize(hammer(threads, per_thread, [&] { return limiter.try_acquire(); }));
+        }, 9);
+
+        crab::ShardedRateLimiter<8> sharded(rates[r], 1000);
+        crab_bench::run("  crab::ShardedRateLimiter<8>", per_thread * threads, [&] {
+            crab_bench::do_not_optimize(hammer(threads, per_thread, [&] { return sharded.try_acquire(); }));
+        }, 9);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file set_ops_bench.cpp
+ * @brief Sorted-set intersection: std::set_intersection vs. crab kernels.
+ *
+ * Compares the scalar merge, the AVX2 block intersection and galloping
+ * across match densities and size ratios.
+ * Run with: ./set_ops_bench [--n=100000]
+ */
+
+#include "bench_common.h"
+
+#include <crab/set_ops.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<uint32_t> random_set(std::size_t n, uint32_t universe, std::mt19937& rng) {
+    std::vector<uint32_t> v(n);
+    for (auto& x : v) {
+        x = rng() % universe;
+    }
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+    return v;
+}
+
+void bench_case(const char* label, std::size_t na, std::size_t nb, uint32_t universe, std::mt19937& rng) {
+    const std::vector<uint32_t> a = random_set(na, universe, rng);
+    const std::vector<uint32_t> b = random_set(nb, universe, rng);
+    std::vector<uint32_t> out(std::min(a.size(), b.size()));
+    crab::Slice<const uint32_t> sa(a.data(), a.size());
+    crab::Slice<const uint32_t> sb(b.data(), b.size());
+    const std::size_t items = a.size() + b.size();
+    char name[80];
+
+    std::printf("%s: |a|=%zu |b|=%zu |a&b|=%zu\n", label, a.size(), b.size(),
+                crab::set_intersection_count(sa, sb));
+
+    std::snprintf(name, sizeof(name), "  std::set_intersection");
+    crab_bench::run(name, items, [&] {
+        auto end = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+        crab_bench::do_not_optimize(end);
+    });
+
+    crab::simd::set_level_cap(crab::simd::Level::Scalar);
+    std::snprintf(name, sizeof(name), "  crab::set_intersection (scalar)");
+    crab_bench::run(name, items, [&] {
+        crab_bench::do_not_optimize(crab::set_intersection(sa, sb, crab::Slice<uint32_t>(out)));
+    });
+
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+    std::snprintf(name, sizeof(name), "  crab::set_intersection");
+    crab_bench::run(name, items, [&] {
+        crab_bench::do_not_optimize(crab::set_intersection(sa, sb, crab::Slice<uint32_t>(out)));
+    });
+
+    std::snprintf(name, sizeof(name), "  crab::set_intersection_count");
+    crab_bench::run(name, items, [&] {
+        crab_bench::do_not_optimize(crab::set_intersection_count(sa, sb));
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 100000));
+    std::mt19937 rng(7);
+
+    std::printf("active SIMD level = %d\n", static_cast<int>(crab::simd::active_level()));
+    bench_case("sparse matches", n, n, static_cast<uint32_t>(n * 64), rng);
+    bench_case("dense matches", n, n, static_cast<uint32_t>(n * 2), rng);
+    bench_case("skewed 1:100", n / 100, n, static_cast<uint32_t>(n * 4), rng);
+    bench_case("skewed 1:1000", n / 1000, n, static_cast<uint32_t>(n * 4), rng);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file sketch_bench.cpp
+ * @brief Streaming sketches: exact answers (sort / hash set) vs. crab's
+ *        fixed-memory sketches, plus HyperLogLog register merges.
+ *
+ * Run with: ./sketch_bench [--n=65536]
+ */
+
+#include "bench_common.h"
+
+#include <crab/sketch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 65536));
+    std::mt19937_64 rng(5);
+    std::lognormal_distribution<double> latency(3.0, 1.0);
+
+    std::vector<double> xs(n);
+    std::vector<uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        xs[i] = latency(rng);
+        keys[i] = rng() % (n / 2 + 1);
+    }
+
+    std::printf("%zu samples\n", n);
+
+    std::printf("p99 of a stream\n");
+    crab_bench::run("  copy + nth_element", n, [&] {
+        std::vector<double> copy = xs;
+        auto mid = copy.begin() + static_cast<std::ptrdiff_t>(0.99 * static_cast<double>(n - 1));
+        std::nth_element(copy.begin(), mid, copy.end());
+        crab_bench::do_not_optimize(*mid);
+    });
+    crab_bench::run("  crab::DDSketch<>", n, [&] {
+        crab::DDSketch<> dd;
+        dd.add_batch(crab::Slice<const double>(xs));
+        crab_bench::do_not_optimize(dd.quantile(0.99).unwrap_or(0.0));
+    });
+    crab_bench::run("  crab::QuantileSketch<double>", n, [&] {
+        crab::QuantileSketch<double> qs;
+        qs.add_batch(crab::Slice<const double>(xs));
+        crab_bench::do_not_optimize(qs.quantile(0.99).unwrap_or(0.0));
+    });
+
+    std::printf("distinct count\n");
+    crab_bench::run("  std::unordered_set", n, [&] {
+        std::unordered_set<uint64_t> seen(keys.begin(), keys.end());
+        crab_bench::do_not_optimize(seen.size());
+    });
+    crab_bench::run("  crab::HyperLogLog<14>", n, [&] {
+        crab::HyperLogLog<14> hll;
+        hll.add_batch(crab::Slice<const uint64_t>(keys));
+        crab_bench::do_not_optimize(hll.estimate());
+    });
+
+    std::printf("frequency\n");
+    crab_bench::run("  crab::CountMinSketch<2048, 4>", n, [&] {
+        crab::CountMinSketch<2048, 4> cms;
+        cms.add_batch(crab::Slice<const uint64_t>(keys));
+        crab_bench::do_not_optimize(cms.estimate(keys[0]));
+    });
+
+    // Per-thread sketches folded together: merge cost per register
+    std::printf("HyperLogLog<14> merge (16384 registers)\n");
+    crab::HyperLogLog<14> a, b;
+    for (std::size_t i = 0; i < n; ++i) {
+        (i % 2 ? a : b).add(keys[i]);
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Scalar);
+    crab_bench::run("  scalar", crab::HyperLogLog<14>::kRegisters, [&] {
+        a.merge(b);
+        crab_bench::clobber_memory();
+    });
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+    crab_bench::run("  crab::HyperLogLog::merge", crab::HyperLogLog<14>::kRegisters, [&] {
+        a.merge(b);
+        crab_bench::clobber_memory();
+    });
+    return 0;
+}
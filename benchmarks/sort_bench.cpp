@@ -0,0 +1,141 @@
+/**
+ * @file sort_bench.cpp
+ * @brief std::sort vs. radix_sort (large inputs) and sort_small (tiny inputs).
+ *
+ * Every timed call first restores the unsorted input with memcpy, so all
+ * variants pay the same copy cost. Tiny sorts run over a batch of arrays
+ * so the clock resolution does not dominate.
+ * Run with: ./sort_bench [--max_n=4194304] [--batch=4096]
+ */
+
+#include "bench_common.h"
+
+#include <crab/sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+template<typename T>
+std::vector<T> random_keys(std::size_t n, std::mt19937_64& rng) {
+    std::vector<T> keys(n);
+    for (auto& k : keys) {
+        if constexpr (std::is_floating_point_v<T>) {
+            k = static_cast<T>(static_cast<double>(rng()) * 0x1.0p-64 * 2e6 - 1e6);
+        } else {
+            k = static_cast<T>(rng());
+        }
+    }
+    return keys;
+}
+
+template<typename T>
+void bench_large(const char* type, std::size_t max_n, std::mt19937_64& rng) {
+    for (std::size_t n = 256; n <= max_n; n *= 16) {
+        const std::vector<T> input = random_keys<T>(n, rng);
+        std::vector<T> work(n);
+        std::vector<T> scratch(n);
+        const int reps = n >= (1u << 20) ? 5 : 31;
+        char name[64];
+
+        std::snprintf(name, sizeof(name), "std::sort %s n=%zu", type, n);
+        const double base = crab_bench::run(name, n, [&] {
+            std::memcpy(work.data(), input.data(), n * sizeof(T));
+            std::sort(work.begin(), work.end());
+            crab_bench::clobber_memory();
+        }, reps);
+
+        std::snprintf(name, sizeof(name), "radix_sort %s n=%zu", type, n);
+        const double radix = crab_bench::run(name, n, [&] {
+            std::memcpy(work.data(), input.data(), n * sizeof(T));
+            (void)crab::radix_sort(crab::Slice<T>(work), crab::Slice<T>(scratch));
+            crab_bench::clobber_memory();
+        }, reps);
+        std::printf("  speedup %.2fx\n", base / radix);
+    }
+}
+
+void bench_pairs(std::size_t n, std::mt19937_64& rng) {
+    const std::vector<uint32_t> input = random_keys<uint32_t>(n, rng);
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(n);
+    std::vector<uint32_t> keys(n), values(n), key_scratch(n), value_scratch(n);
+    char name[64];
+
+    std::snprintf(name, sizeof(name), "std::stable_sort pairs n=%zu", n);
+    const double base = crab_bench::run(name, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            pairs[i] = {input[i], static_cast<uint32_t>(i)};
+        }
+        std::stable_sort(pairs.begin(), pairs.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        crab_bench::clobber_memory();
+    }, 5);
+
+    std::snprintf(name, sizeof(name), "radix_sort_by_key pairs n=%zu", n);
+    const double radix = crab_bench::run(name, n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = input[i];
+            values[i] = static_cast<uint32_t>(i);
+        }
+        (void)crab::radix_sort_by_key(crab::Slice<uint32_t>(keys), crab::Slice<uint32_t>(values),
+                                      crab::Slice<uint32_t>(key_scratch), crab::Slice<uint32_t>(value_scratch));
+        crab_bench::clobber_memory();
+    }, 5);
+    std::printf("  speedup %.2fx\n", base / radix);
+}
+
+template<typename T>
+void bench_small(const char* type, std::size_t batch, std::mt19937_64& rng) {
+    const std::size_t sizes[] = {4, 8, 16, 24, 32};
+    for (std::size_t n : sizes) {
+        const std::vector<T> input = random_keys<T>(n * batch, rng);
+        std::vector<T> work(n * batch);
+        char name[64];
+
+        std::snprintf(name, sizeof(name), "std::sort %s x%zu", type, n);
+        const double base = crab_bench::run(name, batch, [&] {
+            std::memcpy(work.data(), input.data(), work.size() * sizeof(T));
+            for (std::size_t b = 0; b < batch; ++b) {
+                std::sort(work.begin() + static_cast<std::ptrdiff_t>(b * n),
+                          work.begin() + static_cast<std::ptrdiff_t>((b + 1) * n));
+            }
+            crab_bench::clobber_memory();
+        });
+
+        std::snprintf(name, sizeof(name), "sort_small %s x%zu", type, n);
+        const double small = crab_bench::run(name, batch, [&] {
+            std::memcpy(work.data(), input.data(), work.size() * sizeof(T));
+            for (std::size_t b = 0; b < batch; ++b) {
+                crab::sort_small(crab::Slice<T>(work.data() + b * n, n));
+            }
+            crab_bench::clobber_memory();
+        });
+        std::printf("  speedup %.2fx\n", base / small);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t max_n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "max_n", 1 << 22));
+    const std::size_t batch = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "batch", 4096));
+    std::mt19937_64 rng(42);
+
+    std::printf("active SIMD level = %d\n", static_cast<int>(crab::simd::active_level()));
+    bench_large<uint32_t>("u32", max_n, rng);
+    bench_large<int64_t>("i64", max_n, rng);
+    bench_large<float>("f32", max_n, rng);
+    bench_pairs(1 << 20, rng);
+
+    bench_small<int32_t>("i32", batch, rng);
+    bench_small<float>("f32", batch, rng);
+    bench_small<int16_t>("i16", batch, rng);
+
+    crab::simd::set_level_cap(crab::simd::Level::Scalar);
+    bench_small<int32_t>("i32 (scalar network)", batch, rng);
+    return 0;
+}
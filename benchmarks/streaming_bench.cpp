@@ -0,0 +1,139 @@
+/**
+ * @file streaming_bench.cpp
+ * @brief memmove vs. copy_streaming: bandwidth and cache pollution.
+ *
+ * Part 1 reports copy bandwidth across sizes. Part 2 runs a "real-time"
+ * thread that keeps timing passes over a hot working set while the main
+ * thread copies large snapshots. With memmove the copy evicts the hot set
+ * from the shared last-level cache; with copy_streaming it should not.
+ * The default hot set is sized past a typical private L2 so that it
+ * lives in the shared cache.
+ * Run with: ./streaming_bench [--hot_kb=2048] [--snapshot_mb=32] [--copies=16]
+ */
+
+#include "bench_common.h"
+
+#include <crab/streaming.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int64_t touch_hot(const std::vector<int64_t>& hot) {
+    int64_t acc = 0;
+    for (std::size_t i = 0; i < hot.size(); i += 8) {   // one load per cache line
+        acc += hot[i];
+    }
+    return acc;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t hot_kb = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "hot_kb", 2048));
+    const std::size_t snapshot_mb = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "snapshot_mb", 32));
+    const int copies = static_cast<int>(crab_bench::arg_or(argc, argv, "copies", 16));
+
+    std::printf("threshold = %u bytes, active SIMD level = %d\n",
+                static_cast<unsigned>(CRAB_STREAMING_THRESHOLD),
+                static_cast<int>(crab::simd::active_level()));
+
+    // ------------------------------------------------------------------------
+    // Part 1: bandwidth
+    // ------------------------------------------------------------------------
+    const std::size_t sizes[] = {64u << 10, 1u << 20, 16u << 20, 64u << 20};
+    std::vector<uint8_t> src(sizes[3], 1);
+    std::vector<uint8_t> dst(sizes[3], 0);
+
+    for (std::size_t bytes : sizes) {
+        crab::ConstByteSlice from(src.data(), bytes);
+        crab::ByteSlice to(dst.data(), bytes);
+        char name[64];
+
+        std::snprintf(name, sizeof(name), "memmove %zu KiB", bytes >> 10);
+        const double mm = crab_bench::run(name, bytes, [&] {
+            std::memmove(to.data(), from.data(), bytes);
+            crab_bench::clobber_memory();
+        }, 11);
+
+        std::snprintf(name, sizeof(name), "copy_streaming %zu KiB", bytes >> 10);
+        const double st = crab_bench::run(name, bytes, [&] {
+            (void)crab::copy_streaming(from, to);
+            crab_bench::clobber_memory();
+        }, 11);
+
+        std::printf("  -> %.2f GB/s memmove, %.2f GB/s streaming\n",
+                    static_cast<double>(bytes) / mm, static_cast<double>(bytes) / st);
+    }
+
+    // ------------------------------------------------------------------------
+    // Part 2: concurrent hot loop while snapshots are copied
+    // ------------------------------------------------------------------------
+    std::vector<int64_t> hot(hot_kb * 1024 / sizeof(int64_t), 3);
+    const std::size_t snap = snapshot_mb << 20;
+    std::vector<uint8_t> snap_src(snap, 2);
+    std::vector<uint8_t> snap_dst(snap, 0);
+    crab::ConstByteSlice from(snap_src.data(), snap);
+    crab::ByteSlice to(snap_dst.data(), snap);
+    const std::size_t lines = hot.size() / 8;
+
+    std::printf("\nhot set %zu KiB on a second thread, %d x %zu MiB snapshot copies\n",
+                hot_kb, copies, snapshot_mb);
+
+    // Median hot-pass time on the hot thread while `work` runs on this one
+    auto hot_pass_during = [&](auto&& work) {
+        using Clock = std::chrono::steady_clock;
+        std::atomic<bool> ready{false};
+        std::atomic<bool> stop{false};
+        std::vector<double> samples;
+        samples.reserve(1 << 16);
+        std::thread hot_thread([&] {
+            crab_bench::do_not_optimize(touch_hot(hot));   // hot set resident
+            ready.store(true, std::memory_order_release);
+            while (!stop.load(std::memory_order_acquire)) {
+                const auto start = Clock::now();
+                crab_bench::do_not_optimize(touch_hot(hot));
+                if (samples.size() < samples.capacity()) {
+                    samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+                }
+            }
+        });
+        while (!ready.load(std::memory_order_acquire)) {
+        }
+        work();
+        stop.store(true, std::memory_order_release);
+        hot_thread.join();
+        if (samples.empty()) {
+            return 0.0;
+        }
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2),
+                         samples.end());
+        return samples[samples.size() / 2];
+    };
+
+    auto report = [&](const char* name, double ns) {
+        std::printf("%-40s %12.1f ns/pass %10.3f ns/line\n", name, ns, ns / static_cast<double>(lines));
+    };
+
+    report("hot pass, idle", hot_pass_during([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }));
+    report("hot pass during memmove", hot_pass_during([&] {
+        for (int c = 0; c < copies; ++c) {
+            std::memmove(to.data(), from.data(), snap);
+            crab_bench::clobber_memory();
+        }
+    }));
+    report("hot pass during copy_streaming", hot_pass_during([&] {
+        for (int c = 0; c < copies; ++c) {
+            (void)crab::copy_streaming(from, to);
+            crab_bench::clobber_memory();
+        }
+    }));
+
+    return 0;
+}
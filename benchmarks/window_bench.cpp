@@ -0,0 +1,98 @@
+/**
+ * @file window_bench.cpp
+ * @brief Rolling min/max/mean/variance: rescanning the window every tick
+ *        vs. crab's O(1) aggregators.
+ *
+ * Run with: ./window_bench [--n=16384]
+ */
+
+#include "bench_common.h"
+
+#include <crab/window.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kWindow = 256;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = static_cast<std::size_t>(crab_bench::arg_or(argc, argv, "n", 16384));
+    std::mt19937 rng(9);
+    std::normal_distribution<float> step(0.0f, 1.0f);
+
+    // Random walk, like a price series
+    std::vector<float> ticks(n + kWindow);
+    float px = 100.0f;
+    for (auto& t : ticks) {
+        px += step(rng) * 0.01f;
+        t = px;
+    }
+    const float* x = ticks.data() + kWindow;
+
+    std::printf("window = %zu samples, %zu ticks\n", kWindow, n);
+
+    std::printf("rolling min + max\n");
+    crab_bench::run("  rescan window each tick", n, [&] {
+        float acc = 0.0f;
+        for (std::size_t t = 0; t < n; ++t) {
+            const float* w = x + t + 1 - kWindow;
+            const auto [lo, hi] = std::minmax_element(w, w + kWindow);
+            acc += *hi - *lo;
+        }
+        crab_bench::do_not_optimize(acc);
+    });
+    crab_bench::run("  crab::WindowMin + WindowMax", n, [&] {
+        crab::WindowMin<float, kWindow> lo;
+        crab::WindowMax<float, kWindow> hi;
+        float acc = 0.0f;
+        for (std::size_t t = 0; t < n; ++t) {
+            lo.push(x[t]);
+            hi.push(x[t]);
+            acc += hi.value().unwrap_or(0.0f) - lo.value().unwrap_or(0.0f);
+        }
+        crab_bench::do_not_optimize(acc);
+    });
+
+    std::printf("rolling mean + variance\n");
+    crab_bench::run("  rescan window each tick (two-pass)", n, [&] {
+        double acc = 0.0;
+        for (std::size_t t = 0; t < n; ++t) {
+            const float* w = x + t + 1 - kWindow;
+            double sum = 0.0;
+            for (std::size_t k = 0; k < kWindow; ++k) {
+                sum += w[k];
+            }
+            const double mean = sum / kWindow;
+            double m2 = 0.0;
+            for (std::size_t k = 0; k < kWindow; ++k) {
+                m2 += (w[k] - mean) * (w[k] - mean);
+            }
+            acc += m2 / kWindow;
+        }
+        crab_bench::do_not_optimize(acc);
+    });
+    crab_bench::run("  crab::WindowStats", n, [&] {
+        crab::WindowStats<float, kWindow> stats;
+        double acc = 0.0;
+        for (std::size_t t = 0; t < n; ++t) {
+            stats.push(x[t]);
+            acc += stats.variance().unwrap_or(0.0);
+        }
+        crab_bench::do_not_optimize(acc);
+    });
+    crab_bench::run("  crab::EwmaStats", n, [&] {
+        auto ew = crab::EwmaStats::from_span(kWindow);
+        double acc = 0.0;
+        for (std::size_t t = 0; t < n; ++t) {
+            ew.push(x[t]);
+            acc += ew.variance().unwrap_or(0.0);
+        }
+        crab_bench::do_not_optimize(acc);
+    });
+    return 0;
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+/**
+ * @file aligned_slice.h
+ * @brief Slice that carries a compile-time alignment guarantee.
+ *
+ * Lets SIMD kernels use aligned loads/stores without re-checking the
+ * pointer on every call. Alignment is proven once, at construction.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/static_vector.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace crab {
+
+/**
+ * @brief Non-owning view whose data() is aligned to Align bytes.
+ *
+ * Created through the checked from_slice(), from an over-aligned
+ * StaticVector, or as the body of split_aligned().
+ *
+ * @tparam T Element type (can be const)
+ * @tparam Align Alignment in bytes (power of two, >= alignof(T))
+ *
+ * @code{cpp}
+ *   crab::StaticVector<float, 1024, 32> samples;   // 32-byte aligned storage
+ *   crab::AlignedSlice<float, 32> view(samples);
+ *   __m256 v = _mm256_load_ps(view.data());        // aligned load, no check
+ * @endcode
+ */
+template<typename T, std::size_t Align>
+class AlignedSlice {
+    static_assert((Align & (Align - 1)) == 0, "AlignedSlice alignment must be a power of two");
+    static_assert(Align >= alignof(T), "AlignedSlice alignment must be at least alignof(T)");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+
+    static constexpr std::size_t alignment = Align;
+
+    // ========================================================================
+    // Constructors
+    // ========================================================================
+
+    constexpr AlignedSlice() noexcept : m_data(nullptr), m_size(0) {}
+
+    /**
+     * @brief Checked conversion from a Slice.
+     * @return Err(Misaligned) if data() is not Align-aligned
+     */
+    static Result<AlignedSlice, Misaligned> from_slice(Slice<T> s) noexcept {
+        const auto addr = reinterpret_cast<std::uintptr_t>(s.data());
+        if ((addr & (Align - 1)) != 0) {
+            return Err(Misaligned{addr, Align});
+        }
+        return Ok(AlignedSlice(s.data(), s.size()));
+    }
+
+    /**
+     * @brief Construct from a raw pointer the caller knows is aligned.
+     * @warning Alignment is only checked in debug builds.
+     */
+    static AlignedSlice from_raw_unchecked(T* data, size_type size) noexcept {
+        CRAB_DEBUG_ASSERT((reinterpret_cast<std::uintptr_t>(data) & (Align - 1)) == 0,
+            "AlignedSlice::from_raw_unchecked() pointer is misaligned");
+        return AlignedSlice(data, size);
+    }
+
+    /**
+     * @brief View an over-aligned StaticVector (alignment proven at compile time).
+     */
+    template<typename U, std::size_t N, std::size_t A,
+             typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    AlignedSlice(StaticVector<U, N, A>& vec) noexcept
+        : m_data(vec.data()), m_size(vec.size()) {
+        static_assert(A >= Align, "StaticVector storage alignment is weaker than AlignedSlice");
+    }
+
+    template<typename U, std::size_t N, std::size_t A,
+             typename = std::enable_if_t<std::is_convertible_v<const U*, T*>>>
+    AlignedSlice(const StaticVector<U, N, A>& vec) noexcept
+        : m_data(vec.data()), m_size(vec.size()) {
+        static_assert(A >= Align, "StaticVector storage alignment is weaker than AlignedSlice");
+    }
+
+    /**
+     * @brief Weaken the guarantee or add const (e.g. <float, 64> -> <const float, 32>).
+     */
+    template<typename U, std::size_t A,
+             typename = std::enable_if_t<(A >= Align) && std::is_convertible_v<U*, T*> &&
+                                         !(std::is_same_v<U, T> && A == Align)>>
+    constexpr AlignedSlice(AlignedSlice<U, A> other) noexcept
+        : m_data(other.data()), m_size(other.size()) {}
+
+    // ========================================================================
+    // Size & Access
+    // ========================================================================
+
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr bool is_empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief Aligned pointer (the compiler is told about the alignment).
+     */
+    [[nodiscard]] T* data() const noexcept {
+        return static_cast<T*>(__builtin_assume_aligned(m_data, Align));
+    }
+
+    [[nodiscard]] T& operator[](size_type index) const noexcept {
+        CRAB_ASSERT(index < m_size, "AlignedSlice index out of bounds");
+        return data()[index];
+    }
+
+    [[nodiscard]] T& unchecked(size_type index) const noexcept {
+        return data()[index];
+    }
+
+    /**
+     * @brief First n elements (clamped); the start stays aligned.
+     */
+    [[nodiscard]] AlignedSlice first(size_type n) const noexcept {
+        return AlignedSlice(m_data, n > m_size ? m_size : n);
+    }
+
+    /**
+     * @brief Drop the alignment guarantee.
+     */
+    [[nodiscard]] Slice<T> as_slice() const noexcept { return Slice<T>(m_data, m_size); }
+    operator Slice<T>() const noexcept { return as_slice(); }
+
+    [[nodiscard]] iterator begin() const noexcept { return data(); }
+    [[nodiscard]] iterator end() const noexcept { return m_data + m_size; }
+
+private:
+    template<typename, std::size_t>
+    friend class AlignedSlice;
+
+    constexpr AlignedSlice(T* data, size_type size) noexcept : m_data(data), m_size(size) {}
+
+    T* m_data;
+    size_type m_size;
+};
+
+/**
+ * @brief Result of split_aligned(): unaligned head, aligned body, tail.
+ *
+ * body.size() is a multiple of Align / sizeof(T), so a SIMD loop over the
+ * body needs no remainder handling; prologue and epilogue each hold fewer
+ * than one vector and go through the scalar path.
+ */
+template<typename T, std::size_t Align>
+struct AlignedSplit {
+    Slice<T> prologue;
+    AlignedSlice<T, Align> body;
+    Slice<T> epilogue;
+};
+
+/**
+ * @brief Split a Slice into prologue / aligned body / epilogue.
+ *
+ * Like Rust's slice::align_to. If the slice is too short to contain an
+ * aligned block (or T does not evenly divide Align), everything is in the
+ * prologue and the body is empty.
+ */
+template<std::size_t Align, typename T>
+[[nodiscard]] AlignedSplit<T, Align> split_aligned(Slice<T> s) noexcept {
+    static_assert((Align & (Align - 1)) == 0, "split_aligned alignment must be a power of two");
+    constexpr std::size_t lanes = (Align % sizeof(T) == 0) ? Align / sizeof(T) : 0;
+
+    if constexpr (lanes == 0) {
+        return {s, AlignedSlice<T, Align>(), Slice<T>(s.data() + s.size(), 0)};
+    } else {
+        const auto addr = reinterpret_cast<std::uintptr_t>(s.data());
+        const std::uintptr_t misalign = addr & (Align - 1);
+        std::size_t head = 0;
+        if (misalign != 0) {
+            const std::uintptr_t gap = Align - misalign;
+            if (gap % sizeof(T) != 0) {
+                // Elements can never land on an Align boundary
+                return {s, AlignedSlice<T, Align>(), Slice<T>(s.data() + s.size(), 0)};
+            }
+            head = gap / sizeof(T);
+        }
+        if (head >= s.size()) {
+            return {s, AlignedSlice<T, Align>(), Slice<T>(s.data() + s.size(), 0)};
+        }
+        const std::size_t body_len = ((s.size() - head) / lanes) * lanes;
+        return {
+            Slice<T>(s.data(), head),
+            AlignedSlice<T, Align>::from_raw_unchecked(s.data() + head, body_len),
+            Slice<T>(s.data() + head + body_len, s.size() - head - body_len),
+        };
+    }
+}
+
+} // namespace crab
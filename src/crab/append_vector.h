@@ -0,0 +1,195 @@
+#pragma once
+
+/**
+ * @file append_vector.h
+ * @brief Fixed-capacity, lock-free, append-only vector for many writers
+ *        and concurrent readers.
+ *
+ * Writers reserve an index with one fetch_add, construct the element in
+ * place, and mark the slot ready. Readers see the committed prefix:
+ * the longest run [0, size()) in which every slot is ready. Elements are
+ * never moved or removed, so the prefix only grows and a Slice taken from
+ * published() stays valid and immutable for the vector's lifetime.
+ *
+ * ## Concurrency
+ *
+ * try_push() and try_emplace() may be called from any number of threads.
+ * size(), published(), operator[] and get() are wait-free and may run
+ * alongside them. Neither side takes a lock. Whichever writer completes
+ * the run moves the committed prefix past it, so a slow writer delays
+ * the prefix (never other writers) until its element is ready. If an
+ * element's constructor throws, its slot never becomes ready and the
+ * prefix stops there for good.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/error_types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace crab {
+
+/**
+ * @brief Lock-free append-only vector with a published-prefix read view.
+ *
+ * @tparam T Element type (read concurrently as const T)
+ * @tparam Capacity Maximum number of elements
+ *
+ * @code{cpp}
+ *   static crab::AppendVector<Event, 1 << 16> journal;
+ *   journal.try_push(event);                          // any writer thread
+ *   for (const Event& e : journal.published()) { ... } // any reader thread
+ * @endcode
+ */
+template<typename T, std::size_t Capacity>
+class AppendVector {
+    static_assert(Capacity > 0, "AppendVector capacity must be positive");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    AppendVector() noexcept {
+        for (auto& flag : m_ready) {
+            flag.store(false, std::memory_order_relaxed);
+        }
+        m_reserved.store(0, std::memory_order_relaxed);
+        m_committed.store(0, std::memory_order_relaxed);
+    }
+
+    ~AppendVector() { clear(); }
+
+    // Non-copyable, non-movable (shared by address between threads)
+    AppendVector(const AppendVector&) = delete;
+    AppendVector& operator=(const AppendVector&) = delete;
+    AppendVector(AppendVector&&) = delete;
+    AppendVector& operator=(AppendVector&&) = delete;
+
+    // ========================================================================
+    // Writers (lock-free, any thread)
+    // ========================================================================
+
+    /**
+     * @brief Append a copy of value.
+     * @return Ok(index) of the new element, or Err(CapacityExceeded) when full
+     */
+    [[nodiscard]] Result<size_type, CapacityExceeded> try_push(const T& value) { return try_emplace(value); }
+
+    [[nodiscard]] Result<size_type, CapacityExceeded> try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    /**
+     * @brief Construct an element in place at the next free index.
+     * @return Ok(index) of the new element, or Err(CapacityExceeded) when full
+     */
+    template<typename... Args>
+    [[nodiscard]] Result<size_type, CapacityExceeded> try_emplace(Args&&... args) {
+        // Check first so a full vector doesn't keep bumping the counter
+        if (m_reserved.load(std::memory_order_relaxed) >= Capacity) {
+            return Err(CapacityExceeded{Capacity + 1, Capacity});
+        }
+        const size_type index = m_reserved.fetch_add(1, std::memory_order_relaxed);
+        if (index >= Capacity) {
+            return Err(CapacityExceeded{index + 1, Capacity});
+        }
+        new (data() + index) T(std::forward<Args>(args)...);
+        // Fast path: every earlier slot is committed, so only this writer
+        // can move the prefix off `index`; one CAS publishes the element
+        size_type head = index;
+        if (m_committed.load(std::memory_order_relaxed) == index &&
+            m_committed.compare_exchange_strong(head, index + 1, std::memory_order_seq_cst)) {
+            commit(index + 1);
+        } else {
+            // seq_cst pairs with the loads in commit(): of two writers
+            // finishing adjacent runs, at least one sees the other's slot
+            m_ready[index].store(true, std::memory_order_seq_cst);
+            commit(m_committed.load(std::memory_order_seq_cst));
+        }
+        return Ok(index);
+    }
+
+    /**
+     * @brief Destroy all elements and start over (e.g. to rotate a journal).
+     * @note Not thread-safe: no writer or reader may be active, and slices
+     *       from published() are invalidated.
+     */
+    void clear() noexcept {
+        const size_type used = m_reserved.load(std::memory_order_relaxed);
+        const size_type committed = m_committed.load(std::memory_order_relaxed);
+        for (size_type i = 0; i < used && i < Capacity; ++i) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                if (i < committed || m_ready[i].load(std::memory_order_relaxed)) {
+                    data()[i].~T();
+                }
+            }
+            m_ready[i].store(false, std::memory_order_relaxed);
+        }
+        m_reserved.store(0, std::memory_order_relaxed);
+        m_committed.store(0, std::memory_order_relaxed);
+    }
+
+    // ========================================================================
+    // Readers (wait-free, any thread)
+    // ========================================================================
+
+    /// Length of the committed prefix; every element below it is readable
+    [[nodiscard]] size_type size() const noexcept { return m_committed.load(std::memory_order_acquire); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return Capacity; }
+
+    /**
+     * @brief The committed prefix as a contiguous, immutable view.
+     *
+     * Elements appended later are not included. Take a new view to see them.
+     */
+    [[nodiscard]] Slice<const T> published() const noexcept { return Slice<const T>(data(), size()); }
+
+    /**
+     * @brief Element at index (asserts index < size()).
+     */
+    [[nodiscard]] const T& operator[](size_type index) const noexcept {
+        CRAB_ASSERT(index < size(), "AppendVector index not committed");
+        return data()[index];
+    }
+
+    /**
+     * @brief Element at index, or Err(OutOfBounds) if not yet committed.
+     */
+    [[nodiscard]] Result<std::reference_wrapper<const T>, OutOfBounds> get(size_type index) const noexcept {
+        const size_type committed = size();
+        if (index >= committed) {
+            return Err(OutOfBounds{index, committed});
+        }
+        return Ok(std::cref(data()[index]));
+    }
+
+private:
+    T* data() noexcept { return std::launder(reinterpret_cast<T*>(m_storage)); }
+    const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(m_storage)); }
+
+    /**
+     * Advance the committed prefix from c over every ready slot. The CAS
+     * releases the element writes (acquired here through m_ready) to readers.
+     */
+    void commit(size_type c) noexcept {
+        while (c < Capacity && m_ready[c].load(std::memory_order_seq_cst)) {
+            // On failure c is reloaded; another writer has moved the prefix
+            if (m_committed.compare_exchange_weak(c, c + 1, std::memory_order_seq_cst)) {
+                ++c;
+            }
+        }
+    }
+
+    alignas(CRAB_CACHE_LINE_SIZE) std::atomic<size_type> m_reserved;
+    alignas(CRAB_CACHE_LINE_SIZE) std::atomic<size_type> m_committed;
+    std::atomic<bool> m_ready[Capacity];
+    alignas(alignof(T)) unsigned char m_storage[sizeof(T) * Capacity];
+};
+
+} // namespace crab
@@ -0,0 +1,286 @@
+#pragma once
+
+/**
+ * @file buffer_pool.h
+ * @brief Fixed-capacity pool of reference-counted byte buffers.
+ *
+ * Shared ownership without the heap: one received frame can be handed to
+ * several consumers by bumping an intrusive atomic refcount instead of
+ * copying the bytes. Buffers return to the pool on last release.
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/error_types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace crab {
+
+/**
+ * @brief Lock-free pool of refcounted byte buffers (no heap allocation).
+ *
+ * Buffers are acquired uniquely owned, filled through bytes_mut(), then
+ * shared by copying the Handle. Each copy costs one atomic increment; the
+ * last Handle to be destroyed pushes the buffer back onto the free list.
+ * Acquire and release are lock-free and safe from any thread.
+ *
+ * @tparam BufferSize Bytes per buffer
+ * @tparam Count Number of buffers in the pool
+ *
+ * @warning The pool must outlive every Handle it has given out.
+ *
+ * @code{cpp}
+ *   static crab::BufferPool<2048, 64> pool;
+ *   auto frame = pool.try_acquire().unwrap();
+ *   size_t n = recv(fd, frame.bytes_mut().unwrap().data(), 2048, 0);
+ *   frame.set_len(n).unwrap();
+ *
+ *   // Fan-out: one refcount increment per consumer, no memcpy
+ *   for (auto& queue : consumers) {
+ *       queue.try_push(frame);
+ *   }
+ * @endcode
+ */
+template<std::size_t BufferSize, std::size_t Count>
+class BufferPool {
+    static_assert(BufferSize > 0, "BufferPool buffer size must be non-zero");
+    static_assert(Count > 0, "BufferPool must contain at least one buffer");
+    static_assert(Count < UINT32_MAX, "BufferPool count must fit in 32 bits");
+    static_assert(BufferSize <= UINT32_MAX, "BufferPool buffer size must fit in 32 bits");
+
+    struct alignas(CRAB_CACHE_LINE_SIZE) Block {
+        std::atomic<uint32_t> refs{0};
+        std::atomic<uint32_t> next{0};   // Free-list link (valid while free)
+        uint32_t len{0};
+        BufferPool* owner{nullptr};
+        uint8_t bytes[BufferSize];
+    };
+
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Shared handle to a pooled buffer (one pointer wide).
+     *
+     * Copying increments the refcount; destruction decrements it. Small
+     * and nothrow-movable, so it can travel through StaticRingBuffer slots.
+     */
+    class Handle {
+    public:
+        /** @brief Empty handle (owns nothing). */
+        Handle() noexcept = default;
+
+        Handle(const Handle& other) noexcept : m_block(other.m_block) {
+            if (m_block != nullptr) {
+                m_block->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Handle(Handle&& other) noexcept : m_block(other.m_block) {
+            other.m_block = nullptr;
+        }
+
+        Handle& operator=(const Handle& other) noexcept {
+            if (this != &other) {
+                Handle tmp(other);
+                std::swap(m_block, tmp.m_block);
+            }
+            return *this;
+        }
+
+        Handle& operator=(Handle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_block = other.m_block;
+                other.m_block = nullptr;
+            }
+            return *this;
+        }
+
+        ~Handle() { reset(); }
+
+        /**
+         * @brief Explicit clone (same as copy: one refcount increment).
+         */
+        [[nodiscard]] Handle clone() const noexcept { return Handle(*this); }
+
+        /**
+         * @brief Drop this reference now, returning the buffer if last.
+         */
+        void reset() noexcept {
+            if (m_block != nullptr) {
+                if (m_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    m_block->owner->release(m_block);
+                }
+                m_block = nullptr;
+            }
+        }
+
+        /** @brief True if this handle refers to a buffer. */
+        explicit operator bool() const noexcept { return m_block != nullptr; }
+
+        /**
+         * @brief Read-only view of the filled bytes [0, len).
+         */
+        [[nodiscard]] ConstByteSlice bytes() const noexcept {
+            CRAB_ASSERT(m_block != nullptr, "bytes() called on empty Handle");
+            return ConstByteSlice(m_block->bytes, m_block->len);
+        }
+
+        /**
+         * @brief Mutable view of the whole buffer, only while uniquely owned.
+         * @return Some(slice) if this is the only reference, None if shared
+         */
+        [[nodiscard]] Option<ByteSlice> bytes_mut() noexcept {
+            if (!is_unique()) {
+                return None;
+            }
+            return Some(ByteSlice(m_block->bytes, BufferSize));
+        }
+
+        /**
+         * @brief Set the number of valid bytes exposed by bytes().
+         * @return Ok if len fits, Err if len > BufferSize
+         * @note Only call while uniquely owned (before sharing).
+         */
+        [[nodiscard]] Result<Unit, CapacityExceeded> set_len(size_type len) noexcept {
+            CRAB_ASSERT(m_block != nullptr, "set_len() called on empty Handle");
+            CRAB_DEBUG_ASSERT(is_unique(), "set_len() called on shared Handle");
+            if (len > BufferSize) {
+                return Err(CapacityExceeded{len, BufferSize});
+            }
+            m_block->len = static_cast<uint32_t>(len);
+            return Ok();
+        }
+
+        /** @brief Current number of handles sharing this buffer (racy). */
+        [[nodiscard]] size_type use_count() const noexcept {
+            return m_block ? m_block->refs.load(std::memory_order_relaxed) : 0;
+        }
+
+        /** @brief True if this is the only handle to the buffer. */
+        [[nodiscard]] bool is_unique() const noexcept {
+            return m_block != nullptr &&
+                   m_block->refs.load(std::memory_order_acquire) == 1;
+        }
+
+    private:
+        friend class BufferPool;
+
+        explicit Handle(Block* block) noexcept : m_block(block) {}
+
+        Block* m_block{nullptr};
+    };
+
+    // ========================================================================
+    // Constructors
+    // ========================================================================
+
+    /**
+     * @brief Construct pool with every buffer on the free list.
+     */
+    BufferPool() noexcept {
+        for (size_type i = 0; i < Count; ++i) {
+            m_blocks[i].owner = this;
+            m_blocks[i].next.store(static_cast<uint32_t>(i + 1), std::memory_order_relaxed);
+        }
+        m_free_head.store(pack(0, 0), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destructor (debug-checks that every Handle was released).
+     */
+    ~BufferPool() {
+        CRAB_DEBUG_ASSERT(count_free_unsafe() == Count,
+            "BufferPool destroyed while Handles are still alive");
+    }
+
+    // Non-copyable, non-movable (Handles point into the pool)
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+
+    // ========================================================================
+    // Acquire
+    // ========================================================================
+
+    /**
+     * @brief Take a free buffer (lock-free, any thread).
+     * @return Uniquely owned Handle with len 0, or None if the pool is empty
+     */
+    [[nodiscard]] Option<Handle> try_acquire() noexcept {
+        uint64_t head = m_free_head.load(std::memory_order_acquire);
+        Block* block;
+        do {
+            const uint32_t index = index_of(head);
+            if (index == kNil) {
+                return None;
+            }
+            block = &m_blocks[index];
+            const uint32_t next = block->next.load(std::memory_order_relaxed);
+            if (m_free_head.compare_exchange_weak(head, pack(tag_of(head) + 1, next),
+                    std::memory_order_acquire, std::memory_order_acquire)) {
+                break;
+            }
+        } while (true);
+
+        block->len = 0;
+        block->refs.store(1, std::memory_order_relaxed);
+        return Some(Handle(block));
+    }
+
+    // ========================================================================
+    // Capacity
+    // ========================================================================
+
+    [[nodiscard]] constexpr size_type capacity() const noexcept { return Count; }
+    [[nodiscard]] constexpr size_type buffer_size() const noexcept { return BufferSize; }
+
+    /**
+     * @brief Count free buffers by walking the free list (NOT thread-safe).
+     */
+    [[nodiscard]] size_type count_free_unsafe() const noexcept {
+        size_type count = 0;
+        uint32_t index = index_of(m_free_head.load(std::memory_order_relaxed));
+        while (index != kNil) {
+            ++count;
+            index = m_blocks[index].next.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+private:
+    // Free list is a Treiber stack; the tag in the upper 32 bits defeats ABA
+    static constexpr uint32_t kNil = static_cast<uint32_t>(Count);
+
+    static constexpr uint64_t pack(uint32_t tag, uint32_t index) noexcept {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+    static constexpr uint32_t index_of(uint64_t word) noexcept {
+        return static_cast<uint32_t>(word);
+    }
+    static constexpr uint32_t tag_of(uint64_t word) noexcept {
+        return static_cast<uint32_t>(word >> 32);
+    }
+
+    void release(Block* block) noexcept {
+        const uint32_t index = static_cast<uint32_t>(block - m_blocks);
+        uint64_t head = m_free_head.load(std::memory_order_relaxed);
+        do {
+            block->next.store(index_of(head), std::memory_order_relaxed);
+        } while (!m_free_head.compare_exchange_weak(head, pack(tag_of(head) + 1, index),
+                     std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    Block m_blocks[Count];
+    alignas(CRAB_CACHE_LINE_SIZE) std::atomic<uint64_t> m_free_head;
+};
+
+} // namespace crab
@@ -0,0 +1,408 @@
+#pragma once
+
+/**
+ * @file concurrent_hash_map.h
+ * @brief Fixed-capacity open-addressing hash map for read-mostly sharing.
+ *
+ * find() is lock-free: it never writes shared memory, so readers on any
+ * number of cores do not contend with each other. Writers claim one slot
+ * with a CAS on its version word, write, and release it, so writers to
+ * different keys proceed in parallel.
+ *
+ * ## Slots
+ *
+ * Each slot has an atomic 32-bit state (hash tag | keyed | live) and a
+ * version counter that is odd while a writer owns the slot. Values are
+ * read seqlock-style: copy, then retry if the version moved. Key and
+ * value are held in atomic words so those copies are race-free C++.
+ *
+ * ## Deletion
+ *
+ * A slot keeps its key for life. erase() clears the live bit (a
+ * tombstone), and re-inserting that key reuses the slot, so probe chains
+ * never change under a reader and nothing needs reclaiming. A map whose
+ * key set churns will fill up with tombstones. clear() it while
+ * quiescent, or size it for every key it will ever see.
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/hash.h"
+#include "crab/error_types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace crab {
+
+namespace detail {
+
+/// Spin-wait hint for the sibling hyperthread
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/// Default key hash: mix64 for integers, hash_bytes over the object otherwise
+template<typename K>
+struct KeyHash {
+    uint64_t operator()(const K& key) const noexcept {
+        if constexpr (std::is_integral_v<K> || std::is_enum_v<K>) {
+            return mix64(static_cast<uint64_t>(key));
+        } else {
+            return hash_bytes(ConstByteSlice(reinterpret_cast<const uint8_t*>(&key), sizeof(K)));
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Concurrent hash map with lock-free reads and per-slot CAS writes.
+ *
+ * Lookups return a copy of the value, so K and V must be trivially
+ * copyable. K must also have unique object representations, because keys
+ * are compared by bytes.
+ *
+ * @tparam K Key type
+ * @tparam V Value type
+ * @tparam Capacity Maximum number of distinct keys (live or erased)
+ * @tparam Hash Hash functor returning uint64_t
+ *
+ * @code{cpp}
+ *   static crab::ConcurrentHashMap<SymbolId, Quote, 4096> quotes;
+ *   (void)quotes.insert_or_assign(sym, quote);           // occasional writer
+ *   if (auto q = quotes.find(sym)) { use(q.unwrap()); }  // every message
+ * @endcode
+ */
+template<typename K, typename V, std::size_t Capacity, typename Hash = detail::KeyHash<K>>
+class ConcurrentHashMap {
+    static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>,
+                  "ConcurrentHashMap keys and values must be trivially copyable");
+    static_assert(std::has_unique_object_representations_v<K>,
+                  "ConcurrentHashMap keys are compared bytewise and must not have padding");
+    static_assert(Capacity > 0 && Capacity < (std::size_t{1} << 31), "ConcurrentHashMap capacity out of range");
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = std::size_t;
+
+    ConcurrentHashMap() noexcept { clear(); }
+
+    // Non-copyable, non-movable (shared by address between threads)
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap(ConcurrentHashMap&&) = delete;
+    ConcurrentHashMap& operator=(ConcurrentHashMap&&) = delete;
+
+    // ========================================================================
+    // Readers (lock-free)
+    // ========================================================================
+
+    /**
+     * @brief Copy of the value for key, or None if absent or erased.
+     *
+     * Retries only while a writer is rewriting this key's slot.
+     */
+    [[nodiscard]] Option<V> find(const K& key) const noexcept {
+        Words<K> kw;
+        to_words(key, kw);
+        const uint64_t h = Hash{}(key);
+        const Slot* s = locate(kw, h);
+        if (s == nullptr) {
+            return None;
+        }
+        Words<V> vw;
+        bool live = false;
+        for (;;) {
+            const uint32_t v1 = s->version.load(std::memory_order_acquire);
+            if ((v1 & 1) != 0) {
+                detail::cpu_relax();
+                continue;
+            }
+            // Acquire loads keep the version re-check after the copy
+            for (std::size_t w = 0; w < kValueWords; ++w) {
+                vw.w[w] = s->value[w].load(std::memory_order_acquire);
+            }
+            live = (s->state.load(std::memory_order_acquire) & kLive) != 0;
+            if (s->version.load(std::memory_order_relaxed) == v1) {
+                break;
+            }
+        }
+        if (!live) {
+            return None;
+        }
+        return Some(from_words<V>(vw));
+    }
+
+    [[nodiscard]] bool contains(const K& key) const noexcept { return find(key).is_some(); }
+
+    /// Live entries (a snapshot under concurrent writes)
+    [[nodiscard]] size_type size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return Capacity; }
+
+    /// Slots holding a key, live or erased; insert of a new key fails at capacity()
+    [[nodiscard]] size_type keys_used() const noexcept { return m_used.load(std::memory_order_relaxed); }
+
+    // ========================================================================
+    // Writers (per-slot CAS, any thread)
+    // ========================================================================
+
+    /**
+     * @brief Insert key -> value if key is absent; leave an existing value alone.
+     * @return Ok(true) if inserted, Ok(false) if already present,
+     *         Err(CapacityExceeded) if a new key does not fit
+     */
+    [[nodiscard]] Result<bool, CapacityExceeded> insert(const K& key, const V& value) noexcept {
+        return put(key, value, false);
+    }
+
+    /**
+     * @brief Insert key -> value, overwriting any existing value.
+     * @return Ok(true) if the key was not live before, Ok(false) if replaced
+     */
+    [[nodiscard]] Result<bool, CapacityExceeded> insert_or_assign(const K& key, const V& value) noexcept {
+        return put(key, value, true);
+    }
+
+    /**
+     * @brief Apply fn(V&) to the live value for key, atomically w.r.t. other writers.
+     * @return false if key is absent or erased
+     * @note fn runs while the slot is owned; keep it short and non-blocking.
+     */
+    template<typename F>
+    bool update(const K& key, F&& fn) noexcept {
+        Slot* s = locate_for_write(key);
+        if (s == nullptr) {
+            return false;
+        }
+        const uint32_t v = lock(*s);
+        const uint32_t state = s->state.load(std::memory_order_relaxed);
+        if ((state & kLive) != 0) {
+            Words<V> vw;
+            for (std::size_t w = 0; w < kValueWords; ++w) {
+                vw.w[w] = s->value[w].load(std::memory_order_relaxed);
+            }
+            V value = from_words<V>(vw);
+            fn(value);
+            store_value(*s, value);
+        }
+        unlock(*s, v);
+        return (state & kLive) != 0;
+    }
+
+    /**
+     * @brief Erase key, leaving a tombstone the same key can reuse.
+     * @return false if key was absent or already erased
+     */
+    bool erase(const K& key) noexcept {
+        Slot* s = locate_for_write(key);
+        if (s == nullptr) {
+            return false;
+        }
+        const uint32_t v = lock(*s);
+        const uint32_t state = s->state.load(std::memory_order_relaxed);
+        s->state.store(state & ~kLive, std::memory_order_release);
+        unlock(*s, v);
+        if ((state & kLive) == 0) {
+            return false;
+        }
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Remove every key and tombstone.
+     * @note Not thread-safe: no reader or writer may be active.
+     */
+    void clear() noexcept {
+        for (Slot& s : m_slots) {
+            s.version.store(0, std::memory_order_relaxed);
+            s.state.store(0, std::memory_order_relaxed);
+            for (auto& w : s.key) {
+                w.store(0, std::memory_order_relaxed);
+            }
+            for (auto& w : s.value) {
+                w.store(0, std::memory_order_relaxed);
+            }
+        }
+        m_size.store(0, std::memory_order_relaxed);
+        m_used.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t slot_count() noexcept {
+        std::size_t p = 1;
+        while (p < Capacity * 2) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static constexpr std::size_t kSlots = slot_count();
+    static constexpr std::size_t kMask = kSlots - 1;
+    static constexpr std::size_t kKeyWords = (sizeof(K) + 7) / 8;
+    static constexpr std::size_t kValueWords = (sizeof(V) + 7) / 8;
+
+    // Slot state: 0 = empty (ends a probe); else tag bits | kKeyed [| kLive]
+    static constexpr uint32_t kKeyed = 1;
+    static constexpr uint32_t kLive = 2;
+    static constexpr uint32_t kTagMask = ~uint32_t{3};
+
+    template<typename T>
+    struct Words {
+        uint64_t w[(sizeof(T) + 7) / 8];
+    };
+
+    struct Slot {
+        std::atomic<uint32_t> version;  // Odd while a writer owns the slot
+        std::atomic<uint32_t> state;
+        std::atomic<uint64_t> key[kKeyWords];
+        std::atomic<uint64_t> value[kValueWords];
+    };
+
+    template<typename T>
+    static void to_words(const T& x, Words<T>& out) noexcept {
+        std::memset(out.w, 0, sizeof(out.w));
+        std::memcpy(out.w, &x, sizeof(T));
+    }
+
+    template<typename T>
+    static T from_words(const Words<T>& in) noexcept {
+        T x;
+        std::memcpy(&x, in.w, sizeof(T));
+        return x;
+    }
+
+    static uint32_t tag_of(uint64_t h) noexcept { return (static_cast<uint32_t>(h >> 32) & kTagMask) | kKeyed; }
+
+    // Keys are immutable once the state is published, so no version check
+    static bool key_equals(const Slot& s, const Words<K>& kw) noexcept {
+        for (std::size_t w = 0; w < kKeyWords; ++w) {
+            if (s.key[w].load(std::memory_order_relaxed) != kw.w[w]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Slot holding key (live or tombstone), or nullptr
+    const Slot* locate(const Words<K>& kw, uint64_t h) const noexcept {
+        const uint32_t tag = tag_of(h);
+        std::size_t i = static_cast<std::size_t>(h) & kMask;
+        for (std::size_t n = 0; n < kSlots; ++n, i = (i + 1) & kMask) {
+            const uint32_t state = m_slots[i].state.load(std::memory_order_acquire);
+            if (state == 0) {
+                return nullptr;
+            }
+            if ((state & (kTagMask | kKeyed)) == tag && key_equals(m_slots[i], kw)) {
+                return &m_slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    Slot* locate_for_write(const K& key) noexcept {
+        Words<K> kw;
+        to_words(key, kw);
+        return const_cast<Slot*>(locate(kw, Hash{}(key)));
+    }
+
+    /**
+     * Take ownership of a slot: CAS its version from even to odd. Data is
+     * then written with release stores, so a reader that sees any of it
+     * also sees the odd version and retries.
+     */
+    static uint32_t lock(Slot& s) noexcept {
+        uint32_t v = s.version.load(std::memory_order_relaxed);
+        for (;;) {
+            if ((v & 1) != 0) {
+                detail::cpu_relax();
+                v = s.version.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (s.version.compare_exchange_weak(v, v + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return v + 1;
+            }
+        }
+    }
+
+    static void unlock(Slot& s, uint32_t v) noexcept { s.version.store(v + 1, std::memory_order_release); }
+
+    static void store_value(Slot& s, const V& value) noexcept {
+        Words<V> vw;
+        to_words(value, vw);
+        for (std::size_t w = 0; w < kValueWords; ++w) {
+            s.value[w].store(vw.w[w], std::memory_order_release);
+        }
+    }
+
+    Result<bool, CapacityExceeded> put(const K& key, const V& value, bool assign) noexcept {
+        Words<K> kw;
+        to_words(key, kw);
+        const uint64_t h = Hash{}(key);
+        const uint32_t tag = tag_of(h);
+        std::size_t i = static_cast<std::size_t>(h) & kMask;
+        for (std::size_t n = 0; n < kSlots; ++n, i = (i + 1) & kMask) {
+            Slot& s = m_slots[i];
+            uint32_t state = s.state.load(std::memory_order_acquire);
+            if (state == 0) {
+                const uint32_t v = lock(s);
+                state = s.state.load(std::memory_order_relaxed);
+                if (state == 0) {
+                    if (m_used.fetch_add(1, std::memory_order_relaxed) >= Capacity) {
+                        m_used.fetch_sub(1, std::memory_order_relaxed);
+                        unlock(s, v);
+                        return Err(CapacityExceeded{Capacity + 1, Capacity});
+                    }
+                    for (std::size_t w = 0; w < kKeyWords; ++w) {
+                        s.key[w].store(kw.w[w], std::memory_order_release);
+                    }
+                    store_value(s, value);
+                    // Publishes the key to probing readers
+                    s.state.store(tag | kLive, std::memory_order_release);
+                    unlock(s, v);
+                    m_size.fetch_add(1, std::memory_order_relaxed);
+                    return Ok(true);
+                }
+                // Another writer claimed it first; examine what it put there
+                unlock(s, v);
+            }
+            if ((state & (kTagMask | kKeyed)) != tag || !key_equals(s, kw)) {
+                continue;
+            }
+            const uint32_t v = lock(s);
+            const bool was_live = (s.state.load(std::memory_order_relaxed) & kLive) != 0;
+            if (!was_live || assign) {
+                store_value(s, value);
+                s.state.store(tag | kLive, std::memory_order_release);
+            }
+            unlock(s, v);
+            if (!was_live) {
+                m_size.fetch_add(1, std::memory_order_relaxed);
+            }
+            return Ok(!was_live);
+        }
+        return Err(CapacityExceeded{Capacity + 1, Capacity});
+    }
+
+    Slot m_slots[kSlots];
+    alignas(CRAB_CACHE_LINE_SIZE) std::atomic<size_type> m_size;
+    std::atomic<size_type> m_used;
+};
+
+} // namespace crab
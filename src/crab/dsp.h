@@ -0,0 +1,506 @@
+#pragma once
+
+/**
+ * @file dsp.h
+ * @brief Block filters on Slice<float>: FIR, polyphase decimation, biquad
+ *        cascades and moving average.
+ *
+ * Every filter is a fixed-capacity value type that holds its own history
+ * (no heap) and processes a block per call:
+ *
+ *     filter.process(Slice<const float> in, Slice<float> out)
+ *
+ * Blocks may be any length, and consecutive calls continue the signal
+ * exactly. Blocks can come straight from StaticRingBuffer::read_view()
+ * segments. `in` and `out` may be the same buffer.
+ *
+ * FIR and decimation vectorize across output samples: each tap is one
+ * broadcast multiply-add into 8 (AVX2) or 4 (NEON) outputs. IIR
+ * recurrences are serial per channel. The biquad cascade passes each
+ * sample through every section before the next sample, with coefficients
+ * and state in locals. Section s of sample i then overlaps section s - 1
+ * of sample i + 1 in the pipeline.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/numeric.h"
+#include "crab/error_types.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if CRAB_SIMD_X86
+    #include <immintrin.h>
+#elif CRAB_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace crab {
+
+// ============================================================================
+// Correlation Kernels
+// ============================================================================
+
+namespace detail {
+
+/**
+ * @brief y[m] += sum_j h[j] * x[m + j] for m in [0, n).
+ *
+ * x must hold n + taps - 1 samples. Both FIR and the polyphase branches of
+ * the decimator reduce to this.
+ */
+inline void correlate_scalar(const float* x, const float* h, std::size_t taps,
+                             float* y, std::size_t n) noexcept {
+    for (std::size_t m = 0; m < n; ++m) {
+        float acc = y[m];
+        for (std::size_t j = 0; j < taps; ++j) {
+            acc += h[j] * x[m + j];
+        }
+        y[m] = acc;
+    }
+}
+
+#if CRAB_SIMD_X86
+
+CRAB_TARGET_AVX2 inline void correlate_avx2(const float* x, const float* h, std::size_t taps,
+                                            float* y, std::size_t n) noexcept {
+    std::size_t m = 0;
+    // 32 outputs per pass: four independent FMA chains share each broadcast
+    for (; m + 32 <= n; m += 32) {
+        __m256 a0 = _mm256_loadu_ps(y + m);
+        __m256 a1 = _mm256_loadu_ps(y + m + 8);
+        __m256 a2 = _mm256_loadu_ps(y + m + 16);
+        __m256 a3 = _mm256_loadu_ps(y + m + 24);
+        const float* xm = x + m;
+        for (std::size_t j = 0; j < taps; ++j) {
+            const __m256 hj = _mm256_broadcast_ss(h + j);
+            a0 = _mm256_fmadd_ps(hj, _mm256_loadu_ps(xm + j), a0);
+            a1 = _mm256_fmadd_ps(hj, _mm256_loadu_ps(xm + j + 8), a1);
+            a2 = _mm256_fmadd_ps(hj, _mm256_loadu_ps(xm + j + 16), a2);
+            a3 = _mm256_fmadd_ps(hj, _mm256_loadu_ps(xm + j + 24), a3);
+        }
+        _mm256_storeu_ps(y + m, a0);
+        _mm256_storeu_ps(y + m + 8, a1);
+        _mm256_storeu_ps(y + m + 16, a2);
+        _mm256_storeu_ps(y + m + 24, a3);
+    }
+    for (; m + 8 <= n; m += 8) {
+        __m256 a = _mm256_loadu_ps(y + m);
+        for (std::size_t j = 0; j < taps; ++j) {
+            a = _mm256_fmadd_ps(_mm256_broadcast_ss(h + j), _mm256_loadu_ps(x + m + j), a);
+        }
+        _mm256_storeu_ps(y + m, a);
+    }
+    correlate_scalar(x + m, h, taps, y + m, n - m);
+}
+
+#endif // CRAB_SIMD_X86
+
+#if CRAB_SIMD_NEON
+
+inline void correlate_neon(const float* x, const float* h, std::size_t taps,
+                           float* y, std::size_t n) noexcept {
+    std::size_t m = 0;
+    for (; m + 8 <= n; m += 8) {
+        float32x4_t a0 = vld1q_f32(y + m);
+        float32x4_t a1 = vld1q_f32(y + m + 4);
+        for (std::size_t j = 0; j < taps; ++j) {
+            const float32x4_t hj = vdupq_n_f32(h[j]);
+            a0 = vmlaq_f32(a0, hj, vld1q_f32(x + m + j));
+            a1 = vmlaq_f32(a1, hj, vld1q_f32(x + m + j + 4));
+        }
+        vst1q_f32(y + m, a0);
+        vst1q_f32(y + m + 4, a1);
+    }
+    correlate_scalar(x + m, h, taps, y + m, n - m);
+}
+
+#endif // CRAB_SIMD_NEON
+
+inline void correlate(const float* x, const float* h, std::size_t taps,
+                      float* y, std::size_t n) noexcept {
+#if CRAB_SIMD_X86
+    if (use_avx2<float>()) {
+        correlate_avx2(x, h, taps, y, n);
+        return;
+    }
+#elif CRAB_SIMD_NEON
+    if (use_neon<float>()) {
+        correlate_neon(x, h, taps, y, n);
+        return;
+    }
+#endif
+    correlate_scalar(x, h, taps, y, n);
+}
+
+} // namespace detail
+
+// ============================================================================
+// FIR Filter
+// ============================================================================
+
+/**
+ * @brief Streaming FIR filter: y[t] = sum_k h[k] * x[t - k].
+ *
+ * Input is staged through a fixed buffer of Taps - 1 history samples plus
+ * one chunk, so a block of any length is filtered in Chunk-sized passes.
+ * Samples before the first call are treated as zero.
+ *
+ * @tparam Taps Number of coefficients
+ * @tparam Chunk Samples per internal pass (state size is ~Taps + Chunk floats)
+ *
+ * @code{cpp}
+ *   const float h[5] = {0.1f, 0.2f, 0.4f, 0.2f, 0.1f};
+ *   crab::FirFilter<5> fir(h);
+ *   fir.process(in, out).unwrap();
+ * @endcode
+ */
+template<std::size_t Taps, std::size_t Chunk = 256>
+class FirFilter {
+    static_assert(Taps > 0, "FirFilter needs at least one tap");
+    static_assert(Chunk > 0, "FirFilter chunk must be non-zero");
+
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Construct from exactly Taps coefficients (h[0] applies to x[t]).
+     */
+    explicit FirFilter(const float (&coeffs)[Taps]) noexcept {
+        for (size_type k = 0; k < Taps; ++k) {
+            m_reversed[k] = coeffs[Taps - 1 - k];
+        }
+        reset();
+    }
+
+    /**
+     * @brief Construct from a Slice of coefficients.
+     * @return Err(OutOfBounds{coeffs.size(), Taps}) on a length mismatch
+     */
+    [[nodiscard]] static Result<FirFilter, OutOfBounds> from_slice(Slice<const float> coeffs) noexcept {
+        if (coeffs.size() != Taps) {
+            return Err(OutOfBounds{coeffs.size(), Taps});
+        }
+        float h[Taps];
+        std::memcpy(h, coeffs.data(), sizeof(h));
+        return Ok(FirFilter(h));
+    }
+
+    /**
+     * @brief Filter a block; out[i] is the response to in[i].
+     * @return Err(CapacityExceeded) if out is shorter than in (nothing written)
+     */
+    Result<Unit, CapacityExceeded> process(Slice<const float> in, Slice<float> out) noexcept {
+        if (out.size() < in.size()) {
+            return Err(CapacityExceeded{in.size(), out.size()});
+        }
+        const float* src = in.data();
+        float* dst = out.data();
+        size_type remaining = in.size();
+        while (remaining != 0) {
+            const size_type n = remaining < Chunk ? remaining : Chunk;
+            std::memcpy(m_buffer + kHistory, src, n * sizeof(float));
+            std::memset(dst, 0, n * sizeof(float));
+            detail::correlate(m_buffer, m_reversed, Taps, dst, n);
+            std::memmove(m_buffer, m_buffer + n, kHistory * sizeof(float));
+            src += n;
+            dst += n;
+            remaining -= n;
+        }
+        return Ok();
+    }
+
+    /**
+     * @brief Forget all history (as if freshly constructed).
+     */
+    void reset() noexcept {
+        std::memset(m_buffer, 0, sizeof(m_buffer));
+    }
+
+    [[nodiscard]] static constexpr size_type taps() noexcept { return Taps; }
+
+private:
+    static constexpr size_type kHistory = Taps - 1;
+
+    float m_reversed[Taps];
+    float m_buffer[kHistory + Chunk];
+};
+
+// ============================================================================
+// Polyphase Decimator
+// ============================================================================
+
+/**
+ * @brief FIR low-pass followed by keeping every Factor-th sample, computed
+ *        in polyphase form (only the kept outputs are ever evaluated).
+ *
+ * The input is split into Factor phases and each phase is correlated with
+ * its own sub-filter (every Factor-th tap). Each sub-filter runs over a
+ * contiguous phase buffer, so it uses the same vector kernel as FirFilter
+ * at 1/Factor of the cost. Output j corresponds to input j * Factor
+ * (counted from the first sample ever processed).
+ *
+ * @tparam Taps Number of coefficients
+ * @tparam Factor Decimation factor
+ * @tparam Chunk Input samples per internal pass
+ */
+template<std::size_t Taps, std::size_t Factor, std::size_t Chunk = 256>
+class FirDecimator {
+    static_assert(Taps > 0, "FirDecimator needs at least one tap");
+    static_assert(Factor > 0, "FirDecimator factor must be non-zero");
+    static_assert(Chunk >= Factor, "FirDecimator chunk must hold at least one output");
+
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Construct from exactly Taps coefficients.
+     */
+    explicit FirDecimator(const float (&coeffs)[Taps]) noexcept : m_phase_taps{} {
+        // Pad to a multiple of Factor with zeros after the last tap, reverse,
+        // then deal tap j of the reversed filter to phase j % Factor
+        for (size_type j = 0; j < kPaddedTaps; ++j) {
+            const size_type k = kPaddedTaps - 1 - j;
+            m_phase_taps[j % Factor][j / Factor] = k < Taps ? coeffs[k] : 0.0f;
+        }
+        reset();
+    }
+
+    /**
+     * @brief Number of outputs the next process() call will produce for n inputs.
+     */
+    [[nodiscard]] size_type output_count(size_type n) const noexcept {
+        return n > m_next ? (n - m_next + Factor - 1) / Factor : 0;
+    }
+
+    /**
+     * @brief Filter and decimate a block.
+     * @return Number of outputs written, or Err(CapacityExceeded) if out is
+     *         shorter than output_count(in.size()) (nothing written)
+     */
+    Result<size_type, CapacityExceeded> process(Slice<const float> in, Slice<float> out) noexcept {
+        const size_type total = output_count(in.size());
+        if (out.size() < total) {
+            return Err(CapacityExceeded{total, out.size()});
+        }
+        const float* src = in.data();
+        float* dst = out.data();
+        size_type remaining = in.size();
+        while (remaining != 0) {
+            const size_type n = remaining < Chunk ? remaining : Chunk;
+            std::memcpy(m_buffer + kHistory, src, n * sizeof(float));
+            const size_type count = output_count(n);
+            if (count != 0) {
+                // Phase r holds buffer[m_next + i * Factor + r]
+                const size_type span = count + kPhaseTaps - 1;
+                for (size_type i = 0; i < span; ++i) {
+                    const float* row = m_buffer + m_next + i * Factor;
+                    for (size_type r = 0; r < Factor; ++r) {
+                        m_phases[r][i] = row[r];
+                    }
+                }
+                std::memset(dst, 0, count * sizeof(float));
+                for (size_type r = 0; r < Factor; ++r) {
+                    detail::correlate(m_phases[r], m_phase_taps[r], kPhaseTaps, dst, count);
+                }
+            }
+            m_next = m_next + count * Factor - n;
+            std::memmove(m_buffer, m_buffer + n, kHistory * sizeof(float));
+            src += n;
+            dst += count;
+            remaining -= n;
+        }
+        return Ok(total);
+    }
+
+    /**
+     * @brief Forget all history and restart the output phase.
+     */
+    void reset() noexcept {
+        std::memset(m_buffer, 0, sizeof(m_buffer));
+        m_next = 0;
+    }
+
+private:
+    static constexpr size_type kPhaseTaps = (Taps + Factor - 1) / Factor;
+    static constexpr size_type kPaddedTaps = kPhaseTaps * Factor;
+    static constexpr size_type kHistory = kPaddedTaps - 1;
+    static constexpr size_type kMaxOutputs = (Chunk + Factor - 1) / Factor;
+
+    float m_phase_taps[Factor][kPhaseTaps];
+    float m_phases[Factor][kMaxOutputs + kPhaseTaps - 1];
+    float m_buffer[kHistory + Chunk];
+    size_type m_next;  ///< Offset into the next chunk of the next kept sample
+};
+
+// ============================================================================
+// Biquad Cascade
+// ============================================================================
+
+/**
+ * @brief Normalized second-order section (a0 == 1).
+ *
+ * y[t] = b0 x[t] + b1 x[t-1] + b2 x[t-2] - a1 y[t-1] - a2 y[t-2]
+ */
+struct Biquad {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+
+    /**
+     * @brief Low-pass section (RBJ audio EQ cookbook).
+     * @param sample_rate Sampling rate in Hz
+     * @param cutoff Corner frequency in Hz
+     * @param q Quality factor (0.7071 for Butterworth)
+     */
+    [[nodiscard]] static Biquad lowpass(double sample_rate, double cutoff, double q) noexcept {
+        const double w = 2.0 * 3.14159265358979323846 * cutoff / sample_rate;
+        const double alpha = std::sin(w) / (2.0 * q);
+        const double c = std::cos(w);
+        return normalized((1.0 - c) / 2.0, 1.0 - c, (1.0 - c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+    }
+
+    /**
+     * @brief High-pass section (RBJ audio EQ cookbook).
+     */
+    [[nodiscard]] static Biquad highpass(double sample_rate, double cutoff, double q) noexcept {
+        const double w = 2.0 * 3.14159265358979323846 * cutoff / sample_rate;
+        const double alpha = std::sin(w) / (2.0 * q);
+        const double c = std::cos(w);
+        return normalized((1.0 + c) / 2.0, -(1.0 + c), (1.0 + c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+    }
+
+private:
+    static Biquad normalized(double b0, double b1, double b2, double a0, double a1, double a2) noexcept {
+        return Biquad{static_cast<float>(b0 / a0), static_cast<float>(b1 / a0),
+                      static_cast<float>(b2 / a0), static_cast<float>(a1 / a0),
+                      static_cast<float>(a2 / a0)};
+    }
+};
+
+/**
+ * @brief Cascade of Sections biquads in transposed direct form II.
+ *
+ * @tparam Sections Number of second-order sections
+ */
+template<std::size_t Sections>
+class BiquadCascade {
+    static_assert(Sections > 0, "BiquadCascade needs at least one section");
+
+public:
+    using size_type = std::size_t;
+
+    explicit BiquadCascade(const Biquad (&sections)[Sections]) noexcept {
+        for (size_type s = 0; s < Sections; ++s) {
+            m_sections[s] = sections[s];
+        }
+        reset();
+    }
+
+    /**
+     * @brief Filter a block through every section.
+     * @return Err(CapacityExceeded) if out is shorter than in (nothing written)
+     */
+    Result<Unit, CapacityExceeded> process(Slice<const float> in, Slice<float> out) noexcept {
+        const size_type n = in.size();
+        if (out.size() < n) {
+            return Err(CapacityExceeded{n, out.size()});
+        }
+        Biquad c[Sections];
+        float z[Sections][2];
+        std::memcpy(c, m_sections, sizeof(c));
+        std::memcpy(z, m_state, sizeof(z));
+        const float* src = in.data();
+        float* dst = out.data();
+        for (size_type i = 0; i < n; ++i) {
+            float v = src[i];
+            for (size_type s = 0; s < Sections; ++s) {
+                const float y = c[s].b0 * v + z[s][0];
+                z[s][0] = c[s].b1 * v - c[s].a1 * y + z[s][1];
+                z[s][1] = c[s].b2 * v - c[s].a2 * y;
+                v = y;
+            }
+            dst[i] = v;
+        }
+        std::memcpy(m_state, z, sizeof(z));
+        return Ok();
+    }
+
+    void reset() noexcept {
+        std::memset(m_state, 0, sizeof(m_state));
+    }
+
+    [[nodiscard]] const Biquad& section(size_type s) const noexcept {
+        CRAB_ASSERT(s < Sections, "BiquadCascade section out of bounds");
+        return m_sections[s];
+    }
+
+private:
+    Biquad m_sections[Sections];
+    float m_state[Sections][2];
+};
+
+// ============================================================================
+// Moving Average
+// ============================================================================
+
+/**
+ * @brief Boxcar average over the last Window samples, O(1) per sample.
+ *
+ * The running sum is kept in double so long streams do not drift; samples
+ * before the first call count as zero.
+ */
+template<std::size_t Window>
+class MovingAverage {
+    static_assert(Window > 0, "MovingAverage window must be non-zero");
+
+public:
+    using size_type = std::size_t;
+
+    MovingAverage() noexcept { reset(); }
+
+    /**
+     * @brief Average a block.
+     * @return Err(CapacityExceeded) if out is shorter than in (nothing written)
+     */
+    Result<Unit, CapacityExceeded> process(Slice<const float> in, Slice<float> out) noexcept {
+        const size_type n = in.size();
+        if (out.size() < n) {
+            return Err(CapacityExceeded{n, out.size()});
+        }
+        const float* src = in.data();
+        float* dst = out.data();
+        constexpr double inv = 1.0 / static_cast<double>(Window);
+        double sum = m_sum;
+        size_type pos = m_pos;
+        for (size_type i = 0; i < n; ++i) {
+            const float x = src[i];
+            sum += static_cast<double>(x) - static_cast<double>(m_history[pos]);
+            m_history[pos] = x;
+            pos = pos + 1 == Window ? 0 : pos + 1;
+            dst[i] = static_cast<float>(sum * inv);
+        }
+        m_sum = sum;
+        m_pos = pos;
+        return Ok();
+    }
+
+    void reset() noexcept {
+        std::memset(m_history, 0, sizeof(m_history));
+        m_sum = 0.0;
+        m_pos = 0;
+    }
+
+private:
+    float m_history[Window];
+    double m_sum;
+    size_type m_pos;
+};
+
+} // namespace crab
@@ -67,6 +67,77 @@ struct ParseError {
     }
 };
 
+/**
+ * @brief Pointer alignment requirement not met.
+ */
+struct Misaligned {
+    std::uintptr_t address;  ///< Offending address
+    std::size_t alignment;   ///< Required alignment in bytes
+    
+    constexpr bool operator==(const Misaligned& other) const noexcept {
+        return address == other.address && alignment == other.alignment;
+    }
+    constexpr bool operator!=(const Misaligned& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief OS error code (errno) from a failed system call.
+ */
+struct Errno {
+    int code;   ///< errno value captured after the failing call
+    
+    constexpr bool operator==(const Errno& other) const noexcept {
+        return code == other.code;
+    }
+    constexpr bool operator!=(const Errno& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Matrix has no usable pivot (singular or numerically singular).
+ */
+struct SingularMatrix {
+    std::size_t column;   ///< Elimination column where no pivot was found
+    
+    constexpr bool operator==(const SingularMatrix& other) const noexcept {
+        return column == other.column;
+    }
+    constexpr bool operator!=(const SingularMatrix& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Cholesky factorization failed: matrix is not positive definite.
+ */
+struct NotPositiveDefinite {
+    std::size_t column;   ///< Column whose diagonal went non-positive
+    
+    constexpr bool operator==(const NotPositiveDefinite& other) const noexcept {
+        return column == other.column;
+    }
+    constexpr bool operator!=(const NotPositiveDefinite& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Arithmetic result does not fit the target representation.
+ */
+struct Overflow {
+    std::size_t index;   ///< First overflowing element (0 for scalar operations)
+    
+    constexpr bool operator==(const Overflow& other) const noexcept {
+        return index == other.index;
+    }
+    constexpr bool operator!=(const Overflow& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
 /**
  * @brief Generic unit type (for Result<void, E> specialization).
  */
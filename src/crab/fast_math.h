@@ -0,0 +1,637 @@
+#pragma once
+
+/**
+ * @file fast_math.h
+ * @brief Vectorized approximations of exp, log, sin, cos, tanh and sigmoid.
+ *
+ * Each function comes in two forms: a scalar reference `fast_exp(float)`
+ * and a bulk kernel `fast_exp(Slice<const float>, Slice<float>)` that
+ * dispatches at runtime to AVX2+FMA or NEON. Both evaluate the same
+ * range reduction and minimax polynomials (Cephes single precision), so
+ * they agree to within rounding of the fused multiply-adds.
+ *
+ * Accuracy is measured against double-precision libm rounded to float.
+ * The bounds hold on every dispatch level and are checked by the tests:
+ *
+ * | Function       | Domain              | Max error                    |
+ * |----------------|---------------------|------------------------------|
+ * | fast_exp       | [-87.3, 88.7]       | 2 ULP                        |
+ * | fast_log       | (0, inf)            | 2 ULP (denormals included)   |
+ * | fast_sin/cos   | [-8192, 8192]       | 1e-7 absolute (2 ULP when    |
+ * |                |                     | the result is at least 0.5)  |
+ * | fast_tanh      | all finite          | 2 ULP                        |
+ * | fast_sigmoid   | [-87, inf)          | 3 ULP                        |
+ *
+ * Special values: NaN propagates; exp overflows to +inf above 88.72 and
+ * returns 0 below -103.97 (results in between may be denormal); log gives
+ * -inf at 0 and NaN for negatives. Outside [-8192, 8192] sin/cos lose
+ * accuracy (the reduction uses a 3-part pi/4), and above 2^30 in magnitude,
+ * or for infinities, they return NaN.
+ *
+ * The bulk kernels accept the same buffer as in and out.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/numeric.h"
+#include "crab/error_types.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if CRAB_SIMD_X86
+    #include <immintrin.h>
+#elif CRAB_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace crab {
+
+namespace detail {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+namespace fm {
+
+constexpr float kLog2e = 1.44269504088896341f;
+constexpr float kLn2Hi = 0.693359375f;
+constexpr float kLn2Lo = -2.12194440e-4f;
+constexpr float kExpHi = 88.72283935546875f;   // exp() overflows above this
+constexpr float kExpLo = -103.972084045410f;   // exp() rounds to 0 below this
+constexpr float kExpP[6] = {1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+                            4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f};
+
+constexpr float kSqrtHalf = 0.707106781186547524f;
+constexpr float kLogP[9] = {7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f,
+                            -1.2420140846e-1f, 1.4249322787e-1f, -1.6668057665e-1f,
+                            2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f};
+
+constexpr float kFourOverPi = 1.27323954473516f;
+constexpr float kTrigMax = 1073741824.0f;   // 2^30: quadrant index must fit int32
+constexpr float kPio4A = 0.78515625f;
+constexpr float kPio4B = 2.4187564849853515625e-4f;
+constexpr float kPio4C = 3.77489497744594108e-8f;
+constexpr float kSinP[3] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+constexpr float kCosP[3] = {2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f};
+
+constexpr float kTanhSmall = 0.625f;
+constexpr float kTanhP[5] = {-5.70498872745e-3f, 2.06390887954e-2f, -5.37397155531e-2f,
+                             1.33314422036e-1f, -3.33332819422e-1f};
+
+} // namespace fm
+
+inline float bits_to_float(uint32_t u) noexcept {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+inline uint32_t float_to_bits(float f) noexcept {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+// 2^n for n in [-126, 127]
+inline float exp2i(int n) noexcept {
+    return bits_to_float(static_cast<uint32_t>(n + 127) << 23);
+}
+
+// ============================================================================
+// Scalar Reference
+// ============================================================================
+
+inline float sin_or_cos_scalar(float x, bool cosine) noexcept {
+    const bool negative = std::signbit(x);
+    const float a = std::fabs(x);
+    if (!(a <= fm::kTrigMax)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    int32_t j = static_cast<int32_t>(a * fm::kFourOverPi);
+    j = (j + 1) & ~1;
+    const float y = static_cast<float>(j);
+    const float r = ((a - y * fm::kPio4A) - y * fm::kPio4B) - y * fm::kPio4C;
+    const float z = r * r;
+    const float sp = ((fm::kSinP[0] * z + fm::kSinP[1]) * z + fm::kSinP[2]) * z * r + r;
+    const float cp = ((fm::kCosP[0] * z + fm::kCosP[1]) * z + fm::kCosP[2]) * z * z - 0.5f * z + 1.0f;
+    if (cosine) {
+        j += 2;
+    }
+    float res = (j & 2) ? cp : sp;
+    if (j & 4) {
+        res = -res;
+    }
+    return (!cosine && negative) ? -res : res;
+}
+
+} // namespace detail
+
+/**
+ * @brief Scalar reference for exp(x); see the file comment for accuracy.
+ */
+inline float fast_exp(float x) noexcept {
+    using namespace detail::fm;
+    if (x != x) {
+        return x;
+    }
+    if (x < kExpLo) {
+        return 0.0f;
+    }
+    const float xc = x > kExpHi ? kExpHi : x;
+    const float n = std::floor(xc * kLog2e + 0.5f);
+    float r = xc - n * kLn2Hi;
+    r = r - n * kLn2Lo;
+    float p = kExpP[0];
+    for (int k = 1; k < 6; ++k) {
+        p = p * r + kExpP[k];
+    }
+    p = p * (r * r) + r + 1.0f;
+    // 2^n in two halves: n spans [-150, 128], each half is a normal float
+    const int ni = static_cast<int>(n);
+    const int half = ni >> 1;
+    return p * detail::exp2i(half) * detail::exp2i(ni - half);
+}
+
+/**
+ * @brief Scalar reference for log(x) (natural logarithm).
+ */
+inline float fast_log(float x) noexcept {
+    using namespace detail::fm;
+    if (x != x || x == std::numeric_limits<float>::infinity()) {
+        return x;
+    }
+    if (x < 0.0f) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    if (x == 0.0f) {
+        return -std::numeric_limits<float>::infinity();
+    }
+    float e_off = 0.0f;
+    if (x < std::numeric_limits<float>::min()) {
+        x *= 8388608.0f;   // 2^23 brings denormals into the normal range
+        e_off = -23.0f;
+    }
+    const uint32_t bits = detail::float_to_bits(x);
+    float e = static_cast<float>(static_cast<int32_t>(bits >> 23) - 126) + e_off;
+    const float m = detail::bits_to_float((bits & 0x007FFFFFu) | 0x3F000000u);   // [0.5, 1)
+    float t;
+    if (m < kSqrtHalf) {
+        e -= 1.0f;
+        t = m + m - 1.0f;
+    } else {
+        t = m - 1.0f;
+    }
+    const float z = t * t;
+    float y = kLogP[0];
+    for (int k = 1; k < 9; ++k) {
+        y = y * t + kLogP[k];
+    }
+    y = y * t * z;
+    y += e * kLn2Lo;
+    y += -0.5f * z;
+    return (t + y) + e * kLn2Hi;
+}
+
+/**
+ * @brief Scalar reference for sin(x).
+ */
+inline float fast_sin(float x) noexcept {
+    return detail::sin_or_cos_scalar(x, false);
+}
+
+/**
+ * @brief Scalar reference for cos(x).
+ */
+inline float fast_cos(float x) noexcept {
+    return detail::sin_or_cos_scalar(x, true);
+}
+
+/**
+ * @brief Scalar reference for tanh(x).
+ */
+inline float fast_tanh(float x) noexcept {
+    using namespace detail::fm;
+    const float a = std::fabs(x);
+    if (a < kTanhSmall) {
+        const float z = x * x;
+        float p = kTanhP[0];
+        for (int k = 1; k < 5; ++k) {
+            p = p * z + kTanhP[k];
+        }
+        return p * z * x + x;
+    }
+    const float r = 1.0f - 2.0f / (fast_exp(a + a) + 1.0f);
+    return std::copysign(r, x);
+}
+
+/**
+ * @brief Scalar reference for the logistic function 1 / (1 + exp(-x)).
+ */
+inline float fast_sigmoid(float x) noexcept {
+    return 1.0f / (1.0f + fast_exp(-x));
+}
+
+namespace detail {
+
+// ============================================================================
+// AVX2 Kernels
+// ============================================================================
+
+#if CRAB_SIMD_X86
+
+CRAB_TARGET_AVX2 inline __m256 exp_avx2(__m256 x) noexcept {
+    using namespace fm;
+    const __m256 xc = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(kExpLo)), _mm256_set1_ps(kExpHi));
+    const __m256 n = _mm256_floor_ps(_mm256_fmadd_ps(xc, _mm256_set1_ps(kLog2e), _mm256_set1_ps(0.5f)));
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(kLn2Hi), xc);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(kLn2Lo), r);
+    __m256 p = _mm256_set1_ps(kExpP[0]);
+    for (int k = 1; k < 6; ++k) {
+        p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(kExpP[k]));
+    }
+    p = _mm256_add_ps(_mm256_fmadd_ps(p, _mm256_mul_ps(r, r), r), _mm256_set1_ps(1.0f));
+    const __m256i ni = _mm256_cvtps_epi32(n);
+    const __m256i half = _mm256_srai_epi32(ni, 1);
+    const __m256i bias = _mm256_set1_epi32(127);
+    const __m256 s0 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(half, bias), 23));
+    const __m256 s1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(ni, half), bias), 23));
+    __m256 res = _mm256_mul_ps(_mm256_mul_ps(p, s0), s1);
+    res = _mm256_blendv_ps(res, _mm256_setzero_ps(), _mm256_cmp_ps(x, _mm256_set1_ps(kExpLo), _CMP_LT_OQ));
+    return _mm256_blendv_ps(res, x, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+}
+
+CRAB_TARGET_AVX2 inline __m256 log_avx2(__m256 x) noexcept {
+    using namespace fm;
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 small = _mm256_cmp_ps(x, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+    const __m256 xs = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(8388608.0f)), small);
+    const __m256i bits = _mm256_castps_si256(xs);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    e = _mm256_sub_ps(e, _mm256_and_ps(small, _mm256_set1_ps(23.0f)));
+    const __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)),
+                                                         _mm256_set1_epi32(0x3F000000)));
+    const __m256 lt = _mm256_cmp_ps(m, _mm256_set1_ps(kSqrtHalf), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(lt, one));
+    const __m256 t = _mm256_add_ps(_mm256_sub_ps(m, one), _mm256_and_ps(lt, m));
+    const __m256 z = _mm256_mul_ps(t, t);
+    __m256 y = _mm256_set1_ps(kLogP[0]);
+    for (int k = 1; k < 9; ++k) {
+        y = _mm256_fmadd_ps(y, t, _mm256_set1_ps(kLogP[k]));
+    }
+    y = _mm256_mul_ps(_mm256_mul_ps(y, t), z);
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(kLn2Lo), y);
+    y = _mm256_fmadd_ps(_mm256_set1_ps(-0.5f), z, y);
+    __m256 res = _mm256_fmadd_ps(e, _mm256_set1_ps(kLn2Hi), _mm256_add_ps(t, y));
+
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    res = _mm256_blendv_ps(res, _mm256_sub_ps(_mm256_setzero_ps(), inf),
+                           _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ));
+    res = _mm256_blendv_ps(res, _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN()),
+                           _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+    // +inf and NaN map to themselves
+    const __m256 passthrough = _mm256_or_ps(_mm256_cmp_ps(x, inf, _CMP_EQ_OQ), _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+    return _mm256_blendv_ps(res, x, passthrough);
+}
+
+template<bool Cosine>
+CRAB_TARGET_AVX2 inline __m256 sin_or_cos_avx2(__m256 x) noexcept {
+    using namespace fm;
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const __m256 a = _mm256_andnot_ps(sign_mask, x);
+    __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(a, _mm256_set1_ps(kFourOverPi)));
+    j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+    const __m256 y = _mm256_cvtepi32_ps(j);
+    __m256 r = _mm256_fnmadd_ps(y, _mm256_set1_ps(kPio4A), a);
+    r = _mm256_fnmadd_ps(y, _mm256_set1_ps(kPio4B), r);
+    r = _mm256_fnmadd_ps(y, _mm256_set1_ps(kPio4C), r);
+    const __m256 z = _mm256_mul_ps(r, r);
+
+    __m256 sp = _mm256_fmadd_ps(_mm256_set1_ps(kSinP[0]), z, _mm256_set1_ps(kSinP[1]));
+    sp = _mm256_fmadd_ps(sp, z, _mm256_set1_ps(kSinP[2]));
+    sp = _mm256_fmadd_ps(_mm256_mul_ps(sp, z), r, r);
+    __m256 cp = _mm256_fmadd_ps(_mm256_set1_ps(kCosP[0]), z, _mm256_set1_ps(kCosP[1]));
+    cp = _mm256_fmadd_ps(cp, z, _mm256_set1_ps(kCosP[2]));
+    cp = _mm256_fmadd_ps(_mm256_mul_ps(cp, z), z, _mm256_fmadd_ps(_mm256_set1_ps(-0.5f), z, _mm256_set1_ps(1.0f)));
+
+    if (Cosine) {
+        j = _mm256_add_epi32(j, _mm256_set1_epi32(2));
+    }
+    const __m256 use_cos = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)),
+                                                                  _mm256_set1_epi32(2)));
+    __m256 res = _mm256_blendv_ps(sp, cp, use_cos);
+    // bit 2 of j lands on the sign bit
+    res = _mm256_xor_ps(res, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+    if (!Cosine) {
+        res = _mm256_xor_ps(res, _mm256_and_ps(x, sign_mask));
+    }
+    return _mm256_blendv_ps(_mm256_set1_ps(std::numeric_limits<float>::quiet_NaN()), res,
+                            _mm256_cmp_ps(a, _mm256_set1_ps(kTrigMax), _CMP_LE_OQ));
+}
+
+CRAB_TARGET_AVX2 inline __m256 sin_avx2(__m256 x) noexcept { return sin_or_cos_avx2<false>(x); }
+CRAB_TARGET_AVX2 inline __m256 cos_avx2(__m256 x) noexcept { return sin_or_cos_avx2<true>(x); }
+
+CRAB_TARGET_AVX2 inline __m256 tanh_avx2(__m256 x) noexcept {
+    using namespace fm;
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 a = _mm256_andnot_ps(sign_mask, x);
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(kTanhP[0]);
+    for (int k = 1; k < 5; ++k) {
+        p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(kTanhP[k]));
+    }
+    const __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, z), x, x);
+    const __m256 e = exp_avx2(_mm256_add_ps(a, a));
+    __m256 big = _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, one)));
+    big = _mm256_or_ps(big, _mm256_and_ps(x, sign_mask));
+    return _mm256_blendv_ps(big, small, _mm256_cmp_ps(a, _mm256_set1_ps(kTanhSmall), _CMP_LT_OQ));
+}
+
+CRAB_TARGET_AVX2 inline __m256 sigmoid_avx2(__m256 x) noexcept {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 e = exp_avx2(_mm256_sub_ps(_mm256_setzero_ps(), x));
+    return _mm256_div_ps(one, _mm256_add_ps(one, e));
+}
+
+// The tail goes through the vector kernel too, so every element sees the
+// same arithmetic regardless of its position
+template<__m256 (*F)(__m256)>
+CRAB_TARGET_AVX2 inline void map_avx2(const float* in, float* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, F(_mm256_loadu_ps(in + i)));
+    }
+    if (i < n) {
+        alignas(32) float tail[8] = {};
+        std::memcpy(tail, in + i, (n - i) * sizeof(float));
+        _mm256_store_ps(tail, F(_mm256_load_ps(tail)));
+        std::memcpy(out + i, tail, (n - i) * sizeof(float));
+    }
+}
+
+#endif // CRAB_SIMD_X86
+
+// ============================================================================
+// NEON Kernels
+// ============================================================================
+
+#if CRAB_SIMD_NEON
+
+// ARMv7 has no vrndmq/vfmaq/vdivq, so floor, multiply-add and division are
+// composed from the common subset
+
+inline float32x4_t floor_neon(float32x4_t x) noexcept {
+    const float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(x));
+    const uint32x4_t gt = vcgtq_f32(t, x);
+    return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(gt, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+}
+
+inline float32x4_t div_neon(float32x4_t a, float32x4_t b) noexcept {
+    float32x4_t r = vrecpeq_f32(b);
+    r = vmulq_f32(r, vrecpsq_f32(b, r));
+    r = vmulq_f32(r, vrecpsq_f32(b, r));
+    return vmulq_f32(a, r);
+}
+
+inline float32x4_t exp_neon(float32x4_t x) noexcept {
+    using namespace fm;
+    const float32x4_t xc = vminq_f32(vmaxq_f32(x, vdupq_n_f32(kExpLo)), vdupq_n_f32(kExpHi));
+    const float32x4_t n = floor_neon(vmlaq_f32(vdupq_n_f32(0.5f), xc, vdupq_n_f32(kLog2e)));
+    float32x4_t r = vmlsq_f32(xc, n, vdupq_n_f32(kLn2Hi));
+    r = vmlsq_f32(r, n, vdupq_n_f32(kLn2Lo));
+    float32x4_t p = vdupq_n_f32(kExpP[0]);
+    for (int k = 1; k < 6; ++k) {
+        p = vmlaq_f32(vdupq_n_f32(kExpP[k]), p, r);
+    }
+    p = vaddq_f32(vmlaq_f32(r, p, vmulq_f32(r, r)), vdupq_n_f32(1.0f));
+    const int32x4_t ni = vcvtq_s32_f32(n);
+    const int32x4_t half = vshrq_n_s32(ni, 1);
+    const int32x4_t bias = vdupq_n_s32(127);
+    const float32x4_t s0 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(half, bias), 23));
+    const float32x4_t s1 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vsubq_s32(ni, half), bias), 23));
+    float32x4_t res = vmulq_f32(vmulq_f32(p, s0), s1);
+    res = vbslq_f32(vcltq_f32(x, vdupq_n_f32(kExpLo)), vdupq_n_f32(0.0f), res);
+    return vbslq_f32(vceqq_f32(x, x), res, x);
+}
+
+inline float32x4_t log_neon(float32x4_t x) noexcept {
+    using namespace fm;
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const uint32x4_t small = vcltq_f32(x, vdupq_n_f32(std::numeric_limits<float>::min()));
+    const float32x4_t xs = vbslq_f32(small, vmulq_f32(x, vdupq_n_f32(8388608.0f)), x);
+    const uint32x4_t bits = vreinterpretq_u32_f32(xs);
+    float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126)));
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(vdupq_n_f32(23.0f)))));
+    const float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFFu)),
+                                                          vdupq_n_u32(0x3F000000u)));
+    const uint32x4_t lt = vcltq_f32(m, vdupq_n_f32(kSqrtHalf));
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(lt, vreinterpretq_u32_f32(one))));
+    const float32x4_t t = vaddq_f32(vsubq_f32(m, one), vreinterpretq_f32_u32(vandq_u32(lt, vreinterpretq_u32_f32(m))));
+    const float32x4_t z = vmulq_f32(t, t);
+    float32x4_t y = vdupq_n_f32(kLogP[0]);
+    for (int k = 1; k < 9; ++k) {
+        y = vmlaq_f32(vdupq_n_f32(kLogP[k]), y, t);
+    }
+    y = vmulq_f32(vmulq_f32(y, t), z);
+    y = vmlaq_f32(y, e, vdupq_n_f32(kLn2Lo));
+    y = vmlaq_f32(y, z, vdupq_n_f32(-0.5f));
+    float32x4_t res = vmlaq_f32(vaddq_f32(t, y), e, vdupq_n_f32(kLn2Hi));
+
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t inf = vdupq_n_f32(std::numeric_limits<float>::infinity());
+    res = vbslq_f32(vceqq_f32(x, zero), vnegq_f32(inf), res);
+    res = vbslq_f32(vcltq_f32(x, zero), vdupq_n_f32(std::numeric_limits<float>::quiet_NaN()), res);
+    res = vbslq_f32(vceqq_f32(x, inf), x, res);
+    return vbslq_f32(vceqq_f32(x, x), res, x);
+}
+
+template<bool Cosine>
+inline float32x4_t sin_or_cos_neon(float32x4_t x) noexcept {
+    using namespace fm;
+    const uint32x4_t sign_mask = vdupq_n_u32(0x80000000u);
+    const float32x4_t a = vabsq_f32(x);
+    int32x4_t j = vcvtq_s32_f32(vmulq_f32(a, vdupq_n_f32(kFourOverPi)));
+    j = vandq_s32(vaddq_s32(j, vdupq_n_s32(1)), vdupq_n_s32(~1));
+    const float32x4_t y = vcvtq_f32_s32(j);
+    float32x4_t r = vmlsq_f32(a, y, vdupq_n_f32(kPio4A));
+    r = vmlsq_f32(r, y, vdupq_n_f32(kPio4B));
+    r = vmlsq_f32(r, y, vdupq_n_f32(kPio4C));
+    const float32x4_t z = vmulq_f32(r, r);
+
+    float32x4_t sp = vmlaq_f32(vdupq_n_f32(kSinP[1]), vdupq_n_f32(kSinP[0]), z);
+    sp = vmlaq_f32(vdupq_n_f32(kSinP[2]), sp, z);
+    sp = vmlaq_f32(r, vmulq_f32(sp, z), r);
+    float32x4_t cp = vmlaq_f32(vdupq_n_f32(kCosP[1]), vdupq_n_f32(kCosP[0]), z);
+    cp = vmlaq_f32(vdupq_n_f32(kCosP[2]), cp, z);
+    cp = vmlaq_f32(vmlaq_f32(vdupq_n_f32(1.0f), vdupq_n_f32(-0.5f), z), vmulq_f32(cp, z), z);
+
+    if (Cosine) {
+        j = vaddq_s32(j, vdupq_n_s32(2));
+    }
+    const uint32x4_t use_cos = vceqq_s32(vandq_s32(j, vdupq_n_s32(2)), vdupq_n_s32(2));
+    uint32x4_t res = vreinterpretq_u32_f32(vbslq_f32(use_cos, cp, sp));
+    res = veorq_u32(res, vreinterpretq_u32_s32(vshlq_n_s32(vandq_s32(j, vdupq_n_s32(4)), 29)));
+    if (!Cosine) {
+        res = veorq_u32(res, vandq_u32(vreinterpretq_u32_f32(x), sign_mask));
+    }
+    return vbslq_f32(vcleq_f32(a, vdupq_n_f32(kTrigMax)), vreinterpretq_f32_u32(res),
+                     vdupq_n_f32(std::numeric_limits<float>::quiet_NaN()));
+}
+
+inline float32x4_t sin_neon(float32x4_t x) noexcept { return sin_or_cos_neon<false>(x); }
+inline float32x4_t cos_neon(float32x4_t x) noexcept { return sin_or_cos_neon<true>(x); }
+
+inline float32x4_t tanh_neon(float32x4_t x) noexcept {
+    using namespace fm;
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t a = vabsq_f32(x);
+    const float32x4_t z = vmulq_f32(x, x);
+    float32x4_t p = vdupq_n_f32(kTanhP[0]);
+    for (int k = 1; k < 5; ++k) {
+        p = vmlaq_f32(vdupq_n_f32(kTanhP[k]), p, z);
+    }
+    const float32x4_t small = vmlaq_f32(x, vmulq_f32(p, z), x);
+    const float32x4_t e = exp_neon(vaddq_f32(a, a));
+    float32x4_t big = vsubq_f32(one, div_neon(vdupq_n_f32(2.0f), vaddq_f32(e, one)));
+    big = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(big),
+                                          vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000u))));
+    return vbslq_f32(vcltq_f32(a, vdupq_n_f32(kTanhSmall)), small, big);
+}
+
+inline float32x4_t sigmoid_neon(float32x4_t x) noexcept {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    return div_neon(one, vaddq_f32(one, exp_neon(vnegq_f32(x))));
+}
+
+template<float32x4_t (*F)(float32x4_t)>
+inline void map_neon(const float* in, float* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, F(vld1q_f32(in + i)));
+    }
+    if (i < n) {
+        float tail[4] = {};
+        std::memcpy(tail, in + i, (n - i) * sizeof(float));
+        vst1q_f32(tail, F(vld1q_f32(tail)));
+        std::memcpy(out + i, tail, (n - i) * sizeof(float));
+    }
+}
+
+#endif // CRAB_SIMD_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+enum class MathFn { Exp, Log, Sin, Cos, Tanh, Sigmoid };
+
+inline Result<Unit, OutOfBounds> map_math(MathFn fn, Slice<const float> in, Slice<float> out) noexcept {
+    if (out.size() != in.size()) {
+        return Err(OutOfBounds{out.size(), in.size()});
+    }
+    const float* src = in.data();
+    float* dst = out.data();
+    const std::size_t n = in.size();
+#if CRAB_SIMD_X86
+    if (use_avx2<float>()) {
+        switch (fn) {
+            case MathFn::Exp: map_avx2<exp_avx2>(src, dst, n); break;
+            case MathFn::Log: map_avx2<log_avx2>(src, dst, n); break;
+            case MathFn::Sin: map_avx2<sin_avx2>(src, dst, n); break;
+            case MathFn::Cos: map_avx2<cos_avx2>(src, dst, n); break;
+            case MathFn::Tanh: map_avx2<tanh_avx2>(src, dst, n); break;
+            case MathFn::Sigmoid: map_avx2<sigmoid_avx2>(src, dst, n); break;
+        }
+        return Ok();
+    }
+#elif CRAB_SIMD_NEON
+    if (use_neon<float>()) {
+        switch (fn) {
+            case MathFn::Exp: map_neon<exp_neon>(src, dst, n); break;
+            case MathFn::Log: map_neon<log_neon>(src, dst, n); break;
+            case MathFn::Sin: map_neon<sin_neon>(src, dst, n); break;
+            case MathFn::Cos: map_neon<cos_neon>(src, dst, n); break;
+            case MathFn::Tanh: map_neon<tanh_neon>(src, dst, n); break;
+            case MathFn::Sigmoid: map_neon<sigmoid_neon>(src, dst, n); break;
+        }
+        return Ok();
+    }
+#endif
+    float (*scalar)(float) = nullptr;
+    switch (fn) {
+        case MathFn::Exp: scalar = fast_exp; break;
+        case MathFn::Log: scalar = fast_log; break;
+        case MathFn::Sin: scalar = fast_sin; break;
+        case MathFn::Cos: scalar = fast_cos; break;
+        case MathFn::Tanh: scalar = fast_tanh; break;
+        case MathFn::Sigmoid: scalar = fast_sigmoid; break;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] = scalar(src[i]);
+    }
+    return Ok();
+}
+
+} // namespace detail
+
+// ============================================================================
+// Bulk Kernels
+// ============================================================================
+
+/**
+ * @brief out[i] = exp(in[i]).
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+inline Result<Unit, OutOfBounds> fast_exp(Slice<const float> in, Slice<float> out) noexcept {
+    return detail::map_math(detail::MathFn::Exp, in, out);
+}
+
+/**
+ * @brief out[i] = log(in[i]).
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+inline Result<Unit, OutOfBounds> fast_log(Slice<const float> in, Slice<float> out) noexcept {
+    return detail::map_math(detail::MathFn::Log, in, out);
+}
+
+/**
+ * @brief out[i] = sin(in[i]).
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+inline Result<Unit, OutOfBounds> fast_sin(Slice<const float> in, Slice<float> out) noexcept {
+    return detail::map_math(detail::MathFn::Sin, in, out);
+}
+
+/**
+ * @brief out[i] = cos(in[i]).
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+inline Result<Unit, OutOfBounds> fast_cos(Slice<const float> in, Slice<float> out) noexcept {
+    return detail::map_math(detail::MathFn::Cos, in, out);
+}
+
+/**
+ * @brief out[i] = tanh(in[i]).
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+inline Result<Unit, OutOfBounds> fast_tanh(Slice<const float> in, Slice<float> out) noexcept {
+    return detail::map_math(detail::MathFn::Tanh, in, out);
+}
+
+/**
+ * @brief out[i] = 1 / (1 + exp(-in[i])).
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+inline Result<Unit, OutOfBounds> fast_sigmoid(Slice<const float> in, Slice<float> out) noexcept {
+    return detail::map_math(detail::MathFn::Sigmoid, in, out);
+}
+
+} // namespace crab
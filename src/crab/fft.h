@@ -0,0 +1,471 @@
+#pragma once
+
+/**
+ * @file fft.h
+ * @brief Heap-free fixed-size FFT with compile-time twiddle tables.
+ *
+ * Fft<N> (N a power of two) transforms std::complex<float> data in place.
+ * The bit-reversal permutation and per-stage twiddle factors are built by
+ * constexpr code when Fft<N> is instantiated, so there is no plan to
+ * create, no allocation, and no initialization at runtime. Above
+ * kMaxConstexprFft the same tables are built once, on first use, into a
+ * function-local static instead.
+ *
+ * - forward() / inverse(): complex, in place; inverse() scales by 1/N
+ * - forward_real(): N real samples -> N/2 + 1 bins (the rest are conjugate)
+ * - inverse_real(): N/2 + 1 bins -> N real samples, caller-supplied scratch
+ *
+ * The first two radix-2 stages are fused into one twiddle-free radix-4
+ * pass. Every later stage reads its twiddles contiguously, and its
+ * butterflies run 4 complex values per AVX2 vector, or 4 per NEON
+ * deinterleaved pair.
+ *
+ * Tables take 12 * N bytes. Constexpr evaluation cost grows with N: on
+ * GCC 13, N = 4096 adds about half a second per translation unit, 16384
+ * about 1.3 s, and 65536 exceeds the default -fconstexpr-ops-limit.
+ * Clang's default -fconstexpr-steps is lower still, hence the cap.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/numeric.h"
+#include "crab/error_types.h"
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if CRAB_SIMD_X86
+    #include <immintrin.h>
+#elif CRAB_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace crab {
+
+// ============================================================================
+// Compile-Time Tables
+// ============================================================================
+
+namespace detail {
+
+// Taylor series; only called with |x| <= pi/4, where 12 terms reach 1e-17
+constexpr double sin_reduced(double x) noexcept {
+    double term = x;
+    double sum = x;
+    for (int i = 1; i < 12; ++i) {
+        term *= -x * x / ((2.0 * i) * (2.0 * i + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos_reduced(double x) noexcept {
+    double term = 1.0;
+    double sum = 1.0;
+    for (int i = 1; i < 12; ++i) {
+        term *= -x * x / ((2.0 * i - 1.0) * (2.0 * i));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief e^(-2*pi*i*k/n) with exact octant symmetry (cos(pi/2) is exactly 0).
+ */
+constexpr void unit_root(std::size_t k, std::size_t n, double& re, double& im) noexcept {
+    constexpr double half_pi = 1.57079632679489661923;
+    const std::size_t q = (4 * k) / n;           // Quadrant of 2*pi*k/n
+    const std::size_t rem = 4 * k - q * n;      // Position within it, in units of (pi/2)/n
+    double c = 0.0;
+    double s = 0.0;
+    if (2 * rem <= n) {
+        const double phi = half_pi * static_cast<double>(rem) / static_cast<double>(n);
+        c = cos_reduced(phi);
+        s = sin_reduced(phi);
+    } else {
+        const double phi = half_pi * static_cast<double>(n - rem) / static_cast<double>(n);
+        c = sin_reduced(phi);
+        s = cos_reduced(phi);
+    }
+    // Rotate (cos, sin) of the reduced angle into quadrant q
+    double cq = c;
+    double sq = s;
+    switch (q & 3) {
+        case 1: cq = -s; sq = c; break;
+        case 2: cq = -c; sq = -s; break;
+        case 3: cq = s; sq = -c; break;
+        default: break;
+    }
+    re = cq;
+    im = -sq;
+}
+
+/// Largest N whose tables are built by constexpr evaluation
+inline constexpr std::size_t kMaxConstexprFft = 4096;
+
+template<std::size_t N>
+struct FftTables {
+    /// Stage with half-span h keeps W_{2h}^j (j < h) at complex offset h - 1
+    float stage[2 * N];
+    uint32_t bitrev[N];
+};
+
+template<std::size_t N>
+constexpr void fill_fft_tables(FftTables<N>& t) noexcept {
+    std::size_t bits = 0;
+    while ((std::size_t{1} << bits) < N) {
+        ++bits;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        t.bitrev[i] = static_cast<uint32_t>(r);
+    }
+    for (std::size_t h = 1; h < N; h *= 2) {
+        for (std::size_t j = 0; j < h; ++j) {
+            double re = 0.0;
+            double im = 0.0;
+            unit_root(j, 2 * h, re, im);
+            t.stage[2 * (h - 1 + j)] = static_cast<float>(re);
+            t.stage[2 * (h - 1 + j) + 1] = static_cast<float>(im);
+        }
+    }
+}
+
+template<std::size_t N>
+constexpr FftTables<N> build_fft_tables() noexcept {
+    FftTables<N> t{};
+    fill_fft_tables(t);
+    return t;
+}
+
+template<std::size_t N>
+struct ConstexprFftTables {
+    static constexpr FftTables<N> value = build_fft_tables<N>();
+};
+
+template<std::size_t N>
+const FftTables<N>& fft_tables() noexcept {
+    if constexpr (N <= kMaxConstexprFft) {
+        return ConstexprFftTables<N>::value;
+    } else {
+        // Filled in place: the first write to a non-constexpr static ends
+        // any attempt to evaluate this at compile time
+        static FftTables<N> tables;
+        static const bool built = (fill_fft_tables(tables), true);
+        (void)built;
+        return tables;
+    }
+}
+
+// ============================================================================
+// Butterfly Passes (interleaved re, im floats)
+// ============================================================================
+
+inline void fft_permute(float* x, const uint32_t* bitrev, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = bitrev[i];
+        if (i < j) {
+            uint64_t a;
+            uint64_t b;
+            std::memcpy(&a, x + 2 * i, 8);
+            std::memcpy(&b, x + 2 * j, 8);
+            std::memcpy(x + 2 * i, &b, 8);
+            std::memcpy(x + 2 * j, &a, 8);
+        }
+    }
+}
+
+// Stages h = 1 and h = 2 at once: the only twiddles are 1 and -i
+inline void fft_radix4_first(float* x, std::size_t n) noexcept {
+    for (std::size_t s = 0; s < n; s += 4) {
+        float* p = x + 2 * s;
+        const float b0r = p[0] + p[2], b0i = p[1] + p[3];
+        const float b1r = p[0] - p[2], b1i = p[1] - p[3];
+        const float b2r = p[4] + p[6], b2i = p[5] + p[7];
+        const float b3r = p[4] - p[6], b3i = p[5] - p[7];
+        p[0] = b0r + b2r;
+        p[1] = b0i + b2i;
+        p[4] = b0r - b2r;
+        p[5] = b0i - b2i;
+        // -i * b3 = (b3i, -b3r)
+        p[2] = b1r + b3i;
+        p[3] = b1i - b3r;
+        p[6] = b1r - b3i;
+        p[7] = b1i + b3r;
+    }
+}
+
+inline void fft_stages_scalar(float* x, const float* stage, std::size_t n) noexcept {
+    for (std::size_t h = 4; h < n; h *= 2) {
+        const float* w = stage + 2 * (h - 1);
+        for (std::size_t s = 0; s < n; s += 2 * h) {
+            float* a = x + 2 * s;
+            float* b = a + 2 * h;
+            for (std::size_t j = 0; j < h; ++j) {
+                const float wr = w[2 * j], wi = w[2 * j + 1];
+                const float br = b[2 * j], bi = b[2 * j + 1];
+                const float tr = br * wr - bi * wi;
+                const float ti = br * wi + bi * wr;
+                const float ar = a[2 * j], ai = a[2 * j + 1];
+                a[2 * j] = ar + tr;
+                a[2 * j + 1] = ai + ti;
+                b[2 * j] = ar - tr;
+                b[2 * j + 1] = ai - ti;
+            }
+        }
+    }
+}
+
+#if CRAB_SIMD_X86
+
+CRAB_TARGET_AVX2 inline void fft_stages_avx2(float* x, const float* stage, std::size_t n) noexcept {
+    for (std::size_t h = 4; h < n; h *= 2) {
+        const float* w = stage + 2 * (h - 1);
+        for (std::size_t s = 0; s < n; s += 2 * h) {
+            float* a = x + 2 * s;
+            float* b = a + 2 * h;
+            for (std::size_t j = 0; j < h; j += 4) {
+                const __m256 wv = _mm256_loadu_ps(w + 2 * j);
+                const __m256 bv = _mm256_loadu_ps(b + 2 * j);
+                const __m256 av = _mm256_loadu_ps(a + 2 * j);
+                // (br wr - bi wi, bi wr + br wi) = fmaddsub(b, wr, swap(b) * wi)
+                const __m256 wr = _mm256_moveldup_ps(wv);
+                const __m256 wi = _mm256_movehdup_ps(wv);
+                const __m256 bs = _mm256_permute_ps(bv, 0xB1);
+                const __m256 t = _mm256_fmaddsub_ps(bv, wr, _mm256_mul_ps(bs, wi));
+                _mm256_storeu_ps(a + 2 * j, _mm256_add_ps(av, t));
+                _mm256_storeu_ps(b + 2 * j, _mm256_sub_ps(av, t));
+            }
+        }
+    }
+}
+
+#endif // CRAB_SIMD_X86
+
+#if CRAB_SIMD_NEON
+
+inline void fft_stages_neon(float* x, const float* stage, std::size_t n) noexcept {
+    for (std::size_t h = 4; h < n; h *= 2) {
+        const float* w = stage + 2 * (h - 1);
+        for (std::size_t s = 0; s < n; s += 2 * h) {
+            float* a = x + 2 * s;
+            float* b = a + 2 * h;
+            for (std::size_t j = 0; j < h; j += 4) {
+                const float32x4x2_t wv = vld2q_f32(w + 2 * j);
+                const float32x4x2_t bv = vld2q_f32(b + 2 * j);
+                const float32x4x2_t av = vld2q_f32(a + 2 * j);
+                const float32x4_t tr = vmlsq_f32(vmulq_f32(bv.val[0], wv.val[0]), bv.val[1], wv.val[1]);
+                const float32x4_t ti = vmlaq_f32(vmulq_f32(bv.val[0], wv.val[1]), bv.val[1], wv.val[0]);
+                float32x4x2_t lo;
+                float32x4x2_t hi;
+                lo.val[0] = vaddq_f32(av.val[0], tr);
+                lo.val[1] = vaddq_f32(av.val[1], ti);
+                hi.val[0] = vsubq_f32(av.val[0], tr);
+                hi.val[1] = vsubq_f32(av.val[1], ti);
+                vst2q_f32(a + 2 * j, lo);
+                vst2q_f32(b + 2 * j, hi);
+            }
+        }
+    }
+}
+
+#endif // CRAB_SIMD_NEON
+
+/**
+ * @brief In-place forward transform of n interleaved complex values.
+ */
+inline void fft_forward(float* x, std::size_t n, const uint32_t* bitrev, const float* stage) noexcept {
+    fft_permute(x, bitrev, n);
+    fft_radix4_first(x, n);
+#if CRAB_SIMD_X86
+    if (use_avx2<float>()) {
+        fft_stages_avx2(x, stage, n);
+        return;
+    }
+#elif CRAB_SIMD_NEON
+    if (use_neon<float>()) {
+        fft_stages_neon(x, stage, n);
+        return;
+    }
+#endif
+    fft_stages_scalar(x, stage, n);
+}
+
+// Multiply lanes by (re_scale, im_scale): conjugates and/or normalizes
+inline void fft_scale_pairs(float* x, std::size_t n, float re_scale, float im_scale) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        x[2 * i] *= re_scale;
+        x[2 * i + 1] *= im_scale;
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// Fft<N>
+// ============================================================================
+
+/**
+ * @brief Fixed-size FFT over std::complex<float>.
+ *
+ * Forward uses e^(-2*pi*i*j*k/N); inverse uses the conjugate and divides
+ * by N, so inverse(forward(x)) == x.
+ *
+ * @tparam N Transform length (power of two, >= 4)
+ *
+ * @code{cpp}
+ *   std::complex<float> buf[1024];
+ *   crab::Fft<1024>::forward(crab::Slice<std::complex<float>>(buf)).unwrap();
+ * @endcode
+ */
+template<std::size_t N>
+class Fft {
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "Fft size must be a power of two >= 4");
+
+public:
+    using size_type = std::size_t;
+    using complex_type = std::complex<float>;
+
+    [[nodiscard]] static constexpr size_type size() noexcept { return N; }
+
+    /**
+     * @brief In-place forward transform.
+     * @return Err(OutOfBounds{data.size(), N}) if data is not exactly N long
+     */
+    static Result<Unit, OutOfBounds> forward(Slice<complex_type> data) noexcept {
+        if (data.size() != N) {
+            return Err(OutOfBounds{data.size(), N});
+        }
+        transform(reinterpret_cast<float*>(data.data()));
+        return Ok();
+    }
+
+    /**
+     * @brief In-place inverse transform, scaled by 1/N.
+     */
+    static Result<Unit, OutOfBounds> inverse(Slice<complex_type> data) noexcept {
+        if (data.size() != N) {
+            return Err(OutOfBounds{data.size(), N});
+        }
+        float* x = reinterpret_cast<float*>(data.data());
+        detail::fft_scale_pairs(x, N, 1.0f, -1.0f);
+        transform(x);
+        const float inv = 1.0f / static_cast<float>(N);
+        detail::fft_scale_pairs(x, N, inv, -inv);
+        return Ok();
+    }
+
+    /**
+     * @brief Spectrum of N real samples: bins 0..N/2 (out needs N/2 + 1).
+     *
+     * Runs one N/2-point complex transform on the samples packed as
+     * (x[2k], x[2k+1]) pairs directly in `out`, then separates the even
+     * and odd halves in place. No scratch is needed.
+     *
+     * @return Err(OutOfBounds) if in is not N long or out is not N/2 + 1 long
+     */
+    static Result<Unit, OutOfBounds> forward_real(Slice<const float> in, Slice<complex_type> out) noexcept {
+        static_assert(N >= 8, "forward_real() needs N >= 8");
+        constexpr size_type M = N / 2;
+        if (in.size() != N) {
+            return Err(OutOfBounds{in.size(), N});
+        }
+        if (out.size() != M + 1) {
+            return Err(OutOfBounds{out.size(), M + 1});
+        }
+        float* z = reinterpret_cast<float*>(out.data());
+        std::memcpy(z, in.data(), N * sizeof(float));
+        Fft<M>::transform(z);
+
+        const float* w = detail::fft_tables<N>().stage + 2 * (M - 1);  // W_N^k, k < M
+        const float z0r = z[0];
+        const float z0i = z[1];
+        z[0] = z0r + z0i;
+        z[1] = 0.0f;
+        z[2 * M] = z0r - z0i;
+        z[2 * M + 1] = 0.0f;
+        for (size_type k = 1; k <= M / 2; ++k) {
+            const size_type mk = M - k;
+            const float ar = z[2 * k], ai = z[2 * k + 1];
+            const float br = z[2 * mk], bi = z[2 * mk + 1];
+            // E = (Z[k] + conj Z[M-k]) / 2,  O = (Z[k] - conj Z[M-k]) / 2i
+            const float er = 0.5f * (ar + br), ei = 0.5f * (ai - bi);
+            const float or_ = 0.5f * (ai + bi), oi = -0.5f * (ar - br);
+            const float wr = w[2 * k], wi = w[2 * k + 1];
+            const float tr = wr * or_ - wi * oi;
+            const float ti = wr * oi + wi * or_;
+            // X[k] = E + W O,  X[M-k] = conj(E - W O)
+            z[2 * k] = er + tr;
+            z[2 * k + 1] = ei + ti;
+            z[2 * mk] = er - tr;
+            z[2 * mk + 1] = -(ei - ti);
+        }
+        return Ok();
+    }
+
+    /**
+     * @brief N real samples from bins 0..N/2 (the inverse of forward_real()).
+     *
+     * @param in N/2 + 1 bins
+     * @param out N samples
+     * @param scratch N/2 complex values of caller-owned workspace
+     * @return Err(OutOfBounds) naming the first argument of the wrong length
+     */
+    static Result<Unit, OutOfBounds> inverse_real(Slice<const complex_type> in, Slice<float> out,
+                                                  Slice<complex_type> scratch) noexcept {
+        static_assert(N >= 8, "inverse_real() needs N >= 8");
+        constexpr size_type M = N / 2;
+        if (in.size() != M + 1) {
+            return Err(OutOfBounds{in.size(), M + 1});
+        }
+        if (out.size() != N) {
+            return Err(OutOfBounds{out.size(), N});
+        }
+        if (scratch.size() != M) {
+            return Err(OutOfBounds{scratch.size(), M});
+        }
+        const float* x = reinterpret_cast<const float*>(in.data());
+        float* z = reinterpret_cast<float*>(scratch.data());
+        const float* w = detail::fft_tables<N>().stage + 2 * (M - 1);
+        // Z[k] = E + iO with E = (X[k] + conj X[M-k]) / 2 and
+        // O = (X[k] - conj X[M-k]) conj(W^k) / 2; conjugated for the inverse
+        for (size_type k = 0; k < M; ++k) {
+            const size_type mk = M - k;
+            const float ar = x[2 * k], ai = x[2 * k + 1];
+            const float br = x[2 * mk], bi = x[2 * mk + 1];
+            const float er = 0.5f * (ar + br), ei = 0.5f * (ai - bi);
+            const float dr = 0.5f * (ar - br), di = 0.5f * (ai + bi);
+            const float wr = w[2 * k], wi = -w[2 * k + 1];
+            const float or_ = dr * wr - di * wi;
+            const float oi = dr * wi + di * wr;
+            z[2 * k] = er - oi;
+            z[2 * k + 1] = -(ei + or_);
+        }
+        Fft<M>::transform(z);
+        const float inv = 1.0f / static_cast<float>(M);
+        float* dst = out.data();
+        for (size_type k = 0; k < M; ++k) {
+            dst[2 * k] = z[2 * k] * inv;
+            dst[2 * k + 1] = -z[2 * k + 1] * inv;
+        }
+        return Ok();
+    }
+
+private:
+    template<std::size_t>
+    friend class Fft;
+
+    static void transform(float* x) noexcept {
+        const detail::FftTables<N>& tables = detail::fft_tables<N>();
+        detail::fft_forward(x, N, tables.bitrev, tables.stage);
+    }
+};
+
+} // namespace crab
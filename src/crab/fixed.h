@@ -0,0 +1,925 @@
+#pragma once
+
+/**
+ * @file fixed.h
+ * @brief Q-format fixed-point numbers with saturating arithmetic.
+ *
+ * Fixed<IntBits, FracBits> stores a signed value with IntBits integer bits
+ * and FracBits fraction bits (plus sign) in the smallest int8/16/32 that
+ * fits. Q15 is Fixed<0, 15> (int16, range [-1, 1)), Q31 is Fixed<0, 31>.
+ *
+ * Arithmetic never wraps: +, -, * saturate to [min(), max()], and the
+ * checked_* variants return Err(Overflow) instead. Conversions and
+ * products round by Rounding::Floor (arithmetic shift) or Rounding::Nearest
+ * (round half up, the same as x86 pmulhrsw). Everything on the scalar
+ * type except the Result-returning functions is constexpr.
+ *
+ * Bulk kernels over Slice<Fixed> use saturating SIMD for 16-bit formats
+ * (IntBits + FracBits == 15): AVX2 (vpaddsw, widening multiply + vpackssdw)
+ * and NEON (vqadd, vmull + vqmovn). Other widths use the scalar path. SIMD
+ * and scalar results are bit-identical.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if CRAB_SIMD_X86
+    #include <immintrin.h>
+#elif CRAB_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace crab {
+
+/**
+ * @brief How to drop fraction bits.
+ */
+enum class Rounding {
+    Floor,    ///< Toward negative infinity (plain arithmetic shift)
+    Nearest   ///< To nearest, ties toward positive infinity
+};
+
+namespace detail {
+
+template<int Bits>
+using FixedRaw = std::conditional_t<(Bits <= 8), int8_t,
+                 std::conditional_t<(Bits <= 16), int16_t, int32_t>>;
+
+constexpr double pow2(int e) noexcept {
+    double r = 1.0;
+    for (int i = 0; i < e; ++i) {
+        r *= 2.0;
+    }
+    return r;
+}
+
+// v >> shift with the requested rounding (v may be negative)
+constexpr int64_t round_shift(int64_t v, int shift, Rounding mode) noexcept {
+    if (shift == 0) {
+        return v;
+    }
+    if (mode == Rounding::Nearest) {
+        v += int64_t{1} << (shift - 1);
+    }
+    return v >> shift;
+}
+
+/**
+ * @brief Round v * 2^frac to an integer in [lo, hi]; NaN maps to lo.
+ * @param overflow Set when the result had to be clamped (or v was NaN)
+ */
+constexpr int64_t float_to_raw(double v, int frac, Rounding mode,
+                               int64_t lo, int64_t hi, bool& overflow) noexcept {
+    const double x = v * pow2(frac);
+    if (!(x == x)) {
+        overflow = true;
+        return lo;
+    }
+    // Clamp just outside the range first so the int64 conversion is safe
+    const double flo = static_cast<double>(lo) - 1.0;
+    const double fhi = static_cast<double>(hi) + 1.0;
+    const double c = x < flo ? flo : (x > fhi ? fhi : x);
+    int64_t t = static_cast<int64_t>(c);
+    if (static_cast<double>(t) > c) {
+        --t;
+    }
+    if (mode == Rounding::Nearest && c - static_cast<double>(t) >= 0.5) {
+        ++t;
+    }
+    if (t > hi) {
+        overflow = true;
+        return hi;
+    }
+    if (t < lo) {
+        overflow = true;
+        return lo;
+    }
+    return t;
+}
+
+} // namespace detail
+
+// ============================================================================
+// Fixed<IntBits, FracBits>
+// ============================================================================
+
+/**
+ * @brief Signed fixed-point number: value = raw / 2^FracBits.
+ *
+ * @tparam IntBits Integer bits, excluding the sign
+ * @tparam FracBits Fraction bits
+ *
+ * @code{cpp}
+ *   constexpr auto half = crab::Q15::from_float(0.5);
+ *   static_assert(half.raw() == 16384);
+ *   static_assert((crab::Q15::min() * crab::Q15::min()) == crab::Q15::max());
+ * @endcode
+ */
+template<int IntBits, int FracBits>
+class Fixed {
+    static_assert(IntBits >= 0 && FracBits >= 0, "Fixed bit counts must be non-negative");
+    static_assert(IntBits + FracBits >= 1, "Fixed needs at least one magnitude bit");
+    static_assert(IntBits + FracBits + 1 <= 32, "Fixed supports at most 32 bits including sign");
+
+public:
+    static constexpr int kIntBits = IntBits;
+    static constexpr int kFracBits = FracBits;
+    static constexpr int kBits = IntBits + FracBits + 1;
+
+    using raw_type = detail::FixedRaw<kBits>;
+
+    static constexpr int64_t kMaxRaw = (int64_t{1} << (kBits - 1)) - 1;
+    static constexpr int64_t kMinRaw = -(int64_t{1} << (kBits - 1));
+
+    /**
+     * @brief Zero.
+     */
+    constexpr Fixed() noexcept : m_raw(0) {}
+
+    // ========================================================================
+    // Construction and Conversion
+    // ========================================================================
+
+    /**
+     * @brief Wrap a raw integer (must already be within [kMinRaw, kMaxRaw]).
+     */
+    [[nodiscard]] static constexpr Fixed from_raw(raw_type raw) noexcept {
+        CRAB_DEBUG_ASSERT(raw >= kMinRaw && raw <= kMaxRaw, "Fixed::from_raw value out of range");
+        Fixed f;
+        f.m_raw = raw;
+        return f;
+    }
+
+    /**
+     * @brief Clamp a wide raw value into range.
+     */
+    [[nodiscard]] static constexpr Fixed saturate(int64_t raw) noexcept {
+        raw = raw < kMinRaw ? kMinRaw : raw;
+        raw = raw > kMaxRaw ? kMaxRaw : raw;
+        return from_raw(static_cast<raw_type>(raw));
+    }
+
+    /**
+     * @brief Integer value, saturating.
+     */
+    [[nodiscard]] static constexpr Fixed from_int(int64_t v) noexcept {
+        constexpr int64_t max_int = kMaxRaw >> FracBits;
+        constexpr int64_t min_int = kMinRaw >> FracBits;
+        if (v > max_int) {
+            return max();
+        }
+        if (v < min_int) {
+            return min();
+        }
+        return from_raw(static_cast<raw_type>(v * (int64_t{1} << FracBits)));
+    }
+
+    /**
+     * @brief Nearest representable value, saturating (NaN becomes min()).
+     */
+    [[nodiscard]] static constexpr Fixed from_float(double v, Rounding mode = Rounding::Nearest) noexcept {
+        bool overflow = false;
+        return from_raw(static_cast<raw_type>(detail::float_to_raw(v, FracBits, mode, kMinRaw, kMaxRaw, overflow)));
+    }
+
+    /**
+     * @brief Like from_float(), but Err(Overflow{0}) if v is out of range or NaN.
+     */
+    [[nodiscard]] static Result<Fixed, Overflow> checked_from_float(double v, Rounding mode = Rounding::Nearest) noexcept {
+        bool overflow = false;
+        const int64_t raw = detail::float_to_raw(v, FracBits, mode, kMinRaw, kMaxRaw, overflow);
+        if (overflow) {
+            return Err(Overflow{0});
+        }
+        return Ok(from_raw(static_cast<raw_type>(raw)));
+    }
+
+    [[nodiscard]] constexpr raw_type raw() const noexcept { return m_raw; }
+
+    /// Exact for every format (at most 32 significant bits)
+    [[nodiscard]] constexpr double to_double() const noexcept {
+        return static_cast<double>(m_raw) / detail::pow2(FracBits);
+    }
+
+    [[nodiscard]] constexpr float to_float() const noexcept {
+        return static_cast<float>(to_double());
+    }
+
+    [[nodiscard]] static constexpr Fixed max() noexcept { return from_raw(static_cast<raw_type>(kMaxRaw)); }
+    [[nodiscard]] static constexpr Fixed min() noexcept { return from_raw(static_cast<raw_type>(kMinRaw)); }
+    [[nodiscard]] static constexpr Fixed epsilon() noexcept { return from_raw(1); }
+
+    // ========================================================================
+    // Saturating Arithmetic
+    // ========================================================================
+
+    [[nodiscard]] friend constexpr Fixed operator+(Fixed a, Fixed b) noexcept {
+        return saturate(int64_t{a.m_raw} + b.m_raw);
+    }
+
+    [[nodiscard]] friend constexpr Fixed operator-(Fixed a, Fixed b) noexcept {
+        return saturate(int64_t{a.m_raw} - b.m_raw);
+    }
+
+    [[nodiscard]] friend constexpr Fixed operator-(Fixed a) noexcept {
+        return saturate(-int64_t{a.m_raw});
+    }
+
+    /**
+     * @brief Product rounded to nearest (see mul() for other modes).
+     */
+    [[nodiscard]] friend constexpr Fixed operator*(Fixed a, Fixed b) noexcept {
+        return mul(a, b, Rounding::Nearest);
+    }
+
+    [[nodiscard]] static constexpr Fixed mul(Fixed a, Fixed b, Rounding mode) noexcept {
+        return saturate(detail::round_shift(int64_t{a.m_raw} * b.m_raw, FracBits, mode));
+    }
+
+    constexpr Fixed& operator+=(Fixed o) noexcept { return *this = *this + o; }
+    constexpr Fixed& operator-=(Fixed o) noexcept { return *this = *this - o; }
+    constexpr Fixed& operator*=(Fixed o) noexcept { return *this = *this * o; }
+
+    // ========================================================================
+    // Checked Arithmetic
+    // ========================================================================
+
+    [[nodiscard]] static Result<Fixed, Overflow> checked_add(Fixed a, Fixed b) noexcept {
+        return checked(int64_t{a.m_raw} + b.m_raw);
+    }
+
+    [[nodiscard]] static Result<Fixed, Overflow> checked_sub(Fixed a, Fixed b) noexcept {
+        return checked(int64_t{a.m_raw} - b.m_raw);
+    }
+
+    [[nodiscard]] static Result<Fixed, Overflow> checked_mul(Fixed a, Fixed b,
+                                                             Rounding mode = Rounding::Nearest) noexcept {
+        return checked(detail::round_shift(int64_t{a.m_raw} * b.m_raw, FracBits, mode));
+    }
+
+    // ========================================================================
+    // Comparison
+    // ========================================================================
+
+    [[nodiscard]] friend constexpr bool operator==(Fixed a, Fixed b) noexcept { return a.m_raw == b.m_raw; }
+    [[nodiscard]] friend constexpr bool operator!=(Fixed a, Fixed b) noexcept { return a.m_raw != b.m_raw; }
+    [[nodiscard]] friend constexpr bool operator<(Fixed a, Fixed b) noexcept { return a.m_raw < b.m_raw; }
+    [[nodiscard]] friend constexpr bool operator<=(Fixed a, Fixed b) noexcept { return a.m_raw <= b.m_raw; }
+    [[nodiscard]] friend constexpr bool operator>(Fixed a, Fixed b) noexcept { return a.m_raw > b.m_raw; }
+    [[nodiscard]] friend constexpr bool operator>=(Fixed a, Fixed b) noexcept { return a.m_raw >= b.m_raw; }
+
+private:
+    static Result<Fixed, Overflow> checked(int64_t raw) noexcept {
+        if (raw > kMaxRaw || raw < kMinRaw) {
+            return Err(Overflow{0});
+        }
+        return Ok(from_raw(static_cast<raw_type>(raw)));
+    }
+
+    raw_type m_raw;
+};
+
+using Q7 = Fixed<0, 7>;
+using Q15 = Fixed<0, 15>;
+using Q31 = Fixed<0, 31>;
+
+// ============================================================================
+// Bulk Kernels: Internals
+// ============================================================================
+
+namespace detail {
+
+template<typename T>
+struct is_fixed : std::false_type {};
+
+template<int I, int F>
+struct is_fixed<Fixed<I, F>> : std::true_type {};
+
+template<typename T>
+constexpr bool is_fixed_v = is_fixed<std::remove_const_t<T>>::value;
+
+// Formats whose range is exactly int16: hardware saturation matches ours
+template<typename Fx>
+constexpr bool is_fixed16_v = Fx::kBits == 16;
+
+template<typename Fx>
+inline bool use_fixed_simd() noexcept {
+    static_assert(sizeof(Fx) == sizeof(typename Fx::raw_type) && std::is_standard_layout_v<Fx>,
+                  "Fixed must be layout-compatible with its raw type");
+#if CRAB_SIMD_X86
+    return is_fixed16_v<Fx> && simd::active_level() >= simd::Level::Avx2;
+#elif CRAB_SIMD_NEON
+    return is_fixed16_v<Fx> && simd::active_level() >= simd::Level::Neon;
+#else
+    return false;
+#endif
+}
+
+// Fixed is standard-layout with a single raw member, so the two pointers
+// are interconvertible
+template<typename Fx>
+inline const int16_t* raw16(const Fx* p) noexcept { return reinterpret_cast<const int16_t*>(p); }
+template<typename Fx>
+inline int16_t* raw16(Fx* p) noexcept { return reinterpret_cast<int16_t*>(p); }
+
+#if CRAB_SIMD_X86
+
+// Exact 32-bit products, rounded and shifted, packed back with saturation
+template<int F>
+CRAB_TARGET_AVX2 inline __m256i mul_q16_avx2(__m256i a, __m256i b, bool nearest) noexcept {
+    const __m256i lo = _mm256_mullo_epi16(a, b);
+    const __m256i hi = _mm256_mulhi_epi16(a, b);
+    __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+    __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+    if constexpr (F > 0) {
+        if (nearest) {
+            const __m256i half = _mm256_set1_epi32(1 << (F - 1));
+            p0 = _mm256_add_epi32(p0, half);
+            p1 = _mm256_add_epi32(p1, half);
+        }
+        p0 = _mm256_srai_epi32(p0, F);
+        p1 = _mm256_srai_epi32(p1, F);
+    }
+    // unpack and pack both work per 128-bit lane, so element order survives
+    return _mm256_packs_epi32(p0, p1);
+}
+
+CRAB_TARGET_AVX2 inline void add_q16_avx2(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_adds_epi16(va, vb));
+    }
+    for (; i < n; ++i) {
+        const int32_t s = int32_t{a[i]} + b[i];
+        out[i] = static_cast<int16_t>(s > 32767 ? 32767 : (s < -32768 ? -32768 : s));
+    }
+}
+
+template<int F>
+CRAB_TARGET_AVX2 inline std::size_t mul_q16_avx2_loop(const int16_t* a, const int16_t* b, int16_t* out,
+                                                      std::size_t n, bool nearest) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), mul_q16_avx2<F>(va, vb, nearest));
+    }
+    return i;
+}
+
+template<int F>
+CRAB_TARGET_AVX2 inline std::size_t mac_q16_avx2_loop(int16_t* acc, const int16_t* a, const int16_t* b,
+                                                      std::size_t n, bool nearest) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i* pacc = reinterpret_cast<__m256i*>(acc + i);
+        _mm256_storeu_si256(pacc, _mm256_adds_epi16(_mm256_loadu_si256(pacc), mul_q16_avx2<F>(va, vb, nearest)));
+    }
+    return i;
+}
+
+template<int F>
+CRAB_TARGET_AVX2 inline std::size_t scale_q16_avx2_loop(int16_t* x, int16_t k, std::size_t n, bool nearest) noexcept {
+    const __m256i vk = _mm256_set1_epi16(k);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i* p = reinterpret_cast<__m256i*>(x + i);
+        _mm256_storeu_si256(p, mul_q16_avx2<F>(_mm256_loadu_si256(p), vk, nearest));
+    }
+    return i;
+}
+
+// Exact products widened to int64 lanes: no intermediate can overflow
+template<int F>
+CRAB_TARGET_AVX2 inline int64_t dot_q16_avx2(const int16_t* a, const int16_t* b, std::size_t n, std::size_t& done) noexcept {
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        const __m256i lo = _mm256_mullo_epi16(va, vb);
+        const __m256i hi = _mm256_mulhi_epi16(va, vb);
+        const __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+        const __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p0)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p0, 1)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p1)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p1, 1)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    done = i;
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+template<int F>
+CRAB_TARGET_AVX2 inline std::size_t to_q16_avx2(const float* in, int16_t* out, std::size_t n, bool nearest) noexcept {
+    const __m256 scale = _mm256_set1_ps(static_cast<float>(pow2(F)));
+    const __m256 lo = _mm256_set1_ps(-32768.0f);
+    const __m256 hi = _mm256_set1_ps(32767.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    auto convert = [&](__m256 x) CRAB_TARGET_AVX2 {
+        const __m256 y = _mm256_mul_ps(x, scale);
+        __m256 f = _mm256_floor_ps(y);
+        if (nearest) {
+            // y - floor(y) is exact, so ties are decided without rounding error
+            const __m256 up = _mm256_cmp_ps(_mm256_sub_ps(y, f), half, _CMP_GE_OQ);
+            f = _mm256_add_ps(f, _mm256_and_ps(up, one));
+        }
+        // max() returns lo for NaN inputs, like the scalar path
+        f = _mm256_min_ps(_mm256_max_ps(f, lo), hi);
+        return _mm256_cvttps_epi32(f);
+    };
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i a = convert(_mm256_loadu_ps(in + i));
+        const __m256i b = convert(_mm256_loadu_ps(in + i + 8));
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+    return i;
+}
+
+template<int F>
+CRAB_TARGET_AVX2 inline std::size_t from_q16_avx2(const int16_t* in, float* out, std::size_t n) noexcept {
+    const __m256 scale = _mm256_set1_ps(static_cast<float>(1.0 / pow2(F)));
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i w = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(w), scale));
+    }
+    return i;
+}
+
+#endif // CRAB_SIMD_X86
+
+#if CRAB_SIMD_NEON
+
+template<int F>
+inline int16x8_t mul_q16_neon(int16x8_t a, int16x8_t b, bool nearest) noexcept {
+    int32x4_t p0 = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+    int32x4_t p1 = vmull_s16(vget_high_s16(a), vget_high_s16(b));
+    if constexpr (F > 0) {
+        if (nearest) {
+            const int32x4_t half = vdupq_n_s32(1 << (F - 1));
+            p0 = vaddq_s32(p0, half);
+            p1 = vaddq_s32(p1, half);
+        }
+        p0 = vshrq_n_s32(p0, F);
+        p1 = vshrq_n_s32(p1, F);
+    }
+    return vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1));
+}
+
+inline std::size_t add_q16_neon(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(out + i, vqaddq_s16(vld1q_s16(a + i), vld1q_s16(b + i)));
+    }
+    return i;
+}
+
+template<int F>
+inline std::size_t mul_q16_neon_loop(const int16_t* a, const int16_t* b, int16_t* out,
+                                     std::size_t n, bool nearest) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(out + i, mul_q16_neon<F>(vld1q_s16(a + i), vld1q_s16(b + i), nearest));
+    }
+    return i;
+}
+
+template<int F>
+inline std::size_t mac_q16_neon_loop(int16_t* acc, const int16_t* a, const int16_t* b,
+                                     std::size_t n, bool nearest) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int16x8_t p = mul_q16_neon<F>(vld1q_s16(a + i), vld1q_s16(b + i), nearest);
+        vst1q_s16(acc + i, vqaddq_s16(vld1q_s16(acc + i), p));
+    }
+    return i;
+}
+
+template<int F>
+inline std::size_t scale_q16_neon_loop(int16_t* x, int16_t k, std::size_t n, bool nearest) noexcept {
+    const int16x8_t vk = vdupq_n_s16(k);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        vst1q_s16(x + i, mul_q16_neon<F>(vld1q_s16(x + i), vk, nearest));
+    }
+    return i;
+}
+
+// vpadal widens the exact products into int64 lanes as it accumulates
+template<int F>
+inline int64_t dot_q16_neon(const int16_t* a, const int16_t* b, std::size_t n, std::size_t& done) noexcept {
+    int64x2_t acc0 = vdupq_n_s64(0);
+    int64x2_t acc1 = vdupq_n_s64(0);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int16x8_t va = vld1q_s16(a + i);
+        const int16x8_t vb = vld1q_s16(b + i);
+        acc0 = vpadalq_s32(acc0, vmull_s16(vget_low_s16(va), vget_low_s16(vb)));
+        acc1 = vpadalq_s32(acc1, vmull_s16(vget_high_s16(va), vget_high_s16(vb)));
+    }
+    const int64x2_t acc = vaddq_s64(acc0, acc1);
+    done = i;
+    return vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+}
+
+// ARMv7 has no vrndmq, and vcvtq maps NaN to 0: clamp just outside int16
+// first (as the scalar path does), floor by truncate-and-correct, then
+// send NaN lanes to the minimum
+template<int F>
+inline int32x4_t to_q16_neon(float32x4_t x, bool nearest) noexcept {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t y = vmulq_f32(x, vdupq_n_f32(static_cast<float>(pow2(F))));
+    const uint32x4_t valid = vceqq_f32(y, y);
+    const float32x4_t c = vminq_f32(vmaxq_f32(y, vdupq_n_f32(-32769.0f)), vdupq_n_f32(32768.0f));
+    float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(c));
+    t = vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(t, c), vreinterpretq_u32_f32(one))));
+    if (nearest) {
+        // c - t is exact, so ties are decided without rounding error
+        const uint32x4_t up = vcgeq_f32(vsubq_f32(c, t), vdupq_n_f32(0.5f));
+        t = vaddq_f32(t, vreinterpretq_f32_u32(vandq_u32(up, vreinterpretq_u32_f32(one))));
+    }
+    return vbslq_s32(valid, vcvtq_s32_f32(t), vdupq_n_s32(-32768));
+}
+
+template<int F>
+inline std::size_t to_q16_neon_loop(const float* in, int16_t* out, std::size_t n, bool nearest) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int32x4_t lo = to_q16_neon<F>(vld1q_f32(in + i), nearest);
+        const int32x4_t hi = to_q16_neon<F>(vld1q_f32(in + i + 4), nearest);
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+    return i;
+}
+
+template<int F>
+inline std::size_t from_q16_neon(const int16_t* in, float* out, std::size_t n) noexcept {
+    const float32x4_t scale = vdupq_n_f32(static_cast<float>(1.0 / pow2(F)));
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int16x8_t w = vld1q_s16(in + i);
+        vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(w))), scale));
+        vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(w))), scale));
+    }
+    return i;
+}
+
+#endif // CRAB_SIMD_NEON
+
+} // namespace detail
+
+// ============================================================================
+// Bulk Kernels: Saturating
+// ============================================================================
+
+/**
+ * @brief out[i] = a[i] + b[i], saturating.
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+template<typename T, typename U, typename V>
+Result<Unit, OutOfBounds> add_sat(Slice<T> a, Slice<U> b, Slice<V> out) noexcept {
+    using Fx = std::remove_const_t<T>;
+    static_assert(detail::is_fixed_v<Fx> && std::is_same_v<Fx, std::remove_const_t<U>> && std::is_same_v<Fx, V>,
+                  "add_sat() requires matching Fixed element types and a mutable out");
+    if (b.size() != a.size()) {
+        return Err(OutOfBounds{b.size(), a.size()});
+    }
+    if (out.size() != a.size()) {
+        return Err(OutOfBounds{out.size(), a.size()});
+    }
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    if constexpr (detail::is_fixed16_v<Fx>) {
+        if (detail::use_fixed_simd<Fx>()) {
+#if CRAB_SIMD_X86
+            detail::add_q16_avx2(detail::raw16(a.data()), detail::raw16(b.data()), detail::raw16(out.data()), n);
+            return Ok();
+#elif CRAB_SIMD_NEON
+            i = detail::add_q16_neon(detail::raw16(a.data()), detail::raw16(b.data()), detail::raw16(out.data()), n);
+#endif
+        }
+    }
+    for (; i < n; ++i) {
+        out.data()[i] = a.data()[i] + b.data()[i];
+    }
+    return Ok();
+}
+
+/**
+ * @brief out[i] = a[i] * b[i], rounded and saturated.
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+template<typename T, typename U, typename V>
+Result<Unit, OutOfBounds> mul_sat(Slice<T> a, Slice<U> b, Slice<V> out,
+                                  Rounding mode = Rounding::Nearest) noexcept {
+    using Fx = std::remove_const_t<T>;
+    static_assert(detail::is_fixed_v<Fx> && std::is_same_v<Fx, std::remove_const_t<U>> && std::is_same_v<Fx, V>,
+                  "mul_sat() requires matching Fixed element types and a mutable out");
+    if (b.size() != a.size()) {
+        return Err(OutOfBounds{b.size(), a.size()});
+    }
+    if (out.size() != a.size()) {
+        return Err(OutOfBounds{out.size(), a.size()});
+    }
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    if constexpr (detail::is_fixed16_v<Fx>) {
+        if (detail::use_fixed_simd<Fx>()) {
+            const bool nearest = mode == Rounding::Nearest;
+#if CRAB_SIMD_X86
+            i = detail::mul_q16_avx2_loop<Fx::kFracBits>(detail::raw16(a.data()), detail::raw16(b.data()),
+                                                         detail::raw16(out.data()), n, nearest);
+#elif CRAB_SIMD_NEON
+            i = detail::mul_q16_neon_loop<Fx::kFracBits>(detail::raw16(a.data()), detail::raw16(b.data()),
+                                                         detail::raw16(out.data()), n, nearest);
+#else
+            (void)nearest;
+#endif
+        }
+    }
+    for (; i < n; ++i) {
+        out.data()[i] = Fx::mul(a.data()[i], b.data()[i], mode);
+    }
+    return Ok();
+}
+
+/**
+ * @brief acc[i] = acc[i] + a[i] * b[i] (product rounded, both steps saturate).
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+template<typename T, typename U, typename V>
+Result<Unit, OutOfBounds> mac_sat(Slice<T> acc, Slice<U> a, Slice<V> b,
+                                  Rounding mode = Rounding::Nearest) noexcept {
+    using Fx = T;
+    static_assert(detail::is_fixed_v<Fx> && !std::is_const_v<T> &&
+                  std::is_same_v<Fx, std::remove_const_t<U>> && std::is_same_v<Fx, std::remove_const_t<V>>,
+                  "mac_sat() requires matching Fixed element types and a mutable acc");
+    if (a.size() != acc.size()) {
+        return Err(OutOfBounds{a.size(), acc.size()});
+    }
+    if (b.size() != acc.size()) {
+        return Err(OutOfBounds{b.size(), acc.size()});
+    }
+    const std::size_t n = acc.size();
+    std::size_t i = 0;
+    if constexpr (detail::is_fixed16_v<Fx>) {
+        if (detail::use_fixed_simd<Fx>()) {
+            const bool nearest = mode == Rounding::Nearest;
+#if CRAB_SIMD_X86
+            i = detail::mac_q16_avx2_loop<Fx::kFracBits>(detail::raw16(acc.data()), detail::raw16(a.data()),
+                                                         detail::raw16(b.data()), n, nearest);
+#elif CRAB_SIMD_NEON
+            i = detail::mac_q16_neon_loop<Fx::kFracBits>(detail::raw16(acc.data()), detail::raw16(a.data()),
+                                                         detail::raw16(b.data()), n, nearest);
+#else
+            (void)nearest;
+#endif
+        }
+    }
+    for (; i < n; ++i) {
+        acc.data()[i] = acc.data()[i] + Fx::mul(a.data()[i], b.data()[i], mode);
+    }
+    return Ok();
+}
+
+/**
+ * @brief x[i] = x[i] * k, rounded and saturated.
+ */
+template<typename T>
+void scale_sat(Slice<T> x, T k, Rounding mode = Rounding::Nearest) noexcept {
+    static_assert(detail::is_fixed_v<T> && !std::is_const_v<T>, "scale_sat() requires a mutable Slice<Fixed>");
+    const std::size_t n = x.size();
+    std::size_t i = 0;
+    if constexpr (detail::is_fixed16_v<T>) {
+        if (detail::use_fixed_simd<T>()) {
+            const bool nearest = mode == Rounding::Nearest;
+#if CRAB_SIMD_X86
+            i = detail::scale_q16_avx2_loop<T::kFracBits>(detail::raw16(x.data()), k.raw(), n, nearest);
+#elif CRAB_SIMD_NEON
+            i = detail::scale_q16_neon_loop<T::kFracBits>(detail::raw16(x.data()), k.raw(), n, nearest);
+#else
+            (void)nearest;
+#endif
+        }
+    }
+    for (; i < n; ++i) {
+        x.data()[i] = T::mul(x.data()[i], k, mode);
+    }
+}
+
+/**
+ * @brief sum(a[i] * b[i]) with exact products, rounded and saturated once.
+ *
+ * Limited to formats of at most 16 bits so the int64 accumulator cannot
+ * overflow (up to 2^32 terms).
+ * @note Panics if the lengths differ.
+ */
+template<typename T, typename U>
+[[nodiscard]] std::remove_const_t<T> dot_sat(Slice<T> a, Slice<U> b, Rounding mode = Rounding::Nearest) noexcept {
+    using Fx = std::remove_const_t<T>;
+    static_assert(detail::is_fixed_v<Fx> && std::is_same_v<Fx, std::remove_const_t<U>>,
+                  "dot_sat() requires matching Fixed element types");
+    static_assert(Fx::kBits <= 16, "dot_sat() supports formats of at most 16 bits");
+    CRAB_ASSERT(a.size() == b.size(), "dot_sat() called with slices of different lengths");
+    const std::size_t n = a.size();
+    std::size_t i = 0;
+    int64_t acc = 0;
+#if CRAB_SIMD_X86
+    if constexpr (detail::is_fixed16_v<Fx>) {
+        if (detail::use_fixed_simd<Fx>()) {
+            acc = detail::dot_q16_avx2<Fx::kFracBits>(detail::raw16(a.data()), detail::raw16(b.data()), n, i);
+        }
+    }
+#elif CRAB_SIMD_NEON
+    if constexpr (detail::is_fixed16_v<Fx>) {
+        if (detail::use_fixed_simd<Fx>()) {
+            acc = detail::dot_q16_neon<Fx::kFracBits>(detail::raw16(a.data()), detail::raw16(b.data()), n, i);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        acc += int64_t{a.data()[i].raw()} * b.data()[i].raw();
+    }
+    return Fx::saturate(detail::round_shift(acc, Fx::kFracBits, mode));
+}
+
+/**
+ * @brief out[i] = Fixed::from_float(in[i], mode), saturating.
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+template<typename T, typename V>
+Result<Unit, OutOfBounds> to_fixed(Slice<T> in, Slice<V> out, Rounding mode = Rounding::Nearest) noexcept {
+    static_assert(std::is_same_v<std::remove_const_t<T>, float> && detail::is_fixed_v<V> && !std::is_const_v<V>,
+                  "to_fixed() converts Slice<const float> into a mutable Slice<Fixed>");
+    if (out.size() != in.size()) {
+        return Err(OutOfBounds{out.size(), in.size()});
+    }
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if CRAB_SIMD_X86
+    if constexpr (detail::is_fixed16_v<V>) {
+        if (detail::use_fixed_simd<V>()) {
+            i = detail::to_q16_avx2<V::kFracBits>(in.data(), detail::raw16(out.data()), n,
+                                                  mode == Rounding::Nearest);
+        }
+    }
+#elif CRAB_SIMD_NEON
+    if constexpr (detail::is_fixed16_v<V>) {
+        if (detail::use_fixed_simd<V>()) {
+            i = detail::to_q16_neon_loop<V::kFracBits>(in.data(), detail::raw16(out.data()), n,
+                                                       mode == Rounding::Nearest);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out.data()[i] = V::from_float(in.data()[i], mode);
+    }
+    return Ok();
+}
+
+/**
+ * @brief out[i] = in[i].to_float().
+ * @return Err(OutOfBounds) if the lengths differ (nothing written)
+ */
+template<typename T, typename V>
+Result<Unit, OutOfBounds> to_float(Slice<T> in, Slice<V> out) noexcept {
+    using Fx = std::remove_const_t<T>;
+    static_assert(detail::is_fixed_v<Fx> && std::is_same_v<V, float>,
+                  "to_float() converts Slice<const Fixed> into a mutable Slice<float>");
+    if (out.size() != in.size()) {
+        return Err(OutOfBounds{out.size(), in.size()});
+    }
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if CRAB_SIMD_X86
+    if constexpr (detail::is_fixed16_v<Fx>) {
+        if (detail::use_fixed_simd<Fx>()) {
+            i = detail::from_q16_avx2<Fx::kFracBits>(detail::raw16(in.data()), out.data(), n);
+        }
+    }
+#elif CRAB_SIMD_NEON
+    if constexpr (detail::is_fixed16_v<Fx>) {
+        if (detail::use_fixed_simd<Fx>()) {
+            i = detail::from_q16_neon<Fx::kFracBits>(detail::raw16(in.data()), out.data(), n);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out.data()[i] = in.data()[i].to_float();
+    }
+    return Ok();
+}
+
+// ============================================================================
+// Bulk Kernels: Checked
+// ============================================================================
+
+/**
+ * @brief out[i] = a[i] + b[i], stopping at the first overflow.
+ *
+ * Elements before the overflowing one are written; the rest are untouched.
+ * @return Err(Overflow{i}) for the first i whose sum is out of range
+ * @note Panics if the lengths differ.
+ */
+template<typename T, typename U, typename V>
+Result<Unit, Overflow> add_checked(Slice<T> a, Slice<U> b, Slice<V> out) noexcept {
+    using Fx = std::remove_const_t<T>;
+    static_assert(detail::is_fixed_v<Fx> && std::is_same_v<Fx, std::remove_const_t<U>> && std::is_same_v<Fx, V>,
+                  "add_checked() requires matching Fixed element types and a mutable out");
+    CRAB_ASSERT(a.size() == b.size() && a.size() == out.size(), "add_checked() called with slices of different lengths");
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        auto r = Fx::checked_add(a.data()[i], b.data()[i]);
+        if (r.is_err()) {
+            return Err(Overflow{i});
+        }
+        out.data()[i] = r.unwrap();
+    }
+    return Ok();
+}
+
+/**
+ * @brief out[i] = a[i] * b[i], stopping at the first overflow.
+ * @return Err(Overflow{i}) for the first i whose product is out of range
+ * @note Panics if the lengths differ.
+ */
+template<typename T, typename U, typename V>
+Result<Unit, Overflow> mul_checked(Slice<T> a, Slice<U> b, Slice<V> out,
+                                   Rounding mode = Rounding::Nearest) noexcept {
+    using Fx = std::remove_const_t<T>;
+    static_assert(detail::is_fixed_v<Fx> && std::is_same_v<Fx, std::remove_const_t<U>> && std::is_same_v<Fx, V>,
+                  "mul_checked() requires matching Fixed element types and a mutable out");
+    CRAB_ASSERT(a.size() == b.size() && a.size() == out.size(), "mul_checked() called with slices of different lengths");
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        auto r = Fx::checked_mul(a.data()[i], b.data()[i], mode);
+        if (r.is_err()) {
+            return Err(Overflow{i});
+        }
+        out.data()[i] = r.unwrap();
+    }
+    return Ok();
+}
+
+/**
+ * @brief acc[i] += a[i] * b[i], stopping at the first overflow.
+ * @return Err(Overflow{i}) for the first i whose product or sum is out of range
+ * @note Panics if the lengths differ.
+ */
+template<typename T, typename U, typename V>
+Result<Unit, Overflow> mac_checked(Slice<T> acc, Slice<U> a, Slice<V> b,
+                                   Rounding mode = Rounding::Nearest) noexcept {
+    static_assert(detail::is_fixed_v<T> && !std::is_const_v<T> &&
+                  std::is_same_v<T, std::remove_const_t<U>> && std::is_same_v<T, std::remove_const_t<V>>,
+                  "mac_checked() requires matching Fixed element types and a mutable acc");
+    CRAB_ASSERT(a.size() == acc.size() && b.size() == acc.size(), "mac_checked() called with slices of different lengths");
+    for (std::size_t i = 0; i < acc.size(); ++i) {
+        auto p = T::checked_mul(a.data()[i], b.data()[i], mode);
+        if (p.is_err()) {
+            return Err(Overflow{i});
+        }
+        auto s = T::checked_add(acc.data()[i], p.unwrap());
+        if (s.is_err()) {
+            return Err(Overflow{i});
+        }
+        acc.data()[i] = s.unwrap();
+    }
+    return Ok();
+}
+
+/**
+ * @brief out[i] = Fixed::from_float(in[i]), stopping at the first value out
+ *        of range (or NaN).
+ * @note Panics if the lengths differ.
+ */
+template<typename T, typename V>
+Result<Unit, Overflow> to_fixed_checked(Slice<T> in, Slice<V> out, Rounding mode = Rounding::Nearest) noexcept {
+    static_assert(std::is_same_v<std::remove_const_t<T>, float> && detail::is_fixed_v<V> && !std::is_const_v<V>,
+                  "to_fixed_checked() converts Slice<const float> into a mutable Slice<Fixed>");
+    CRAB_ASSERT(in.size() == out.size(), "to_fixed_checked() called with slices of different lengths");
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        auto r = V::checked_from_float(in.data()[i], mode);
+        if (r.is_err()) {
+            return Err(Overflow{i});
+        }
+        out.data()[i] = r.unwrap();
+    }
+    return Ok();
+}
+
+} // namespace crab
@@ -0,0 +1,461 @@
+#pragma once
+
+/**
+ * @file gather.h
+ * @brief Indexed gather/scatter and stream compaction over Slices.
+ *
+ * Building blocks for columnar processing: pick rows by an index list,
+ * write rows back by index, or keep only the rows selected by a mask or
+ * predicate.
+ *
+ * Index lists are validated in bulk (one SIMD max-reduction over the
+ * indices) before anything is read or written, so the inner loops carry
+ * no per-element bounds checks and a bad index leaves the output untouched.
+ *
+ * SIMD paths cover 4- and 8-byte trivially copyable element types: AVX2
+ * and AVX-512 gathers, AVX-512 scatters, and AVX2 (permute table) or
+ * AVX-512 (compress) compaction. Other types and targets use scalar loops.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/error_types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
+namespace crab {
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_simd_word_v =
+    std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+// ============================================================================
+// Bulk Index Validation
+// ============================================================================
+
+inline uint32_t max_index_scalar(const uint32_t* idx, std::size_t n) noexcept {
+    uint32_t best = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        best = idx[i] > best ? idx[i] : best;
+    }
+    return best;
+}
+
+#if CRAB_SIMD_X86
+
+CRAB_TARGET_AVX2 inline uint32_t max_index_avx2(const uint32_t* idx, std::size_t n) noexcept {
+    __m256i m0 = _mm256_setzero_si256();
+    __m256i m1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        m0 = _mm256_max_epu32(m0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i)));
+        m1 = _mm256_max_epu32(m1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i + 8)));
+    }
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_max_epu32(m0, m1));
+    const uint32_t best = max_index_scalar(lanes, 8);
+    const uint32_t tail = max_index_scalar(idx + i, n - i);
+    return tail > best ? tail : best;
+}
+
+#endif // CRAB_SIMD_X86
+
+#if CRAB_SIMD_NEON
+
+inline uint32_t max_index_neon(const uint32_t* idx, std::size_t n) noexcept {
+    uint32x4_t m = vdupq_n_u32(0);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        m = vmaxq_u32(m, vld1q_u32(idx + i));
+    }
+    uint32x2_t pair = vpmax_u32(vget_low_u32(m), vget_high_u32(m));
+    pair = vpmax_u32(pair, pair);
+    const uint32_t best = vget_lane_u32(pair, 0);
+    const uint32_t tail = max_index_scalar(idx + i, n - i);
+    return tail > best ? tail : best;
+}
+
+#endif // CRAB_SIMD_NEON
+
+inline uint32_t max_index(const uint32_t* idx, std::size_t n) noexcept {
+#if CRAB_SIMD_X86
+    // Memory-bound: AVX2 already saturates load bandwidth here
+    if (simd::active_level() >= simd::Level::Avx2) {
+        return max_index_avx2(idx, n);
+    }
+#elif CRAB_SIMD_NEON
+    if (simd::active_level() >= simd::Level::Neon) {
+        return max_index_neon(idx, n);
+    }
+#endif
+    return max_index_scalar(idx, n);
+}
+
+// ============================================================================
+// Gather / Scatter Kernels
+// ============================================================================
+
+#if CRAB_SIMD_X86
+
+// Indices are already validated and below 2^31 (hardware gathers are signed)
+template<std::size_t Size>
+CRAB_TARGET_AVX2 std::size_t gather_avx2(const void* src, const uint32_t* idx, void* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    if constexpr (Size == 4) {
+        const auto* base = static_cast<const int*>(src);
+        for (; i + 8 <= n; i += 8) {
+            const __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(static_cast<uint8_t*>(out) + i * 4),
+                                _mm256_i32gather_epi32(base, vi, 4));
+        }
+    } else {
+        const auto* base = static_cast<const long long*>(src);
+        for (; i + 4 <= n; i += 4) {
+            const __m128i vi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(static_cast<uint8_t*>(out) + i * 8),
+                                _mm256_i32gather_epi64(base, vi, 8));
+        }
+    }
+    return i;
+}
+
+template<std::size_t Size>
+CRAB_TARGET_AVX512 std::size_t gather_avx512(const void* src, const uint32_t* idx, void* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    if constexpr (Size == 4) {
+        for (; i + 16 <= n; i += 16) {
+            const __m512i vi = _mm512_loadu_si512(idx + i);
+            _mm512_storeu_si512(static_cast<uint8_t*>(out) + i * 4, _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, vi, src, 4));
+        }
+    } else {
+        for (; i + 8 <= n; i += 8) {
+            const __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+            _mm512_storeu_si512(static_cast<uint8_t*>(out) + i * 8, _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xFF, vi, src, 8));
+        }
+    }
+    return i;
+}
+
+// AVX-512 scatters store lanes in order, so duplicate indices keep the last value
+template<std::size_t Size>
+CRAB_TARGET_AVX512 std::size_t scatter_avx512(const void* values, const uint32_t* idx, void* dst, std::size_t n) noexcept {
+    std::size_t i = 0;
+    if constexpr (Size == 4) {
+        for (; i + 16 <= n; i += 16) {
+            const __m512i vi = _mm512_loadu_si512(idx + i);
+            _mm512_i32scatter_epi32(dst, vi, _mm512_loadu_si512(static_cast<const uint8_t*>(values) + i * 4), 4);
+        }
+    } else {
+        for (; i + 8 <= n; i += 8) {
+            const __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+            _mm512_i32scatter_epi64(dst, vi, _mm512_loadu_si512(static_cast<const uint8_t*>(values) + i * 8), 8);
+        }
+    }
+    return i;
+}
+
+#endif // CRAB_SIMD_X86
+
+// ============================================================================
+// Compaction Kernels
+// ============================================================================
+
+#if CRAB_SIMD_X86
+
+// For each 8-bit keep mask, the 32-bit lane indices that move kept lanes
+// to the front. 8-byte elements use the low 4 bits, as pairs of lanes.
+struct CompactTables {
+    std::array<std::array<uint8_t, 8>, 256> words{};
+    std::array<std::array<uint8_t, 8>, 16> dwords{};
+
+    constexpr CompactTables() noexcept {
+        for (unsigned m = 0; m < 256; ++m) {
+            unsigned k = 0;
+            for (unsigned lane = 0; lane < 8; ++lane) {
+                if (m & (1u << lane)) {
+                    words[m][k++] = static_cast<uint8_t>(lane);
+                }
+            }
+        }
+        for (unsigned m = 0; m < 16; ++m) {
+            unsigned k = 0;
+            for (unsigned lane = 0; lane < 4; ++lane) {
+                if (m & (1u << lane)) {
+                    dwords[m][k++] = static_cast<uint8_t>(2 * lane);
+                    dwords[m][k++] = static_cast<uint8_t>(2 * lane + 1);
+                }
+            }
+        }
+    }
+};
+
+inline constexpr CompactTables kCompactTables{};
+
+// Keep bits for Lanes (4 or 8) mask bytes: bit i set when mask[i] != 0
+template<std::size_t Lanes>
+CRAB_TARGET_AVX2 unsigned keep_bits(const uint8_t* mask) noexcept {
+    __m128i m;
+    if constexpr (Lanes == 8) {
+        m = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask));
+    } else {
+        int32_t word;
+        std::memcpy(&word, mask, 4);
+        m = _mm_cvtsi32_si128(word);
+    }
+    const unsigned zero = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(m, _mm_setzero_si128())));
+    return ~zero & ((1u << Lanes) - 1);
+}
+
+// Writes whole vectors while a full vector still fits below `cap`, so pass
+// the final kept count to leave everything past it untouched; returns the
+// number of input elements consumed (count kept via `kept`)
+template<std::size_t Size>
+CRAB_TARGET_AVX2 std::size_t select_avx2(const void* src, const uint8_t* mask, void* out,
+                                         std::size_t n, std::size_t cap, std::size_t& kept) noexcept {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* dst = static_cast<uint8_t*>(out);
+    constexpr std::size_t lanes = 32 / Size;
+    std::size_t k = 0;
+    std::size_t i = 0;
+    for (; i + lanes <= n && k + lanes <= cap; i += lanes) {
+        const unsigned bits = keep_bits<lanes>(mask + i);
+        const uint8_t* perm = (Size == 4) ? kCompactTables.words[bits].data() : kCompactTables.dwords[bits].data();
+        const __m256i shuffle = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(perm)));
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * Size));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k * Size), _mm256_permutevar8x32_epi32(v, shuffle));
+        k += static_cast<std::size_t>(__builtin_popcount(bits));
+    }
+    kept = k;
+    return i;
+}
+
+// Compress-store writes only the kept lanes, so no slack is needed
+template<std::size_t Size>
+CRAB_TARGET_AVX512 std::size_t select_avx512(const void* src, const uint8_t* mask, void* out,
+                                             std::size_t n, std::size_t& kept) noexcept {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* dst = static_cast<uint8_t*>(out);
+    constexpr std::size_t lanes = 64 / Size;
+    std::size_t k = 0;
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m512i v = _mm512_loadu_si512(in + i * Size);
+        if constexpr (Size == 4) {
+            const __mmask16 keep = _mm_test_epi8_mask(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i)), _mm_set1_epi8(-1));
+            _mm512_mask_storeu_epi32(dst + k * Size, static_cast<__mmask16>((1u << __builtin_popcount(keep)) - 1),
+                                     _mm512_maskz_compress_epi32(keep, v));
+            k += static_cast<std::size_t>(__builtin_popcount(keep));
+        } else {
+            const __mmask8 keep = static_cast<__mmask8>(keep_bits<8>(mask + i));
+            _mm512_mask_storeu_epi64(dst + k * Size, static_cast<__mmask8>((1u << __builtin_popcount(keep)) - 1),
+                                     _mm512_maskz_compress_epi64(keep, v));
+            k += static_cast<std::size_t>(__builtin_popcount(keep));
+        }
+    }
+    kept = k;
+    return i;
+}
+
+#endif // CRAB_SIMD_X86
+
+} // namespace detail
+
+// ============================================================================
+// Gather / Scatter
+// ============================================================================
+
+/**
+ * @brief out[i] = src[idx[i]] for every i < idx.size().
+ *
+ * @return Ok, or Err(OutOfBounds) if out is shorter than idx
+ *         ({idx.size(), out.size()}) or an index is out of range
+ *         ({largest index, src.size()}). Nothing is written on error.
+ */
+template<typename T, typename U>
+Result<Unit, OutOfBounds> gather(Slice<T> src, Slice<const uint32_t> idx, Slice<U> out) noexcept {
+    using V = std::remove_const_t<T>;
+    static_assert(std::is_same_v<V, U>, "gather() requires matching element types and a mutable output");
+    if (out.size() < idx.size()) {
+        return Err(OutOfBounds{idx.size(), out.size()});
+    }
+    if (idx.is_empty()) {
+        return Ok();
+    }
+    const uint32_t max = detail::max_index(idx.data(), idx.size());
+    if (max >= src.size()) {
+        return Err(OutOfBounds{max, src.size()});
+    }
+
+    const V* in = src.data();
+    const uint32_t* ix = idx.data();
+    V* dst = out.data();
+    const std::size_t n = idx.size();
+    std::size_t i = 0;
+#if CRAB_SIMD_X86
+    if constexpr (detail::is_simd_word_v<V>) {
+        if (max <= static_cast<uint32_t>(INT32_MAX)) {
+            const simd::Level level = simd::active_level();
+            if (level >= simd::Level::Avx512) {
+                i = detail::gather_avx512<sizeof(V)>(in, ix, dst, n);
+            } else if (level >= simd::Level::Avx2) {
+                i = detail::gather_avx2<sizeof(V)>(in, ix, dst, n);
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = in[ix[i]];
+    }
+    return Ok();
+}
+
+/**
+ * @brief dst[idx[i]] = values[i] for every i; later duplicates win.
+ *
+ * @return Ok, or Err(OutOfBounds) if values and idx differ in length
+ *         ({idx.size(), values.size()}) or an index is out of range
+ *         ({largest index, dst.size()}). Nothing is written on error.
+ */
+template<typename T, typename U>
+Result<Unit, OutOfBounds> scatter(Slice<T> values, Slice<const uint32_t> idx, Slice<U> dst) noexcept {
+    using V = std::remove_const_t<T>;
+    static_assert(std::is_same_v<V, U>, "scatter() requires matching element types and a mutable destination");
+    if (values.size() != idx.size()) {
+        return Err(OutOfBounds{idx.size(), values.size()});
+    }
+    if (idx.is_empty()) {
+        return Ok();
+    }
+    const uint32_t max = detail::max_index(idx.data(), idx.size());
+    if (max >= dst.size()) {
+        return Err(OutOfBounds{max, dst.size()});
+    }
+
+    const V* in = values.data();
+    const uint32_t* ix = idx.data();
+    V* out = dst.data();
+    const std::size_t n = idx.size();
+    std::size_t i = 0;
+#if CRAB_SIMD_X86
+    if constexpr (detail::is_simd_word_v<V>) {
+        if (max <= static_cast<uint32_t>(INT32_MAX) && simd::active_level() >= simd::Level::Avx512) {
+            i = detail::scatter_avx512<sizeof(V)>(in, ix, out, n);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[ix[i]] = in[i];
+    }
+    return Ok();
+}
+
+// ============================================================================
+// Stream Compaction
+// ============================================================================
+
+/// select_by_mask() failure: mask/src length mismatch, or out too short
+using SelectError = std::variant<OutOfBounds, CapacityExceeded>;
+
+/**
+ * @brief Copy src[i] to the front of out for every i with mask[i] != 0.
+ *
+ * The kept count is computed first, so a short output fails before
+ * anything is written. Elements of out past the returned count are
+ * left untouched.
+ *
+ * @param src Input elements
+ * @param mask One byte per element (nonzero = keep)
+ * @param out Destination for the kept elements, in order
+ * @return Number of elements written; Err(OutOfBounds) if mask and src
+ *         differ in length, or Err(CapacityExceeded) if out is shorter
+ *         than the kept count (as compact_if() reports it)
+ */
+template<typename T, typename U>
+Result<std::size_t, SelectError> select_by_mask(Slice<T> src, Slice<const uint8_t> mask, Slice<U> out) noexcept {
+    using V = std::remove_const_t<T>;
+    static_assert(std::is_same_v<V, U>, "select_by_mask() requires matching element types and a mutable output");
+    if (mask.size() != src.size()) {
+        return Err(OutOfBounds{mask.size(), src.size()});
+    }
+
+    const std::size_t n = src.size();
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += mask.unchecked(i) != 0;
+    }
+    if (total > out.size()) {
+        return Err(CapacityExceeded{total, out.size()});
+    }
+
+    const V* in = src.data();
+    const uint8_t* keep = mask.data();
+    V* dst = out.data();
+    std::size_t i = 0;
+    std::size_t k = 0;
+#if CRAB_SIMD_X86
+    if constexpr (detail::is_simd_word_v<V>) {
+        const simd::Level level = simd::active_level();
+        if (level >= simd::Level::Avx512) {
+            i = detail::select_avx512<sizeof(V)>(in, keep, dst, n, k);
+        } else if (level >= simd::Level::Avx2) {
+            i = detail::select_avx2<sizeof(V)>(in, keep, dst, n, total, k);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (keep[i] != 0) {
+            dst[k++] = in[i];
+        }
+    }
+    return Ok(k);
+}
+
+/**
+ * @brief Copy the elements of src matching pred to the front of out.
+ *
+ * Branch-free: every element is written to out[k] and k advances only on
+ * a match, so unpredictable predicates cost no mispredictions. As a
+ * result, out[count] (when it exists) may be overwritten with a rejected
+ * element; the rest of out past the count is untouched.
+ *
+ * @return Number of matches written, or Err if more than out.size()
+ *         elements match (out then holds the first out.size() matches)
+ */
+template<typename T, typename U, typename Pred>
+Result<std::size_t, CapacityExceeded> compact_if(Slice<T> src, Slice<U> out, Pred pred) noexcept {
+    using V = std::remove_const_t<T>;
+    static_assert(std::is_same_v<V, U>, "compact_if() requires matching element types and a mutable output");
+    const std::size_t n = src.size();
+    const std::size_t cap = out.size();
+    const V* in = src.data();
+    V* dst = out.data();
+
+    std::size_t i = 0;
+    std::size_t k = 0;
+    for (; i < n && k < cap; ++i) {
+        dst[k] = in[i];
+        k += static_cast<bool>(pred(in[i])) ? 1 : 0;
+    }
+    if (i < n) {
+        std::size_t overflow = 0;
+        for (; i < n; ++i) {
+            overflow += static_cast<bool>(pred(in[i])) ? 1 : 0;
+        }
+        if (overflow != 0) {
+            return Err(CapacityExceeded{k + overflow, cap});
+        }
+    }
+    return Ok(k);
+}
+
+} // namespace crab
@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * @file hash.h
+ * @brief Non-cryptographic hashing shared by sketches and hash tables.
+ *
+ * Results are identical on every platform (input words are read
+ * little-endian), so hashes may be persisted or compared across machines.
+ * Not resistant to adversarial keys.
+ */
+
+#include "crab/slice.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crab {
+
+namespace detail {
+
+/// MurmurHash3 finalizer: spreads sequential IDs over all 64 bits
+constexpr uint64_t mix64(uint64_t x) noexcept {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// Compilers fold this into a single load on little-endian targets
+inline uint64_t load_le(const uint8_t* p, std::size_t n) noexcept {
+    uint64_t w = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        w |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return w;
+}
+
+/**
+ * @brief 64-bit hash of a byte string, eight bytes per step.
+ *
+ * Each word is folded in with a multiply and xor-shift; mix64 finishes.
+ * The length seeds the state so "a" and "a\0" differ.
+ */
+inline uint64_t hash_bytes(ConstByteSlice key, uint64_t seed = 0) noexcept {
+    constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    const uint8_t* p = key.data();
+    std::size_t n = key.size();
+    uint64_t h = seed ^ (static_cast<uint64_t>(n) * kMul);
+    for (; n >= 8; p += 8, n -= 8) {
+        h = (h ^ load_le(p, 8)) * kMul;
+        h ^= h >> 32;
+    }
+    if (n != 0) {
+        h = (h ^ load_le(p, n)) * kMul;
+        h ^= h >> 32;
+    }
+    return mix64(h);
+}
+
+} // namespace detail
+
+} // namespace crab
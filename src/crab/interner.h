@@ -0,0 +1,214 @@
+#pragma once
+
+/**
+ * @file interner.h
+ * @brief Heap-free string interner: byte strings to dense 32-bit IDs.
+ *
+ * Each distinct string is copied once into an inline arena and assigned
+ * the next ID (0, 1, 2, ...). After that, equality is an integer compare,
+ * maps can key on 4 bytes, and resolve(id) hands the bytes back as a
+ * ConstByteSlice that stays valid for the interner's lifetime.
+ *
+ * ## Concurrency
+ *
+ * One writer, any number of readers. intern() must be serialized (a
+ * single thread, or a crab::Mutex around it). find(), resolve() and
+ * size() are lock-free and wait-free, and are safe to call while intern()
+ * runs. A string becomes visible to readers only after its bytes and
+ * entry are fully written (release/acquire on the index slot and count).
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/hash.h"
+#include "crab/error_types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace crab {
+
+/**
+ * @brief Fixed-capacity string interner with stable dense IDs.
+ *
+ * The index is open-addressed with linear probing over 2 * MaxStrings
+ * slots (rounded to a power of two). Each 8-byte slot packs the upper 32
+ * hash bits with id + 1, so a probe compares arena bytes only on a
+ * 32-bit hash match.
+ *
+ * @tparam ArenaBytes Total bytes of string data
+ * @tparam MaxStrings Maximum number of distinct strings
+ *
+ * @code{cpp}
+ *   static crab::StringInterner<64 * 1024, 4096> topics;
+ *   uint32_t id = topics.intern(name).unwrap();     // writer thread
+ *   crab::ConstByteSlice bytes = topics.resolve(id);  // any thread
+ * @endcode
+ */
+template<std::size_t ArenaBytes, std::size_t MaxStrings>
+class StringInterner {
+    static_assert(ArenaBytes > 0 && ArenaBytes <= UINT32_MAX, "StringInterner arena size must fit in 32 bits");
+    static_assert(MaxStrings > 0 && MaxStrings < UINT32_MAX / 2, "StringInterner string count must fit in 31 bits");
+
+public:
+    using id_type = uint32_t;
+    using size_type = std::size_t;
+
+    StringInterner() noexcept {
+        for (auto& slot : m_slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+    }
+
+    // Non-copyable, non-movable (readers may hold slices into the arena)
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+    StringInterner(StringInterner&&) = delete;
+    StringInterner& operator=(StringInterner&&) = delete;
+
+    // ========================================================================
+    // Writer
+    // ========================================================================
+
+    /**
+     * @brief ID of s, adding it first if it is new.
+     * @return Err(CapacityExceeded) if the arena or the ID space is full
+     * @note Single writer: serialize calls externally.
+     */
+    Result<id_type, CapacityExceeded> intern(ConstByteSlice s) noexcept {
+        const uint64_t h = detail::hash_bytes(s);
+        std::size_t slot = 0;
+        const uint32_t found = probe(s, h, slot);
+        if (found != kNil) {
+            return Ok(found);
+        }
+        const uint32_t id = m_count.load(std::memory_order_relaxed);
+        if (id >= MaxStrings) {
+            return Err(CapacityExceeded{std::size_t{id} + 1, MaxStrings});
+        }
+        if (s.size() > ArenaBytes - m_arena_used) {
+            return Err(CapacityExceeded{m_arena_used + s.size(), ArenaBytes});
+        }
+        if (s.size() != 0) {
+            std::memcpy(m_arena + m_arena_used, s.data(), s.size());
+        }
+        m_entries[id] = Entry{static_cast<uint32_t>(m_arena_used), static_cast<uint32_t>(s.size())};
+        m_arena_used += s.size();
+        // Publish: the slot makes the string findable, the count resolvable
+        m_slots[slot].store(pack(h, id), std::memory_order_release);
+        m_count.store(id + 1, std::memory_order_release);
+        return Ok(id);
+    }
+
+    // ========================================================================
+    // Readers (lock-free)
+    // ========================================================================
+
+    /**
+     * @brief ID of s if it has been interned, without adding it.
+     */
+    [[nodiscard]] Option<id_type> find(ConstByteSlice s) const noexcept {
+        std::size_t slot = 0;
+        const uint32_t found = probe(s, detail::hash_bytes(s), slot);
+        if (found == kNil) {
+            return None;
+        }
+        return Some(found);
+    }
+
+    /**
+     * @brief Bytes of an interned string (asserts id < size()).
+     */
+    [[nodiscard]] ConstByteSlice resolve(id_type id) const noexcept {
+        CRAB_ASSERT(id < m_count.load(std::memory_order_acquire), "StringInterner id not interned");
+        const Entry& e = m_entries[id];
+        return ConstByteSlice(m_arena + e.offset, e.len);
+    }
+
+    /**
+     * @brief Bytes of an interned string, or Err(OutOfBounds) for an unknown id.
+     */
+    [[nodiscard]] Result<ConstByteSlice, OutOfBounds> get(id_type id) const noexcept {
+        const uint32_t count = m_count.load(std::memory_order_acquire);
+        if (id >= count) {
+            return Err(OutOfBounds{id, count});
+        }
+        const Entry& e = m_entries[id];
+        return Ok(ConstByteSlice(m_arena + e.offset, e.len));
+    }
+
+    // ========================================================================
+    // Size & Capacity
+    // ========================================================================
+
+    /// Strings interned so far (IDs are [0, size()))
+    [[nodiscard]] size_type size() const noexcept { return m_count.load(std::memory_order_acquire); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return MaxStrings; }
+    [[nodiscard]] static constexpr size_type arena_capacity() noexcept { return ArenaBytes; }
+
+    /// Arena bytes in use (writer thread only)
+    [[nodiscard]] size_type arena_used() const noexcept { return m_arena_used; }
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+
+    static constexpr std::size_t slot_count() noexcept {
+        std::size_t p = 1;
+        while (p < MaxStrings * 2) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static constexpr std::size_t kSlots = slot_count();
+    static constexpr std::size_t kMask = kSlots - 1;
+
+    struct Entry {
+        uint32_t offset;
+        uint32_t len;
+    };
+
+    // High hash bits | id + 1 (0 marks an empty slot)
+    static uint64_t pack(uint64_t hash, uint32_t id) noexcept {
+        return (hash & 0xFFFFFFFF00000000ull) | (uint64_t{id} + 1);
+    }
+
+    /**
+     * Walk the probe sequence for s. Returns its id, or kNil with `slot`
+     * set to the empty slot where it would go. Entries are never removed,
+     * so the first empty slot ends the search.
+     */
+    uint32_t probe(ConstByteSlice s, uint64_t hash, std::size_t& slot) const noexcept {
+        const uint64_t tag = hash & 0xFFFFFFFF00000000ull;
+        std::size_t i = static_cast<std::size_t>(hash) & kMask;
+        for (;; i = (i + 1) & kMask) {
+            const uint64_t v = m_slots[i].load(std::memory_order_acquire);
+            if (v == 0) {
+                slot = i;
+                return kNil;
+            }
+            if ((v & 0xFFFFFFFF00000000ull) != tag) {
+                continue;
+            }
+            const uint32_t id = static_cast<uint32_t>(v) - 1;
+            const Entry& e = m_entries[id];
+            if (e.len == s.size() && (e.len == 0 || std::memcmp(m_arena + e.offset, s.data(), e.len) == 0)) {
+                return id;
+            }
+        }
+    }
+
+    std::atomic<uint64_t> m_slots[kSlots];
+    Entry m_entries[MaxStrings];
+    alignas(CRAB_CACHE_LINE_SIZE) std::atomic<uint32_t> m_count;
+    std::size_t m_arena_used = 0;
+    uint8_t m_arena[ArenaBytes];
+};
+
+} // namespace crab
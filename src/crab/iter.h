@@ -0,0 +1,563 @@
+#pragma once
+
+/**
+ * @file iter.h
+ * @brief Lazy, fusable iterator adapters over Slice and StaticVector.
+ *
+ * Pipelines are built from small value types and driven by the terminal
+ * operation (push-based), so filter -> map -> fold inlines into a single
+ * loop over the source with no intermediate buffers.
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/static_vector.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace crab {
+
+template<typename Stage>
+class Iter;
+
+namespace detail {
+
+/**
+ * @brief Marker error type for pipelines without try_map().
+ */
+struct NoIterError {};
+
+// ============================================================================
+// Sources
+// ============================================================================
+//
+// Every stage provides:
+//   item_type           type passed to the sink
+//   for_each(sink)      calls sink(item) for every item (no early exit, so
+//                       the source loop stays vectorizable)
+//   try_for_each(sink)  stops as soon as sink returns false; returns false
+//                       if stopped early
+//   error()             pointer to a captured try_map() error, or nullptr
+
+template<typename T>
+struct SliceSource {
+    using item_type = T&;
+    using error_type = NoIterError;
+
+    T* data;
+    std::size_t size;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        for (std::size_t i = 0; i < size; ++i) {
+            sink(data[i]);
+        }
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!sink(data[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const error_type* error() const noexcept { return nullptr; }
+};
+
+template<typename A, typename B>
+struct ZipSource {
+    using item_type = std::pair<A&, B&>;
+    using error_type = NoIterError;
+
+    A* a;
+    B* b;
+    std::size_t size;   // min of both lengths
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        for (std::size_t i = 0; i < size; ++i) {
+            sink(std::pair<A&, B&>(a[i], b[i]));
+        }
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!sink(std::pair<A&, B&>(a[i], b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const error_type* error() const noexcept { return nullptr; }
+};
+
+template<typename T>
+struct ChunksSource {
+    using item_type = Slice<T>;
+    using error_type = NoIterError;
+
+    T* data;
+    std::size_t size;
+    std::size_t chunk;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        for (std::size_t i = 0; i < size; i += chunk) {
+            const std::size_t n = (size - i < chunk) ? size - i : chunk;
+            sink(Slice<T>(data + i, n));
+        }
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        for (std::size_t i = 0; i < size; i += chunk) {
+            const std::size_t n = (size - i < chunk) ? size - i : chunk;
+            if (!sink(Slice<T>(data + i, n))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const error_type* error() const noexcept { return nullptr; }
+};
+
+template<typename T>
+struct WindowsSource {
+    using item_type = Slice<T>;
+    using error_type = NoIterError;
+
+    T* data;
+    std::size_t size;
+    std::size_t width;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        for (std::size_t i = 0; i + width <= size; ++i) {
+            sink(Slice<T>(data + i, width));
+        }
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        for (std::size_t i = 0; i + width <= size; ++i) {
+            if (!sink(Slice<T>(data + i, width))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const error_type* error() const noexcept { return nullptr; }
+};
+
+// ============================================================================
+// Adapters
+// ============================================================================
+
+template<typename Up, typename F>
+struct MapStage {
+    using item_type = std::invoke_result_t<F&, typename Up::item_type>;
+    using error_type = typename Up::error_type;
+
+    Up up;
+    F fn;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        auto inner = [&](auto&& item) { sink(fn(std::forward<decltype(item)>(item))); };
+        up.for_each(inner);
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        auto inner = [&](auto&& item) { return sink(fn(std::forward<decltype(item)>(item))); };
+        return up.try_for_each(inner);
+    }
+
+    const error_type* error() const noexcept { return up.error(); }
+};
+
+template<typename Up, typename P>
+struct FilterStage {
+    using item_type = typename Up::item_type;
+    using error_type = typename Up::error_type;
+
+    Up up;
+    P pred;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        auto inner = [&](auto&& item) {
+            if (pred(item)) {
+                sink(std::forward<decltype(item)>(item));
+            }
+        };
+        up.for_each(inner);
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        auto inner = [&](auto&& item) {
+            if (pred(item)) {
+                return static_cast<bool>(sink(std::forward<decltype(item)>(item)));
+            }
+            return true;
+        };
+        return up.try_for_each(inner);
+    }
+
+    const error_type* error() const noexcept { return up.error(); }
+};
+
+template<typename Up>
+struct EnumerateStage {
+    using item_type = std::pair<std::size_t, typename Up::item_type>;
+    using error_type = typename Up::error_type;
+
+    Up up;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        std::size_t index = 0;
+        auto inner = [&](auto&& item) {
+            sink(item_type(index++, std::forward<decltype(item)>(item)));
+        };
+        up.for_each(inner);
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        std::size_t index = 0;
+        auto inner = [&](auto&& item) {
+            return sink(item_type(index++, std::forward<decltype(item)>(item)));
+        };
+        return up.try_for_each(inner);
+    }
+
+    const error_type* error() const noexcept { return up.error(); }
+};
+
+template<typename Up>
+struct TakeStage {
+    using item_type = typename Up::item_type;
+    using error_type = typename Up::error_type;
+
+    Up up;
+    std::size_t count;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        if (count == 0) {
+            return;
+        }
+        std::size_t left = count;
+        auto inner = [&](auto&& item) {
+            sink(std::forward<decltype(item)>(item));
+            return --left != 0;
+        };
+        (void)up.try_for_each(inner);
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        if (count == 0) {
+            return true;
+        }
+        std::size_t left = count;
+        bool stopped = false;
+        auto inner = [&](auto&& item) {
+            if (!sink(std::forward<decltype(item)>(item))) {
+                stopped = true;
+                return false;
+            }
+            return --left != 0;
+        };
+        (void)up.try_for_each(inner);
+        return !stopped;
+    }
+
+    const error_type* error() const noexcept { return up.error(); }
+};
+
+template<typename Up, typename F, typename E>
+struct TryMapStage {
+    static_assert(std::is_same_v<typename Up::error_type, NoIterError>,
+        "Only one try_map() per pipeline is supported");
+    using item_type = typename std::invoke_result_t<F&, typename Up::item_type>::value_type;
+    using error_type = E;
+
+    Up up;
+    F fn;
+    Option<E> err;
+
+    template<typename Sink>
+    void for_each(Sink& sink) {
+        auto inner = [&](auto&& item) {
+            auto result = fn(std::forward<decltype(item)>(item));
+            if (result.is_err()) {
+                err = Some(std::move(result).unwrap_err());
+                return false;
+            }
+            sink(std::move(result).unwrap());
+            return true;
+        };
+        (void)up.try_for_each(inner);
+    }
+
+    template<typename Sink>
+    bool try_for_each(Sink& sink) {
+        auto inner = [&](auto&& item) {
+            auto result = fn(std::forward<decltype(item)>(item));
+            if (result.is_err()) {
+                err = Some(std::move(result).unwrap_err());
+                return false;
+            }
+            return static_cast<bool>(sink(std::move(result).unwrap()));
+        };
+        return up.try_for_each(inner) && err.is_none();
+    }
+
+    const error_type* error() const noexcept { return err.as_ptr(); }
+};
+
+template<typename S>
+inline constexpr bool is_fallible_v =
+    !std::is_same_v<typename S::error_type, NoIterError>;
+
+} // namespace detail
+
+/**
+ * @brief Lazy pipeline over a Slice-like source.
+ *
+ * Adapters return a new Iter by value and do no work; the terminal
+ * operation (fold, for_each, collect_into) drives the whole chain in a
+ * single loop. Without try_map() or take(), that loop has no early exit
+ * and vectorizes like the hand-written equivalent.
+ *
+ * If the pipeline contains try_map(), terminals stop at the first Err and
+ * wrap their usual return type in Result<_, E>.
+ *
+ * @code{cpp}
+ *   int total = crab::iter(samples)
+ *       .filter([](int v) { return v > 0; })
+ *       .map([](int v) { return v * 2; })
+ *       .fold(0, [](int acc, int v) { return acc + v; });
+ *
+ *   float dot = crab::zip(a, b).fold(0.0f, [](float acc, auto p) {
+ *       return acc + p.first * p.second;
+ *   });
+ * @endcode
+ */
+template<typename Stage>
+class Iter {
+public:
+    using error_type = typename Stage::error_type;
+
+    explicit Iter(Stage stage) noexcept(std::is_nothrow_move_constructible_v<Stage>)
+        : m_stage(std::move(stage)) {}
+
+    // ========================================================================
+    // Adapters (lazy)
+    // ========================================================================
+
+    /**
+     * @brief Transform each item with fn.
+     */
+    template<typename F>
+    [[nodiscard]] auto map(F fn) const {
+        using S = detail::MapStage<Stage, F>;
+        return Iter<S>(S{m_stage, std::move(fn)});
+    }
+
+    /**
+     * @brief Keep only items for which pred returns true.
+     */
+    template<typename P>
+    [[nodiscard]] auto filter(P pred) const {
+        using S = detail::FilterStage<Stage, P>;
+        return Iter<S>(S{m_stage, std::move(pred)});
+    }
+
+    /**
+     * @brief Pair each item with its position: std::pair<size_t, Item>.
+     */
+    [[nodiscard]] auto enumerate() const {
+        using S = detail::EnumerateStage<Stage>;
+        return Iter<S>(S{m_stage});
+    }
+
+    /**
+     * @brief Stop after the first n items.
+     */
+    [[nodiscard]] auto take(std::size_t n) const {
+        using S = detail::TakeStage<Stage>;
+        return Iter<S>(S{m_stage, n});
+    }
+
+    /**
+     * @brief Transform with a fallible fn returning Result<U, E>.
+     *
+     * Iteration stops at the first Err, which the terminal returns.
+     */
+    template<typename F>
+    [[nodiscard]] auto try_map(F fn) const {
+        using E = typename std::invoke_result_t<F&, typename Stage::item_type>::error_type;
+        using S = detail::TryMapStage<Stage, F, E>;
+        return Iter<S>(S{m_stage, std::move(fn), None});
+    }
+
+    // ========================================================================
+    // Terminals
+    // ========================================================================
+
+    /**
+     * @brief Reduce all items into an accumulator: acc = fn(acc, item).
+     * @return Final accumulator (Result<Acc, E> if the pipeline is fallible)
+     */
+    template<typename Acc, typename F>
+    [[nodiscard]] auto fold(Acc init, F fn) {
+        auto sink = [&](auto&& item) {
+            init = fn(std::move(init), std::forward<decltype(item)>(item));
+        };
+        m_stage.for_each(sink);
+        if constexpr (detail::is_fallible_v<Stage>) {
+            if (const error_type* e = m_stage.error()) {
+                return Result<Acc, error_type>(Err(*e));
+            }
+            return Result<Acc, error_type>(Ok(std::move(init)));
+        } else {
+            return init;
+        }
+    }
+
+    /**
+     * @brief Call fn for each item.
+     * @return Unit (Result<Unit, E> if the pipeline is fallible)
+     */
+    template<typename F>
+    auto for_each(F fn) {
+        auto sink = [&](auto&& item) { fn(std::forward<decltype(item)>(item)); };
+        m_stage.for_each(sink);
+        if constexpr (detail::is_fallible_v<Stage>) {
+            if (const error_type* e = m_stage.error()) {
+                return Result<Unit, error_type>(Err(*e));
+            }
+            return Result<Unit, error_type>(Ok());
+        } else {
+            return Unit{};
+        }
+    }
+
+    /**
+     * @brief Count the items produced by the pipeline.
+     */
+    [[nodiscard]] auto count() {
+        return fold(std::size_t{0}, [](std::size_t n, auto&&) { return n + 1; });
+    }
+
+    /**
+     * @brief Append every item to a StaticVector.
+     *
+     * Stops at the first item that does not fit; items pushed so far stay
+     * in the vector.
+     *
+     * @return Number of items appended, or CapacityExceeded.
+     *         Fallible pipelines return Result<Result<size_t, CapacityExceeded>, E>.
+     */
+    template<typename T, std::size_t N, std::size_t A>
+    [[nodiscard]] auto collect_into(StaticVector<T, N, A>& out) {
+        std::size_t pushed = 0;
+        bool overflow = false;
+        auto sink = [&](auto&& item) {
+            if (out.is_full()) {
+                overflow = true;
+                return false;
+            }
+            out.emplace_back(std::forward<decltype(item)>(item));
+            ++pushed;
+            return true;
+        };
+        (void)m_stage.try_for_each(sink);
+
+        using Collected = Result<std::size_t, CapacityExceeded>;
+        Collected collected = overflow
+            ? Collected(Err(CapacityExceeded{out.size() + 1, N}))
+            : Collected(Ok(pushed));
+        if constexpr (detail::is_fallible_v<Stage>) {
+            if (const error_type* e = m_stage.error()) {
+                return Result<Collected, error_type>(Err(*e));
+            }
+            return Result<Collected, error_type>(Ok(std::move(collected)));
+        } else {
+            return collected;
+        }
+    }
+
+private:
+    Stage m_stage;
+};
+
+// ============================================================================
+// Entry Points
+// ============================================================================
+
+/**
+ * @brief Start a pipeline over a Slice (items are T&).
+ */
+template<typename T>
+[[nodiscard]] Iter<detail::SliceSource<T>> iter(Slice<T> s) noexcept {
+    return Iter<detail::SliceSource<T>>({s.data(), s.size()});
+}
+
+/**
+ * @brief Start a pipeline over an lvalue container (StaticVector, array, ...).
+ */
+template<typename Container,
+         typename T = std::remove_pointer_t<decltype(std::declval<Container&>().data())>>
+[[nodiscard]] Iter<detail::SliceSource<T>> iter(Container& c) noexcept {
+    return Iter<detail::SliceSource<T>>({c.data(), c.size()});
+}
+
+/**
+ * @brief Walk two slices in lockstep (items are std::pair<A&, B&>).
+ *
+ * Length is the shorter of the two; no per-element bounds checks.
+ */
+template<typename A, typename B>
+[[nodiscard]] Iter<detail::ZipSource<A, B>> zip(Slice<A> a, Slice<B> b) noexcept {
+    const std::size_t n = a.size() < b.size() ? a.size() : b.size();
+    return Iter<detail::ZipSource<A, B>>({a.data(), b.data(), n});
+}
+
+/**
+ * @brief Non-overlapping chunks of n elements (the last may be shorter).
+ * @note Panics if n == 0.
+ */
+template<typename T>
+[[nodiscard]] Iter<detail::ChunksSource<T>> chunks(Slice<T> s, std::size_t n) noexcept {
+    CRAB_ASSERT(n > 0, "chunks() size must be non-zero");
+    return Iter<detail::ChunksSource<T>>({s.data(), s.size(), n});
+}
+
+/**
+ * @brief Overlapping windows of n consecutive elements.
+ * @note Panics if n == 0. Yields nothing if n > s.size().
+ */
+template<typename T>
+[[nodiscard]] Iter<detail::WindowsSource<T>> windows(Slice<T> s, std::size_t n) noexcept {
+    CRAB_ASSERT(n > 0, "windows() size must be non-zero");
+    return Iter<detail::WindowsSource<T>>({s.data(), s.size(), n});
+}
+
+} // namespace crab
@@ -11,6 +11,7 @@
  * 
  * - `CRAB_CUSTOM_PANIC`: Define before including to use custom panic handler
  * - `CRAB_CACHE_LINE_SIZE`: Define to override default cache line (32 or 64)
+ * - `CRAB_HAS_POSIX_IO`: Define to 0 to disable readv/writev helpers
  */
 
 // ============================================================================
@@ -31,6 +32,21 @@
     #endif
 #endif
 
+/**
+ * @brief POSIX scatter/gather IO availability (readv/writev).
+ * 
+ * Enables file-descriptor helpers such as StaticRingBuffer::fill_from_fd().
+ * Define CRAB_HAS_POSIX_IO to 0 before including CrabLib to disable on
+ * hosted targets; defaults to 0 on bare-metal.
+ */
+#ifndef CRAB_HAS_POSIX_IO
+    #if defined(__unix__) || defined(__APPLE__)
+        #define CRAB_HAS_POSIX_IO 1
+    #else
+        #define CRAB_HAS_POSIX_IO 0
+    #endif
+#endif
+
 // ============================================================================
 // Panic Handler
 // ============================================================================
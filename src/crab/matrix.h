@@ -0,0 +1,729 @@
+#pragma once
+
+/**
+ * @file matrix.h
+ * @brief Small fixed-size matrices and vectors (3x3, 4x4, 6x6 control math).
+ *
+ * StaticVec<T, N> and StaticMatrix<T, R, C> keep their elements inline: no
+ * heap, dimensions checked at compile time. Rows are padded to a multiple of
+ * 16 bytes and the padding is kept at zero, so every row loop runs over a
+ * fixed, SIMD-friendly trip count. Compilers vectorize these loops without
+ * tail handling: a 3x3 float multiply becomes three 4-lane row updates.
+ *
+ * Arithmetic, transpose and determinant are constexpr. Operations that can
+ * fail (inverse, Cholesky) return Result and run at runtime, because
+ * Result is not a literal type.
+ *
+ * Views interoperate with the rest of CrabLib:
+ * - StaticVec::as_slice() -> Slice<T> of exactly N elements
+ * - StaticMatrix::row(r) -> Slice<T> of exactly C elements
+ * - StaticMatrix::view() -> Slice2D<T> with the padded pitch
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/slice2d.h"
+#include "crab/error_types.h"
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace crab {
+
+namespace detail {
+
+/**
+ * @brief Elements per row after padding to a 16-byte multiple.
+ */
+template<typename T>
+constexpr std::size_t padded_width(std::size_t n) noexcept {
+    constexpr std::size_t lanes = sizeof(T) < 16 ? 16 / sizeof(T) : 1;
+    return (n + lanes - 1) / lanes * lanes;
+}
+
+template<typename T>
+constexpr std::size_t kMatrixAlign = alignof(T) > 16 ? alignof(T) : 16;
+
+template<typename T>
+constexpr T abs_value(T x) noexcept {
+    return x < T(0) ? -x : x;
+}
+
+} // namespace detail
+
+template<typename T, std::size_t R, std::size_t C>
+class StaticMatrix;
+
+// ============================================================================
+// StaticVec
+// ============================================================================
+
+/**
+ * @brief Fixed-size column vector with padded, zero-filled storage.
+ *
+ * @tparam T Arithmetic element type
+ * @tparam N Dimension
+ *
+ * @code{cpp}
+ *   constexpr crab::StaticVec<float, 3> v(1.0f, 2.0f, 3.0f);
+ *   static_assert(v.dot(v) == 14.0f);
+ * @endcode
+ */
+template<typename T, std::size_t N>
+class StaticVec {
+    static_assert(std::is_arithmetic_v<T>, "StaticVec needs an arithmetic element type");
+    static_assert(N > 0, "StaticVec dimension must be non-zero");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// Storage length including zero padding
+    static constexpr size_type kPadded = detail::padded_width<T>(N);
+
+    /**
+     * @brief Zero vector.
+     */
+    constexpr StaticVec() noexcept : m_data{} {}
+
+    /**
+     * @brief Construct from exactly N values.
+     */
+    template<typename... Args,
+             typename = std::enable_if_t<sizeof...(Args) == N &&
+                                         (std::is_convertible_v<Args, T> && ...)>>
+    constexpr explicit StaticVec(Args... args) noexcept : m_data{static_cast<T>(args)...} {}
+
+    /**
+     * @brief Vector with every element set to value.
+     */
+    [[nodiscard]] static constexpr StaticVec filled(T value) noexcept {
+        StaticVec v;
+        for (size_type i = 0; i < N; ++i) {
+            v.m_data[i] = value;
+        }
+        return v;
+    }
+
+    /**
+     * @brief Copy from a Slice of exactly N elements.
+     * @return Err(OutOfBounds{src.size(), N}) on a length mismatch
+     */
+    [[nodiscard]] static Result<StaticVec, OutOfBounds> from_slice(Slice<const T> src) noexcept {
+        if (src.size() != N) {
+            return Err(OutOfBounds{src.size(), N});
+        }
+        StaticVec v;
+        for (size_type i = 0; i < N; ++i) {
+            v.m_data[i] = src.data()[i];
+        }
+        return Ok(v);
+    }
+
+    // ========================================================================
+    // Element Access
+    // ========================================================================
+
+    [[nodiscard]] static constexpr size_type size() noexcept { return N; }
+
+    [[nodiscard]] constexpr T& operator[](size_type i) noexcept {
+        CRAB_ASSERT(i < N, "StaticVec index out of bounds");
+        return m_data[i];
+    }
+
+    [[nodiscard]] constexpr const T& operator[](size_type i) const noexcept {
+        CRAB_ASSERT(i < N, "StaticVec index out of bounds");
+        return m_data[i];
+    }
+
+    /**
+     * @brief Checked element access.
+     */
+    [[nodiscard]] Result<std::reference_wrapper<T>, OutOfBounds> get(size_type i) noexcept {
+        if (i >= N) {
+            return Err(OutOfBounds{i, N});
+        }
+        return Ok(std::ref(m_data[i]));
+    }
+
+    [[nodiscard]] Result<std::reference_wrapper<const T>, OutOfBounds> get(size_type i) const noexcept {
+        if (i >= N) {
+            return Err(OutOfBounds{i, N});
+        }
+        return Ok(std::cref(m_data[i]));
+    }
+
+    [[nodiscard]] constexpr T* data() noexcept { return m_data; }
+    [[nodiscard]] constexpr const T* data() const noexcept { return m_data; }
+
+    /**
+     * @brief The N elements as a Slice (padding is not exposed).
+     */
+    [[nodiscard]] Slice<T> as_slice() noexcept { return Slice<T>(m_data, N); }
+    [[nodiscard]] Slice<const T> as_slice() const noexcept { return Slice<const T>(m_data, N); }
+
+    // ========================================================================
+    // Arithmetic
+    // ========================================================================
+
+    constexpr StaticVec& operator+=(const StaticVec& o) noexcept {
+        for (size_type i = 0; i < kPadded; ++i) {
+            m_data[i] += o.m_data[i];
+        }
+        return *this;
+    }
+
+    constexpr StaticVec& operator-=(const StaticVec& o) noexcept {
+        for (size_type i = 0; i < kPadded; ++i) {
+            m_data[i] -= o.m_data[i];
+        }
+        return *this;
+    }
+
+    constexpr StaticVec& operator*=(T s) noexcept {
+        for (size_type i = 0; i < kPadded; ++i) {
+            m_data[i] *= s;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr StaticVec operator+(StaticVec a, const StaticVec& b) noexcept { return a += b; }
+    [[nodiscard]] friend constexpr StaticVec operator-(StaticVec a, const StaticVec& b) noexcept { return a -= b; }
+    [[nodiscard]] friend constexpr StaticVec operator*(StaticVec a, T s) noexcept { return a *= s; }
+    [[nodiscard]] friend constexpr StaticVec operator*(T s, StaticVec a) noexcept { return a *= s; }
+    [[nodiscard]] friend constexpr StaticVec operator-(StaticVec a) noexcept { return a *= T(-1); }
+
+    [[nodiscard]] friend constexpr bool operator==(const StaticVec& a, const StaticVec& b) noexcept {
+        for (size_type i = 0; i < N; ++i) {
+            if (!(a.m_data[i] == b.m_data[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    [[nodiscard]] friend constexpr bool operator!=(const StaticVec& a, const StaticVec& b) noexcept {
+        return !(a == b);
+    }
+
+    [[nodiscard]] constexpr T dot(const StaticVec& o) const noexcept {
+        T acc{};
+        for (size_type i = 0; i < kPadded; ++i) {
+            acc += m_data[i] * o.m_data[i];
+        }
+        return acc;
+    }
+
+    [[nodiscard]] constexpr T norm_squared() const noexcept { return dot(*this); }
+
+    /**
+     * @brief Euclidean length (not constexpr: uses std::sqrt).
+     */
+    [[nodiscard]] T norm() const noexcept { return std::sqrt(norm_squared()); }
+
+private:
+    template<typename, std::size_t, std::size_t>
+    friend class StaticMatrix;
+
+    alignas(detail::kMatrixAlign<T>) T m_data[kPadded];
+};
+
+/**
+ * @brief 3-D cross product.
+ */
+template<typename T>
+[[nodiscard]] constexpr StaticVec<T, 3> cross(const StaticVec<T, 3>& a, const StaticVec<T, 3>& b) noexcept {
+    return StaticVec<T, 3>(a[1] * b[2] - a[2] * b[1],
+                           a[2] * b[0] - a[0] * b[2],
+                           a[0] * b[1] - a[1] * b[0]);
+}
+
+// ============================================================================
+// StaticMatrix
+// ============================================================================
+
+/**
+ * @brief Fixed-size row-major matrix with padded, zero-filled rows.
+ *
+ * @tparam T Arithmetic element type
+ * @tparam R Rows
+ * @tparam C Columns
+ *
+ * @code{cpp}
+ *   constexpr auto a = crab::StaticMatrix<float, 2, 2>(1.0f, 2.0f,
+ *                                                      3.0f, 4.0f);
+ *   static_assert(a.transpose()(0, 1) == 3.0f);
+ *   auto inv = crab::inverse(a);            // Result<..., SingularMatrix>
+ * @endcode
+ */
+template<typename T, std::size_t R, std::size_t C>
+class StaticMatrix {
+    static_assert(std::is_arithmetic_v<T>, "StaticMatrix needs an arithmetic element type");
+    static_assert(R > 0 && C > 0, "StaticMatrix dimensions must be non-zero");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// Elements between the starts of consecutive rows
+    static constexpr size_type kPitch = detail::padded_width<T>(C);
+
+    /**
+     * @brief Zero matrix.
+     */
+    constexpr StaticMatrix() noexcept : m_data{} {}
+
+    /**
+     * @brief Construct from exactly R * C values in row-major order.
+     */
+    template<typename... Args,
+             typename = std::enable_if_t<sizeof...(Args) == R * C &&
+                                         (std::is_convertible_v<Args, T> && ...)>>
+    constexpr explicit StaticMatrix(Args... args) noexcept : m_data{} {
+        const T values[] = {static_cast<T>(args)...};
+        for (size_type i = 0; i < R * C; ++i) {
+            m_data[i / C * kPitch + i % C] = values[i];
+        }
+    }
+
+    /**
+     * @brief Identity (square matrices only).
+     */
+    [[nodiscard]] static constexpr StaticMatrix identity() noexcept {
+        static_assert(R == C, "identity() needs a square matrix");
+        StaticMatrix m;
+        for (size_type i = 0; i < R; ++i) {
+            m.m_data[i * kPitch + i] = T(1);
+        }
+        return m;
+    }
+
+    /**
+     * @brief Diagonal matrix from a vector (square matrices only).
+     */
+    [[nodiscard]] static constexpr StaticMatrix diagonal(const StaticVec<T, R>& d) noexcept {
+        static_assert(R == C, "diagonal() needs a square matrix");
+        StaticMatrix m;
+        for (size_type i = 0; i < R; ++i) {
+            m.m_data[i * kPitch + i] = d.m_data[i];
+        }
+        return m;
+    }
+
+    /**
+     * @brief Copy from an R x C view (any pitch).
+     * @return Err(OutOfBounds) naming the mismatched dimension
+     */
+    [[nodiscard]] static Result<StaticMatrix, OutOfBounds> from_view(Slice2D<const T> src) noexcept {
+        if (src.rows() != R) {
+            return Err(OutOfBounds{src.rows(), R});
+        }
+        if (src.cols() != C) {
+            return Err(OutOfBounds{src.cols(), C});
+        }
+        StaticMatrix m;
+        for (size_type r = 0; r < R; ++r) {
+            const T* row = src.row(r).data();
+            for (size_type c = 0; c < C; ++c) {
+                m.m_data[r * kPitch + c] = row[c];
+            }
+        }
+        return Ok(m);
+    }
+
+    // ========================================================================
+    // Element Access
+    // ========================================================================
+
+    [[nodiscard]] static constexpr size_type rows() noexcept { return R; }
+    [[nodiscard]] static constexpr size_type cols() noexcept { return C; }
+
+    [[nodiscard]] constexpr T& operator()(size_type r, size_type c) noexcept {
+        CRAB_ASSERT(r < R && c < C, "StaticMatrix index out of bounds");
+        return m_data[r * kPitch + c];
+    }
+
+    [[nodiscard]] constexpr const T& operator()(size_type r, size_type c) const noexcept {
+        CRAB_ASSERT(r < R && c < C, "StaticMatrix index out of bounds");
+        return m_data[r * kPitch + c];
+    }
+
+    /**
+     * @brief Checked element access.
+     */
+    [[nodiscard]] Result<std::reference_wrapper<T>, OutOfBounds> get(size_type r, size_type c) noexcept {
+        if (r >= R) {
+            return Err(OutOfBounds{r, R});
+        }
+        if (c >= C) {
+            return Err(OutOfBounds{c, C});
+        }
+        return Ok(std::ref(m_data[r * kPitch + c]));
+    }
+
+    [[nodiscard]] Result<std::reference_wrapper<const T>, OutOfBounds> get(size_type r, size_type c) const noexcept {
+        if (r >= R) {
+            return Err(OutOfBounds{r, R});
+        }
+        if (c >= C) {
+            return Err(OutOfBounds{c, C});
+        }
+        return Ok(std::cref(m_data[r * kPitch + c]));
+    }
+
+    /**
+     * @brief Row r as a Slice of exactly C elements.
+     */
+    [[nodiscard]] Slice<T> row(size_type r) noexcept {
+        CRAB_ASSERT(r < R, "StaticMatrix row out of bounds");
+        return Slice<T>(m_data + r * kPitch, C);
+    }
+
+    [[nodiscard]] Slice<const T> row(size_type r) const noexcept {
+        CRAB_ASSERT(r < R, "StaticMatrix row out of bounds");
+        return Slice<const T>(m_data + r * kPitch, C);
+    }
+
+    /**
+     * @brief The whole matrix as a Slice2D (pitch = kPitch).
+     */
+    [[nodiscard]] Slice2D<T> view() noexcept { return Slice2D<T>(m_data, R, C, kPitch); }
+    [[nodiscard]] Slice2D<const T> view() const noexcept { return Slice2D<const T>(m_data, R, C, kPitch); }
+
+    [[nodiscard]] constexpr T* data() noexcept { return m_data; }
+    [[nodiscard]] constexpr const T* data() const noexcept { return m_data; }
+
+    // ========================================================================
+    // Arithmetic
+    // ========================================================================
+
+    constexpr StaticMatrix& operator+=(const StaticMatrix& o) noexcept {
+        for (size_type i = 0; i < R * kPitch; ++i) {
+            m_data[i] += o.m_data[i];
+        }
+        return *this;
+    }
+
+    constexpr StaticMatrix& operator-=(const StaticMatrix& o) noexcept {
+        for (size_type i = 0; i < R * kPitch; ++i) {
+            m_data[i] -= o.m_data[i];
+        }
+        return *this;
+    }
+
+    constexpr StaticMatrix& operator*=(T s) noexcept {
+        for (size_type i = 0; i < R * kPitch; ++i) {
+            m_data[i] *= s;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr StaticMatrix operator+(StaticMatrix a, const StaticMatrix& b) noexcept { return a += b; }
+    [[nodiscard]] friend constexpr StaticMatrix operator-(StaticMatrix a, const StaticMatrix& b) noexcept { return a -= b; }
+    [[nodiscard]] friend constexpr StaticMatrix operator*(StaticMatrix a, T s) noexcept { return a *= s; }
+    [[nodiscard]] friend constexpr StaticMatrix operator*(T s, StaticMatrix a) noexcept { return a *= s; }
+    [[nodiscard]] friend constexpr StaticMatrix operator-(StaticMatrix a) noexcept { return a *= T(-1); }
+
+    [[nodiscard]] friend constexpr bool operator==(const StaticMatrix& a, const StaticMatrix& b) noexcept {
+        for (size_type r = 0; r < R; ++r) {
+            for (size_type c = 0; c < C; ++c) {
+                if (!(a.m_data[r * kPitch + c] == b.m_data[r * kPitch + c])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    [[nodiscard]] friend constexpr bool operator!=(const StaticMatrix& a, const StaticMatrix& b) noexcept {
+        return !(a == b);
+    }
+
+    /**
+     * @brief Matrix product. Each output row is a sum of scaled rows of b,
+     *        so the inner loop runs over b's padded pitch.
+     */
+    template<std::size_t K>
+    [[nodiscard]] friend constexpr StaticMatrix<T, R, K>
+    operator*(const StaticMatrix& a, const StaticMatrix<T, C, K>& b) noexcept {
+        using Out = StaticMatrix<T, R, K>;
+        Out out;
+        for (size_type r = 0; r < R; ++r) {
+            T* dst = out.data() + r * Out::kPitch;
+            for (size_type k = 0; k < C; ++k) {
+                const T s = a.m_data[r * kPitch + k];
+                const T* src = b.data() + k * Out::kPitch;
+                for (size_type c = 0; c < Out::kPitch; ++c) {
+                    dst[c] += s * src[c];
+                }
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Matrix-vector product.
+     */
+    [[nodiscard]] friend constexpr StaticVec<T, R>
+    operator*(const StaticMatrix& a, const StaticVec<T, C>& x) noexcept {
+        static_assert(StaticVec<T, C>::kPadded == kPitch, "row and vector padding must agree");
+        StaticVec<T, R> out;
+        const T* xd = x.data();
+        for (size_type r = 0; r < R; ++r) {
+            T acc{};
+            for (size_type c = 0; c < kPitch; ++c) {
+                acc += a.m_data[r * kPitch + c] * xd[c];
+            }
+            out[r] = acc;
+        }
+        return out;
+    }
+
+    [[nodiscard]] constexpr StaticMatrix<T, C, R> transpose() const noexcept {
+        StaticMatrix<T, C, R> out;
+        for (size_type r = 0; r < R; ++r) {
+            for (size_type c = 0; c < C; ++c) {
+                out.m_data[c * StaticMatrix<T, C, R>::kPitch + r] = m_data[r * kPitch + c];
+            }
+        }
+        return out;
+    }
+
+    [[nodiscard]] constexpr T trace() const noexcept {
+        static_assert(R == C, "trace() needs a square matrix");
+        T acc{};
+        for (size_type i = 0; i < R; ++i) {
+            acc += m_data[i * kPitch + i];
+        }
+        return acc;
+    }
+
+private:
+    template<typename, std::size_t, std::size_t>
+    friend class StaticMatrix;
+
+    alignas(detail::kMatrixAlign<T>) T m_data[R * kPitch];
+};
+
+// ============================================================================
+// Determinant, Inverse
+// ============================================================================
+
+namespace detail {
+
+/**
+ * @brief Gauss-Jordan elimination with partial pivoting: a -> I, inv -> a^-1.
+ *
+ * Pivots whose magnitude is at or below eps * N * max|a| count as zero.
+ * @return The failing column, or N on success
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t gauss_jordan(StaticMatrix<T, N, N>& a, StaticMatrix<T, N, N>& inv) noexcept {
+    T scale{};
+    for (std::size_t r = 0; r < N; ++r) {
+        for (std::size_t c = 0; c < N; ++c) {
+            const T v = abs_value(a(r, c));
+            scale = v > scale ? v : scale;
+        }
+    }
+    const T tiny = std::numeric_limits<T>::epsilon() * static_cast<T>(N) * scale;
+    T* ad = a.data();
+    T* id = inv.data();
+    constexpr std::size_t P = StaticMatrix<T, N, N>::kPitch;
+
+    for (std::size_t col = 0; col < N; ++col) {
+        std::size_t pivot = col;
+        for (std::size_t r = col + 1; r < N; ++r) {
+            if (abs_value(ad[r * P + col]) > abs_value(ad[pivot * P + col])) {
+                pivot = r;
+            }
+        }
+        if (!(abs_value(ad[pivot * P + col]) > tiny)) {
+            return col;
+        }
+        if (pivot != col) {
+            for (std::size_t c = 0; c < P; ++c) {
+                const T ta = ad[col * P + c];
+                ad[col * P + c] = ad[pivot * P + c];
+                ad[pivot * P + c] = ta;
+                const T ti = id[col * P + c];
+                id[col * P + c] = id[pivot * P + c];
+                id[pivot * P + c] = ti;
+            }
+        }
+        const T inv_p = T(1) / ad[col * P + col];
+        for (std::size_t c = 0; c < P; ++c) {
+            ad[col * P + c] *= inv_p;
+            id[col * P + c] *= inv_p;
+        }
+        for (std::size_t r = 0; r < N; ++r) {
+            const T f = ad[r * P + col];
+            if (r == col || f == T(0)) {
+                continue;
+            }
+            for (std::size_t c = 0; c < P; ++c) {
+                ad[r * P + c] -= f * ad[col * P + c];
+                id[r * P + c] -= f * id[col * P + c];
+            }
+        }
+    }
+    return N;
+}
+
+} // namespace detail
+
+/**
+ * @brief Determinant (closed form up to 3x3, partial-pivot elimination above).
+ */
+template<typename T, std::size_t N>
+[[nodiscard]] constexpr T determinant(const StaticMatrix<T, N, N>& m) noexcept {
+    if constexpr (N == 1) {
+        return m(0, 0);
+    } else if constexpr (N == 2) {
+        return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    } else if constexpr (N == 3) {
+        return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1))
+             - m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0))
+             + m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+    } else {
+        static_assert(std::is_floating_point_v<T>, "determinant() above 3x3 needs a floating-point type");
+        StaticMatrix<T, N, N> a = m;
+        T det = T(1);
+        for (std::size_t col = 0; col < N; ++col) {
+            std::size_t pivot = col;
+            for (std::size_t r = col + 1; r < N; ++r) {
+                if (detail::abs_value(a(r, col)) > detail::abs_value(a(pivot, col))) {
+                    pivot = r;
+                }
+            }
+            if (a(pivot, col) == T(0)) {
+                return T(0);
+            }
+            if (pivot != col) {
+                for (std::size_t c = 0; c < N; ++c) {
+                    const T t = a(col, c);
+                    a(col, c) = a(pivot, c);
+                    a(pivot, c) = t;
+                }
+                det = -det;
+            }
+            det *= a(col, col);
+            for (std::size_t r = col + 1; r < N; ++r) {
+                const T f = a(r, col) / a(col, col);
+                for (std::size_t c = col; c < N; ++c) {
+                    a(r, c) -= f * a(col, c);
+                }
+            }
+        }
+        return det;
+    }
+}
+
+/**
+ * @brief Inverse of a square matrix.
+ *
+ * @return Err(SingularMatrix{column}) if elimination finds no pivot larger
+ *         than eps * N * max|m| in that column
+ */
+template<typename T, std::size_t N>
+[[nodiscard]] Result<StaticMatrix<T, N, N>, SingularMatrix> inverse(const StaticMatrix<T, N, N>& m) noexcept {
+    static_assert(std::is_floating_point_v<T>, "inverse() needs a floating-point type");
+    StaticMatrix<T, N, N> a = m;
+    StaticMatrix<T, N, N> inv = StaticMatrix<T, N, N>::identity();
+    const std::size_t failed = detail::gauss_jordan(a, inv);
+    if (failed != N) {
+        return Err(SingularMatrix{failed});
+    }
+    return Ok(inv);
+}
+
+// ============================================================================
+// Cholesky
+// ============================================================================
+
+/**
+ * @brief Cholesky factor L (lower triangular, m = L * L^T).
+ *
+ * Only the lower triangle of m is read; m is assumed symmetric.
+ * @return Err(NotPositiveDefinite{column}) if a diagonal goes <= 0
+ */
+template<typename T, std::size_t N>
+[[nodiscard]] Result<StaticMatrix<T, N, N>, NotPositiveDefinite>
+cholesky(const StaticMatrix<T, N, N>& m) noexcept {
+    static_assert(std::is_floating_point_v<T>, "cholesky() needs a floating-point type");
+    StaticMatrix<T, N, N> l;
+    for (std::size_t j = 0; j < N; ++j) {
+        T d = m(j, j);
+        for (std::size_t k = 0; k < j; ++k) {
+            d -= l(j, k) * l(j, k);
+        }
+        if (!(d > T(0))) {
+            return Err(NotPositiveDefinite{j});
+        }
+        const T ljj = std::sqrt(d);
+        l(j, j) = ljj;
+        const T inv = T(1) / ljj;
+        for (std::size_t i = j + 1; i < N; ++i) {
+            T s = m(i, j);
+            for (std::size_t k = 0; k < j; ++k) {
+                s -= l(i, k) * l(j, k);
+            }
+            l(i, j) = s * inv;
+        }
+    }
+    return Ok(l);
+}
+
+/**
+ * @brief Solve L * L^T * x = b given the factor from cholesky().
+ */
+template<typename T, std::size_t N>
+[[nodiscard]] constexpr StaticVec<T, N>
+cholesky_solve(const StaticMatrix<T, N, N>& l, const StaticVec<T, N>& b) noexcept {
+    StaticVec<T, N> y;
+    for (std::size_t i = 0; i < N; ++i) {
+        T s = b[i];
+        for (std::size_t k = 0; k < i; ++k) {
+            s -= l(i, k) * y[k];
+        }
+        y[i] = s / l(i, i);
+    }
+    StaticVec<T, N> x;
+    for (std::size_t i = N; i-- > 0;) {
+        T s = y[i];
+        for (std::size_t k = i + 1; k < N; ++k) {
+            s -= l(k, i) * x[k];
+        }
+        x[i] = s / l(i, i);
+    }
+    return x;
+}
+
+/**
+ * @brief Solve m * x = b for symmetric positive-definite m.
+ */
+template<typename T, std::size_t N>
+[[nodiscard]] Result<StaticVec<T, N>, NotPositiveDefinite>
+solve_spd(const StaticMatrix<T, N, N>& m, const StaticVec<T, N>& b) noexcept {
+    auto l = cholesky(m);
+    if (l.is_err()) {
+        return Err(l.unwrap_err());
+    }
+    return Ok(cholesky_solve(l.unwrap(), b));
+}
+
+// ============================================================================
+// Common Aliases
+// ============================================================================
+
+using Vec3f = StaticVec<float, 3>;
+using Vec4f = StaticVec<float, 4>;
+using Mat3f = StaticMatrix<float, 3, 3>;
+using Mat4f = StaticMatrix<float, 4, 4>;
+using Vec3d = StaticVec<double, 3>;
+using Mat3d = StaticMatrix<double, 3, 3>;
+using Mat6d = StaticMatrix<double, 6, 6>;
+
+} // namespace crab
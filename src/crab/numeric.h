@@ -0,0 +1,933 @@
+#pragma once
+
+/**
+ * @file numeric.h
+ * @brief SIMD numeric reductions and elementwise kernels over Slice.
+ *
+ * sum, min/max, argmin/argmax, dot, axpy, scale and clamp for float,
+ * double and int32_t, with explicit AVX2 (x86) and NEON (ARM, float)
+ * implementations selected at runtime. Other arithmetic types use the
+ * scalar reference path.
+ *
+ * Compilers do not vectorize floating-point reductions under strict IEEE
+ * rules, so the vector kernels reassociate explicitly (several
+ * accumulators) and offer pairwise and Kahan summation for accuracy.
+ * Results may differ from a naive left-to-right loop in the last bits.
+ *
+ * @note Kahan summation relies on strict FP semantics; it degrades to
+ *       plain summation under -ffast-math / -fassociative-math.
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace crab {
+
+/**
+ * @brief Summation algorithm for floating-point sum().
+ */
+enum class Summation {
+    Fast,      ///< Blocked multi-accumulator sum (error grows ~O(n))
+    Pairwise,  ///< Pairwise over blocks (error grows ~O(log n)), near Fast speed
+    Kahan,     ///< Compensated (error ~O(1)), about half the speed of Fast
+};
+
+namespace detail {
+
+/// Accumulator type: int32 sums and dot products widen to int64.
+template<typename T>
+using AccumOf = std::conditional_t<std::is_integral_v<T> && (sizeof(T) < 8), int64_t, T>;
+
+template<typename T>
+inline constexpr bool has_simd_kernels_v =
+    std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>;
+
+constexpr std::size_t kPairwiseBlock = 256;
+
+// ============================================================================
+// Scalar Reference
+// ============================================================================
+
+template<typename T>
+AccumOf<T> sum_fast_scalar(const T* p, std::size_t n) noexcept {
+    using A = AccumOf<T>;
+    A a0{}, a1{}, a2{}, a3{};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a0 += static_cast<A>(p[i]);
+        a1 += static_cast<A>(p[i + 1]);
+        a2 += static_cast<A>(p[i + 2]);
+        a3 += static_cast<A>(p[i + 3]);
+    }
+    for (; i < n; ++i) {
+        a0 += static_cast<A>(p[i]);
+    }
+    return (a0 + a1) + (a2 + a3);
+}
+
+template<typename T>
+AccumOf<T> sum_pairwise_scalar(const T* p, std::size_t n) noexcept {
+    if (n <= kPairwiseBlock) {
+        return sum_fast_scalar(p, n);
+    }
+    const std::size_t half = (n / 2) & ~static_cast<std::size_t>(7);
+    return sum_pairwise_scalar(p, half) + sum_pairwise_scalar(p + half, n - half);
+}
+
+// Neumaier's variant of Kahan summation (also handles |x| > |sum|)
+template<typename T>
+T sum_kahan_scalar(const T* p, std::size_t n) noexcept {
+    T s = 0;
+    T c = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const T x = p[i];
+        const T t = s + x;
+        const bool big = (s < 0 ? -s : s) >= (x < 0 ? -x : x);
+        c += big ? (s - t) + x : (x - t) + s;
+        s = t;
+    }
+    return s + c;
+}
+
+template<typename T>
+AccumOf<T> sum_scalar(const T* p, std::size_t n, Summation mode) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        switch (mode) {
+            case Summation::Fast: return sum_fast_scalar(p, n);
+            case Summation::Kahan: return sum_kahan_scalar(p, n);
+            case Summation::Pairwise: break;
+        }
+        return sum_pairwise_scalar(p, n);
+    } else {
+        (void)mode;
+        return sum_fast_scalar(p, n);
+    }
+}
+
+// v if it beats best, or if it is NaN, so that a NaN sticks
+template<bool Max, typename T>
+T pick_extreme(T best, T v) noexcept {
+    return (Max ? (v > best) : (v < best)) || v != v ? v : best;
+}
+
+template<bool Max, typename T>
+T extreme_scalar(const T* p, std::size_t n) noexcept {
+    T best = p[0];
+    for (std::size_t i = 1; i < n; ++i) {
+        best = pick_extreme<Max>(best, p[i]);
+    }
+    return best;
+}
+
+template<bool Max, typename T>
+std::size_t arg_extreme_scalar(const T* p, std::size_t n) noexcept {
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < n; ++i) {
+        if (Max ? (p[i] > p[best]) : (p[i] < p[best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+template<typename T>
+AccumOf<T> dot_scalar(const T* a, const T* b, std::size_t n) noexcept {
+    using A = AccumOf<T>;
+    A a0{}, a1{}, a2{}, a3{};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a0 += static_cast<A>(a[i]) * static_cast<A>(b[i]);
+        a1 += static_cast<A>(a[i + 1]) * static_cast<A>(b[i + 1]);
+        a2 += static_cast<A>(a[i + 2]) * static_cast<A>(b[i + 2]);
+        a3 += static_cast<A>(a[i + 3]) * static_cast<A>(b[i + 3]);
+    }
+    for (; i < n; ++i) {
+        a0 += static_cast<A>(a[i]) * static_cast<A>(b[i]);
+    }
+    return (a0 + a1) + (a2 + a3);
+}
+
+template<typename T>
+void axpy_scalar(T alpha, const T* x, T* y, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] = alpha * x[i] + y[i];
+    }
+}
+
+template<typename T>
+void scale_scalar(T* x, T alpha, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] *= alpha;
+    }
+}
+
+template<typename T>
+void clamp_scalar(T* x, T lo, T hi, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const T v = x[i] < lo ? lo : x[i];
+        x[i] = v > hi ? hi : v;
+    }
+}
+
+// ============================================================================
+// AVX2
+// ============================================================================
+
+#if CRAB_SIMD_X86
+
+struct Avx2F32 {
+    using scalar = float;
+    using vec = __m256;
+    using ivec = __m256i;
+    static constexpr std::size_t lanes = 8;
+
+    CRAB_TARGET_AVX2 static vec load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    CRAB_TARGET_AVX2 static void store(float* p, vec v) noexcept { _mm256_storeu_ps(p, v); }
+    CRAB_TARGET_AVX2 static vec set1(float v) noexcept { return _mm256_set1_ps(v); }
+    CRAB_TARGET_AVX2 static vec zero() noexcept { return _mm256_setzero_ps(); }
+    CRAB_TARGET_AVX2 static vec add(vec a, vec b) noexcept { return _mm256_add_ps(a, b); }
+    CRAB_TARGET_AVX2 static vec sub(vec a, vec b) noexcept { return _mm256_sub_ps(a, b); }
+    CRAB_TARGET_AVX2 static vec mul(vec a, vec b) noexcept { return _mm256_mul_ps(a, b); }
+    CRAB_TARGET_AVX2 static vec fma(vec a, vec b, vec c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+    CRAB_TARGET_AVX2 static vec min(vec a, vec b) noexcept { return _mm256_min_ps(a, b); }
+    CRAB_TARGET_AVX2 static vec max(vec a, vec b) noexcept { return _mm256_max_ps(a, b); }
+
+    // Lanes where a or b is NaN
+    CRAB_TARGET_AVX2 static vec unordered(vec a, vec b) noexcept { return _mm256_cmp_ps(a, b, _CMP_UNORD_Q); }
+    CRAB_TARGET_AVX2 static vec bit_or(vec a, vec b) noexcept { return _mm256_or_ps(a, b); }
+    CRAB_TARGET_AVX2 static bool any(vec mask) noexcept { return _mm256_movemask_ps(mask) != 0; }
+
+    // Lane mask where a is strictly better than b (less, or greater if Max)
+    template<bool Max>
+    CRAB_TARGET_AVX2 static ivec better(vec a, vec b) noexcept {
+        return _mm256_castps_si256(_mm256_cmp_ps(a, b, Max ? _CMP_GT_OQ : _CMP_LT_OQ));
+    }
+    CRAB_TARGET_AVX2 static vec select(ivec mask, vec yes, vec no) noexcept {
+        return _mm256_blendv_ps(no, yes, _mm256_castsi256_ps(mask));
+    }
+    CRAB_TARGET_AVX2 static ivec iota() noexcept { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+    CRAB_TARGET_AVX2 static ivec iadd_lanes(ivec v) noexcept { return _mm256_add_epi32(v, _mm256_set1_epi32(8)); }
+    CRAB_TARGET_AVX2 static ivec iselect(ivec mask, ivec yes, ivec no) noexcept {
+        return _mm256_blendv_epi8(no, yes, mask);
+    }
+    CRAB_TARGET_AVX2 static void istore(int64_t* out, ivec v) noexcept {
+        alignas(32) int32_t tmp[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), v);
+        for (int i = 0; i < 8; ++i) {
+            out[i] = tmp[i];
+        }
+    }
+};
+
+struct Avx2F64 {
+    using scalar = double;
+    using vec = __m256d;
+    using ivec = __m256i;
+    static constexpr std::size_t lanes = 4;
+
+    CRAB_TARGET_AVX2 static vec load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+    CRAB_TARGET_AVX2 static void store(double* p, vec v) noexcept { _mm256_storeu_pd(p, v); }
+    CRAB_TARGET_AVX2 static vec set1(double v) noexcept { return _mm256_set1_pd(v); }
+    CRAB_TARGET_AVX2 static vec zero() noexcept { return _mm256_setzero_pd(); }
+    CRAB_TARGET_AVX2 static vec add(vec a, vec b) noexcept { return _mm256_add_pd(a, b); }
+    CRAB_TARGET_AVX2 static vec sub(vec a, vec b) noexcept { return _mm256_sub_pd(a, b); }
+    CRAB_TARGET_AVX2 static vec mul(vec a, vec b) noexcept { return _mm256_mul_pd(a, b); }
+    CRAB_TARGET_AVX2 static vec fma(vec a, vec b, vec c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+    CRAB_TARGET_AVX2 static vec min(vec a, vec b) noexcept { return _mm256_min_pd(a, b); }
+    CRAB_TARGET_AVX2 static vec max(vec a, vec b) noexcept { return _mm256_max_pd(a, b); }
+
+    CRAB_TARGET_AVX2 static vec unordered(vec a, vec b) noexcept { return _mm256_cmp_pd(a, b, _CMP_UNORD_Q); }
+    CRAB_TARGET_AVX2 static vec bit_or(vec a, vec b) noexcept { return _mm256_or_pd(a, b); }
+    CRAB_TARGET_AVX2 static bool any(vec mask) noexcept { return _mm256_movemask_pd(mask) != 0; }
+
+    template<bool Max>
+    CRAB_TARGET_AVX2 static ivec better(vec a, vec b) noexcept {
+        return _mm256_castpd_si256(_mm256_cmp_pd(a, b, Max ? _CMP_GT_OQ : _CMP_LT_OQ));
+    }
+    CRAB_TARGET_AVX2 static vec select(ivec mask, vec yes, vec no) noexcept {
+        return _mm256_blendv_pd(no, yes, _mm256_castsi256_pd(mask));
+    }
+    CRAB_TARGET_AVX2 static ivec iota() noexcept { return _mm256_setr_epi64x(0, 1, 2, 3); }
+    CRAB_TARGET_AVX2 static ivec iadd_lanes(ivec v) noexcept { return _mm256_add_epi64(v, _mm256_set1_epi64x(4)); }
+    CRAB_TARGET_AVX2 static ivec iselect(ivec mask, ivec yes, ivec no) noexcept {
+        return _mm256_blendv_epi8(no, yes, mask);
+    }
+    CRAB_TARGET_AVX2 static void istore(int64_t* out, ivec v) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+    }
+};
+
+struct Avx2I32 {
+    using scalar = int32_t;
+    using vec = __m256i;
+    using ivec = __m256i;
+    static constexpr std::size_t lanes = 8;
+
+    CRAB_TARGET_AVX2 static vec load(const int32_t* p) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    CRAB_TARGET_AVX2 static void store(int32_t* p, vec v) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    CRAB_TARGET_AVX2 static vec set1(int32_t v) noexcept { return _mm256_set1_epi32(v); }
+    CRAB_TARGET_AVX2 static vec add(vec a, vec b) noexcept { return _mm256_add_epi32(a, b); }
+    CRAB_TARGET_AVX2 static vec mul(vec a, vec b) noexcept { return _mm256_mullo_epi32(a, b); }
+    CRAB_TARGET_AVX2 static vec fma(vec a, vec b, vec c) noexcept { return add(mul(a, b), c); }
+    CRAB_TARGET_AVX2 static vec min(vec a, vec b) noexcept { return _mm256_min_epi32(a, b); }
+    CRAB_TARGET_AVX2 static vec max(vec a, vec b) noexcept { return _mm256_max_epi32(a, b); }
+
+    // Integers have no NaN
+    CRAB_TARGET_AVX2 static vec unordered(vec, vec) noexcept { return _mm256_setzero_si256(); }
+    CRAB_TARGET_AVX2 static vec bit_or(vec a, vec b) noexcept { return _mm256_or_si256(a, b); }
+    CRAB_TARGET_AVX2 static bool any(vec mask) noexcept { return !_mm256_testz_si256(mask, mask); }
+
+    template<bool Max>
+    CRAB_TARGET_AVX2 static ivec better(vec a, vec b) noexcept {
+        return Max ? _mm256_cmpgt_epi32(a, b) : _mm256_cmpgt_epi32(b, a);
+    }
+    CRAB_TARGET_AVX2 static vec select(ivec mask, vec yes, vec no) noexcept {
+        return _mm256_blendv_epi8(no, yes, mask);
+    }
+    CRAB_TARGET_AVX2 static ivec iota() noexcept { return Avx2F32::iota(); }
+    CRAB_TARGET_AVX2 static ivec iadd_lanes(ivec v) noexcept { return Avx2F32::iadd_lanes(v); }
+    CRAB_TARGET_AVX2 static ivec iselect(ivec mask, ivec yes, ivec no) noexcept {
+        return _mm256_blendv_epi8(no, yes, mask);
+    }
+    CRAB_TARGET_AVX2 static void istore(int64_t* out, ivec v) noexcept { Avx2F32::istore(out, v); }
+};
+
+template<typename T>
+struct Avx2OpsFor;
+template<> struct Avx2OpsFor<float> { using type = Avx2F32; };
+template<> struct Avx2OpsFor<double> { using type = Avx2F64; };
+template<> struct Avx2OpsFor<int32_t> { using type = Avx2I32; };
+
+template<typename Ops>
+CRAB_TARGET_AVX2 typename Ops::scalar sum_fast_avx2(const typename Ops::scalar* p, std::size_t n) noexcept {
+    using V = typename Ops::vec;
+    constexpr std::size_t L = Ops::lanes;
+    V a0 = Ops::zero(), a1 = Ops::zero(), a2 = Ops::zero(), a3 = Ops::zero();
+    std::size_t i = 0;
+    for (; i + 4 * L <= n; i += 4 * L) {
+        a0 = Ops::add(a0, Ops::load(p + i));
+        a1 = Ops::add(a1, Ops::load(p + i + L));
+        a2 = Ops::add(a2, Ops::load(p + i + 2 * L));
+        a3 = Ops::add(a3, Ops::load(p + i + 3 * L));
+    }
+    for (; i + L <= n; i += L) {
+        a0 = Ops::add(a0, Ops::load(p + i));
+    }
+    alignas(32) typename Ops::scalar lanes[L];
+    Ops::store(lanes, Ops::add(Ops::add(a0, a1), Ops::add(a2, a3)));
+    typename Ops::scalar total = sum_fast_scalar(lanes, L);
+    for (; i < n; ++i) {
+        total += p[i];
+    }
+    return total;
+}
+
+template<typename Ops>
+CRAB_TARGET_AVX2 typename Ops::scalar sum_pairwise_avx2(const typename Ops::scalar* p, std::size_t n) noexcept {
+    if (n <= kPairwiseBlock) {
+        return sum_fast_avx2<Ops>(p, n);
+    }
+    const std::size_t half = (n / 2) & ~static_cast<std::size_t>(31);
+    return sum_pairwise_avx2<Ops>(p, half) + sum_pairwise_avx2<Ops>(p + half, n - half);
+}
+
+template<typename Ops>
+CRAB_TARGET_AVX2 typename Ops::scalar sum_kahan_avx2(const typename Ops::scalar* p, std::size_t n) noexcept {
+    using S = typename Ops::scalar;
+    using V = typename Ops::vec;
+    constexpr std::size_t L = Ops::lanes;
+    V s = Ops::zero();
+    V c = Ops::zero();
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        const V y = Ops::sub(Ops::load(p + i), c);
+        const V t = Ops::add(s, y);
+        c = Ops::sub(Ops::sub(t, s), y);
+        s = t;
+    }
+    // Fold lane sums, lane compensations and the tail with scalar Neumaier
+    alignas(32) S parts[2 * L];
+    Ops::store(parts, s);
+    Ops::store(parts + L, Ops::sub(Ops::zero(), c));
+    S total = sum_kahan_scalar(parts, 2 * L);
+    S tail[2] = {total, sum_kahan_scalar(p + i, n - i)};
+    return sum_kahan_scalar(tail, 2);
+}
+
+CRAB_TARGET_AVX2 inline int64_t sum_i32_avx2(const int32_t* p, std::size_t n) noexcept {
+    __m256i a0 = _mm256_setzero_si256();
+    __m256i a1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(a0, a1));
+    int64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) {
+        total += p[i];
+    }
+    return total;
+}
+
+CRAB_TARGET_AVX2 inline int64_t dot_i32_avx2(const int32_t* a, const int32_t* b, std::size_t n) noexcept {
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        // mul_epi32 multiplies the even lanes into 64-bit products
+        const __m256i even = _mm256_mul_epi32(va, vb);
+        const __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32));
+        acc = _mm256_add_epi64(acc, _mm256_add_epi64(even, odd));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    int64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i) {
+        total += static_cast<int64_t>(a[i]) * b[i];
+    }
+    return total;
+}
+
+template<bool Max, typename Ops>
+CRAB_TARGET_AVX2 typename Ops::scalar extreme_avx2(const typename Ops::scalar* p, std::size_t n) noexcept {
+    using V = typename Ops::vec;
+    constexpr std::size_t L = Ops::lanes;
+    if (n < L) {
+        return extreme_scalar<Max>(p, n);
+    }
+    V b0 = Ops::load(p);
+    V b1 = b0;
+    // min/max can drop a NaN already in the accumulator, so track NaN lanes
+    // apart and let the scalar path produce the result when one turns up
+    V nan = Ops::unordered(b0, b0);
+    std::size_t i = L;
+    for (; i + 2 * L <= n; i += 2 * L) {
+        const V v0 = Ops::load(p + i);
+        const V v1 = Ops::load(p + i + L);
+        nan = Ops::bit_or(nan, Ops::unordered(v0, v1));
+        b0 = Max ? Ops::max(b0, v0) : Ops::min(b0, v0);
+        b1 = Max ? Ops::max(b1, v1) : Ops::min(b1, v1);
+    }
+    // Overlapping final load covers the tail without a scalar loop
+    const V last = Ops::load(p + n - L);
+    if (Ops::any(Ops::bit_or(nan, Ops::unordered(last, last)))) {
+        return extreme_scalar<Max>(p, n);
+    }
+    b0 = Max ? Ops::max(Ops::max(b0, b1), last) : Ops::min(Ops::min(b0, b1), last);
+    alignas(32) typename Ops::scalar lanes[L];
+    Ops::store(lanes, b0);
+    typename Ops::scalar best = extreme_scalar<Max>(lanes, L);
+    for (; i < n - L; ++i) {
+        best = pick_extreme<Max>(best, p[i]);
+    }
+    return best;
+}
+
+template<bool Max, typename Ops>
+CRAB_TARGET_AVX2 std::size_t arg_extreme_avx2(const typename Ops::scalar* p, std::size_t n) noexcept {
+    using S = typename Ops::scalar;
+    using V = typename Ops::vec;
+    using I = typename Ops::ivec;
+    constexpr std::size_t L = Ops::lanes;
+    if (n < L || n > static_cast<std::size_t>(INT32_MAX)) {
+        return arg_extreme_scalar<Max>(p, n);
+    }
+    V best = Ops::load(p);
+    I best_idx = Ops::iota();
+    I idx = Ops::iadd_lanes(best_idx);
+    std::size_t i = L;
+    for (; i + L <= n; i += L) {
+        const V v = Ops::load(p + i);
+        const I mask = Ops::template better<Max>(v, best);
+        best = Ops::select(mask, v, best);
+        best_idx = Ops::iselect(mask, idx, best_idx);
+        idx = Ops::iadd_lanes(idx);
+    }
+    // Each lane holds its first best; ties across lanes go to the lowest index
+    alignas(32) S vals[L];
+    int64_t where[L];
+    Ops::store(vals, best);
+    Ops::istore(where, best_idx);
+    std::size_t result = static_cast<std::size_t>(where[0]);
+    S result_val = vals[0];
+    for (std::size_t l = 1; l < L; ++l) {
+        const bool better = Max ? vals[l] > result_val : vals[l] < result_val;
+        if (better || (vals[l] == result_val && static_cast<std::size_t>(where[l]) < result)) {
+            result = static_cast<std::size_t>(where[l]);
+            result_val = vals[l];
+        }
+    }
+    for (; i < n; ++i) {
+        if (Max ? p[i] > result_val : p[i] < result_val) {
+            result = i;
+            result_val = p[i];
+        }
+    }
+    return result;
+}
+
+template<typename Ops>
+CRAB_TARGET_AVX2 typename Ops::scalar dot_avx2(const typename Ops::scalar* a,
+                                               const typename Ops::scalar* b, std::size_t n) noexcept {
+    using V = typename Ops::vec;
+    constexpr std::size_t L = Ops::lanes;
+    V a0 = Ops::zero(), a1 = Ops::zero(), a2 = Ops::zero(), a3 = Ops::zero();
+    std::size_t i = 0;
+    for (; i + 4 * L <= n; i += 4 * L) {
+        a0 = Ops::fma(Ops::load(a + i), Ops::load(b + i), a0);
+        a1 = Ops::fma(Ops::load(a + i + L), Ops::load(b + i + L), a1);
+        a2 = Ops::fma(Ops::load(a + i + 2 * L), Ops::load(b + i + 2 * L), a2);
+        a3 = Ops::fma(Ops::load(a + i + 3 * L), Ops::load(b + i + 3 * L), a3);
+    }
+    for (; i + L <= n; i += L) {
+        a0 = Ops::fma(Ops::load(a + i), Ops::load(b + i), a0);
+    }
+    alignas(32) typename Ops::scalar lanes[L];
+    Ops::store(lanes, Ops::add(Ops::add(a0, a1), Ops::add(a2, a3)));
+    typename Ops::scalar total = sum_fast_scalar(lanes, L);
+    for (; i < n; ++i) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+template<typename Ops>
+CRAB_TARGET_AVX2 void axpy_avx2(typename Ops::scalar alpha, const typename Ops::scalar* x,
+                                typename Ops::scalar* y, std::size_t n) noexcept {
+    constexpr std::size_t L = Ops::lanes;
+    const auto va = Ops::set1(alpha);
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        Ops::store(y + i, Ops::fma(va, Ops::load(x + i), Ops::load(y + i)));
+    }
+    axpy_scalar(alpha, x + i, y + i, n - i);
+}
+
+template<typename Ops>
+CRAB_TARGET_AVX2 void scale_avx2(typename Ops::scalar* x, typename Ops::scalar alpha, std::size_t n) noexcept {
+    constexpr std::size_t L = Ops::lanes;
+    const auto va = Ops::set1(alpha);
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        Ops::store(x + i, Ops::mul(Ops::load(x + i), va));
+    }
+    scale_scalar(x + i, alpha, n - i);
+}
+
+template<typename Ops>
+CRAB_TARGET_AVX2 void clamp_avx2(typename Ops::scalar* x, typename Ops::scalar lo,
+                                 typename Ops::scalar hi, std::size_t n) noexcept {
+    constexpr std::size_t L = Ops::lanes;
+    const auto vlo = Ops::set1(lo);
+    const auto vhi = Ops::set1(hi);
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        // max/min return their second operand when either is NaN; passing
+        // x second lets NaN through, matching the scalar path
+        Ops::store(x + i, Ops::min(vhi, Ops::max(vlo, Ops::load(x + i))));
+    }
+    clamp_scalar(x + i, lo, hi, n - i);
+}
+
+#endif // CRAB_SIMD_X86
+
+// ============================================================================
+// NEON (float)
+// ============================================================================
+
+#if CRAB_SIMD_NEON
+
+inline float hsum_neon(float32x4_t v) noexcept {
+    const float32x2_t pair = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(pair, pair), 0);
+}
+
+inline float sum_fast_neon(const float* p, std::size_t n) noexcept {
+    float32x4_t a0 = vdupq_n_f32(0.0f), a1 = a0, a2 = a0, a3 = a0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = vaddq_f32(a0, vld1q_f32(p + i));
+        a1 = vaddq_f32(a1, vld1q_f32(p + i + 4));
+        a2 = vaddq_f32(a2, vld1q_f32(p + i + 8));
+        a3 = vaddq_f32(a3, vld1q_f32(p + i + 12));
+    }
+    for (; i + 4 <= n; i += 4) {
+        a0 = vaddq_f32(a0, vld1q_f32(p + i));
+    }
+    float total = hsum_neon(vaddq_f32(vaddq_f32(a0, a1), vaddq_f32(a2, a3)));
+    for (; i < n; ++i) {
+        total += p[i];
+    }
+    return total;
+}
+
+inline float sum_pairwise_neon(const float* p, std::size_t n) noexcept {
+    if (n <= kPairwiseBlock) {
+        return sum_fast_neon(p, n);
+    }
+    const std::size_t half = (n / 2) & ~static_cast<std::size_t>(15);
+    return sum_pairwise_neon(p, half) + sum_pairwise_neon(p + half, n - half);
+}
+
+template<bool Max>
+float extreme_neon(const float* p, std::size_t n) noexcept {
+    if (n < 4) {
+        return extreme_scalar<Max>(p, n);
+    }
+    float32x4_t best = vld1q_f32(p);
+    std::size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        best = Max ? vmaxq_f32(best, vld1q_f32(p + i)) : vminq_f32(best, vld1q_f32(p + i));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, best);
+    float result = extreme_scalar<Max>(lanes, 4);
+    for (; i < n; ++i) {
+        result = pick_extreme<Max>(result, p[i]);
+    }
+    return result;
+}
+
+inline float dot_neon(const float* a, const float* b, std::size_t n) noexcept {
+    float32x4_t a0 = vdupq_n_f32(0.0f), a1 = a0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = vmlaq_f32(a0, vld1q_f32(a + i), vld1q_f32(b + i));
+        a1 = vmlaq_f32(a1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float total = hsum_neon(vaddq_f32(a0, a1));
+    for (; i < n; ++i) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+inline void axpy_neon(float alpha, const float* x, float* y, std::size_t n) noexcept {
+    const float32x4_t va = vdupq_n_f32(alpha);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vmlaq_f32(vld1q_f32(y + i), va, vld1q_f32(x + i)));
+    }
+    axpy_scalar(alpha, x + i, y + i, n - i);
+}
+
+inline void scale_neon(float* x, float alpha, std::size_t n) noexcept {
+    const float32x4_t va = vdupq_n_f32(alpha);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(x + i, vmulq_f32(vld1q_f32(x + i), va));
+    }
+    scale_scalar(x + i, alpha, n - i);
+}
+
+inline void clamp_neon(float* x, float lo, float hi, std::size_t n) noexcept {
+    const float32x4_t vlo = vdupq_n_f32(lo);
+    const float32x4_t vhi = vdupq_n_f32(hi);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(x + i, vminq_f32(vmaxq_f32(vld1q_f32(x + i), vlo), vhi));
+    }
+    clamp_scalar(x + i, lo, hi, n - i);
+}
+
+#endif // CRAB_SIMD_NEON
+
+template<typename T>
+inline bool use_avx2() noexcept {
+#if CRAB_SIMD_X86
+    return has_simd_kernels_v<T> && simd::active_level() >= simd::Level::Avx2;
+#else
+    return false;
+#endif
+}
+
+template<typename T>
+inline bool use_neon() noexcept {
+#if CRAB_SIMD_NEON
+    return std::is_same_v<T, float> && simd::active_level() >= simd::Level::Neon;
+#else
+    return false;
+#endif
+}
+
+} // namespace detail
+
+// ============================================================================
+// Reductions
+// ============================================================================
+
+/**
+ * @brief Sum of all elements (int32 widens to int64).
+ *
+ * @param x Input elements
+ * @param mode Summation algorithm (floating point only)
+ * @return Sum, or None if x is empty
+ */
+template<typename T>
+[[nodiscard]] Option<detail::AccumOf<std::remove_const_t<T>>>
+sum(Slice<T> x, Summation mode = Summation::Pairwise) noexcept {
+    using U = std::remove_const_t<T>;
+    static_assert(std::is_arithmetic_v<U>, "sum() requires an arithmetic element type");
+    if (x.is_empty()) {
+        return None;
+    }
+    const U* p = x.data();
+    const std::size_t n = x.size();
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_simd_kernels_v<U>) {
+        if (detail::use_avx2<U>()) {
+            using Ops = typename detail::Avx2OpsFor<U>::type;
+            if constexpr (std::is_same_v<U, int32_t>) {
+                return Some(detail::sum_i32_avx2(p, n));
+            } else {
+                switch (mode) {
+                    case Summation::Fast: return Some(detail::sum_fast_avx2<Ops>(p, n));
+                    case Summation::Kahan: return Some(detail::sum_kahan_avx2<Ops>(p, n));
+                    case Summation::Pairwise: break;
+                }
+                return Some(detail::sum_pairwise_avx2<Ops>(p, n));
+            }
+        }
+    }
+#endif
+#if CRAB_SIMD_NEON
+    if constexpr (std::is_same_v<U, float>) {
+        if (detail::use_neon<U>() && mode != Summation::Kahan) {
+            return Some(mode == Summation::Fast ? detail::sum_fast_neon(p, n)
+                                                : detail::sum_pairwise_neon(p, n));
+        }
+    }
+#endif
+    return Some(detail::sum_scalar(p, n, mode));
+}
+
+/**
+ * @brief Smallest element, or None if empty.
+ * @note NaN propagates: any NaN element makes the result NaN.
+ */
+template<typename T>
+[[nodiscard]] Option<std::remove_const_t<T>> min_value(Slice<T> x) noexcept {
+    using U = std::remove_const_t<T>;
+    if (x.is_empty()) {
+        return None;
+    }
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_simd_kernels_v<U>) {
+        if (detail::use_avx2<U>()) {
+            return Some(detail::extreme_avx2<false, typename detail::Avx2OpsFor<U>::type>(x.data(), x.size()));
+        }
+    }
+#endif
+#if CRAB_SIMD_NEON
+    if constexpr (std::is_same_v<U, float>) {
+        if (detail::use_neon<U>()) {
+            return Some(detail::extreme_neon<false>(x.data(), x.size()));
+        }
+    }
+#endif
+    return Some(detail::extreme_scalar<false>(x.data(), x.size()));
+}
+
+/**
+ * @brief Largest element, or None if empty.
+ * @note NaN propagates: any NaN element makes the result NaN.
+ */
+template<typename T>
+[[nodiscard]] Option<std::remove_const_t<T>> max_value(Slice<T> x) noexcept {
+    using U = std::remove_const_t<T>;
+    if (x.is_empty()) {
+        return None;
+    }
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_simd_kernels_v<U>) {
+        if (detail::use_avx2<U>()) {
+            return Some(detail::extreme_avx2<true, typename detail::Avx2OpsFor<U>::type>(x.data(), x.size()));
+        }
+    }
+#endif
+#if CRAB_SIMD_NEON
+    if constexpr (std::is_same_v<U, float>) {
+        if (detail::use_neon<U>()) {
+            return Some(detail::extreme_neon<true>(x.data(), x.size()));
+        }
+    }
+#endif
+    return Some(detail::extreme_scalar<true>(x.data(), x.size()));
+}
+
+/**
+ * @brief Index of the first smallest element, or None if empty.
+ */
+template<typename T>
+[[nodiscard]] Option<std::size_t> argmin(Slice<T> x) noexcept {
+    if (x.is_empty()) {
+        return None;
+    }
+#if CRAB_SIMD_X86
+    using U = std::remove_const_t<T>;
+    if constexpr (detail::has_simd_kernels_v<U>) {
+        if (detail::use_avx2<U>()) {
+            return Some(detail::arg_extreme_avx2<false, typename detail::Avx2OpsFor<U>::type>(x.data(), x.size()));
+        }
+    }
+#endif
+    return Some(detail::arg_extreme_scalar<false>(x.data(), x.size()));
+}
+
+/**
+ * @brief Index of the first largest element, or None if empty.
+ */
+template<typename T>
+[[nodiscard]] Option<std::size_t> argmax(Slice<T> x) noexcept {
+    if (x.is_empty()) {
+        return None;
+    }
+#if CRAB_SIMD_X86
+    using U = std::remove_const_t<T>;
+    if constexpr (detail::has_simd_kernels_v<U>) {
+        if (detail::use_avx2<U>()) {
+            return Some(detail::arg_extreme_avx2<true, typename detail::Avx2OpsFor<U>::type>(x.data(), x.size()));
+        }
+    }
+#endif
+    return Some(detail::arg_extreme_scalar<true>(x.data(), x.size()));
+}
+
+/**
+ * @brief Dot product (int32 widens to int64), or None if either input is empty.
+ * @note Panics if the lengths differ.
+ */
+template<typename T, typename U>
+[[nodiscard]] Option<detail::AccumOf<std::remove_const_t<T>>> dot(Slice<T> a, Slice<U> b) noexcept {
+    using V = std::remove_const_t<T>;
+    static_assert(std::is_same_v<V, std::remove_const_t<U>>, "dot() requires matching element types");
+    CRAB_ASSERT(a.size() == b.size(), "dot() called with slices of different lengths");
+    if (a.is_empty()) {
+        return None;
+    }
+    const std::size_t n = a.size();
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_simd_kernels_v<V>) {
+        if (detail::use_avx2<V>()) {
+            if constexpr (std::is_same_v<V, int32_t>) {
+                return Some(detail::dot_i32_avx2(a.data(), b.data(), n));
+            } else {
+                return Some(detail::dot_avx2<typename detail::Avx2OpsFor<V>::type>(a.data(), b.data(), n));
+            }
+        }
+    }
+#endif
+#if CRAB_SIMD_NEON
+    if constexpr (std::is_same_v<V, float>) {
+        if (detail::use_neon<V>()) {
+            return Some(detail::dot_neon(a.data(), b.data(), n));
+        }
+    }
+#endif
+    return Some(detail::dot_scalar(a.data(), b.data(), n));
+}
+
+// ============================================================================
+// Elementwise
+// ============================================================================
+
+/**
+ * @brief y[i] = alpha * x[i] + y[i].
+ * @return Ok, or Err if x and y differ in length
+ */
+template<typename T, typename U>
+Result<Unit, OutOfBounds> axpy(std::remove_const_t<U> alpha, Slice<T> x, Slice<U> y) noexcept {
+    using V = std::remove_const_t<T>;
+    static_assert(std::is_same_v<V, U>, "axpy() requires matching element types and a mutable y");
+    if (x.size() != y.size()) {
+        return Err(OutOfBounds{x.size(), y.size()});
+    }
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_simd_kernels_v<V>) {
+        if (detail::use_avx2<V>()) {
+            detail::axpy_avx2<typename detail::Avx2OpsFor<V>::type>(alpha, x.data(), y.data(), x.size());
+            return Ok();
+        }
+    }
+#endif
+#if CRAB_SIMD_NEON
+    if constexpr (std::is_same_v<V, float>) {
+        if (detail::use_neon<V>()) {
+            detail::axpy_neon(alpha, x.data(), y.data(), x.size());
+            return Ok();
+        }
+    }
+#endif
+    detail::axpy_scalar(alpha, x.data(), y.data(), x.size());
+    return Ok();
+}
+
+/**
+ * @brief x[i] *= alpha.
+ */
+template<typename T>
+void scale(Slice<T> x, T alpha) noexcept {
+    static_assert(!std::is_const_v<T>, "scale() requires a mutable Slice");
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_simd_kernels_v<T>) {
+        if (detail::use_avx2<T>()) {
+            detail::scale_avx2<typename detail::Avx2OpsFor<T>::type>(x.data(), alpha, x.size());
+            return;
+        }
+    }
+#endif
+#if CRAB_SIMD_NEON
+    if constexpr (std::is_same_v<T, float>) {
+        if (detail::use_neon<T>()) {
+            detail::scale_neon(x.data(), alpha, x.size());
+            return;
+        }
+    }
+#endif
+    detail::scale_scalar(x.data(), alpha, x.size());
+}
+
+/**
+ * @brief x[i] = min(max(x[i], lo), hi).
+ * @note NaN elements are left as NaN. Panics if lo > hi.
+ */
+template<typename T>
+void clamp(Slice<T> x, T lo, T hi) noexcept {
+    static_assert(!std::is_const_v<T>, "clamp() requires a mutable Slice");
+    CRAB_ASSERT(!(hi < lo), "clamp() called with lo > hi");
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_simd_kernels_v<T>) {
+        if (detail::use_avx2<T>()) {
+            detail::clamp_avx2<typename detail::Avx2OpsFor<T>::type>(x.data(), lo, hi, x.size());
+            return;
+        }
+    }
+#endif
+#if CRAB_SIMD_NEON
+    if constexpr (std::is_same_v<T, float>) {
+        if (detail::use_neon<T>()) {
+            detail::clamp_neon(x.data(), lo, hi, x.size());
+            return;
+        }
+    }
+#endif
+    detail::clamp_scalar(x.data(), lo, hi, x.size());
+}
+
+} // namespace crab
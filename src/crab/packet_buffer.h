@@ -0,0 +1,171 @@
+#pragma once
+
+/**
+ * @file packet_buffer.h
+ * @brief Fixed-capacity packet buffer with reserved headroom and tailroom.
+ *
+ * Tracks a data window inside inline storage so protocol layers can
+ * prepend and strip headers in O(1) without moving the payload.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crab {
+
+/**
+ * @brief Byte buffer with a movable data window (like Linux sk_buff).
+ *
+ * Storage is a fixed inline array (no heap). The data window
+ * [head, tail) sits inside it; headroom is the space before head and
+ * tailroom the space after tail. Encapsulation grows the window
+ * toward the front, decapsulation shrinks it, and the payload bytes
+ * never move.
+ *
+ * @tparam N Total buffer capacity in bytes
+ *
+ * @code{cpp}
+ *   crab::PacketBuffer<1514> pkt(64);            // 64 bytes headroom
+ *   auto payload = pkt.put_tail(len).unwrap();   // fill payload
+ *   auto udp = CRAB_TRY(pkt.push_header(8));     // write UDP header
+ *   auto ip  = CRAB_TRY(pkt.push_header(20));    // write IP header
+ *   send(pkt.data());
+ * @endcode
+ */
+template<std::size_t N>
+class PacketBuffer {
+    static_assert(N > 0, "PacketBuffer capacity must be non-zero");
+
+public:
+    using size_type = std::size_t;
+
+    // ========================================================================
+    // Constructors
+    // ========================================================================
+
+    /**
+     * @brief Construct empty buffer with the data window at the start.
+     */
+    PacketBuffer() noexcept = default;
+
+    /**
+     * @brief Construct empty buffer with reserved headroom.
+     * @note Panics if headroom > N; prefer with_headroom() for error handling.
+     */
+    explicit PacketBuffer(size_type headroom) noexcept
+        : m_head(headroom), m_tail(headroom) {
+        CRAB_ASSERT(headroom <= N, "PacketBuffer headroom exceeds capacity");
+    }
+
+    /**
+     * @brief Construct empty buffer with reserved headroom (checked).
+     * @return Ok if headroom fits, Err if headroom > N
+     */
+    static Result<PacketBuffer, CapacityExceeded> with_headroom(size_type headroom) noexcept {
+        if (headroom > N) {
+            return Err(CapacityExceeded{headroom, N});
+        }
+        return Ok(PacketBuffer(headroom));
+    }
+
+    // ========================================================================
+    // Size & Capacity
+    // ========================================================================
+
+    [[nodiscard]] size_type size() const noexcept { return m_tail - m_head; }
+    [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+    [[nodiscard]] bool empty() const noexcept { return m_tail == m_head; }
+    [[nodiscard]] size_type headroom() const noexcept { return m_head; }
+    [[nodiscard]] size_type tailroom() const noexcept { return N - m_tail; }
+
+    // ========================================================================
+    // Data Window
+    // ========================================================================
+
+    /**
+     * @brief View of the current data window.
+     */
+    [[nodiscard]] ByteSlice data() noexcept {
+        return ByteSlice(m_storage + m_head, m_tail - m_head);
+    }
+
+    [[nodiscard]] ConstByteSlice data() const noexcept {
+        return ConstByteSlice(m_storage + m_head, m_tail - m_head);
+    }
+
+    /**
+     * @brief Prepend n bytes to the data window (consumes headroom).
+     * @return View of the new header bytes, or Err if headroom < n
+     */
+    [[nodiscard]] Result<ByteSlice, CapacityExceeded> push_header(size_type n) noexcept {
+        if (n > m_head) {
+            return Err(CapacityExceeded{n, m_head});
+        }
+        m_head -= n;
+        return Ok(ByteSlice(m_storage + m_head, n));
+    }
+
+    /**
+     * @brief Strip n bytes from the front of the data window.
+     * @return View of the removed header bytes, or Err if size() < n
+     * @note The returned view stays valid until the headroom is reused.
+     */
+    [[nodiscard]] Result<ByteSlice, OutOfBounds> pull_header(size_type n) noexcept {
+        if (n > size()) {
+            return Err(OutOfBounds{n, size()});
+        }
+        ByteSlice header(m_storage + m_head, n);
+        m_head += n;
+        return Ok(header);
+    }
+
+    /**
+     * @brief Append n bytes to the data window (consumes tailroom).
+     * @return View of the new tail bytes, or Err if tailroom < n
+     */
+    [[nodiscard]] Result<ByteSlice, CapacityExceeded> put_tail(size_type n) noexcept {
+        if (n > tailroom()) {
+            return Err(CapacityExceeded{n, tailroom()});
+        }
+        ByteSlice tail(m_storage + m_tail, n);
+        m_tail += n;
+        return Ok(tail);
+    }
+
+    /**
+     * @brief Shrink the data window to len bytes (drops trailer/padding).
+     * @return View of the remaining data, or Err if len > size()
+     */
+    [[nodiscard]] Result<ByteSlice, OutOfBounds> trim(size_type len) noexcept {
+        if (len > size()) {
+            return Err(OutOfBounds{len, size()});
+        }
+        m_tail = m_head + len;
+        return Ok(data());
+    }
+
+    /**
+     * @brief Empty the buffer and reserve headroom for a new packet.
+     * @return Ok if headroom fits, Err if headroom > N
+     */
+    [[nodiscard]] Result<Unit, CapacityExceeded> reset(size_type headroom = 0) noexcept {
+        if (headroom > N) {
+            return Err(CapacityExceeded{headroom, N});
+        }
+        m_head = headroom;
+        m_tail = headroom;
+        return Ok();
+    }
+
+private:
+    uint8_t m_storage[N]{};
+    size_type m_head{0};
+    size_type m_tail{0};
+};
+
+} // namespace crab
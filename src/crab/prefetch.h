@@ -0,0 +1,237 @@
+#pragma once
+
+/**
+ * @file prefetch.h
+ * @brief Prefetch-aware traversal: overlap cache misses instead of paying
+ *        for them one at a time.
+ *
+ * Random lookups into a table larger than the cache stall for ~100 ns per
+ * miss when done one after another. These helpers issue the memory
+ * requests for upcoming items before the current one is processed:
+ *
+ * - for_each_prefetch(): linear walk, prefetching `distance` elements ahead
+ *   (for large or strided elements the hardware prefetcher misses).
+ * - for_each_indexed(): table[idx[i]] lookups, prefetching idx[i + distance].
+ * - for_each_group(): group prefetching. Locate G keys, prefetch all G
+ *   targets, then probe them, for one-hop lookups such as hash buckets.
+ * - amac(): Asynchronous Memory Access Chaining. Keeps W independent
+ *   multi-hop lookups (chains, trees) in flight and round-robins between
+ *   them, prefetching each one's next hop.
+ *
+ * The best distance or width depends on the machine and the work per item;
+ * benchmarks/prefetch_bench.cpp sweeps them (--distance, --group, --width).
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/gather.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(__GNUC__) && !defined(__clang__) && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace crab {
+
+// ============================================================================
+// Prefetch Primitives
+// ============================================================================
+
+/**
+ * @brief Hint that addr will be read soon.
+ * @tparam Locality 0 (use once) .. 3 (keep in all cache levels)
+ */
+template<int Locality = 3>
+inline void prefetch_read(const void* addr) noexcept {
+    static_assert(Locality >= 0 && Locality <= 3, "prefetch locality must be 0..3");
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr, 0, Locality);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(addr), Locality == 0 ? _MM_HINT_NTA : _MM_HINT_T0);
+#else
+    (void)addr;
+#endif
+}
+
+/**
+ * @brief Hint that addr will be written soon (fetch the line for ownership).
+ */
+template<int Locality = 3>
+inline void prefetch_write(const void* addr) noexcept {
+    static_assert(Locality >= 0 && Locality <= 3, "prefetch locality must be 0..3");
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr, 1, Locality);
+#else
+    prefetch_read<Locality>(addr);
+#endif
+}
+
+// ============================================================================
+// Linear and Indexed Traversal
+// ============================================================================
+
+/**
+ * @brief Call fn(element) for each element, prefetching `distance` ahead.
+ *
+ * Worth it when elements are large (several cache lines) or the per-element
+ * work is long enough that the hardware prefetcher falls behind.
+ */
+template<typename T, typename F>
+void for_each_prefetch(Slice<T> s, std::size_t distance, F&& fn) {
+    const std::size_t n = s.size();
+    T* p = s.data();
+    const std::size_t lead = distance < n ? n - distance : 0;
+    std::size_t i = 0;
+    for (; i < lead; ++i) {
+        prefetch_read(p + i + distance);
+        fn(p[i]);
+    }
+    for (; i < n; ++i) {
+        fn(p[i]);
+    }
+}
+
+/**
+ * @brief Call fn(table[idx[i]]) for each index, prefetching `distance` ahead.
+ *
+ * Indices are validated in bulk first (see gather.h), so the loop itself
+ * has no bounds checks and fn is never called if any index is bad.
+ *
+ * @return Ok, or Err(OutOfBounds{largest index, table.size()})
+ */
+template<typename T, typename F>
+Result<Unit, OutOfBounds> for_each_indexed(Slice<T> table, Slice<const uint32_t> idx,
+                                           std::size_t distance, F&& fn) {
+    const std::size_t n = idx.size();
+    if (n == 0) {
+        return Ok();
+    }
+    const uint32_t max = detail::max_index(idx.data(), n);
+    if (max >= table.size()) {
+        return Err(OutOfBounds{max, table.size()});
+    }
+    T* base = table.data();
+    const uint32_t* ix = idx.data();
+    const std::size_t lead = distance < n ? n - distance : 0;
+    std::size_t i = 0;
+    for (; i < lead; ++i) {
+        prefetch_read(base + ix[i + distance]);
+        fn(base[ix[i]]);
+    }
+    for (; i < n; ++i) {
+        fn(base[ix[i]]);
+    }
+    return Ok();
+}
+
+// ============================================================================
+// Group Prefetching
+// ============================================================================
+
+/**
+ * @brief One-hop batched lookups: locate a group of keys, prefetch, then probe.
+ *
+ * For each group of Group keys, locate(key) returns the address the probe
+ * will touch (e.g. a hash bucket); all Group addresses are prefetched before
+ * probe(key, address) runs for each, so the misses overlap.
+ *
+ * @tparam Group Keys in flight (8-16 is typical; tune with prefetch_bench)
+ * @param keys Keys to look up
+ * @param locate Callable: (const K&) -> pointer to the target
+ * @param probe Callable: (const K&, pointer) -> void
+ */
+template<std::size_t Group, typename K, typename Locate, typename Probe>
+void for_each_group(Slice<K> keys, Locate&& locate, Probe&& probe) {
+    static_assert(Group > 0, "for_each_group() needs a group size of at least 1");
+    using Ptr = decltype(locate(keys.data()[0]));
+    const std::size_t n = keys.size();
+    K* k = keys.data();
+    Ptr targets[Group];
+    for (std::size_t base = 0; base < n; base += Group) {
+        const std::size_t count = n - base < Group ? n - base : Group;
+        for (std::size_t g = 0; g < count; ++g) {
+            targets[g] = locate(k[base + g]);
+            prefetch_read(targets[g]);
+        }
+        for (std::size_t g = 0; g < count; ++g) {
+            probe(k[base + g], targets[g]);
+        }
+    }
+}
+
+// ============================================================================
+// AMAC (Asynchronous Memory Access Chaining)
+// ============================================================================
+
+/**
+ * @brief Interleave Width multi-hop lookups, prefetching each one's next hop.
+ *
+ * The machine describes one lookup as a sequence of steps:
+ * @code{cpp}
+ *   struct ChainLookup {
+ *       struct State { const Node* node; uint64_t key; };
+ *       // Begin a lookup; return the first address it will read
+ *       const void* start(State& s, const uint64_t& key);
+ *       // Do one hop (its address was prefetched earlier); return the next
+ *       // address to read, or nullptr when this lookup is finished
+ *       const void* step(State& s);
+ *   };
+ * @endcode
+ *
+ * amac() keeps Width lookups in flight in a ring. Each visit does one hop
+ * of one lookup and prefetches its next address. A finished slot is
+ * refilled with the next key. While one lookup waits on memory, the
+ * others make progress.
+ *
+ * @tparam Width Lookups in flight (tune with prefetch_bench; ~8-16)
+ */
+template<std::size_t Width, typename K, typename Machine>
+void amac(Slice<K> keys, Machine& machine) {
+    static_assert(Width > 0, "amac() needs a width of at least 1");
+    using State = typename Machine::State;
+    State states[Width];
+    bool active[Width] = {};
+
+    const std::size_t n = keys.size();
+    K* k = keys.data();
+    std::size_t next = 0;
+    std::size_t in_flight = 0;
+
+    // A lookup may finish in start() (nullptr): keep feeding the slot
+    auto refill = [&](std::size_t slot) {
+        while (next < n) {
+            const void* addr = machine.start(states[slot], k[next++]);
+            if (addr != nullptr) {
+                prefetch_read(addr);
+                active[slot] = true;
+                ++in_flight;
+                return;
+            }
+        }
+    };
+
+    for (std::size_t slot = 0; slot < Width; ++slot) {
+        refill(slot);
+    }
+    while (in_flight != 0) {
+        for (std::size_t slot = 0; slot < Width; ++slot) {
+            if (!active[slot]) {
+                continue;
+            }
+            const void* addr = machine.step(states[slot]);
+            if (addr != nullptr) {
+                prefetch_read(addr);
+            } else {
+                active[slot] = false;
+                --in_flight;
+                refill(slot);
+            }
+        }
+    }
+}
+
+} // namespace crab
@@ -0,0 +1,602 @@
+#pragma once
+
+/**
+ * @file prefix_trie.h
+ * @brief Heap-free multibit trie for longest-prefix matching.
+ *
+ * PrefixTrie stores (prefix, value) rules over bit strings: integer keys
+ * such as IPv4 addresses, 16-byte IPv6 addresses, or byte-string topics.
+ * A lookup returns the value of the longest stored prefix of the key.
+ *
+ * The layout follows Tree Bitmap / Poptrie. Each node consumes a 4-bit
+ * stride and keeps two bitmaps:
+ * - child_map: which of the 16 next nibbles have a child node
+ * - prefix_map: which prefixes ending inside this stride (lengths 0-3,
+ *   15 positions) carry a value
+ *
+ * A node's children, and separately its values, sit contiguously in fixed
+ * inline pools. A popcount of the bitmap below a position gives the
+ * offset into that block, so one node is 12 bytes and a lookup costs one
+ * node read per 4 key bits.
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/prefetch.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace crab {
+
+namespace detail {
+
+// ============================================================================
+// Block Allocator
+// ============================================================================
+
+/**
+ * @brief Hands out runs of 1..MaxBlock consecutive slots from [0, Capacity).
+ *
+ * Bump allocation with one free list per run length; a request with an
+ * empty list splits a longer free run. Each live run records an owner
+ * index, so compact() can slide every live run down over the holes and
+ * report the moves. That lets the owner fix its pointers, and nothing is
+ * lost to fragmentation.
+ */
+template<std::size_t Capacity, std::size_t MaxBlock>
+class BlockAllocator {
+    static_assert(MaxBlock < 0x80, "BlockAllocator run length must fit in 7 bits");
+
+public:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+
+    BlockAllocator() noexcept { reset(); }
+
+    /**
+     * @brief Allocate size slots owned by owner; None if no free run fits.
+     *
+     * None while free() >= size means the space is fragmented: compact()
+     * and retry.
+     */
+    [[nodiscard]] Option<uint32_t> alloc(std::size_t size, uint32_t owner) noexcept {
+        CRAB_DEBUG_ASSERT(size >= 1 && size <= MaxBlock, "BlockAllocator size out of range");
+        for (std::size_t s = size; s <= MaxBlock; ++s) {
+            const uint32_t idx = m_free[s];
+            if (idx == kNil) {
+                continue;
+            }
+            m_free[s] = m_link[idx];
+            if (s > size) {
+                push_free(idx + static_cast<uint32_t>(size), s - size);
+            }
+            return Some(take(idx, size, owner));
+        }
+        if (Capacity - m_top < size) {
+            return None;
+        }
+        const uint32_t idx = static_cast<uint32_t>(m_top);
+        m_top += size;
+        return Some(take(idx, size, owner));
+    }
+
+    void release(uint32_t idx) noexcept {
+        const std::size_t size = m_span[idx] & kSizeMask;
+        push_free(idx, size);
+        m_used -= size;
+    }
+
+    void set_owner(uint32_t idx, uint32_t owner) noexcept {
+        CRAB_DEBUG_ASSERT(m_span[idx] & kLive, "BlockAllocator owner set on a free run");
+        m_link[idx] = owner;
+    }
+
+    /**
+     * @brief Pack live runs to the front, calling move(from, to, size, owner)
+     *        for each one that moves (always to a lower index).
+     */
+    template<typename Move>
+    void compact(Move&& move) {
+        std::size_t w = 0;
+        for (std::size_t p = 0; p < m_top;) {
+            const std::size_t size = m_span[p] & kSizeMask;
+            if (m_span[p] & kLive) {
+                const uint32_t owner = m_link[p];
+                if (p != w) {
+                    m_span[w] = m_span[p];
+                    m_link[w] = owner;
+                    move(static_cast<uint32_t>(p), static_cast<uint32_t>(w), size, owner);
+                }
+                w += size;
+            }
+            p += size;
+        }
+        for (auto& head : m_free) {
+            head = kNil;
+        }
+        m_top = w;
+    }
+
+    void reset() noexcept {
+        for (auto& head : m_free) {
+            head = kNil;
+        }
+        m_top = 0;
+        m_used = 0;
+    }
+
+    /// Slots currently handed out
+    [[nodiscard]] std::size_t used() const noexcept { return m_used; }
+    [[nodiscard]] std::size_t available() const noexcept { return Capacity - m_used; }
+
+private:
+    static constexpr uint8_t kLive = 0x80;
+    static constexpr uint8_t kSizeMask = 0x7F;
+
+    uint32_t take(uint32_t idx, std::size_t size, uint32_t owner) noexcept {
+        m_span[idx] = static_cast<uint8_t>(size | kLive);
+        m_link[idx] = owner;
+        m_used += size;
+        return idx;
+    }
+
+    void push_free(uint32_t idx, std::size_t size) noexcept {
+        m_span[idx] = static_cast<uint8_t>(size);
+        m_link[idx] = m_free[size];
+        m_free[size] = idx;
+    }
+
+    uint32_t m_free[MaxBlock + 1];
+    uint32_t m_link[Capacity];    // Run start: owner if live, next free run otherwise
+    uint8_t m_span[Capacity];     // Run start: length, plus kLive
+    std::size_t m_top;
+    std::size_t m_used;
+};
+
+// Baseline x86-64 has no popcnt and __builtin_popcount becomes a libgcc
+// call; a 16-bit SWAR count is a handful of ALU ops instead
+inline unsigned popcount16(uint32_t x) noexcept {
+#if defined(__POPCNT__) || defined(__aarch64__)
+    return static_cast<unsigned>(__builtin_popcount(x));
+#else
+    x = x - ((x >> 1) & 0x5555u);
+    x = (x & 0x3333u) + ((x >> 2) & 0x3333u);
+    x = (x + (x >> 4)) & 0x0F0Fu;
+    return (x + (x >> 8)) & 0x1Fu;
+#endif
+}
+
+} // namespace detail
+
+// ============================================================================
+// PrefixTrie
+// ============================================================================
+
+/**
+ * @brief Fixed-capacity longest-prefix-match table.
+ *
+ * @tparam V Value type (default-constructible, movable)
+ * @tparam MaxNodes Trie nodes (12 bytes each); one per 4 bits of distinct
+ *         prefix path, the root included
+ * @tparam MaxPrefixes Stored rules
+ *
+ * @code{cpp}
+ *   crab::PrefixTrie<uint16_t, 4096, 1024> routes;
+ *   routes.insert(uint32_t{0x0A000000}, 8, 1).unwrap();    // 10.0.0.0/8
+ *   routes.insert(uint32_t{0x0A010000}, 16, 2).unwrap();   // 10.1.0.0/16
+ *   auto hop = routes.longest_prefix(uint32_t{0x0A010203});   // Some(2)
+ * @endcode
+ */
+template<typename V, std::size_t MaxNodes, std::size_t MaxPrefixes>
+class PrefixTrie {
+    static_assert(MaxNodes >= 1 && MaxNodes < 0x80000000u, "PrefixTrie needs between 1 and 2^31 - 1 nodes");
+    static_assert(MaxPrefixes >= 1 && MaxPrefixes < 0xFFFFFFFFu, "PrefixTrie needs between 1 and 2^32 - 1 prefixes");
+    static_assert(std::is_default_constructible_v<V>, "PrefixTrie values must be default-constructible");
+
+public:
+    using value_type = V;
+    using size_type = std::size_t;
+
+    static constexpr unsigned kStride = 4;
+
+    PrefixTrie() noexcept { clear(); }
+
+    // ========================================================================
+    // Insert
+    // ========================================================================
+
+    /**
+     * @brief Add or replace the rule for the top prefix_bits of an integer key.
+     * @return Ok(true) if added, Ok(false) if an existing rule was replaced,
+     *         Err(CapacityExceeded) if the node or prefix pool is full
+     * @note On Err the rule is not stored; interior nodes created on the way
+     *       stay and are reused by later inserts.
+     */
+    template<typename K, typename = std::enable_if_t<std::is_unsigned_v<K>>>
+    Result<bool, CapacityExceeded> insert(K key, std::size_t prefix_bits, V value) {
+        CRAB_ASSERT(prefix_bits <= kKeyBits<K>, "PrefixTrie prefix longer than the key");
+        return insert_with([key](std::size_t d) { return int_nibble(key, d); }, prefix_bits, std::move(value));
+    }
+
+    /**
+     * @brief Add or replace the rule for the first prefix_bits of a byte key.
+     *
+     * Bits are taken most significant first, so a 16-byte IPv6 address or a
+     * topic string ("orders/eu" with prefix_bits = 72) both work.
+     */
+    Result<bool, CapacityExceeded> insert(ConstByteSlice key, std::size_t prefix_bits, V value) {
+        CRAB_ASSERT(prefix_bits <= key.size() * 8, "PrefixTrie prefix longer than the key");
+        return insert_with([key](std::size_t d) { return byte_nibble(key, d); }, prefix_bits, std::move(value));
+    }
+
+    /**
+     * @brief Remove every rule; capacity is fully reclaimed.
+     */
+    void clear() noexcept {
+        m_node_alloc.reset();
+        m_value_alloc.reset();
+        m_size = 0;
+        const uint32_t root = m_node_alloc.alloc(1, kNil).unwrap();
+        CRAB_DEBUG_ASSERT(root == 0, "PrefixTrie root must be node 0");
+        m_nodes[root] = Node{};
+    }
+
+    // ========================================================================
+    // Lookup
+    // ========================================================================
+
+    /**
+     * @brief Value of the longest rule that is a prefix of key, or None.
+     */
+    template<typename K, typename = std::enable_if_t<std::is_unsigned_v<K>>>
+    [[nodiscard]] Option<std::reference_wrapper<const V>> longest_prefix(K key) const noexcept {
+        return wrap(find([key](std::size_t d) { return int_nibble(key, d); }, kKeyBits<K>));
+    }
+
+    template<typename K, typename = std::enable_if_t<std::is_unsigned_v<K>>>
+    [[nodiscard]] Option<std::reference_wrapper<V>> longest_prefix(K key) noexcept {
+        return wrap_mut(find([key](std::size_t d) { return int_nibble(key, d); }, kKeyBits<K>));
+    }
+
+    /**
+     * @brief Longest rule that is a prefix of all key.size() * 8 bits of key.
+     */
+    [[nodiscard]] Option<std::reference_wrapper<const V>> longest_prefix(ConstByteSlice key) const noexcept {
+        return wrap(find([key](std::size_t d) { return byte_nibble(key, d); }, key.size() * 8));
+    }
+
+    [[nodiscard]] Option<std::reference_wrapper<V>> longest_prefix(ConstByteSlice key) noexcept {
+        return wrap_mut(find([key](std::size_t d) { return byte_nibble(key, d); }, key.size() * 8));
+    }
+
+    /**
+     * @brief out[i] = value for keys[i], or miss if no rule matches.
+     *
+     * Keys go through in groups of 8 that descend in lockstep, one level
+     * per pass, prefetching each lane's next node. Integer keys share a
+     * length, so no lane waits on another's depth. With tables larger
+     * than cache this hides most of the per-level miss latency.
+     *
+     * @return Err(OutOfBounds) if out and keys differ in length
+     */
+    template<typename U>
+    Result<Unit, OutOfBounds> longest_prefix_batch(Slice<U> keys, Slice<V> out, const V& miss) const {
+        using K = std::remove_const_t<U>;
+        static_assert(std::is_unsigned_v<K>, "PrefixTrie::longest_prefix_batch() takes unsigned integer keys");
+        if (out.size() != keys.size()) {
+            return Err(OutOfBounds{out.size(), keys.size()});
+        }
+        const std::size_t n = keys.size();
+        const K* k = keys.data();
+        V* o = out.data();
+        for (std::size_t base = 0; base < n; base += kBatchWidth) {
+            const std::size_t lanes = n - base < kBatchWidth ? n - base : kBatchWidth;
+            uint32_t node[kBatchWidth] = {};
+            uint32_t best[kBatchWidth];
+            uint32_t active = (1u << lanes) - 1u;
+            for (std::size_t g = 0; g < lanes; ++g) {
+                best[g] = kNil;
+            }
+            for (std::size_t d = 0; active != 0; d += kStride) {
+                const std::size_t rem = kKeyBits<K> - d;
+                for (std::size_t g = 0; g < lanes; ++g) {
+                    if (((active >> g) & 1u) == 0) {
+                        continue;
+                    }
+                    node[g] = step(node[g], rem == 0 ? 0u : int_nibble(k[base + g], d), rem, best[g]);
+                    if (node[g] == kNil) {
+                        active &= ~(1u << g);
+                    } else {
+                        prefetch_read(&m_nodes[node[g]]);
+                    }
+                }
+            }
+            for (std::size_t g = 0; g < lanes; ++g) {
+                o[base + g] = best[g] == kNil ? miss : m_values[best[g]];
+            }
+        }
+        return Ok();
+    }
+
+    // ========================================================================
+    // Size & Capacity
+    // ========================================================================
+
+    /// Number of stored rules
+    [[nodiscard]] size_type size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] size_type node_count() const noexcept { return m_node_alloc.used(); }
+    [[nodiscard]] static constexpr size_type node_capacity() noexcept { return MaxNodes; }
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return MaxPrefixes; }
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr uint32_t kParked = 0x80000000u;    // Owner tag during compaction
+    static constexpr std::size_t kBatchWidth = 8;
+
+    template<typename K>
+    static constexpr std::size_t kKeyBits = sizeof(K) * 8;
+
+    struct Node {
+        uint16_t child_map = 0;     // Bit n: child for next nibble n
+        uint16_t prefix_map = 0;    // Bit (2^len - 1 + bits): rule ending here
+        uint32_t child_base = 0;    // First child in m_nodes
+        uint32_t value_base = 0;    // First value in m_values
+    };
+
+    template<typename K>
+    static unsigned int_nibble(K key, std::size_t d) noexcept {
+        return static_cast<unsigned>(key >> (kKeyBits<K> - kStride - d)) & 0xFu;
+    }
+
+    static unsigned byte_nibble(ConstByteSlice key, std::size_t d) noexcept {
+        return (static_cast<unsigned>(key.unchecked(d / 8)) >> (4 - (d & 4))) & 0xFu;
+    }
+
+    static unsigned rank(uint32_t map, unsigned pos) noexcept {
+        return detail::popcount16(map & ((1u << pos) - 1u));
+    }
+
+    // Position in prefix_map of the len-bit rule whose bits lead nibble
+    static unsigned prefix_pos(unsigned len, unsigned nibble) noexcept {
+        return (1u << len) - 1u + (nibble >> (kStride - len));
+    }
+
+    /**
+     * One trie level: record the longest rule in this node that matches,
+     * then return the child to visit next, or kNil to stop.
+     * rem is the number of key bits left from this node's depth.
+     */
+    uint32_t step(uint32_t node, unsigned nibble, std::size_t rem, uint32_t& best) const noexcept {
+        const Node& n = m_nodes[node];
+        // Every in-node rule the nibble can match, one per length 0..3;
+        // a longer length always sits at a higher bit
+        uint32_t cand = (1u << prefix_pos(0, nibble)) | (1u << prefix_pos(1, nibble)) |
+                        (1u << prefix_pos(2, nibble)) | (1u << prefix_pos(3, nibble));
+        if (rem < kStride - 1) {
+            cand &= (1u << ((1u << (rem + 1)) - 1u)) - 1u;
+        }
+        const uint32_t hit = n.prefix_map & cand;
+        if (hit != 0) {
+            const unsigned pos = 31u - static_cast<unsigned>(__builtin_clz(hit));
+            best = n.value_base + rank(n.prefix_map, pos);
+        }
+        if (rem < kStride || ((n.child_map >> nibble) & 1u) == 0) {
+            return kNil;
+        }
+        return n.child_base + rank(n.child_map, nibble);
+    }
+
+    template<typename NibbleAt>
+    uint32_t find(NibbleAt nibble_at, std::size_t key_bits) const noexcept {
+        uint32_t node = 0;
+        uint32_t best = kNil;
+        for (std::size_t d = 0;; d += kStride) {
+            const std::size_t rem = key_bits - d;
+            node = step(node, rem == 0 ? 0u : nibble_at(d), rem, best);
+            if (node == kNil) {
+                return best;
+            }
+        }
+    }
+
+    template<typename NibbleAt>
+    Result<bool, CapacityExceeded> insert_with(NibbleAt nibble_at, std::size_t prefix_bits, V&& value) {
+        uint32_t node = 0;
+        std::size_t d = 0;
+        for (; prefix_bits - d >= kStride; d += kStride) {
+            const unsigned nibble = nibble_at(d);
+            if (((m_nodes[node].child_map >> nibble) & 1u) == 0) {
+                auto grown = add_child(node, nibble);
+                if (grown.is_err()) {
+                    return Err(grown.unwrap_err());
+                }
+            }
+            const Node& n = m_nodes[node];
+            node = n.child_base + rank(n.child_map, nibble);
+        }
+
+        const unsigned len = static_cast<unsigned>(prefix_bits - d);
+        const unsigned pos = prefix_pos(len, len == 0 ? 0u : nibble_at(d));
+        Node& n = m_nodes[node];
+        if ((n.prefix_map >> pos) & 1u) {
+            m_values[n.value_base + rank(n.prefix_map, pos)] = std::move(value);
+            return Ok(false);
+        }
+        const unsigned at = rank(n.prefix_map, pos);
+        auto base = grow_values(node, at);
+        if (base.is_none()) {
+            return Err(CapacityExceeded{m_size + 1, MaxPrefixes});
+        }
+        m_values[base.unwrap() + at] = std::move(value);
+        n.value_base = base.unwrap();
+        n.prefix_map = static_cast<uint16_t>(n.prefix_map | (1u << pos));
+        ++m_size;
+        return Ok(true);
+    }
+
+    // Regrow node's child block by one, leaving an empty node for nibble.
+    // Compaction may move node itself, so its index is updated in place.
+    Result<Unit, CapacityExceeded> add_child(uint32_t& node, unsigned nibble) noexcept {
+        const unsigned at = rank(m_nodes[node].child_map, nibble);
+        auto base = grow_children(node, at);
+        if (base.is_none()) {
+            return Err(CapacityExceeded{m_node_alloc.used() + 1, MaxNodes});
+        }
+        Node& n = m_nodes[node];
+        const unsigned count = detail::popcount16(n.child_map);
+        // Runs owned by the moved children follow them
+        for (unsigned i = 0; i <= count; ++i) {
+            if (i != at) {
+                adopt(base.unwrap() + i);
+            }
+        }
+        m_nodes[base.unwrap() + at] = Node{};
+        n.child_base = base.unwrap();
+        n.child_map = static_cast<uint16_t>(n.child_map | (1u << nibble));
+        return Ok();
+    }
+
+    /**
+     * Move node's value block into a new run one longer, with slot `at`
+     * open; the old run is released. If free space is fragmented, the
+     * block is parked on the stack while the pool compacts, so this only
+     * fails when every slot is in use.
+     */
+    Option<uint32_t> grow_values(uint32_t node, unsigned at) {
+        const Node& n = m_nodes[node];
+        const unsigned count = detail::popcount16(n.prefix_map);
+        auto base = m_value_alloc.alloc(count + 1, node);
+        if (base.is_some()) {
+            move_block(m_values + n.value_base, count, m_values + base.unwrap(), at);
+            if (count != 0) {
+                m_value_alloc.release(n.value_base);
+            }
+            return base;
+        }
+        if (m_value_alloc.available() == 0) {
+            return None;
+        }
+        V parked[15];
+        move_block(m_values + n.value_base, count, parked, count);
+        if (count != 0) {
+            m_value_alloc.release(n.value_base);
+        }
+        compact_values();
+        const uint32_t fresh = m_value_alloc.alloc(count + 1, node).unwrap();
+        move_block(parked, count, m_values + fresh, at);
+        return Some(fresh);
+    }
+
+    // Same as grow_values() for the child block; the caller re-adopts
+    Option<uint32_t> grow_children(uint32_t& node, unsigned at) noexcept {
+        const Node& n = m_nodes[node];
+        const unsigned count = detail::popcount16(n.child_map);
+        auto base = m_node_alloc.alloc(count + 1, node);
+        if (base.is_some()) {
+            move_block(m_nodes + n.child_base, count, m_nodes + base.unwrap(), at);
+            if (count != 0) {
+                m_node_alloc.release(n.child_base);
+            }
+            return base;
+        }
+        if (m_node_alloc.available() == 0) {
+            return None;
+        }
+        // Parked children's runs may move during compaction; tag them so
+        // the fix-up lands in parked[] instead of a stale slot
+        Node parked[16];
+        const uint32_t old_base = n.child_base;
+        move_block(m_nodes + old_base, count, parked, count);
+        for (unsigned i = 0; i < count; ++i) {
+            if (parked[i].child_map != 0) {
+                m_node_alloc.set_owner(parked[i].child_base, kParked | i);
+            }
+        }
+        if (count != 0) {
+            m_node_alloc.release(old_base);
+        }
+        // The parent still names the released run; hide it so adopt()
+        // leaves it alone if compaction moves the parent itself
+        const uint16_t child_map = n.child_map;
+        m_nodes[node].child_map = 0;
+        compact_nodes(node, parked);
+        m_nodes[node].child_map = child_map;
+        const uint32_t fresh = m_node_alloc.alloc(count + 1, node).unwrap();
+        move_block(parked, count, m_nodes + fresh, at);
+        return Some(fresh);
+    }
+
+    // Re-point the runs owned by the node now at idx
+    void adopt(uint32_t idx) noexcept {
+        const Node& n = m_nodes[idx];
+        if (n.child_map != 0) {
+            m_node_alloc.set_owner(n.child_base, idx);
+        }
+        if (n.prefix_map != 0) {
+            m_value_alloc.set_owner(n.value_base, idx);
+        }
+    }
+
+    void compact_nodes(uint32_t& watch, Node* parked) noexcept {
+        m_node_alloc.compact([&](uint32_t from, uint32_t to, std::size_t size, uint32_t owner) {
+            for (uint32_t i = 0; i < size; ++i) {
+                m_nodes[to + i] = m_nodes[from + i];
+                adopt(to + i);
+            }
+            Node& parent = (owner & kParked) ? parked[owner & ~kParked] : m_nodes[owner];
+            parent.child_base = to;
+            if (watch >= from && watch < from + size) {
+                watch = to + (watch - from);
+            }
+        });
+    }
+
+    void compact_values() {
+        m_value_alloc.compact([&](uint32_t from, uint32_t to, std::size_t size, uint32_t owner) {
+            for (uint32_t i = 0; i < size; ++i) {
+                m_values[to + i] = std::move(m_values[from + i]);
+            }
+            m_nodes[owner].value_base = to;
+        });
+    }
+
+    // Move count elements from src to dst, leaving dst[at] open
+    template<typename T>
+    static void move_block(T* src, unsigned count, T* dst, unsigned at) {
+        for (unsigned i = 0; i < at; ++i) {
+            dst[i] = std::move(src[i]);
+        }
+        for (unsigned i = at; i < count; ++i) {
+            dst[i + 1] = std::move(src[i]);
+        }
+    }
+
+    Option<std::reference_wrapper<const V>> wrap(uint32_t idx) const noexcept {
+        if (idx == kNil) {
+            return None;
+        }
+        return Some(std::cref(m_values[idx]));
+    }
+
+    Option<std::reference_wrapper<V>> wrap_mut(uint32_t idx) noexcept {
+        if (idx == kNil) {
+            return None;
+        }
+        return Some(std::ref(m_values[idx]));
+    }
+
+    Node m_nodes[MaxNodes];
+    V m_values[MaxPrefixes];
+    detail::BlockAllocator<MaxNodes, 16> m_node_alloc;
+    detail::BlockAllocator<MaxPrefixes, 15> m_value_alloc;
+    size_type m_size;
+};
+
+} // namespace crab
@@ -11,13 +11,40 @@
 #include "crab/result.h"
 #include "crab/option.h"
 #include "crab/slice.h"
+#include "crab/slice2d.h"
+#include "crab/aligned_slice.h"
+#include "crab/iter.h"
 
 // Containers
 #include "crab/static_vector.h"
 #include "crab/ring_buffer.h"
+#include "crab/packet_buffer.h"
+#include "crab/buffer_pool.h"
+#include "crab/prefix_trie.h"
+#include "crab/interner.h"
+#include "crab/append_vector.h"
+
+// Bulk memory / SIMD
+#include "crab/simd.h"
+#include "crab/streaming.h"
+#include "crab/numeric.h"
+#include "crab/gather.h"
+#include "crab/sort.h"
+#include "crab/set_ops.h"
+#include "crab/select.h"
+#include "crab/prefetch.h"
+#include "crab/matrix.h"
+#include "crab/dsp.h"
+#include "crab/fft.h"
+#include "crab/fixed.h"
+#include "crab/fast_math.h"
+#include "crab/window.h"
+#include "crab/sketch.h"
 
 // Synchronization
 #include "crab/mutex.h"
+#include "crab/concurrent_hash_map.h"
+#include "crab/rate_limiter.h"
 
 // Utilities
 #include "crab/macros.h"
@@ -36,8 +63,31 @@
  * - `crab::Result<T, E>`: Error handling without exceptions
  * - `crab::Option<T>`: Nullable values with monadic interface
  * - `crab::Slice<T>`: Bounds-checked non-owning view
+ * - `crab::Slice2D<T>`: Row-major 2-D view with pitch (images, matrices)
+ * - `crab::AlignedSlice<T, A>`: Slice with a proven alignment for SIMD loads
+ * - `crab::iter(slice)`: Lazy map/filter/zip/fold pipelines over slices
  * - `crab::StaticVector<T, N>`: Fixed-capacity vector (no heap)
+ * - `crab::PacketBuffer<N>`: Byte buffer with headroom/tailroom for headers
+ * - `crab::BufferPool<Size, N>`: Refcounted byte buffers for zero-copy fan-out
+ * - `crab::PrefixTrie<V, Nodes, Rules>`: Heap-free longest-prefix match (popcount-indexed multibit trie)
+ * - `crab::StringInterner<Bytes, N>`: Byte strings to dense 32-bit IDs, lock-free readers
+ * - `crab::AppendVector<T, N>`: Lock-free multi-writer append, published-prefix reads
  * - `crab::Mutex<T>`: Data-owning mutex (Rust pattern)
+ * - `crab::ConcurrentHashMap<K, V, N>`: Lock-free reads, per-slot CAS writes
+ * - `crab::RateLimiter<Clock>`: Lock-free token bucket, one CAS per grant
+ * - `crab::sum(slice)`, `crab::dot(a, b)`: SIMD reductions with runtime dispatch
+ * - `crab::gather`, `crab::select_by_mask`: Bulk-validated gather/scatter and compaction
+ * - `crab::radix_sort`, `crab::sort_small`: Allocation-free radix sort and sorting networks
+ * - `crab::set_intersection` etc.: SIMD/galloping operations on sorted ID lists
+ * - `crab::top_k`, `crab::TopK<T, K>`, `crab::select_nth`: Heap-free ranking and selection
+ * - `crab::for_each_indexed`, `crab::amac`: Prefetching traversals that overlap cache misses
+ * - `crab::StaticMatrix<T, R, C>`, `crab::StaticVec<T, N>`: Padded fixed-size linear algebra
+ * - `crab::FirFilter`, `crab::BiquadCascade`: Heap-free block DSP filters on Slice<float>
+ * - `crab::Fft<N>`: Fixed-size FFT with compile-time twiddle tables
+ * - `crab::Fixed<I, F>`, `crab::mac_sat`: Q-format fixed point with saturating SIMD kernels
+ * - `crab::fast_exp`, `crab::fast_tanh` etc.: Vectorized math approximations with documented ULP bounds
+ * - `crab::WindowMin`, `crab::WindowStats`, `crab::EwmaStats`: O(1) sliding-window statistics
+ * - `crab::DDSketch`, `crab::QuantileSketch`, `crab::HyperLogLog`, `crab::CountMinSketch`: Mergeable fixed-memory sketches
  * 
  * ## Quick Start
  * 
@@ -0,0 +1,299 @@
+#pragma once
+
+/**
+ * @file rate_limiter.h
+ * @brief Lock-free token-bucket rate limiters.
+ *
+ * The bucket state is a single atomic 64-bit word, updated by CAS. It
+ * holds the "theoretical arrival time" (TAT) of the GCRA formulation:
+ * the instant at which the bucket would be full again. That one
+ * timestamp encodes both the last refill and the token count:
+ *
+ *   tokens(now) = burst - (max(TAT, now) - now) / interval
+ *
+ * so refill needs no separate counter and cannot drift or overflow.
+ * Granting n tokens advances TAT by n * interval, and is refused if that
+ * would push it more than burst * interval past now.
+ *
+ * ## Cost
+ *
+ * A granted try_acquire() is one clock read, one relaxed load and one
+ * CAS. A refused one is a clock read and a load: throttled clients do
+ * not write the shared line. Under heavy contention, ShardedRateLimiter
+ * spreads the CAS traffic over per-thread cache lines.
+ *
+ * ## Clocks
+ *
+ * The clock is a policy type with two static members:
+ * @code
+ *   struct MyClock {
+ *       static uint64_t now() noexcept;             // monotonic ticks
+ *       static double ticks_per_second() noexcept;  // may be calibrated
+ *   };
+ * @endcode
+ * SteadyClock (nanoseconds from std::chrono::steady_clock) is the
+ * default. A TSC-based clock plugs in the same way.
+ */
+
+#include "crab/macros.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace crab {
+
+/// Default rate-limiter clock: std::chrono::steady_clock in nanoseconds
+struct SteadyClock {
+    static uint64_t now() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+    static double ticks_per_second() noexcept { return 1e9; }
+};
+
+namespace detail {
+
+/**
+ * Limiter time is clock ticks since construction, with kRateFracBits
+ * fractional bits so emission intervals of a few ticks stay accurate.
+ * At 1 GHz ticks this wraps after ~36 years of uptime.
+ */
+constexpr unsigned kRateFracBits = 4;
+
+inline uint64_t rate_interval(double tokens_per_second, double ticks_per_second) noexcept {
+    CRAB_ASSERT(tokens_per_second > 0.0, "rate must be positive");
+    const double units = ticks_per_second * double(uint64_t{1} << kRateFracBits) / tokens_per_second;
+    CRAB_ASSERT(units >= 1.0 && units < 1e18, "rate out of range for this clock");
+    return static_cast<uint64_t>(units + 0.5);
+}
+
+/// burst * interval, asserting it fits (slow rates with large bursts overflow)
+inline uint64_t rate_tolerance(uint64_t interval, uint32_t burst) noexcept {
+    CRAB_ASSERT(burst <= UINT64_MAX / interval, "burst too large for this rate");
+    return interval * burst;
+}
+
+/**
+ * GCRA step: grant `cost` if the bucket at `tat` can absorb it by `now`.
+ * Relaxed ordering is enough; the word guards no other memory.
+ */
+inline bool gcra_acquire(std::atomic<uint64_t>& tat, uint64_t now, uint64_t cost, uint64_t tolerance) noexcept {
+    uint64_t cur = tat.load(std::memory_order_relaxed);
+    for (;;) {
+        const uint64_t next = (cur > now ? cur : now) + cost;
+        if (next - now > tolerance) {
+            return false;
+        }
+        if (tat.compare_exchange_weak(cur, next, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+inline uint32_t gcra_available(const std::atomic<uint64_t>& tat, uint64_t now, uint64_t interval,
+                               uint64_t tolerance) noexcept {
+    const uint64_t cur = tat.load(std::memory_order_relaxed);
+    const uint64_t debt = cur > now ? cur - now : 0;
+    return debt >= tolerance ? 0 : static_cast<uint32_t>((tolerance - debt) / interval);
+}
+
+/// Small per-thread index, assigned round-robin on first use
+inline uint32_t thread_index() noexcept {
+    static std::atomic<uint32_t> next{0};
+    thread_local const uint32_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+} // namespace detail
+
+// ============================================================================
+// RateLimiter
+// ============================================================================
+
+/**
+ * @brief Lock-free token bucket: `rate` tokens per second, up to `burst` banked.
+ *
+ * Starts full. Safe to share across any number of threads.
+ *
+ * @tparam Clock Tick source (see file comment)
+ *
+ * @code{cpp}
+ *   crab::RateLimiter<> limiter(1000.0, 50);  // 1000 msg/s, bursts of 50
+ *   if (limiter.try_acquire()) { send(msg); }
+ *   if (limiter.try_acquire(batch.size())) { send_all(batch); }
+ * @endcode
+ */
+template<typename Clock = SteadyClock>
+class RateLimiter {
+public:
+    RateLimiter(double tokens_per_second, uint32_t burst) noexcept
+        : m_interval(detail::rate_interval(tokens_per_second, Clock::ticks_per_second())),
+          m_tolerance(detail::rate_tolerance(m_interval, burst)),
+          m_burst(burst),
+          m_epoch(Clock::now()) {
+        m_tat.store(0, std::memory_order_relaxed);
+    }
+
+    // Non-copyable, non-movable (shared by address between threads)
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+    RateLimiter(RateLimiter&&) = delete;
+    RateLimiter& operator=(RateLimiter&&) = delete;
+
+    // ========================================================================
+    // Acquire
+    // ========================================================================
+
+    /**
+     * @brief Take n tokens if all n are available now.
+     * @return false (taking nothing) if fewer than n are banked, or n > burst
+     */
+    [[nodiscard]] bool try_acquire(uint32_t n = 1) noexcept { return try_acquire_at(Clock::now(), n); }
+
+    /**
+     * @brief try_acquire() at a clock reading the caller already has.
+     *
+     * Lets a loop amortize one clock read over many checks. `ticks` must
+     * come from the same Clock; readings may arrive slightly out of order
+     * across threads.
+     */
+    [[nodiscard]] bool try_acquire_at(uint64_t ticks, uint32_t n = 1) noexcept {
+        if (n > m_burst) {
+            return false;
+        }
+        return detail::gcra_acquire(m_tat, to_units(ticks), m_interval * n, m_tolerance);
+    }
+
+    // ========================================================================
+    // Observers
+    // ========================================================================
+
+    /// Tokens that could be taken right now (a snapshot; may change at once)
+    [[nodiscard]] uint32_t available() const noexcept { return available_at(Clock::now()); }
+
+    [[nodiscard]] uint32_t available_at(uint64_t ticks) const noexcept {
+        return detail::gcra_available(m_tat, to_units(ticks), m_interval, m_tolerance);
+    }
+
+    [[nodiscard]] uint32_t burst() const noexcept { return m_burst; }
+
+    /// Refill the bucket to `burst` tokens
+    void reset() noexcept { m_tat.store(0, std::memory_order_relaxed); }
+
+private:
+    uint64_t to_units(uint64_t ticks) const noexcept {
+        return ticks > m_epoch ? (ticks - m_epoch) << detail::kRateFracBits : 0;
+    }
+
+    alignas(CRAB_CACHE_LINE_SIZE) std::atomic<uint64_t> m_tat;
+    uint64_t m_interval;   // Time units per token
+    uint64_t m_tolerance;  // burst * m_interval
+    uint32_t m_burst;
+    uint64_t m_epoch;
+};
+
+// ============================================================================
+// ShardedRateLimiter
+// ============================================================================
+
+/**
+ * @brief Rate limiter split into Shards independent buckets.
+ *
+ * Each shard owns rate / Shards and an even share of the burst on its own
+ * cache line. A thread always starts at its home shard, so the common
+ * case touches no line another thread is writing. When the home shard is
+ * empty, the other shards are tried in turn before refusing, so the
+ * aggregate still honours `rate` and `burst`.
+ *
+ * A single request larger than one shard's burst share always fails.
+ * Size the burst (or Shards) accordingly.
+ *
+ * @tparam Shards Number of buckets (typically the number of hot threads)
+ * @tparam Clock Tick source (see file comment)
+ */
+template<std::size_t Shards, typename Clock = SteadyClock>
+class ShardedRateLimiter {
+    static_assert(Shards > 0, "ShardedRateLimiter needs at least one shard");
+
+public:
+    ShardedRateLimiter(double tokens_per_second, uint32_t burst) noexcept
+        : m_interval(detail::rate_interval(tokens_per_second / double(Shards), Clock::ticks_per_second())),
+          m_burst(burst),
+          m_epoch(Clock::now()) {
+        for (std::size_t i = 0; i < Shards; ++i) {
+            m_shards[i].burst = static_cast<uint32_t>(burst / Shards + (i < burst % Shards ? 1 : 0));
+            m_shards[i].tolerance = detail::rate_tolerance(m_interval, m_shards[i].burst);
+            m_shards[i].tat.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ShardedRateLimiter(const ShardedRateLimiter&) = delete;
+    ShardedRateLimiter& operator=(const ShardedRateLimiter&) = delete;
+    ShardedRateLimiter(ShardedRateLimiter&&) = delete;
+    ShardedRateLimiter& operator=(ShardedRateLimiter&&) = delete;
+
+    // ========================================================================
+    // Acquire
+    // ========================================================================
+
+    /// Take n tokens from one shard, home shard first
+    [[nodiscard]] bool try_acquire(uint32_t n = 1) noexcept { return try_acquire_at(Clock::now(), n); }
+
+    [[nodiscard]] bool try_acquire_at(uint64_t ticks, uint32_t n = 1) noexcept {
+        const uint64_t now = to_units(ticks);
+        const uint64_t cost = m_interval * n;
+        const std::size_t home = detail::thread_index() % Shards;
+        for (std::size_t k = 0; k < Shards; ++k) {
+            Shard& s = m_shards[(home + k) % Shards];
+            if (n <= s.burst && detail::gcra_acquire(s.tat, now, cost, s.tolerance)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ========================================================================
+    // Observers
+    // ========================================================================
+
+    /// Tokens banked across all shards (a snapshot)
+    [[nodiscard]] uint32_t available() const noexcept { return available_at(Clock::now()); }
+
+    [[nodiscard]] uint32_t available_at(uint64_t ticks) const noexcept {
+        const uint64_t now = to_units(ticks);
+        uint32_t total = 0;
+        for (const Shard& s : m_shards) {
+            total += detail::gcra_available(s.tat, now, m_interval, s.tolerance);
+        }
+        return total;
+    }
+
+    [[nodiscard]] uint32_t burst() const noexcept { return m_burst; }
+    [[nodiscard]] static constexpr std::size_t shard_count() noexcept { return Shards; }
+
+    void reset() noexcept {
+        for (Shard& s : m_shards) {
+            s.tat.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct alignas(CRAB_CACHE_LINE_SIZE) Shard {
+        std::atomic<uint64_t> tat;
+        uint64_t tolerance;
+        uint32_t burst;
+    };
+
+    uint64_t to_units(uint64_t ticks) const noexcept {
+        return ticks > m_epoch ? (ticks - m_epoch) << detail::kRateFracBits : 0;
+    }
+
+    Shard m_shards[Shards];
+    uint64_t m_interval;  // Time units per token, per shard
+    uint32_t m_burst;
+    uint64_t m_epoch;
+};
+
+} // namespace crab
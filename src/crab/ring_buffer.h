@@ -12,7 +12,15 @@
  */
 
 #include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
 #include "crab/macros.h"
+#include "crab/error_types.h"
+
+#if CRAB_HAS_POSIX_IO
+#include <sys/uio.h>
+#include <cerrno>
+#endif
 
 #include <atomic>
 #include <cstddef>
@@ -195,6 +203,208 @@ public:
                m_tail.load(std::memory_order_acquire);
     }
     
+    // ========================================================================
+    // Bulk Views (trivially copyable elements only)
+    // ========================================================================
+    
+    /**
+     * @brief A region of the ring as at most two contiguous Slices.
+     * 
+     * `first` comes before `second` in FIFO order; `second` is empty unless
+     * the region wraps past the end of the storage.
+     */
+    template<typename U>
+    struct Segments {
+        Slice<U> first;
+        Slice<U> second;
+        
+        [[nodiscard]] size_type size() const noexcept { return first.size() + second.size(); }
+        [[nodiscard]] bool is_empty() const noexcept { return size() == 0; }
+    };
+    
+    /**
+     * @brief Readable elements, in place (consumer only).
+     * 
+     * Process the views, then release them with consume(). Lets block
+     * kernels (filters, checksums) read straight out of the ring.
+     * 
+     * @code{cpp}
+     *   auto view = ring.read_view();
+     *   fir.process(view.first, out).unwrap();
+     *   ring.consume(view.first.size());
+     * @endcode
+     */
+    [[nodiscard]] Segments<const T> read_view() const noexcept {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "read_view() requires a trivially copyable element type");
+        
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        if (tail >= head) {
+            return {Slice<const T>(slot_ptr(head), tail - head), Slice<const T>()};
+        }
+        return {Slice<const T>(slot_ptr(head), Capacity - head), Slice<const T>(slot_ptr(0), tail)};
+    }
+    
+    /**
+     * @brief Release the first n readable elements (consumer only).
+     */
+    void consume(size_type n) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "consume() requires a trivially copyable element type");
+        
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        const size_type readable = tail >= head ? tail - head : Capacity - head + tail;
+        CRAB_ASSERT(n <= readable, "StaticRingBuffer::consume past readable region");
+        m_head.store((head + n) % Capacity, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Free space, in place (producer only).
+     * 
+     * Write into the views, then publish with commit().
+     */
+    [[nodiscard]] Segments<T> write_view() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "write_view() requires a trivially copyable element type");
+        
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        const size_type head = m_head.load(std::memory_order_acquire);
+        
+        // Free region is [tail, head - 1) modulo Capacity (one slot stays empty)
+        if (head > tail) {
+            return {Slice<T>(slot_ptr(tail), head - 1 - tail), Slice<T>()};
+        }
+        const size_type first_end = (head == 0) ? Capacity - 1 : Capacity;
+        return {Slice<T>(slot_ptr(tail), first_end - tail),
+                Slice<T>(slot_ptr(0), head > 1 ? head - 1 : 0)};
+    }
+    
+    /**
+     * @brief Publish the first n elements written through write_view() (producer only).
+     */
+    void commit(size_type n) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "commit() requires a trivially copyable element type");
+        
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        const size_type head = m_head.load(std::memory_order_acquire);
+        const size_type used = tail >= head ? tail - head : Capacity - head + tail;
+        CRAB_ASSERT(n <= Capacity - 1 - used, "StaticRingBuffer::commit past free region");
+        m_tail.store((tail + n) % Capacity, std::memory_order_release);
+    }
+    
+#if CRAB_HAS_POSIX_IO
+    // ========================================================================
+    // File Descriptor IO (byte buffers only)
+    // ========================================================================
+    
+    /**
+     * @brief Read from a file descriptor directly into free space (producer only).
+     * 
+     * Issues a single readv() covering both wrap segments of the free region,
+     * then publishes the new tail once. No intermediate copy is made.
+     * 
+     * @param fd Readable file descriptor (socket, pipe, file)
+     * @return Number of bytes read (0 means EOF), or Errno on failure.
+     *         Err(Errno{ENOBUFS}) if the buffer is full, so Ok(0) is never
+     *         ambiguous. EINTR is retried internally.
+     * 
+     * @code{cpp}
+     *   crab::StaticRingBuffer<uint8_t, 4096> rx;
+     *   auto n = rx.fill_from_fd(sock);
+     *   if (n.is_err() && n.unwrap_err().code == EAGAIN) { ... }
+     * @endcode
+     */
+    [[nodiscard]] Result<size_type, Errno> fill_from_fd(int fd) noexcept {
+        static_assert(sizeof(T) == 1 && std::is_trivially_copyable_v<T>,
+            "fill_from_fd() requires a byte-sized trivially copyable element type");
+        
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        const size_type head = m_head.load(std::memory_order_acquire);
+        
+        // Free region is [tail, head - 1) modulo Capacity (one slot stays empty)
+        struct iovec iov[2];
+        int iov_count = 0;
+        if (head > tail) {
+            if (head - 1 > tail) {
+                iov[iov_count++] = {&m_storage[tail], head - 1 - tail};
+            }
+        } else {
+            const size_type first_end = (head == 0) ? Capacity - 1 : Capacity;
+            if (first_end > tail) {
+                iov[iov_count++] = {&m_storage[tail], first_end - tail};
+            }
+            if (head > 1) {
+                iov[iov_count++] = {&m_storage[0], head - 1};
+            }
+        }
+        if (iov_count == 0) {
+            return Err(Errno{ENOBUFS});
+        }
+        
+        ssize_t n;
+        do {
+            n = ::readv(fd, iov, iov_count);
+        } while (n < 0 && errno == EINTR);
+        
+        if (n < 0) {
+            return Err(Errno{errno});
+        }
+        
+        const size_type count = static_cast<size_type>(n);
+        m_tail.store((tail + count) % Capacity, std::memory_order_release);
+        return Ok(count);
+    }
+    
+    /**
+     * @brief Write readable bytes directly to a file descriptor (consumer only).
+     * 
+     * Issues a single writev() covering both wrap segments of the readable
+     * region, then advances head by the number of bytes accepted.
+     * 
+     * @param fd Writable file descriptor
+     * @return Number of bytes written (0 if the buffer was empty), or Errno.
+     *         EINTR is retried internally; short writes leave the rest queued.
+     */
+    [[nodiscard]] Result<size_type, Errno> drain_to_fd(int fd) noexcept {
+        static_assert(sizeof(T) == 1 && std::is_trivially_copyable_v<T>,
+            "drain_to_fd() requires a byte-sized trivially copyable element type");
+        
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        
+        if (head == tail) {
+            return Ok(size_type{0});
+        }
+        
+        struct iovec iov[2];
+        int iov_count = 0;
+        if (tail > head) {
+            iov[iov_count++] = {&m_storage[head], tail - head};
+        } else {
+            iov[iov_count++] = {&m_storage[head], Capacity - head};
+            if (tail > 0) {
+                iov[iov_count++] = {&m_storage[0], tail};
+            }
+        }
+        
+        ssize_t n;
+        do {
+            n = ::writev(fd, iov, iov_count);
+        } while (n < 0 && errno == EINTR);
+        
+        if (n < 0) {
+            return Err(Errno{errno});
+        }
+        
+        const size_type count = static_cast<size_type>(n);
+        m_head.store((head + count) % Capacity, std::memory_order_release);
+        return Ok(count);
+    }
+#endif // CRAB_HAS_POSIX_IO
+    
     // ========================================================================
     // Shared Operations (safe from any thread)
     // ========================================================================
@@ -0,0 +1,390 @@
+#pragma once
+
+/**
+ * @file select.h
+ * @brief Heap-free top-k and order-statistic selection.
+ *
+ * - top_k(): the k best elements of a Slice, best first, in O(n log k)
+ *   using a bounded heap in caller-provided storage.
+ * - TopK<T, K>: streaming accumulator that keeps the K best of everything
+ *   pushed so far, fed one element or one batch at a time.
+ * - select_nth(): nth_element-style selection. Quickselect normally; if
+ *   partitioning degrades it switches to median-of-medians pivots, so the
+ *   worst case is O(n) rather than O(n^2) (or libstdc++'s O(n log n)).
+ *
+ * "Best" means largest under Compare (default std::less), matching
+ * std::priority_queue. Pass std::greater<> to keep the smallest. Among
+ * equal elements, which ones are kept is unspecified.
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/static_vector.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace crab {
+
+namespace detail {
+
+// ============================================================================
+// Bounded Heap (root = worst kept element)
+// ============================================================================
+
+template<typename T, typename Compare>
+void heap_sift_down(T* heap, std::size_t size, std::size_t i, Compare& less) noexcept {
+    T value = static_cast<T&&>(heap[i]);
+    for (;;) {
+        std::size_t child = 2 * i + 1;
+        if (child >= size) {
+            break;
+        }
+        // Descend toward the worse child (the one that should be nearer the root)
+        if (child + 1 < size && less(heap[child + 1], heap[child])) {
+            ++child;
+        }
+        if (!less(heap[child], value)) {
+            break;
+        }
+        heap[i] = static_cast<T&&>(heap[child]);
+        i = child;
+    }
+    heap[i] = static_cast<T&&>(value);
+}
+
+template<typename T, typename Compare>
+void heap_build(T* heap, std::size_t size, Compare& less) noexcept {
+    for (std::size_t i = size / 2; i-- > 0;) {
+        heap_sift_down(heap, size, i, less);
+    }
+}
+
+// Offer one candidate to a full heap
+template<typename T, typename Compare>
+void heap_offer(T* heap, std::size_t size, const T& value, Compare& less) noexcept {
+    if (less(heap[0], value)) {
+        heap[0] = value;
+        heap_sift_down(heap, size, 0, less);
+    }
+}
+
+// Heapsort in place: repeatedly move the worst to the back -> best first
+template<typename T, typename Compare>
+void heap_sort_best_first(T* heap, std::size_t size, Compare& less) noexcept {
+    for (std::size_t end = size; end > 1; --end) {
+        std::swap(heap[0], heap[end - 1]);
+        heap_sift_down(heap, end - 1, 0, less);
+    }
+}
+
+template<typename T, typename Compare>
+void top_k_into(const T* src, std::size_t n, T* out, std::size_t k, Compare& less) noexcept {
+    heap_build(out, k, less);
+    for (std::size_t i = k; i < n; ++i) {
+        heap_offer(out, k, src[i], less);
+    }
+    heap_sort_best_first(out, k, less);
+}
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+template<typename T, typename Compare>
+void insertion_sort_range(T* p, std::size_t lo, std::size_t hi, Compare& less) noexcept {
+    for (std::size_t i = lo + 1; i < hi; ++i) {
+        T value = static_cast<T&&>(p[i]);
+        std::size_t j = i;
+        for (; j > lo && less(value, p[j - 1]); --j) {
+            p[j] = static_cast<T&&>(p[j - 1]);
+        }
+        p[j] = static_cast<T&&>(value);
+    }
+}
+
+// Three-way partition of [lo, hi): returns [lt, gt) holding elements equal to pivot
+template<typename T, typename Compare>
+std::pair<std::size_t, std::size_t> partition3(T* p, std::size_t lo, std::size_t hi,
+                                                const T& pivot, Compare& less) noexcept {
+    std::size_t lt = lo;
+    std::size_t i = lo;
+    std::size_t gt = hi;
+    while (i < gt) {
+        if (less(p[i], pivot)) {
+            std::swap(p[lt++], p[i++]);
+        } else if (less(pivot, p[i])) {
+            std::swap(p[i], p[--gt]);
+        } else {
+            ++i;
+        }
+    }
+    return {lt, gt};
+}
+
+template<typename T, typename Compare>
+void select_range(T* p, std::size_t lo, std::size_t hi, std::size_t nth, Compare& less, int budget) noexcept;
+
+// Pivot guaranteed to have >= 30% of the range on each side
+template<typename T, typename Compare>
+T median_of_medians(T* p, std::size_t lo, std::size_t hi, Compare& less) noexcept {
+    std::size_t groups = 0;
+    for (std::size_t g = lo; g < hi; g += 5) {
+        const std::size_t end = g + 5 < hi ? g + 5 : hi;
+        insertion_sort_range(p, g, end, less);
+        std::swap(p[lo + groups], p[g + (end - g) / 2]);
+        ++groups;
+    }
+    const std::size_t mid = lo + groups / 2;
+    select_range(p, lo, lo + groups, mid, less, 0);
+    return p[mid];
+}
+
+template<typename T, typename Compare>
+const T& median_of_three(const T& a, const T& b, const T& c, Compare& less) noexcept {
+    if (less(a, b)) {
+        return less(b, c) ? b : (less(a, c) ? c : a);
+    }
+    return less(a, c) ? a : (less(b, c) ? c : b);
+}
+
+// Introselect: median-of-3 quickselect for `budget` rounds, then median-of-medians
+template<typename T, typename Compare>
+void select_range(T* p, std::size_t lo, std::size_t hi, std::size_t nth, Compare& less, int budget) noexcept {
+    while (hi - lo > 16) {
+        T pivot = budget > 0
+            ? median_of_three(p[lo], p[lo + (hi - lo) / 2], p[hi - 1], less)
+            : median_of_medians(p, lo, hi, less);
+        --budget;
+        const auto [lt, gt] = partition3(p, lo, hi, pivot, less);
+        if (nth < lt) {
+            hi = lt;
+        } else if (nth >= gt) {
+            lo = gt;
+        } else {
+            return;
+        }
+    }
+    insertion_sort_range(p, lo, hi, less);
+}
+
+inline int select_budget(std::size_t n) noexcept {
+    int log2 = 0;
+    while (n > 1) {
+        n >>= 1;
+        ++log2;
+    }
+    return 2 * log2;
+}
+
+} // namespace detail
+
+// ============================================================================
+// Top-k
+// ============================================================================
+
+/**
+ * @brief Write the out.size() best elements of src into out, best first.
+ *
+ * @param src Candidates (unchanged)
+ * @param out Storage for the result; its size is k
+ * @param less Ordering; the largest elements are kept
+ * @return View of the filled prefix (min(k, src.size()) elements)
+ */
+template<typename T, typename U, typename Compare = std::less<std::remove_const_t<T>>>
+Slice<U> top_k(Slice<T> src, Slice<U> out, Compare less = Compare{}) noexcept {
+    static_assert(std::is_same_v<std::remove_const_t<T>, U>, "top_k() requires matching element types and a mutable output");
+    const std::size_t k = out.size() < src.size() ? out.size() : src.size();
+    for (std::size_t i = 0; i < k; ++i) {
+        out.unchecked(i) = src.unchecked(i);
+    }
+    if (k != 0) {
+        detail::top_k_into<U>(src.data(), src.size(), out.data(), k, less);
+    }
+    return out.first(k);
+}
+
+/**
+ * @brief Replace the contents of out with the k best elements of src, best first.
+ *
+ * @return View of out, or Err if k exceeds out's capacity
+ */
+template<typename T, typename U, std::size_t N, std::size_t A, typename Compare = std::less<U>>
+Result<Slice<const U>, CapacityExceeded>
+top_k(Slice<T> src, std::size_t k, StaticVector<U, N, A>& out, Compare less = Compare{}) noexcept {
+    static_assert(std::is_same_v<std::remove_const_t<T>, U>, "top_k() requires matching element types");
+    if (k > N) {
+        return Err(CapacityExceeded{k, N});
+    }
+    out.clear();
+    if (k > src.size()) {
+        k = src.size();
+    }
+    for (std::size_t i = 0; i < k; ++i) {
+        out.push_back(src.unchecked(i));
+    }
+    if (k != 0) {
+        detail::top_k_into<U>(src.data(), src.size(), out.data(), k, less);
+    }
+    return Ok(Slice<const U>(out.data(), out.size()));
+}
+
+/**
+ * @brief Streaming top-K: keeps the K best elements seen so far.
+ *
+ * Storage is a StaticVector used as a bounded heap whose root is the worst
+ * kept element, so once full a candidate costs one comparison unless it
+ * beats that threshold.
+ *
+ * @tparam T Element type
+ * @tparam K Number of elements to keep
+ * @tparam Compare Ordering; the largest elements are kept
+ *
+ * @code{cpp}
+ *   crab::TopK<Quote, 10, ByPrice> best;
+ *   for (auto batch : ticks) {
+ *       best.push_batch(batch);
+ *   }
+ *   for (const Quote& q : best.sorted()) { ... }   // best first
+ * @endcode
+ */
+template<typename T, std::size_t K, typename Compare = std::less<T>>
+class TopK {
+    static_assert(K > 0, "TopK must keep at least one element");
+
+public:
+    TopK() = default;
+    explicit TopK(Compare less) noexcept : m_less(static_cast<Compare&&>(less)) {}
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    /**
+     * @brief Offer one candidate.
+     */
+    void push(const T& value) noexcept {
+        restore_heap();
+        if (!m_heap.is_full()) {
+            m_heap.push_back(value);
+            if (m_heap.is_full()) {
+                detail::heap_build(m_heap.data(), K, m_less);
+            }
+            return;
+        }
+        detail::heap_offer(m_heap.data(), K, value, m_less);
+    }
+
+    /**
+     * @brief Offer every element of a batch.
+     */
+    template<typename U>
+    void push_batch(Slice<U> batch) noexcept {
+        static_assert(std::is_same_v<std::remove_const_t<U>, T>, "TopK::push_batch() element type mismatch");
+        std::size_t i = 0;
+        while (i < batch.size() && !m_heap.is_full()) {
+            push(batch.unchecked(i++));
+        }
+        restore_heap();
+        T* heap = m_heap.data();
+        for (; i < batch.size(); ++i) {
+            // Most candidates fail the threshold test and never touch the heap
+            if (m_less(heap[0], batch.unchecked(i))) {
+                heap[0] = batch.unchecked(i);
+                detail::heap_sift_down(heap, K, 0, m_less);
+            }
+        }
+    }
+
+    // ========================================================================
+    // Results
+    // ========================================================================
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_heap.size(); }
+    [[nodiscard]] bool is_empty() const noexcept { return m_heap.empty(); }
+    [[nodiscard]] bool is_full() const noexcept { return m_heap.is_full(); }
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept { return K; }
+
+    /**
+     * @brief Worst kept element once K are held (a candidate must beat it).
+     */
+    [[nodiscard]] Option<T> threshold() noexcept {
+        if (!m_heap.is_full()) {
+            return None;
+        }
+        restore_heap();
+        return Some(m_heap.data()[0]);
+    }
+
+    /**
+     * @brief Kept elements, best first. Valid until the next push.
+     */
+    [[nodiscard]] Slice<const T> sorted() noexcept {
+        if (!m_sorted) {
+            if (!m_heap.is_full()) {
+                detail::heap_build(m_heap.data(), m_heap.size(), m_less);
+            }
+            detail::heap_sort_best_first(m_heap.data(), m_heap.size(), m_less);
+            m_sorted = true;
+        }
+        return Slice<const T>(m_heap.data(), m_heap.size());
+    }
+
+    /**
+     * @brief Kept elements in unspecified order. Valid until the next push.
+     */
+    [[nodiscard]] Slice<const T> as_slice() const noexcept {
+        return Slice<const T>(m_heap.data(), m_heap.size());
+    }
+
+    void clear() noexcept {
+        m_heap.clear();
+        m_sorted = false;
+    }
+
+private:
+    // sorted() leaves the storage best-first; a full heap needs rebuilding
+    void restore_heap() noexcept {
+        if (m_sorted) {
+            m_sorted = false;
+            if (m_heap.is_full()) {
+                detail::heap_build(m_heap.data(), K, m_less);
+            }
+        }
+    }
+
+    StaticVector<T, K> m_heap;
+    Compare m_less{};
+    bool m_sorted = false;
+};
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+/**
+ * @brief Partially order s so that s[nth] is the element a full sort would
+ *        put there, everything before it is not greater, and everything
+ *        after it is not less.
+ *
+ * Worst case O(n): quickselect falls back to median-of-medians pivots after
+ * 2*log2(n) rounds. Three-way partitioning keeps runs of equal keys cheap.
+ *
+ * @return Reference to s[nth], or Err if nth >= s.size()
+ */
+template<typename T, typename Compare = std::less<T>>
+Result<std::reference_wrapper<T>, OutOfBounds> select_nth(Slice<T> s, std::size_t nth, Compare less = Compare{}) noexcept {
+    static_assert(!std::is_const_v<T>, "select_nth() requires a mutable Slice");
+    if (nth >= s.size()) {
+        return Err(OutOfBounds{nth, s.size()});
+    }
+    detail::select_range(s.data(), 0, s.size(), nth, less, detail::select_budget(s.size()));
+    return Ok(std::ref(s.unchecked(nth)));
+}
+
+} // namespace crab
@@ -0,0 +1,459 @@
+#pragma once
+
+/**
+ * @file set_ops.h
+ * @brief Intersection, union, difference and merge of sorted Slices.
+ *
+ * Inputs are sorted ascending; the set operations additionally expect
+ * each input to hold no duplicates (posting lists, ID sets). Results are
+ * written to a caller-provided Slice and are sorted and duplicate-free.
+ *
+ * Strategy is chosen per call:
+ * - Similar sizes: intersection compares 8x8 (uint32) or 4x4 (uint64)
+ *   blocks with AVX2 and compacts the matches with a permute table;
+ *   the other operations use a scalar merge.
+ * - Skewed sizes (one side more than kGallopRatio times longer): every
+ *   element of the short side is located in the long side by galloping
+ *   (exponential then binary search), O(m log(n/m)).
+ *
+ * Each operation has a *_count() variant that only counts the result.
+ * When the output is too small, the write variants fill it and return
+ * Err(CapacityExceeded{full result size, capacity}).
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/gather.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace crab {
+
+namespace detail {
+
+/// Size ratio above which the short side is galloped through the long one.
+constexpr std::size_t kGallopRatio = 32;
+
+// ============================================================================
+// Output Sinks
+// ============================================================================
+
+// Counts results only
+template<typename T>
+struct CountSink {
+    std::size_t count = 0;
+
+    void push(const T&) noexcept { ++count; }
+    void push_run(const T*, std::size_t n) noexcept { count += n; }
+    [[nodiscard]] std::size_t room() const noexcept { return SIZE_MAX; }
+    [[nodiscard]] T* cursor() const noexcept { return nullptr; }
+};
+
+// Writes up to capacity, then keeps counting so the error reports the full size
+template<typename T>
+struct WriteSink {
+    T* out;
+    std::size_t capacity;
+    std::size_t count = 0;
+
+    void push(const T& v) noexcept {
+        if (count < capacity) {
+            out[count] = v;
+        }
+        ++count;
+    }
+    void push_run(const T* p, std::size_t n) noexcept {
+        if (count < capacity) {
+            const std::size_t fits = n < capacity - count ? n : capacity - count;
+            std::memcpy(out + count, p, fits * sizeof(T));
+        }
+        count += n;
+    }
+    [[nodiscard]] std::size_t room() const noexcept { return count < capacity ? capacity - count : 0; }
+    [[nodiscard]] T* cursor() const noexcept { return out + count; }
+
+    [[nodiscard]] Result<std::size_t, CapacityExceeded> finish() const noexcept {
+        if (count > capacity) {
+            return Err(CapacityExceeded{count, capacity});
+        }
+        return Ok(count);
+    }
+};
+
+// First index in [lo, n) with p[index] >= key
+template<typename T>
+std::size_t gallop(const T* p, std::size_t lo, std::size_t n, T key) noexcept {
+    std::size_t step = 1;
+    std::size_t hi = lo;
+    while (hi < n && p[hi] < key) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+    }
+    if (hi > n) {
+        hi = n;
+    }
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (p[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// ============================================================================
+// Intersection Kernels
+// ============================================================================
+
+#if CRAB_SIMD_X86
+
+template<typename T>
+struct SetAvx2;
+
+template<>
+struct SetAvx2<uint32_t> {
+    static constexpr std::size_t lanes = 8;
+
+    // Bit l set when a[l] equals any lane of b
+    CRAB_TARGET_AVX2 static unsigned match(const uint32_t* a, const uint32_t* b) noexcept {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+        __m256i hits = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi32(va, vb));
+        }
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hits)));
+    }
+
+    // Store the a lanes selected by bits to out; nothing past them is written
+    CRAB_TARGET_AVX2 static void compact(uint32_t* out, const uint32_t* a, unsigned bits) noexcept {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        const __m256i perm = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kCompactTables.words[bits].data())));
+        const __m256i keep = _mm256_cmpgt_epi32(_mm256_set1_epi32(__builtin_popcount(bits)),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        _mm256_maskstore_epi32(reinterpret_cast<int*>(out), keep, _mm256_permutevar8x32_epi32(va, perm));
+    }
+};
+
+template<>
+struct SetAvx2<uint64_t> {
+    static constexpr std::size_t lanes = 4;
+
+    CRAB_TARGET_AVX2 static unsigned match(const uint64_t* a, const uint64_t* b) noexcept {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        __m256i hits = _mm256_cmpeq_epi64(va, vb);
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x39)));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x4E)));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x93)));
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(hits)));
+    }
+
+    CRAB_TARGET_AVX2 static void compact(uint64_t* out, const uint64_t* a, unsigned bits) noexcept {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        const __m256i perm = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kCompactTables.dwords[bits].data())));
+        // Two dwords per kept element
+        const __m256i keep = _mm256_cmpgt_epi32(_mm256_set1_epi32(2 * __builtin_popcount(bits)),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        _mm256_maskstore_epi32(reinterpret_cast<int*>(out), keep, _mm256_permutevar8x32_epi32(va, perm));
+    }
+};
+
+template<typename T>
+inline constexpr bool has_set_avx2_v = std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>;
+
+// Block-compare while both sides have a full block (and, when writing, the
+// output has room for a whole block of matches). Advances i, j and the sink.
+template<typename T, typename Sink>
+CRAB_TARGET_AVX2 void intersect_blocks_avx2(const T* a, std::size_t na, std::size_t& i,
+                                            const T* b, std::size_t nb, std::size_t& j, Sink& sink) noexcept {
+    using Ops = SetAvx2<T>;
+    constexpr std::size_t L = Ops::lanes;
+    constexpr bool writing = !std::is_same_v<Sink, CountSink<T>>;
+    while (i + L <= na && j + L <= nb) {
+        if constexpr (writing) {
+            if (sink.room() < L) {
+                break;
+            }
+        }
+        const unsigned bits = Ops::match(a + i, b + j);
+        if (bits != 0) {
+            if constexpr (writing) {
+                Ops::compact(sink.cursor(), a + i, bits);
+            }
+            sink.count += static_cast<std::size_t>(__builtin_popcount(bits));
+        }
+        const T a_last = a[i + L - 1];
+        const T b_last = b[j + L - 1];
+        i += a_last <= b_last ? L : 0;
+        j += b_last <= a_last ? L : 0;
+    }
+}
+
+#endif // CRAB_SIMD_X86
+
+template<typename T, typename Sink>
+void intersect_gallop(const T* small, std::size_t ns, const T* large, std::size_t nl, Sink& sink) noexcept {
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < ns && j < nl; ++i) {
+        j = gallop(large, j, nl, small[i]);
+        if (j < nl && large[j] == small[i]) {
+            sink.push(small[i]);
+            ++j;
+        }
+    }
+}
+
+template<typename T, typename Sink>
+void intersect(const T* a, std::size_t na, const T* b, std::size_t nb, Sink& sink) noexcept {
+    if (na * kGallopRatio < nb) {
+        intersect_gallop(a, na, b, nb, sink);
+        return;
+    }
+    if (nb * kGallopRatio < na) {
+        intersect_gallop(b, nb, a, na, sink);
+        return;
+    }
+    std::size_t i = 0;
+    std::size_t j = 0;
+#if CRAB_SIMD_X86
+    if constexpr (has_set_avx2_v<T>) {
+        if (simd::active_level() >= simd::Level::Avx2) {
+            intersect_blocks_avx2(a, na, i, b, nb, j, sink);
+        }
+    }
+#endif
+    while (i < na && j < nb) {
+        const T x = a[i];
+        const T y = b[j];
+        if (x == y) {
+            sink.push(x);
+        }
+        i += x <= y;
+        j += y <= x;
+    }
+}
+
+// ============================================================================
+// Union / Difference / Merge Kernels
+// ============================================================================
+
+// Union when `small` is much shorter: copy runs of `large` between hits
+template<typename T, typename Sink>
+void union_gallop(const T* small, std::size_t ns, const T* large, std::size_t nl, Sink& sink) noexcept {
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < ns; ++i) {
+        const std::size_t pos = gallop(large, j, nl, small[i]);
+        sink.push_run(large + j, pos - j);
+        j = (pos < nl && large[pos] == small[i]) ? pos + 1 : pos;
+        sink.push(small[i]);
+    }
+    sink.push_run(large + j, nl - j);
+}
+
+template<typename T, typename Sink>
+void unite(const T* a, std::size_t na, const T* b, std::size_t nb, Sink& sink) noexcept {
+    if (na * kGallopRatio < nb) {
+        union_gallop(a, na, b, nb, sink);
+        return;
+    }
+    if (nb * kGallopRatio < na) {
+        union_gallop(b, nb, a, na, sink);
+        return;
+    }
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < na && j < nb) {
+        const T x = a[i];
+        const T y = b[j];
+        sink.push(x < y ? x : y);
+        i += x <= y;
+        j += y <= x;
+    }
+    sink.push_run(a + i, na - i);
+    sink.push_run(b + j, nb - j);
+}
+
+template<typename T, typename Sink>
+void subtract(const T* a, std::size_t na, const T* b, std::size_t nb, Sink& sink) noexcept {
+    if (na * kGallopRatio < nb) {
+        // Few candidates: look each one up in b
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < na; ++i) {
+            j = gallop(b, j, nb, a[i]);
+            if (j == nb || b[j] != a[i]) {
+                sink.push(a[i]);
+            }
+        }
+        return;
+    }
+    if (nb * kGallopRatio < na) {
+        // Few removals: copy the runs of a between them
+        std::size_t i = 0;
+        for (std::size_t j = 0; j < nb && i < na; ++j) {
+            const std::size_t pos = gallop(a, i, na, b[j]);
+            sink.push_run(a + i, pos - i);
+            i = (pos < na && a[pos] == b[j]) ? pos + 1 : pos;
+        }
+        sink.push_run(a + i, na - i);
+        return;
+    }
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < na && j < nb) {
+        const T x = a[i];
+        const T y = b[j];
+        if (x < y) {
+            sink.push(x);
+        }
+        i += x <= y;
+        j += y <= x;
+    }
+    sink.push_run(a + i, na - i);
+}
+
+template<typename T, typename U>
+using SetElem = std::enable_if_t<std::is_integral_v<std::remove_const_t<T>> &&
+                                 std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>>,
+                                 std::remove_const_t<T>>;
+
+} // namespace detail
+
+// ============================================================================
+// Intersection
+// ============================================================================
+
+/**
+ * @brief Elements present in both a and b.
+ *
+ * @param a Sorted, duplicate-free input
+ * @param b Sorted, duplicate-free input
+ * @param out Destination (min(a.size(), b.size()) always suffices);
+ *            elements past the returned count are left untouched
+ * @return Number of elements written, or Err if out is too small
+ */
+template<typename T, typename U, typename V = detail::SetElem<T, U>>
+Result<std::size_t, CapacityExceeded> set_intersection(Slice<T> a, Slice<U> b, Slice<V> out) noexcept {
+    detail::WriteSink<V> sink{out.data(), out.size()};
+    detail::intersect<V>(a.data(), a.size(), b.data(), b.size(), sink);
+    return sink.finish();
+}
+
+/**
+ * @brief Size of the intersection of a and b, without writing it.
+ */
+template<typename T, typename U, typename V = detail::SetElem<T, U>>
+[[nodiscard]] std::size_t set_intersection_count(Slice<T> a, Slice<U> b) noexcept {
+    detail::CountSink<V> sink;
+    detail::intersect<V>(a.data(), a.size(), b.data(), b.size(), sink);
+    return sink.count;
+}
+
+// ============================================================================
+// Union
+// ============================================================================
+
+/**
+ * @brief Elements present in a or b (each once).
+ *
+ * @param out Destination (a.size() + b.size() always suffices)
+ * @return Number of elements written, or Err if out is too small
+ */
+template<typename T, typename U, typename V = detail::SetElem<T, U>>
+Result<std::size_t, CapacityExceeded> set_union(Slice<T> a, Slice<U> b, Slice<V> out) noexcept {
+    detail::WriteSink<V> sink{out.data(), out.size()};
+    detail::unite<V>(a.data(), a.size(), b.data(), b.size(), sink);
+    return sink.finish();
+}
+
+/**
+ * @brief Size of the union of a and b, without writing it.
+ */
+template<typename T, typename U, typename V = detail::SetElem<T, U>>
+[[nodiscard]] std::size_t set_union_count(Slice<T> a, Slice<U> b) noexcept {
+    detail::CountSink<V> sink;
+    detail::unite<V>(a.data(), a.size(), b.data(), b.size(), sink);
+    return sink.count;
+}
+
+// ============================================================================
+// Difference
+// ============================================================================
+
+/**
+ * @brief Elements of a that are not in b.
+ *
+ * @param out Destination (a.size() always suffices)
+ * @return Number of elements written, or Err if out is too small
+ */
+template<typename T, typename U, typename V = detail::SetElem<T, U>>
+Result<std::size_t, CapacityExceeded> set_difference(Slice<T> a, Slice<U> b, Slice<V> out) noexcept {
+    detail::WriteSink<V> sink{out.data(), out.size()};
+    detail::subtract<V>(a.data(), a.size(), b.data(), b.size(), sink);
+    return sink.finish();
+}
+
+/**
+ * @brief Size of a minus b, without writing it.
+ */
+template<typename T, typename U, typename V = detail::SetElem<T, U>>
+[[nodiscard]] std::size_t set_difference_count(Slice<T> a, Slice<U> b) noexcept {
+    detail::CountSink<V> sink;
+    detail::subtract<V>(a.data(), a.size(), b.data(), b.size(), sink);
+    return sink.count;
+}
+
+// ============================================================================
+// Merge
+// ============================================================================
+
+/**
+ * @brief Stable merge of two sorted Slices, keeping duplicates.
+ *
+ * Equal elements from a come before those from b. Duplicates are allowed
+ * in either input.
+ *
+ * @param out Destination of at least a.size() + b.size() elements
+ * @return a.size() + b.size(), or Err if out is too small (nothing written)
+ */
+template<typename T, typename U, typename V = detail::SetElem<T, U>>
+Result<std::size_t, CapacityExceeded> merge(Slice<T> a, Slice<U> b, Slice<V> out) noexcept {
+    const std::size_t na = a.size();
+    const std::size_t nb = b.size();
+    if (out.size() < na + nb) {
+        return Err(CapacityExceeded{na + nb, out.size()});
+    }
+    const V* pa = a.data();
+    const V* pb = b.data();
+    V* dst = out.data();
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < na && j < nb) {
+        const bool take_b = pb[j] < pa[i];
+        dst[i + j] = take_b ? pb[j] : pa[i];
+        i += !take_b;
+        j += take_b;
+    }
+    if (i < na) {
+        std::memcpy(dst + i + j, pa + i, (na - i) * sizeof(V));
+    }
+    if (j < nb) {
+        std::memcpy(dst + i + j, pb + j, (nb - j) * sizeof(V));
+    }
+    return Ok(na + nb);
+}
+
+} // namespace crab
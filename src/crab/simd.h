@@ -0,0 +1,123 @@
+#pragma once
+
+/**
+ * @file simd.h
+ * @brief Instruction-set detection and runtime dispatch helpers.
+ *
+ * Kernels are written once per ISA and selected at runtime, so a binary
+ * built for baseline x86-64 (SSE2) or ARMv8 (NEON) still uses AVX2 or
+ * AVX-512 when the CPU has it.
+ *
+ * ## Customization
+ *
+ * - `CRAB_NO_SIMD`: Define to compile only the scalar paths
+ */
+
+#include <atomic>
+#include <cstdint>
+
+// ============================================================================
+// Compile-time ISA Detection
+// ============================================================================
+
+#if !defined(CRAB_NO_SIMD) && (defined(__GNUC__) || defined(__clang__))
+    #if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+        #define CRAB_SIMD_X86 1
+    #endif
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define CRAB_SIMD_NEON 1
+    #endif
+#endif
+
+#ifndef CRAB_SIMD_X86
+    #define CRAB_SIMD_X86 0
+#endif
+#ifndef CRAB_SIMD_NEON
+    #define CRAB_SIMD_NEON 0
+#endif
+
+#if CRAB_SIMD_X86
+    #include <immintrin.h>
+    /// Compile one function for AVX2+FMA regardless of -march.
+    #define CRAB_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    /// Compile one function for AVX-512 F/BW/VL regardless of -march.
+    #define CRAB_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx512dq,avx2,fma")))
+#endif
+
+#if CRAB_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace crab {
+namespace simd {
+
+// ============================================================================
+// Runtime Dispatch
+// ============================================================================
+
+/**
+ * @brief Instruction-set tiers, ordered from least to most capable.
+ *
+ * Sse2 and Neon are the baselines on their architectures.
+ */
+enum class Level : int {
+    Scalar = 0,
+    Neon = 1,
+    Sse2 = 1,
+    Avx2 = 2,
+    Avx512 = 3,
+};
+
+namespace detail {
+
+inline Level detect_level() noexcept {
+#if CRAB_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq")) {
+        return Level::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return Level::Avx2;
+    }
+    return Level::Sse2;
+#elif CRAB_SIMD_NEON
+    return Level::Neon;
+#else
+    return Level::Scalar;
+#endif
+}
+
+inline std::atomic<int>& level_cap() noexcept {
+    static std::atomic<int> cap{static_cast<int>(Level::Avx512)};
+    return cap;
+}
+
+} // namespace detail
+
+/**
+ * @brief Best instruction set supported by this CPU (cached).
+ */
+[[nodiscard]] inline Level detected_level() noexcept {
+    static const Level level = detail::detect_level();
+    return level;
+}
+
+/**
+ * @brief Instruction set kernels should use: detected_level() capped by set_level_cap().
+ */
+[[nodiscard]] inline Level active_level() noexcept {
+    const int cap = detail::level_cap().load(std::memory_order_relaxed);
+    const int detected = static_cast<int>(detected_level());
+    return static_cast<Level>(detected < cap ? detected : cap);
+}
+
+/**
+ * @brief Limit runtime dispatch (e.g. force Scalar to test or compare paths).
+ */
+inline void set_level_cap(Level cap) noexcept {
+    detail::level_cap().store(static_cast<int>(cap), std::memory_order_relaxed);
+}
+
+} // namespace simd
+} // namespace crab
@@ -0,0 +1,1168 @@
+#pragma once
+
+/**
+ * @file sketch.h
+ * @brief Fixed-memory streaming sketches: quantiles, cardinality, frequency.
+ *
+ * - DDSketch<Bins, RelativeErrorBp>: quantiles with bounded relative error
+ * - QuantileSketch<T, K, Levels>: KLL-style compactors, bounded rank error
+ * - HyperLogLog<P>: distinct counts in 2^P one-byte registers
+ * - CountMinSketch<Width, Depth>: per-key frequency upper bounds
+ *
+ * Every sketch has a size fixed at compile time and never allocates.
+ * Sketches of the same type merge with merge(), so each thread can keep
+ * its own sketch and fold the results together later. save() writes a
+ * portable little-endian encoding into a ByteSlice and load() reads it
+ * back, validating the tag and parameters (Err(ParseError) otherwise).
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/error_types.h"
+#include "crab/hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if CRAB_SIMD_X86
+    #include <immintrin.h>
+#elif CRAB_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace crab {
+
+namespace detail {
+
+// ============================================================================
+// Serialization
+// ============================================================================
+
+template<std::size_t N>
+using UintOfSize = std::conditional_t<N == 1, uint8_t,
+                   std::conditional_t<N == 2, uint16_t,
+                   std::conditional_t<N == 4, uint32_t, uint64_t>>>;
+
+enum class SketchKind : uint8_t { HyperLogLog = 1, CountMin = 2, DDSketch = 3, Quantile = 4 };
+
+constexpr uint8_t kSketchMagic[4] = {'C', 'R', 'S', 'K'};
+constexpr uint8_t kSketchVersion = 1;
+constexpr std::size_t kSketchHeaderSize = 8;
+
+// Callers check capacity up front, so writes are unchecked
+struct SketchWriter {
+    uint8_t* out;
+    std::size_t pos = 0;
+
+    template<typename T>
+    void put(T value) noexcept {
+        static_assert(std::is_arithmetic_v<T>, "SketchWriter::put() takes arithmetic values");
+        UintOfSize<sizeof(T)> u;
+        std::memcpy(&u, &value, sizeof(T));
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            out[pos++] = static_cast<uint8_t>(static_cast<uint64_t>(u) >> (8 * i));
+        }
+    }
+
+    void header(SketchKind kind) noexcept {
+        for (uint8_t b : kSketchMagic) {
+            put(b);
+        }
+        put(static_cast<uint8_t>(kind));
+        put(kSketchVersion);
+        put(uint16_t{0});
+    }
+};
+
+// Sticky: after the first failure every get() returns zero and the
+// first error is what finish() reports
+struct SketchReader {
+    ConstByteSlice in;
+    std::size_t pos = 0;
+    bool failed = false;
+    ParseError error{0, 0, 0};
+
+    void fail(ParseError e) noexcept {
+        if (!failed) {
+            failed = true;
+            error = e;
+        }
+    }
+
+    /// True if n more bytes are available
+    bool has(std::size_t n) noexcept {
+        if (!failed && in.size() - pos < n) {
+            fail(ParseError{in.size(), 0, 0});
+        }
+        return !failed;
+    }
+
+    template<typename T>
+    T get() noexcept {
+        static_assert(std::is_arithmetic_v<T>, "SketchReader::get() reads arithmetic values");
+        if (!has(sizeof(T))) {
+            return T{};
+        }
+        uint64_t u = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            u |= static_cast<uint64_t>(in.unchecked(pos++)) << (8 * i);
+        }
+        const auto narrow = static_cast<UintOfSize<sizeof(T)>>(u);
+        T value;
+        std::memcpy(&value, &narrow, sizeof(T));
+        return value;
+    }
+
+    /// Check a field against the value this sketch type was built with
+    template<typename T>
+    void expect(T want) noexcept {
+        const std::size_t at = pos;
+        const T got = get<T>();
+        if (!failed && got != want) {
+            fail(ParseError{at, static_cast<uint8_t>(want), static_cast<uint8_t>(got)});
+        }
+    }
+
+    void header(SketchKind kind) noexcept {
+        for (uint8_t b : kSketchMagic) {
+            expect(b);
+        }
+        expect(static_cast<uint8_t>(kind));
+        expect(kSketchVersion);
+        expect(uint16_t{0});
+    }
+
+    [[nodiscard]] Result<Unit, ParseError> finish() const noexcept {
+        if (failed) {
+            return Err(error);
+        }
+        return Ok();
+    }
+};
+
+// ============================================================================
+// Register Merge Kernels
+// ============================================================================
+
+#if CRAB_SIMD_X86
+CRAB_TARGET_AVX2 inline std::size_t max_u8_avx2(uint8_t* dst, const uint8_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_max_epu8(a, b));
+    }
+    return i;
+}
+#endif
+
+/// dst[i] = max(dst[i], src[i])
+inline void max_u8(uint8_t* dst, const uint8_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+#if CRAB_SIMD_X86
+    if (simd::active_level() >= simd::Level::Avx2) {
+        i = max_u8_avx2(dst, src, n);
+    }
+#elif CRAB_SIMD_NEON
+    if (simd::active_level() >= simd::Level::Neon) {
+        for (; i + 16 <= n; i += 16) {
+            vst1q_u8(dst + i, vmaxq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = dst[i] < src[i] ? src[i] : dst[i];
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// HyperLogLog
+// ============================================================================
+
+/**
+ * @brief Distinct-count estimator with 2^P one-byte registers.
+ *
+ * Standard error is about 1.04 / sqrt(2^P): 0.81% at the default P = 14
+ * (16 KiB). The estimate uses Ertl's improved estimator, which needs no
+ * empirical bias tables and is accurate from 0 up to ~2^(64 - P) items.
+ * merge() is a register-wise max (AVX2 / NEON).
+ *
+ * @code{cpp}
+ *   crab::HyperLogLog<14> users;
+ *   users.add(user_id);
+ *   double distinct = users.estimate();
+ * @endcode
+ */
+template<unsigned P = 14>
+class HyperLogLog {
+    static_assert(P >= 4 && P <= 18, "HyperLogLog precision must be in [4, 18]");
+
+public:
+    static constexpr std::size_t kRegisters = std::size_t{1} << P;
+    static constexpr std::size_t kSerializedSize = detail::kSketchHeaderSize + 1 + kRegisters;
+
+    HyperLogLog() noexcept { reset(); }
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    /**
+     * @brief Add an integer key (hashed internally, so sequential IDs are fine).
+     */
+    void add(uint64_t key) noexcept {
+        add_hash(detail::mix64(key));
+    }
+
+    /**
+     * @brief Add an arbitrary byte key.
+     */
+    void add_bytes(ConstByteSlice key) noexcept {
+        add_hash(detail::hash_bytes(key));
+    }
+
+    /**
+     * @brief Add a key that is already a well-mixed 64-bit hash.
+     */
+    void add_hash(uint64_t hash) noexcept {
+        const std::size_t idx = static_cast<std::size_t>(hash >> (64 - P));
+        // Guard bit caps the rank at 64 - P + 1 when the remaining bits are zero
+        const uint64_t w = (hash << P) | (uint64_t{1} << (P - 1));
+        const uint8_t rank = static_cast<uint8_t>(__builtin_clzll(w) + 1);
+        m_regs[idx] = m_regs[idx] < rank ? rank : m_regs[idx];
+    }
+
+    template<typename U>
+    void add_batch(Slice<U> keys) noexcept {
+        static_assert(std::is_same_v<std::remove_const_t<U>, uint64_t>, "HyperLogLog::add_batch() takes uint64_t keys");
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            add(keys.unchecked(i));
+        }
+    }
+
+    /**
+     * @brief Fold in another sketch: the result estimates the union.
+     */
+    void merge(const HyperLogLog& other) noexcept {
+        detail::max_u8(m_regs, other.m_regs, kRegisters);
+    }
+
+    void reset() noexcept {
+        std::memset(m_regs, 0, sizeof(m_regs));
+    }
+
+    // ========================================================================
+    // Query
+    // ========================================================================
+
+    /**
+     * @brief Estimated number of distinct keys added.
+     */
+    [[nodiscard]] double estimate() const noexcept {
+        constexpr unsigned q = 64 - P;
+        uint32_t hist[q + 2] = {};
+        for (std::size_t i = 0; i < kRegisters; ++i) {
+            ++hist[m_regs[i]];
+        }
+        constexpr double m = static_cast<double>(kRegisters);
+        double z = m * tau(1.0 - static_cast<double>(hist[q + 1]) / m);
+        for (unsigned k = q; k >= 1; --k) {
+            z = 0.5 * (z + static_cast<double>(hist[k]));
+        }
+        z += m * sigma(static_cast<double>(hist[0]) / m);
+        // alpha_inf = 1 / (2 ln 2)
+        return 0.5 / 0.69314718055994530942 * m * m / z;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept {
+        for (std::size_t i = 0; i < kRegisters; ++i) {
+            if (m_regs[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // ========================================================================
+    // Serialization
+    // ========================================================================
+
+    /**
+     * @brief Write kSerializedSize bytes.
+     * @return Bytes written, or Err(CapacityExceeded) if out is too small
+     */
+    Result<std::size_t, CapacityExceeded> save(ByteSlice out) const noexcept {
+        if (out.size() < kSerializedSize) {
+            return Err(CapacityExceeded{kSerializedSize, out.size()});
+        }
+        detail::SketchWriter w{out.data()};
+        w.header(detail::SketchKind::HyperLogLog);
+        w.put(static_cast<uint8_t>(P));
+        std::memcpy(out.data() + w.pos, m_regs, kRegisters);
+        return Ok(w.pos + kRegisters);
+    }
+
+    /**
+     * @brief Replace this sketch with one previously written by save().
+     *
+     * On error the sketch is left unchanged.
+     */
+    Result<Unit, ParseError> load(ConstByteSlice in) noexcept {
+        // Truncated, as SketchReader reports it (also bounds the memcpy below)
+        if (in.size() < kSerializedSize) {
+            return Err(ParseError{in.size(), 0, 0});
+        }
+        detail::SketchReader r{in};
+        r.header(detail::SketchKind::HyperLogLog);
+        r.expect(static_cast<uint8_t>(P));
+        if (!r.has(kRegisters)) {
+            return r.finish();
+        }
+        const uint8_t* regs = in.data() + r.pos;
+        for (std::size_t i = 0; i < kRegisters; ++i) {
+            if (regs[i] > 64 - P + 1) {
+                return Err(ParseError{r.pos + i, static_cast<uint8_t>(64 - P + 1), regs[i]});
+            }
+        }
+        std::memcpy(m_regs, regs, kRegisters);
+        return Ok();
+    }
+
+private:
+    static double sigma(double x) noexcept {
+        if (x == 1.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        double y = 1.0;
+        double z = x;
+        double prev;
+        do {
+            x *= x;
+            prev = z;
+            z += x * y;
+            y += y;
+        } while (z != prev);
+        return z;
+    }
+
+    static double tau(double x) noexcept {
+        if (x == 0.0 || x == 1.0) {
+            return 0.0;
+        }
+        double y = 1.0;
+        double z = 1.0 - x;
+        double prev;
+        do {
+            x = std::sqrt(x);
+            prev = z;
+            y *= 0.5;
+            z -= (1.0 - x) * (1.0 - x) * y;
+        } while (z != prev);
+        return z / 3.0;
+    }
+
+    alignas(32) uint8_t m_regs[kRegisters];
+};
+
+// ============================================================================
+// Count-Min Sketch
+// ============================================================================
+
+/**
+ * @brief Frequency estimates that never undercount.
+ *
+ * estimate(key) >= true count, and exceeds it by more than
+ * e / Width * total() with probability at most e^-Depth. Counters are
+ * 32-bit and saturate instead of wrapping. Pair it with TopK to track
+ * heavy hitters: offer (estimate, key) after each add().
+ *
+ * @tparam Width Counters per row (power of two)
+ * @tparam Depth Independent rows
+ */
+template<std::size_t Width = 2048, std::size_t Depth = 4>
+class CountMinSketch {
+    static_assert(Width >= 16 && (Width & (Width - 1)) == 0, "CountMinSketch width must be a power of two >= 16");
+    static_assert(Depth >= 1 && Depth <= 16, "CountMinSketch depth must be in [1, 16]");
+
+public:
+    static constexpr std::size_t kSerializedSize = detail::kSketchHeaderSize + 8 + 8 + Width * Depth * 4;
+
+    CountMinSketch() noexcept { reset(); }
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    void add(uint64_t key, uint32_t count = 1) noexcept {
+        add_hash(detail::mix64(key), count);
+    }
+
+    void add_bytes(ConstByteSlice key, uint32_t count = 1) noexcept {
+        add_hash(detail::hash_bytes(key), count);
+    }
+
+    void add_hash(uint64_t hash, uint32_t count = 1) noexcept {
+        // Row d uses h1 + d * h2 (Kirsch-Mitzenmacher double hashing)
+        const uint32_t h1 = static_cast<uint32_t>(hash);
+        const uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1u;
+        for (std::size_t d = 0; d < Depth; ++d) {
+            uint32_t& c = m_counts[d][(h1 + static_cast<uint32_t>(d) * h2) & (Width - 1)];
+            c = sat_add(c, count);
+        }
+        m_total += count;
+    }
+
+    template<typename U>
+    void add_batch(Slice<U> keys) noexcept {
+        static_assert(std::is_same_v<std::remove_const_t<U>, uint64_t>, "CountMinSketch::add_batch() takes uint64_t keys");
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            add(keys.unchecked(i));
+        }
+    }
+
+    /**
+     * @brief Fold in another sketch (counters add, saturating).
+     */
+    void merge(const CountMinSketch& other) noexcept {
+        for (std::size_t d = 0; d < Depth; ++d) {
+            uint32_t* dst = m_counts[d];
+            const uint32_t* src = other.m_counts[d];
+            for (std::size_t i = 0; i < Width; ++i) {
+                dst[i] = sat_add(dst[i], src[i]);
+            }
+        }
+        m_total += other.m_total;
+    }
+
+    void reset() noexcept {
+        std::memset(m_counts, 0, sizeof(m_counts));
+        m_total = 0;
+    }
+
+    // ========================================================================
+    // Query
+    // ========================================================================
+
+    [[nodiscard]] uint32_t estimate(uint64_t key) const noexcept {
+        return estimate_hash(detail::mix64(key));
+    }
+
+    [[nodiscard]] uint32_t estimate_bytes(ConstByteSlice key) const noexcept {
+        return estimate_hash(detail::hash_bytes(key));
+    }
+
+    [[nodiscard]] uint32_t estimate_hash(uint64_t hash) const noexcept {
+        const uint32_t h1 = static_cast<uint32_t>(hash);
+        const uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1u;
+        uint32_t best = std::numeric_limits<uint32_t>::max();
+        for (std::size_t d = 0; d < Depth; ++d) {
+            const uint32_t c = m_counts[d][(h1 + static_cast<uint32_t>(d) * h2) & (Width - 1)];
+            best = c < best ? c : best;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Sum of all counts added (not saturated).
+     */
+    [[nodiscard]] uint64_t total() const noexcept { return m_total; }
+
+    // ========================================================================
+    // Serialization
+    // ========================================================================
+
+    Result<std::size_t, CapacityExceeded> save(ByteSlice out) const noexcept {
+        if (out.size() < kSerializedSize) {
+            return Err(CapacityExceeded{kSerializedSize, out.size()});
+        }
+        detail::SketchWriter w{out.data()};
+        w.header(detail::SketchKind::CountMin);
+        w.put(static_cast<uint32_t>(Width));
+        w.put(static_cast<uint32_t>(Depth));
+        w.put(m_total);
+        for (std::size_t d = 0; d < Depth; ++d) {
+            for (std::size_t i = 0; i < Width; ++i) {
+                w.put(m_counts[d][i]);
+            }
+        }
+        return Ok(w.pos);
+    }
+
+    Result<Unit, ParseError> load(ConstByteSlice in) noexcept {
+        detail::SketchReader r{in};
+        r.header(detail::SketchKind::CountMin);
+        r.expect(static_cast<uint32_t>(Width));
+        r.expect(static_cast<uint32_t>(Depth));
+        if (!r.has(8 + Width * Depth * 4)) {
+            return r.finish();
+        }
+        m_total = r.get<uint64_t>();
+        for (std::size_t d = 0; d < Depth; ++d) {
+            for (std::size_t i = 0; i < Width; ++i) {
+                m_counts[d][i] = r.get<uint32_t>();
+            }
+        }
+        return Ok();
+    }
+
+private:
+    static uint32_t sat_add(uint32_t a, uint32_t b) noexcept {
+        const uint32_t s = a + b;
+        return s < a ? std::numeric_limits<uint32_t>::max() : s;
+    }
+
+    uint32_t m_counts[Depth][Width];
+    uint64_t m_total;
+};
+
+// ============================================================================
+// DDSketch
+// ============================================================================
+
+namespace detail {
+
+// ln((1 + a) / (1 - a)) = 2 atanh(a), as a series so it is constexpr
+constexpr double log_gamma(double a) noexcept {
+    double term = a;
+    double sum = 0.0;
+    for (int k = 0; k < 64; ++k) {
+        sum += term / static_cast<double>(2 * k + 1);
+        term *= a * a;
+    }
+    return 2.0 * sum;
+}
+
+} // namespace detail
+
+/**
+ * @brief Quantiles with relative error at most RelativeErrorBp / 10000.
+ *
+ * Positive values land in logarithmic buckets of ratio
+ * gamma = (1 + a) / (1 - a), so any returned quantile is within a factor
+ * (1 +- a) of a true sample at that rank: 1% by default, regardless of
+ * how skewed the distribution is. Values <= 0 share one zero bucket and
+ * report as 0 (clamped to the observed range). NaN and infinities are
+ * ignored.
+ *
+ * Bins consecutive buckets are tracked (2048 at 1% spans ~18 decades).
+ * When a new value falls above the window the lowest buckets collapse,
+ * so accuracy is kept for the high quantiles that matter for latency.
+ *
+ * @code{cpp}
+ *   crab::DDSketch<> latency;
+ *   latency.add(elapsed_us);
+ *   double p99 = latency.quantile(0.99).unwrap_or(0.0);
+ * @endcode
+ */
+template<std::size_t Bins = 2048, unsigned RelativeErrorBp = 100>
+class DDSketch {
+    static_assert(Bins >= 16, "DDSketch needs at least 16 bins");
+    static_assert(RelativeErrorBp >= 1 && RelativeErrorBp <= 5000, "DDSketch relative error must be in [1, 5000] bp");
+
+public:
+    static constexpr double kRelativeError = RelativeErrorBp / 10000.0;
+    static constexpr double kGamma = (1.0 + kRelativeError) / (1.0 - kRelativeError);
+    static constexpr std::size_t kMaxSerializedSize = detail::kSketchHeaderSize + 4 + 4 + 8 + 8 + 8 + 8 + 4 + 4 + 4 + Bins * 8;
+
+    DDSketch() noexcept { reset(); }
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    void add(double value, uint64_t count = 1) noexcept {
+        // NaN and +-inf have no bucket (log(inf) has no int32_t key)
+        if (!std::isfinite(value) || count == 0) {
+            return;
+        }
+        if (value <= 0.0) {
+            m_zero += count;
+        } else {
+            m_bins[place(key_of(value))] += count;
+        }
+        m_count += count;
+        m_min = value < m_min ? value : m_min;
+        m_max = value > m_max ? value : m_max;
+    }
+
+    template<typename U>
+    void add_batch(Slice<U> values) noexcept {
+        static_assert(std::is_arithmetic_v<std::remove_const_t<U>>, "DDSketch::add_batch() needs arithmetic values");
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            add(static_cast<double>(values.unchecked(i)));
+        }
+    }
+
+    /**
+     * @brief Fold in another sketch: the result summarizes both streams.
+     * @note Panics if other is this sketch (bins may shift mid-merge).
+     */
+    void merge(const DDSketch& other) noexcept {
+        CRAB_ASSERT(&other != this, "DDSketch::merge() called with itself");
+        if (other.m_count == 0) {
+            return;
+        }
+        if (other.m_has_keys) {
+            for (std::size_t j = 0; j < Bins; ++j) {
+                if (other.m_bins[j] != 0) {
+                    m_bins[place(other.m_offset + static_cast<int32_t>(j))] += other.m_bins[j];
+                }
+            }
+        }
+        m_zero += other.m_zero;
+        m_count += other.m_count;
+        m_min = other.m_min < m_min ? other.m_min : m_min;
+        m_max = other.m_max > m_max ? other.m_max : m_max;
+    }
+
+    void reset() noexcept {
+        std::memset(m_bins, 0, sizeof(m_bins));
+        m_offset = 0;
+        m_has_keys = false;
+        m_zero = 0;
+        m_count = 0;
+        m_min = std::numeric_limits<double>::infinity();
+        m_max = -std::numeric_limits<double>::infinity();
+    }
+
+    // ========================================================================
+    // Query
+    // ========================================================================
+
+    /**
+     * @brief Value at quantile q in [0, 1], or None if empty or q is out of range.
+     *
+     * q = 0 and q = 1 return the exact min and max.
+     */
+    [[nodiscard]] Option<double> quantile(double q) const noexcept {
+        if (m_count == 0 || !(q >= 0.0 && q <= 1.0)) {
+            return None;
+        }
+        if (q == 0.0) {
+            return Some(m_min);
+        }
+        if (q == 1.0) {
+            return Some(m_max);
+        }
+        const double rank = q * static_cast<double>(m_count - 1);
+        uint64_t seen = m_zero;
+        if (rank < static_cast<double>(seen)) {
+            return Some(clamp(0.0));
+        }
+        for (std::size_t j = 0; j < Bins; ++j) {
+            seen += m_bins[j];
+            if (rank < static_cast<double>(seen)) {
+                return Some(clamp(value_of(m_offset + static_cast<int32_t>(j))));
+            }
+        }
+        return Some(m_max);
+    }
+
+    [[nodiscard]] uint64_t count() const noexcept { return m_count; }
+    [[nodiscard]] bool is_empty() const noexcept { return m_count == 0; }
+
+    [[nodiscard]] Option<double> min() const noexcept {
+        if (m_count == 0) {
+            return None;
+        }
+        return Some(m_min);
+    }
+
+    [[nodiscard]] Option<double> max() const noexcept {
+        if (m_count == 0) {
+            return None;
+        }
+        return Some(m_max);
+    }
+
+    // ========================================================================
+    // Serialization
+    // ========================================================================
+
+    /**
+     * @brief Bytes save() will write (only the occupied bucket range is stored).
+     */
+    [[nodiscard]] std::size_t serialized_size() const noexcept {
+        const auto [first, n] = used_range();
+        (void)first;
+        return kMaxSerializedSize - (Bins - n) * 8;
+    }
+
+    Result<std::size_t, CapacityExceeded> save(ByteSlice out) const noexcept {
+        const std::size_t size = serialized_size();
+        if (out.size() < size) {
+            return Err(CapacityExceeded{size, out.size()});
+        }
+        const auto [first, n] = used_range();
+        detail::SketchWriter w{out.data()};
+        w.header(detail::SketchKind::DDSketch);
+        w.put(static_cast<uint32_t>(Bins));
+        w.put(static_cast<uint32_t>(RelativeErrorBp));
+        w.put(m_count);
+        w.put(m_zero);
+        w.put(m_min);
+        w.put(m_max);
+        w.put(m_offset);
+        w.put(static_cast<uint32_t>(first));
+        w.put(static_cast<uint32_t>(n));
+        for (std::size_t j = first; j < first + n; ++j) {
+            w.put(m_bins[j]);
+        }
+        return Ok(w.pos);
+    }
+
+    /**
+     * @brief Replace this sketch with one written by save(); unchanged on error.
+     */
+    Result<Unit, ParseError> load(ConstByteSlice in) noexcept {
+        detail::SketchReader r{in};
+        r.header(detail::SketchKind::DDSketch);
+        r.expect(static_cast<uint32_t>(Bins));
+        r.expect(static_cast<uint32_t>(RelativeErrorBp));
+        const uint64_t count = r.get<uint64_t>();
+        const uint64_t zero = r.get<uint64_t>();
+        const double mn = r.get<double>();
+        const double mx = r.get<double>();
+        const int32_t offset = r.get<int32_t>();
+        const uint32_t first = r.get<uint32_t>();
+        const std::size_t n_at = r.pos;
+        const uint32_t n = r.get<uint32_t>();
+        if (r.failed) {
+            return r.finish();
+        }
+        if (first > Bins || n > Bins - first) {
+            return Err(ParseError{n_at, 0, 0});
+        }
+        if (!r.has(std::size_t{n} * 8)) {
+            return r.finish();
+        }
+        uint64_t bins[Bins] = {};
+        uint64_t total = zero;
+        for (std::size_t j = first; j < first + n; ++j) {
+            bins[j] = r.get<uint64_t>();
+            total += bins[j];
+        }
+        if (total != count) {
+            return Err(ParseError{n_at, 0, 0});
+        }
+        std::memcpy(m_bins, bins, sizeof(m_bins));
+        m_count = count;
+        m_zero = zero;
+        m_min = count ? mn : std::numeric_limits<double>::infinity();
+        m_max = count ? mx : -std::numeric_limits<double>::infinity();
+        m_offset = offset;
+        m_has_keys = n != 0;
+        return Ok();
+    }
+
+private:
+    static constexpr double kLogGamma = detail::log_gamma(kRelativeError);
+
+    static int32_t key_of(double x) noexcept {
+        return static_cast<int32_t>(std::ceil(std::log(x) / kLogGamma));
+    }
+
+    // Midpoint (in relative terms) of bucket (gamma^(k-1), gamma^k]
+    static double value_of(int32_t key) noexcept {
+        return 2.0 * std::exp(static_cast<double>(key) * kLogGamma) / (kGamma + 1.0);
+    }
+
+    double clamp(double v) const noexcept {
+        return v < m_min ? m_min : (v > m_max ? m_max : v);
+    }
+
+    struct Range {
+        std::size_t first;
+        std::size_t size;
+    };
+
+    Range used_range() const noexcept {
+        std::size_t lo = 0;
+        while (lo < Bins && m_bins[lo] == 0) {
+            ++lo;
+        }
+        if (lo == Bins) {
+            return {0, 0};
+        }
+        std::size_t hi = Bins - 1;
+        while (m_bins[hi] == 0) {
+            --hi;
+        }
+        return {lo, hi - lo + 1};
+    }
+
+    // Index for a key, moving the bucket window if needed
+    std::size_t place(int32_t key) noexcept {
+        if (!m_has_keys) {
+            m_offset = key - static_cast<int32_t>(Bins / 2);
+            m_has_keys = true;
+        }
+        const int64_t idx = static_cast<int64_t>(key) - m_offset;
+        if (idx >= static_cast<int64_t>(Bins)) {
+            shift_up(static_cast<std::size_t>(idx - static_cast<int64_t>(Bins - 1)));
+            return Bins - 1;
+        }
+        if (idx < 0) {
+            const Range used = used_range();
+            const std::size_t room = used.size == 0 ? Bins : Bins - (used.first + used.size);
+            const std::size_t want = static_cast<std::size_t>(-idx);
+            // Shift down as far as the top allows; anything still below collapses into bin 0
+            shift_down(want < room ? want : room);
+            return 0;
+        }
+        return static_cast<std::size_t>(idx);
+    }
+
+    // Slide the window up by s buckets, folding the lowest ones into bin 0
+    void shift_up(std::size_t s) noexcept {
+        if (s >= Bins) {
+            uint64_t all = 0;
+            for (std::size_t j = 0; j < Bins; ++j) {
+                all += m_bins[j];
+            }
+            std::memset(m_bins, 0, sizeof(m_bins));
+            m_bins[0] = all;
+        } else {
+            uint64_t fold = 0;
+            for (std::size_t j = 0; j <= s; ++j) {
+                fold += m_bins[j];
+            }
+            std::memmove(m_bins, m_bins + s, (Bins - s) * sizeof(uint64_t));
+            std::memset(m_bins + (Bins - s), 0, s * sizeof(uint64_t));
+            m_bins[0] = fold;
+        }
+        m_offset += static_cast<int32_t>(s);
+    }
+
+    void shift_down(std::size_t d) noexcept {
+        if (d == 0) {
+            return;
+        }
+        std::memmove(m_bins + d, m_bins, (Bins - d) * sizeof(uint64_t));
+        std::memset(m_bins, 0, d * sizeof(uint64_t));
+        m_offset -= static_cast<int32_t>(d);
+    }
+
+    uint64_t m_bins[Bins];
+    int32_t m_offset;     // Key of m_bins[0]
+    bool m_has_keys;
+    uint64_t m_zero;      // Values <= 0
+    uint64_t m_count;
+    double m_min;
+    double m_max;
+};
+
+// ============================================================================
+// KLL-Style Quantile Sketch
+// ============================================================================
+
+/**
+ * @brief Rank-accurate quantiles for any arithmetic type.
+ *
+ * A stack of Levels compactors with K items each; an item at level h
+ * stands for 2^h samples. When a level fills it is sorted and every
+ * other item (random phase) moves up a level, which keeps total weight
+ * exact and rank error unbiased. Levels above 0 are kept sorted as
+ * items are merged in, so quantile() only sorts a stack copy of level 0
+ * (K * sizeof(T) bytes) and is safe to call concurrently on a const
+ * sketch. Typical rank error is about sqrt(levels in use) / K (under 1%
+ * for K = 256 on millions of samples).
+ *
+ * Capacity is K * 2^Levels samples; beyond that the top level starts
+ * discarding half its items. NaN is ignored.
+ *
+ * @tparam T Arithmetic sample type
+ * @tparam K Items per level (even)
+ * @tparam Levels Number of compactor levels
+ */
+template<typename T, std::size_t K = 256, std::size_t Levels = 32>
+class QuantileSketch {
+    static_assert(std::is_arithmetic_v<T>, "QuantileSketch requires an arithmetic type");
+    static_assert(K >= 8 && K % 2 == 0 && K <= 65535, "QuantileSketch K must be even, in [8, 65535]");
+    static_assert(Levels >= 2 && Levels <= 48, "QuantileSketch levels must be in [2, 48]");
+
+public:
+    static constexpr std::size_t kMaxSerializedSize =
+        detail::kSketchHeaderSize + 4 + 4 + 1 + 8 + 2 * sizeof(T) + Levels * (2 + K * sizeof(T));
+
+    QuantileSketch() noexcept { reset(); }
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    void add(T value) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (value != value) {
+                return;
+            }
+        }
+        append(value);
+        ++m_count;
+        m_min = value < m_min ? value : m_min;
+        m_max = value > m_max ? value : m_max;
+    }
+
+    template<typename U>
+    void add_batch(Slice<U> values) noexcept {
+        static_assert(std::is_same_v<std::remove_const_t<U>, T>, "QuantileSketch::add_batch() element type mismatch");
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            add(values.unchecked(i));
+        }
+    }
+
+    /**
+     * @brief Fold in another sketch: items join the level of equal weight.
+     * @note Panics if other is this sketch (levels compact mid-merge).
+     */
+    void merge(const QuantileSketch& other) noexcept {
+        CRAB_ASSERT(&other != this, "QuantileSketch::merge() called with itself");
+        if (other.m_count == 0) {
+            return;
+        }
+        for (std::size_t i = 0; i < other.m_sizes[0]; ++i) {
+            append(other.m_items[0][i]);
+        }
+        for (std::size_t h = 1; h < Levels; ++h) {
+            absorb(h, other.m_items[h], other.m_sizes[h]);
+        }
+        m_count += other.m_count;
+        m_min = other.m_min < m_min ? other.m_min : m_min;
+        m_max = other.m_max > m_max ? other.m_max : m_max;
+    }
+
+    void reset() noexcept {
+        std::memset(m_sizes, 0, sizeof(m_sizes));
+        m_count = 0;
+        m_min = std::numeric_limits<T>::max();
+        m_max = std::numeric_limits<T>::lowest();
+        m_rng = 0x9E3779B97F4A7C15ull;
+    }
+
+    // ========================================================================
+    // Query
+    // ========================================================================
+
+    /**
+     * @brief Value at quantile q in [0, 1], or None if empty or q is out of range.
+     *
+     * q = 0 and q = 1 return the exact min and max.
+     */
+    [[nodiscard]] Option<T> quantile(double q) const noexcept {
+        if (m_count == 0 || !(q >= 0.0 && q <= 1.0)) {
+            return None;
+        }
+        if (q == 0.0) {
+            return Some(m_min);
+        }
+        if (q == 1.0) {
+            return Some(m_max);
+        }
+        // Only level 0 is unordered; sort a copy so the sketch stays untouched
+        T level0[K];
+        std::copy(m_items[0], m_items[0] + m_sizes[0], level0);
+        std::sort(level0, level0 + m_sizes[0]);
+        const T* items[Levels];
+        uint64_t total = 0;
+        for (std::size_t h = 0; h < Levels; ++h) {
+            items[h] = h == 0 ? level0 : m_items[h];
+            total += static_cast<uint64_t>(m_sizes[h]) << h;
+        }
+        const double rank = q * static_cast<double>(total);
+        // k-way merge across levels in ascending order
+        std::size_t pos[Levels] = {};
+        uint64_t seen = 0;
+        for (;;) {
+            std::size_t best = Levels;
+            for (std::size_t h = 0; h < Levels; ++h) {
+                if (pos[h] < m_sizes[h] && (best == Levels || items[h][pos[h]] < items[best][pos[best]])) {
+                    best = h;
+                }
+            }
+            if (best == Levels) {
+                return Some(m_max);
+            }
+            seen += uint64_t{1} << best;
+            if (static_cast<double>(seen) > rank) {
+                return Some(items[best][pos[best]]);
+            }
+            ++pos[best];
+        }
+    }
+
+    [[nodiscard]] uint64_t count() const noexcept { return m_count; }
+    [[nodiscard]] bool is_empty() const noexcept { return m_count == 0; }
+
+    // ========================================================================
+    // Serialization
+    // ========================================================================
+
+    [[nodiscard]] std::size_t serialized_size() const noexcept {
+        std::size_t items = 0;
+        for (std::size_t h = 0; h < Levels; ++h) {
+            items += m_sizes[h];
+        }
+        return kMaxSerializedSize - (Levels * K - items) * sizeof(T);
+    }
+
+    Result<std::size_t, CapacityExceeded> save(ByteSlice out) const noexcept {
+        const std::size_t size = serialized_size();
+        if (out.size() < size) {
+            return Err(CapacityExceeded{size, out.size()});
+        }
+        detail::SketchWriter w{out.data()};
+        w.header(detail::SketchKind::Quantile);
+        w.put(static_cast<uint32_t>(K));
+        w.put(static_cast<uint32_t>(Levels));
+        w.put(type_tag());
+        w.put(m_count);
+        w.put(m_min);
+        w.put(m_max);
+        for (std::size_t h = 0; h < Levels; ++h) {
+            w.put(m_sizes[h]);
+            for (std::size_t i = 0; i < m_sizes[h]; ++i) {
+                w.put(m_items[h][i]);
+            }
+        }
+        return Ok(w.pos);
+    }
+
+    /**
+     * @brief Replace this sketch with one written by save(); unchanged on error.
+     */
+    Result<Unit, ParseError> load(ConstByteSlice in) noexcept {
+        detail::SketchReader r{in};
+        r.header(detail::SketchKind::Quantile);
+        r.expect(static_cast<uint32_t>(K));
+        r.expect(static_cast<uint32_t>(Levels));
+        r.expect(type_tag());
+        const uint64_t count = r.get<uint64_t>();
+        const T mn = r.get<T>();
+        const T mx = r.get<T>();
+        if (r.failed) {
+            return r.finish();
+        }
+        // Decode the levels first so a bad one leaves *this untouched
+        uint16_t sizes[Levels] = {};
+        const std::size_t levels_at = r.pos;
+        uint64_t weight = 0;
+        for (std::size_t h = 0; h < Levels; ++h) {
+            const std::size_t at = r.pos;
+            sizes[h] = r.get<uint16_t>();
+            if (sizes[h] > K) {
+                return Err(ParseError{at, 0, 0});
+            }
+            if (!r.has(sizes[h] * sizeof(T))) {
+                return r.finish();
+            }
+            r.pos += sizes[h] * sizeof(T);
+            weight += static_cast<uint64_t>(sizes[h]) << h;
+        }
+        if (r.failed) {
+            return r.finish();
+        }
+        if ((weight == 0) != (count == 0)) {
+            return Err(ParseError{levels_at, 0, 0});
+        }
+        r.pos = levels_at;
+        for (std::size_t h = 0; h < Levels; ++h) {
+            m_sizes[h] = r.get<uint16_t>();
+            for (std::size_t i = 0; i < m_sizes[h]; ++i) {
+                m_items[h][i] = r.get<T>();
+            }
+            // Restore the sorted-level invariant for input from any writer
+            if (h != 0) {
+                std::sort(m_items[h], m_items[h] + m_sizes[h]);
+            }
+        }
+        m_count = count;
+        m_min = count ? mn : std::numeric_limits<T>::max();
+        m_max = count ? mx : std::numeric_limits<T>::lowest();
+        return Ok();
+    }
+
+private:
+    // Distinguishes e.g. int32_t from float, which share a size
+    static constexpr uint8_t type_tag() noexcept {
+        return static_cast<uint8_t>(sizeof(T) | (std::is_floating_point_v<T> ? 0x80 : 0) |
+                                    (std::is_signed_v<T> ? 0x40 : 0));
+    }
+
+    bool coin() noexcept {
+        m_rng ^= m_rng << 13;
+        m_rng ^= m_rng >> 7;
+        m_rng ^= m_rng << 17;
+        return (m_rng >> 63) != 0;
+    }
+
+    // Level 0 takes raw samples in arrival order
+    void append(T value) noexcept {
+        if (m_sizes[0] == K) {
+            compact(0);
+        }
+        m_items[0][m_sizes[0]++] = value;
+    }
+
+    // Merge n sorted items into sorted level h (h > 0), compacting as it fills
+    void absorb(std::size_t h, const T* src, std::size_t n) noexcept {
+        while (n != 0) {
+            if (m_sizes[h] == K) {
+                compact(h);
+            }
+            const std::size_t take = n < K - m_sizes[h] ? n : K - m_sizes[h];
+            // Merge from the back: level h has room for `take` more
+            T* dst = m_items[h];
+            std::size_t i = m_sizes[h];
+            std::size_t j = take;
+            for (std::size_t out = i + j; j != 0; --out) {
+                if (i != 0 && src[j - 1] < dst[i - 1]) {
+                    dst[out - 1] = dst[--i];
+                } else {
+                    dst[out - 1] = src[--j];
+                }
+            }
+            m_sizes[h] = static_cast<uint16_t>(m_sizes[h] + take);
+            src += take;
+            n -= take;
+        }
+    }
+
+    // Keep every other sorted item (random phase) at the front, then
+    // promote them; the level is empty afterwards
+    void compact(std::size_t h) noexcept {
+        T* items = m_items[h];
+        if (h == 0) {
+            std::sort(items, items + K);
+        }
+        const std::size_t phase = coin() ? 1 : 0;
+        for (std::size_t i = 0; i < K / 2; ++i) {
+            items[i] = items[2 * i + phase];
+        }
+        if (h + 1 < Levels) {
+            m_sizes[h] = 0;
+            absorb(h + 1, items, K / 2);
+        } else {
+            // Out of levels: keep the half in place (weight is lost, not distorted)
+            m_sizes[h] = static_cast<uint16_t>(K / 2);
+        }
+    }
+
+    T m_items[Levels][K];
+    uint16_t m_sizes[Levels];
+    uint64_t m_count;
+    T m_min;
+    T m_max;
+    uint64_t m_rng;
+};
+
+} // namespace crab
@@ -0,0 +1,400 @@
+#pragma once
+
+/**
+ * @file slice2d.h
+ * @brief Strided and 2-D non-owning views for image and matrix buffers.
+ *
+ * Slice2D<T> describes a row-major buffer with padding (pitch) so callers
+ * pay one bounds check per row and keep the inner loop over a plain
+ * Slice<T>, unchecked and vectorizable.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+namespace crab {
+
+/**
+ * @brief Bounds-checked view of every stride-th element.
+ *
+ * Typical use is a matrix column or one channel of interleaved samples.
+ * Does NOT own the data.
+ *
+ * @tparam T Element type (can be const for read-only views)
+ */
+template<typename T>
+class StridedSlice {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    /**
+     * @brief Random-access iterator that steps by the stride.
+     *
+     * Tracks an index rather than a pointer, so end() never forms a
+     * pointer past the underlying buffer.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        constexpr iterator() noexcept = default;
+        constexpr iterator(T* base, difference_type index, difference_type stride) noexcept
+            : m_base(base), m_index(index), m_stride(stride) {}
+
+        constexpr reference operator*() const noexcept { return m_base[m_index * m_stride]; }
+        constexpr pointer operator->() const noexcept { return &m_base[m_index * m_stride]; }
+        constexpr reference operator[](difference_type n) const noexcept {
+            return m_base[(m_index + n) * m_stride];
+        }
+
+        constexpr iterator& operator++() noexcept { ++m_index; return *this; }
+        constexpr iterator operator++(int) noexcept { iterator t = *this; ++m_index; return t; }
+        constexpr iterator& operator--() noexcept { --m_index; return *this; }
+        constexpr iterator operator--(int) noexcept { iterator t = *this; --m_index; return t; }
+        constexpr iterator& operator+=(difference_type n) noexcept { m_index += n; return *this; }
+        constexpr iterator& operator-=(difference_type n) noexcept { m_index -= n; return *this; }
+        constexpr iterator operator+(difference_type n) const noexcept { iterator t = *this; return t += n; }
+        constexpr iterator operator-(difference_type n) const noexcept { iterator t = *this; return t -= n; }
+        constexpr difference_type operator-(const iterator& o) const noexcept { return m_index - o.m_index; }
+
+        constexpr bool operator==(const iterator& o) const noexcept { return m_index == o.m_index; }
+        constexpr bool operator!=(const iterator& o) const noexcept { return m_index != o.m_index; }
+        constexpr bool operator<(const iterator& o) const noexcept { return m_index < o.m_index; }
+
+    private:
+        T* m_base{nullptr};
+        difference_type m_index{0};
+        difference_type m_stride{1};
+    };
+
+    // ========================================================================
+    // Constructors
+    // ========================================================================
+
+    constexpr StridedSlice() noexcept : m_data(nullptr), m_size(0), m_stride(1) {}
+
+    /**
+     * @brief Construct from raw pointer, element count and stride (explicit).
+     *
+     * @param data Pointer to first element
+     * @param size Number of elements in the view
+     * @param stride Distance between elements, in elements (>= 1)
+     */
+    explicit constexpr StridedSlice(T* data, size_type size, size_type stride) noexcept
+        : m_data(data), m_size(size), m_stride(stride) {}
+
+    /**
+     * @brief Checked construction over a Slice.
+     * @return Err if the last element (offset + (size-1)*stride) is past the end
+     */
+    static Result<StridedSlice, OutOfBounds>
+    from_slice(Slice<T> base, size_type offset, size_type size, size_type stride) noexcept {
+        if (stride == 0) {
+            return Err(OutOfBounds{0, 0});
+        }
+        if (size == 0) {
+            return Ok(StridedSlice(base.data(), 0, stride));
+        }
+        const size_type last = offset + (size - 1) * stride;
+        if (offset >= base.size() || last >= base.size()) {
+            return Err(OutOfBounds{last, base.size()});
+        }
+        return Ok(StridedSlice(base.data() + offset, size, stride));
+    }
+
+    /** @brief Implicit conversion to a read-only view. */
+    template<typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    constexpr operator StridedSlice<const T>() const noexcept {
+        return StridedSlice<const T>(m_data, m_size, m_stride);
+    }
+
+    // ========================================================================
+    // Size
+    // ========================================================================
+
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr size_type stride() const noexcept { return m_stride; }
+    [[nodiscard]] constexpr bool is_empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+
+    // ========================================================================
+    // Element Access
+    // ========================================================================
+
+    [[nodiscard]] Result<std::reference_wrapper<T>, OutOfBounds> get(size_type index) const noexcept {
+        if (index >= m_size) {
+            return Err(OutOfBounds{index, m_size});
+        }
+        return Ok(std::ref(m_data[index * m_stride]));
+    }
+
+    /**
+     * @brief Element access (bounds-checked unless CRAB_UNSAFE_FAST).
+     */
+    [[nodiscard]] reference operator[](size_type index) const noexcept {
+        CRAB_ASSERT(index < m_size, "StridedSlice index out of bounds");
+        return m_data[index * m_stride];
+    }
+
+    /**
+     * @brief Unchecked element access (explicit unsafe opt-in).
+     */
+    [[nodiscard]] reference unchecked(size_type index) const noexcept {
+        return m_data[index * m_stride];
+    }
+
+    [[nodiscard]] constexpr T* data() const noexcept { return m_data; }
+
+    // ========================================================================
+    // Iteration
+    // ========================================================================
+
+    [[nodiscard]] iterator begin() const noexcept {
+        return iterator(m_data, 0, static_cast<std::ptrdiff_t>(m_stride));
+    }
+    [[nodiscard]] iterator end() const noexcept {
+        return iterator(m_data, static_cast<std::ptrdiff_t>(m_size),
+                        static_cast<std::ptrdiff_t>(m_stride));
+    }
+
+private:
+    T* m_data;
+    size_type m_size;
+    size_type m_stride;
+};
+
+/**
+ * @brief Row-major 2-D view with pitch (row stride >= cols).
+ *
+ * Padding between rows is never exposed: row(i) returns exactly cols
+ * elements. Inner loops run over that row Slice with unchecked() or
+ * range-for, so the bounds check happens once per row.
+ *
+ * @tparam T Element type (can be const for read-only views)
+ *
+ * @code{cpp}
+ *   uint8_t frame[480 * 656];  // 640 px wide, 16 bytes row padding
+ *   auto img = crab::Slice2D<uint8_t>::from_slice(crab::ByteSlice(frame), 480, 640, 656).unwrap();
+ *   img.for_each_row([](std::size_t, crab::ByteSlice row) {
+ *       for (auto& px : row) { px = 255 - px; }  // unchecked, vectorizable
+ *   });
+ * @endcode
+ */
+template<typename T>
+class Slice2D {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+
+    // ========================================================================
+    // Constructors
+    // ========================================================================
+
+    constexpr Slice2D() noexcept : m_data(nullptr), m_rows(0), m_cols(0), m_pitch(0) {}
+
+    /**
+     * @brief Construct from raw pointer and shape (explicit, unchecked).
+     *
+     * @param data Pointer to element (0, 0)
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param pitch Elements between the starts of consecutive rows
+     */
+    explicit constexpr Slice2D(T* data, size_type rows, size_type cols, size_type pitch) noexcept
+        : m_data(data), m_rows(rows), m_cols(cols), m_pitch(pitch) {}
+
+    /**
+     * @brief Checked construction over a 1-D buffer.
+     * @return Err if pitch < cols or the last row runs past the buffer
+     */
+    static Result<Slice2D, OutOfBounds>
+    from_slice(Slice<T> buffer, size_type rows, size_type cols, size_type pitch) noexcept {
+        if (pitch < cols) {
+            return Err(OutOfBounds{cols, pitch});
+        }
+        if (rows == 0 || cols == 0) {
+            return Ok(Slice2D(buffer.data(), rows, cols, pitch));
+        }
+        const size_type needed = (rows - 1) * pitch + cols;
+        if (needed > buffer.size()) {
+            return Err(OutOfBounds{needed, buffer.size()});
+        }
+        return Ok(Slice2D(buffer.data(), rows, cols, pitch));
+    }
+
+    /**
+     * @brief Checked construction over a densely packed buffer (pitch == cols).
+     */
+    static Result<Slice2D, OutOfBounds>
+    from_slice(Slice<T> buffer, size_type rows, size_type cols) noexcept {
+        return from_slice(buffer, rows, cols, cols);
+    }
+
+    /** @brief Implicit conversion to a read-only view. */
+    template<typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    constexpr operator Slice2D<const T>() const noexcept {
+        return Slice2D<const T>(m_data, m_rows, m_cols, m_pitch);
+    }
+
+    // ========================================================================
+    // Shape
+    // ========================================================================
+
+    [[nodiscard]] constexpr size_type rows() const noexcept { return m_rows; }
+    [[nodiscard]] constexpr size_type cols() const noexcept { return m_cols; }
+    [[nodiscard]] constexpr size_type pitch() const noexcept { return m_pitch; }
+    [[nodiscard]] constexpr bool is_empty() const noexcept { return m_rows == 0 || m_cols == 0; }
+    [[nodiscard]] constexpr bool is_contiguous() const noexcept { return m_pitch == m_cols || m_rows <= 1; }
+    [[nodiscard]] constexpr T* data() const noexcept { return m_data; }
+
+    // ========================================================================
+    // Element Access
+    // ========================================================================
+
+    /**
+     * @brief Get element with bounds checking, returning Result.
+     */
+    [[nodiscard]] Result<std::reference_wrapper<T>, OutOfBounds>
+    at(size_type r, size_type c) const noexcept {
+        if (r >= m_rows) {
+            return Err(OutOfBounds{r, m_rows});
+        }
+        if (c >= m_cols) {
+            return Err(OutOfBounds{c, m_cols});
+        }
+        return Ok(std::ref(m_data[r * m_pitch + c]));
+    }
+
+    /**
+     * @brief Element access (bounds-checked unless CRAB_UNSAFE_FAST).
+     */
+    [[nodiscard]] reference operator()(size_type r, size_type c) const noexcept {
+        CRAB_ASSERT(r < m_rows && c < m_cols, "Slice2D index out of bounds");
+        return m_data[r * m_pitch + c];
+    }
+
+    /**
+     * @brief Unchecked element access (explicit unsafe opt-in).
+     */
+    [[nodiscard]] reference unchecked(size_type r, size_type c) const noexcept {
+        return m_data[r * m_pitch + c];
+    }
+
+    // ========================================================================
+    // Rows, Columns, Sub-views
+    // ========================================================================
+
+    /**
+     * @brief Row r as a Slice of exactly cols() elements (one bounds check).
+     */
+    [[nodiscard]] Slice<T> row(size_type r) const noexcept {
+        CRAB_ASSERT(r < m_rows, "Slice2D row out of bounds");
+        return Slice<T>(m_data + r * m_pitch, m_cols);
+    }
+
+    /**
+     * @brief Row r as a Slice, returning Result instead of asserting.
+     */
+    [[nodiscard]] Result<Slice<T>, OutOfBounds> get_row(size_type r) const noexcept {
+        if (r >= m_rows) {
+            return Err(OutOfBounds{r, m_rows});
+        }
+        return Ok(Slice<T>(m_data + r * m_pitch, m_cols));
+    }
+
+    /**
+     * @brief Column c as a StridedSlice (stride == pitch).
+     */
+    [[nodiscard]] Result<StridedSlice<T>, OutOfBounds> column(size_type c) const noexcept {
+        if (c >= m_cols) {
+            return Err(OutOfBounds{c, m_cols});
+        }
+        return Ok(StridedSlice<T>(m_data + c, m_rows, m_pitch));
+    }
+
+    /**
+     * @brief Sub-rectangle view sharing this view's pitch.
+     *
+     * @param r0 First row
+     * @param c0 First column
+     * @param rows Number of rows in the sub-view
+     * @param cols Number of columns in the sub-view
+     */
+    [[nodiscard]] Result<Slice2D, OutOfBounds>
+    subview(size_type r0, size_type c0, size_type rows, size_type cols) const noexcept {
+        if (r0 > m_rows || rows > m_rows - r0) {
+            return Err(OutOfBounds{r0 + rows, m_rows});
+        }
+        if (c0 > m_cols || cols > m_cols - c0) {
+            return Err(OutOfBounds{c0 + cols, m_cols});
+        }
+        return Ok(Slice2D(m_data + r0 * m_pitch + c0, rows, cols, m_pitch));
+    }
+
+    /**
+     * @brief Whole buffer as a 1-D Slice (only if there is no row padding).
+     */
+    [[nodiscard]] Result<Slice<T>, OutOfBounds> as_contiguous() const noexcept {
+        if (!is_contiguous()) {
+            return Err(OutOfBounds{m_pitch, m_cols});
+        }
+        return Ok(Slice<T>(m_data, m_rows * m_cols));
+    }
+
+    // ========================================================================
+    // Traversal
+    // ========================================================================
+
+    /**
+     * @brief Call fn(r, row_slice) for every row. No per-element checks.
+     */
+    template<typename F>
+    void for_each_row(F&& fn) const {
+        for (size_type r = 0; r < m_rows; ++r) {
+            fn(r, Slice<T>(m_data + r * m_pitch, m_cols));
+        }
+    }
+
+    /**
+     * @brief Call fn(r0, c0, tile) for each tile_rows x tile_cols block.
+     *
+     * Tiles are visited row-major; edge tiles are clipped to the view.
+     * Useful for cache blocking (transpose, convolution, downsampling).
+     *
+     * @note Panics if a tile dimension is zero.
+     */
+    template<typename F>
+    void for_each_tile(size_type tile_rows, size_type tile_cols, F&& fn) const {
+        CRAB_ASSERT(tile_rows > 0 && tile_cols > 0, "Slice2D tile size must be non-zero");
+        for (size_type r0 = 0; r0 < m_rows; r0 += tile_rows) {
+            const size_type h = (m_rows - r0 < tile_rows) ? m_rows - r0 : tile_rows;
+            for (size_type c0 = 0; c0 < m_cols; c0 += tile_cols) {
+                const size_type w = (m_cols - c0 < tile_cols) ? m_cols - c0 : tile_cols;
+                fn(r0, c0, Slice2D(m_data + r0 * m_pitch + c0, h, w, m_pitch));
+            }
+        }
+    }
+
+private:
+    T* m_data;
+    size_type m_rows;
+    size_type m_cols;
+    size_type m_pitch;
+};
+
+} // namespace crab
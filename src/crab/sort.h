@@ -0,0 +1,530 @@
+#pragma once
+
+/**
+ * @file sort.h
+ * @brief Allocation-free sorting kernels: LSD radix sort and sorting networks.
+ *
+ * - radix_sort() / radix_sort_by_key(): stable LSD radix sort for integer
+ *   and floating-point keys using a caller-provided scratch Slice. O(n);
+ *   overtakes std::sort from roughly a thousand keys (see sort_bench).
+ * - sort_network<N>(): branch-free Batcher odd-even merge network for a
+ *   fixed N <= 32, for any T with operator<.
+ * - sort_small(): up to 32 arithmetic elements, using an in-register
+ *   AVX2 bitonic sort for int32/uint32/float and sorting networks otherwise.
+ * - sort_small_stable(): insertion sort for small inputs that need stability.
+ *
+ * Floating-point keys are ordered by their IEEE total order: -0.0 sorts
+ * before +0.0, and negative/positive NaNs sort first/last in radix_sort().
+ * sort_network() and sort_small() do not support NaN.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/error_types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace crab {
+
+namespace detail {
+
+// ============================================================================
+// Radix Key Mapping
+// ============================================================================
+
+template<std::size_t Size>
+struct UnsignedOfSize;
+template<> struct UnsignedOfSize<1> { using type = uint8_t; };
+template<> struct UnsignedOfSize<2> { using type = uint16_t; };
+template<> struct UnsignedOfSize<4> { using type = uint32_t; };
+template<> struct UnsignedOfSize<8> { using type = uint64_t; };
+
+/// Map a key to an unsigned integer with the same ordering.
+template<typename K>
+struct RadixKey {
+    static_assert(std::is_integral_v<K> || std::is_floating_point_v<K>,
+        "radix_sort keys must be integers or floating point");
+    using Bits = typename UnsignedOfSize<sizeof(K)>::type;
+    static constexpr Bits sign = static_cast<Bits>(Bits{1} << (sizeof(K) * 8 - 1));
+
+    static Bits bits(K key) noexcept {
+        Bits b;
+        std::memcpy(&b, &key, sizeof(K));
+        if constexpr (std::is_floating_point_v<K>) {
+            // Negative: flip everything; positive: flip the sign bit
+            return (b & sign) ? static_cast<Bits>(~b) : static_cast<Bits>(b ^ sign);
+        } else if constexpr (std::is_signed_v<K>) {
+            return static_cast<Bits>(b ^ sign);
+        } else {
+            return b;
+        }
+    }
+};
+
+constexpr std::size_t kRadixInsertionCutoff = 32;
+
+template<typename K, typename V>
+void insertion_sort_by_bits(K* keys, V* values, std::size_t n) noexcept {
+    using R = RadixKey<K>;
+    for (std::size_t i = 1; i < n; ++i) {
+        const K key = keys[i];
+        const auto bits = R::bits(key);
+        std::size_t j = i;
+        if constexpr (std::is_void_v<V>) {
+            for (; j > 0 && bits < R::bits(keys[j - 1]); --j) {
+                keys[j] = keys[j - 1];
+            }
+        } else {
+            V value = static_cast<V&&>(values[i]);
+            for (; j > 0 && bits < R::bits(keys[j - 1]); --j) {
+                keys[j] = keys[j - 1];
+                values[j] = static_cast<V&&>(values[j - 1]);
+            }
+            values[j] = static_cast<V&&>(value);
+        }
+        keys[j] = key;
+    }
+}
+
+// Values are moved alongside keys when V is not void
+template<typename K, typename V>
+void radix_sort_impl(K* keys, K* key_scratch, V* values, V* value_scratch, std::size_t n) noexcept {
+    using R = RadixKey<K>;
+    constexpr std::size_t passes = sizeof(K);
+
+    if (n <= kRadixInsertionCutoff) {
+        insertion_sort_by_bits<K, V>(keys, values, n);
+        return;
+    }
+    CRAB_ASSERT(n <= UINT32_MAX, "radix_sort() supports at most 2^32 - 1 elements");
+
+    // All histograms in one read pass
+    uint32_t counts[passes][256] = {};
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto bits = R::bits(keys[i]);
+        for (std::size_t p = 0; p < passes; ++p) {
+            ++counts[p][(bits >> (8 * p)) & 0xFF];
+        }
+    }
+
+    K* src = keys;
+    K* dst = key_scratch;
+    V* vsrc = values;
+    V* vdst = value_scratch;
+    for (std::size_t p = 0; p < passes; ++p) {
+        const unsigned shift = static_cast<unsigned>(8 * p);
+        uint32_t* count = counts[p];
+        // Every key shares this digit: the pass would be a plain copy
+        if (count[(R::bits(src[0]) >> shift) & 0xFF] == n) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (std::size_t d = 0; d < 256; ++d) {
+            const uint32_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t to = count[(R::bits(src[i]) >> shift) & 0xFF]++;
+            dst[to] = src[i];
+            if constexpr (!std::is_void_v<V>) {
+                vdst[to] = static_cast<V&&>(vsrc[i]);
+            }
+        }
+        std::swap(src, dst);
+        if constexpr (!std::is_void_v<V>) {
+            std::swap(vsrc, vdst);
+        }
+    }
+
+    if (src != keys) {
+        std::memcpy(keys, src, n * sizeof(K));
+        if constexpr (!std::is_void_v<V>) {
+            for (std::size_t i = 0; i < n; ++i) {
+                values[i] = static_cast<V&&>(vsrc[i]);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Sorting Networks
+// ============================================================================
+
+struct NetworkPair {
+    uint8_t lo;
+    uint8_t hi;
+};
+
+constexpr std::size_t network_width(std::size_t n) noexcept {
+    std::size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+// Batcher's odd-even merge sort over the next power of two, dropping every
+// comparator that touches an index >= N (those lanes would hold +inf and
+// never swap). Returns the comparator count; fills out when non-null.
+template<std::size_t N>
+constexpr std::size_t batcher_pairs(NetworkPair* out) noexcept {
+    constexpr std::size_t width = network_width(N);
+    std::size_t count = 0;
+    for (std::size_t p = 1; p < width; p <<= 1) {
+        for (std::size_t k = p; k >= 1; k >>= 1) {
+            for (std::size_t j = k % p; j + k < width; j += 2 * k) {
+                for (std::size_t i = 0; i < k && i + j + k < width; ++i) {
+                    const std::size_t a = i + j;
+                    const std::size_t b = i + j + k;
+                    if (a / (2 * p) == b / (2 * p) && b < N) {
+                        if (out != nullptr) {
+                            out[count] = NetworkPair{static_cast<uint8_t>(a), static_cast<uint8_t>(b)};
+                        }
+                        ++count;
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+template<std::size_t N>
+constexpr std::array<NetworkPair, batcher_pairs<N>(nullptr)> build_network() noexcept {
+    std::array<NetworkPair, batcher_pairs<N>(nullptr)> pairs{};
+    batcher_pairs<N>(pairs.data());
+    return pairs;
+}
+
+template<std::size_t N>
+struct Network {
+    static constexpr std::size_t size = batcher_pairs<N>(nullptr);
+    static constexpr std::array<NetworkPair, size> pairs = build_network<N>();
+};
+
+template<typename T>
+inline void compare_exchange(T& a, T& b) noexcept {
+    const bool swap = b < a;
+    const T lo = swap ? b : a;
+    const T hi = swap ? a : b;
+    a = lo;
+    b = hi;
+}
+
+template<std::size_t N, typename T, std::size_t... I>
+inline void run_network(T* a, std::index_sequence<I...>) noexcept {
+    (compare_exchange(a[Network<N>::pairs[I].lo], a[Network<N>::pairs[I].hi]), ...);
+}
+
+template<typename T>
+constexpr T sort_padding() noexcept {
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+        return std::numeric_limits<T>::infinity();
+    } else {
+        return std::numeric_limits<T>::max();
+    }
+}
+
+// ============================================================================
+// AVX2 In-Register Bitonic Sort (8 x 32-bit lanes)
+// ============================================================================
+
+#if CRAB_SIMD_X86
+
+// Per-stage lane permutation (partner = lane ^ j) and "take max" lane mask
+struct BitonicStage {
+    int32_t perm[8];
+    int32_t take_max[8];
+};
+
+struct BitonicTables {
+    BitonicStage sort[6]{};   // full sort of 8 lanes: k = 2, 4, 8
+    BitonicStage merge[3]{};  // merge of a bitonic register: j = 4, 2, 1
+
+    constexpr BitonicTables() noexcept {
+        std::size_t s = 0;
+        for (int k = 2; k <= 8; k <<= 1) {
+            for (int j = k >> 1; j >= 1; j >>= 1) {
+                for (int i = 0; i < 8; ++i) {
+                    sort[s].perm[i] = i ^ j;
+                    sort[s].take_max[i] = (((i & j) != 0) != ((i & k) != 0)) ? -1 : 0;
+                }
+                ++s;
+            }
+        }
+        s = 0;
+        for (int j = 4; j >= 1; j >>= 1) {
+            for (int i = 0; i < 8; ++i) {
+                merge[s].perm[i] = i ^ j;
+                merge[s].take_max[i] = (i & j) != 0 ? -1 : 0;
+            }
+            ++s;
+        }
+    }
+};
+
+inline constexpr BitonicTables kBitonicTables{};
+
+template<typename T>
+struct SortAvx2;
+
+template<>
+struct SortAvx2<int32_t> {
+    using vec = __m256i;
+    CRAB_TARGET_AVX2 static vec load(const int32_t* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    CRAB_TARGET_AVX2 static void store(int32_t* p, vec v) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    CRAB_TARGET_AVX2 static vec min(vec a, vec b) noexcept { return _mm256_min_epi32(a, b); }
+    CRAB_TARGET_AVX2 static vec max(vec a, vec b) noexcept { return _mm256_max_epi32(a, b); }
+    CRAB_TARGET_AVX2 static vec permute(vec v, __m256i idx) noexcept { return _mm256_permutevar8x32_epi32(v, idx); }
+    CRAB_TARGET_AVX2 static vec blend(vec lo, vec hi, __m256i mask) noexcept { return _mm256_blendv_epi8(lo, hi, mask); }
+};
+
+template<>
+struct SortAvx2<uint32_t> : SortAvx2<int32_t> {
+    using vec = __m256i;
+    CRAB_TARGET_AVX2 static vec load(const uint32_t* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    CRAB_TARGET_AVX2 static void store(uint32_t* p, vec v) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    CRAB_TARGET_AVX2 static vec min(vec a, vec b) noexcept { return _mm256_min_epu32(a, b); }
+    CRAB_TARGET_AVX2 static vec max(vec a, vec b) noexcept { return _mm256_max_epu32(a, b); }
+};
+
+template<>
+struct SortAvx2<float> {
+    using vec = __m256;
+    CRAB_TARGET_AVX2 static vec load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    CRAB_TARGET_AVX2 static void store(float* p, vec v) noexcept { _mm256_storeu_ps(p, v); }
+    CRAB_TARGET_AVX2 static vec min(vec a, vec b) noexcept { return _mm256_min_ps(a, b); }
+    CRAB_TARGET_AVX2 static vec max(vec a, vec b) noexcept { return _mm256_max_ps(a, b); }
+    CRAB_TARGET_AVX2 static vec permute(vec v, __m256i idx) noexcept { return _mm256_permutevar8x32_ps(v, idx); }
+    CRAB_TARGET_AVX2 static vec blend(vec lo, vec hi, __m256i mask) noexcept {
+        return _mm256_blendv_ps(lo, hi, _mm256_castsi256_ps(mask));
+    }
+};
+
+template<typename Ops, typename V>
+CRAB_TARGET_AVX2 V bitonic_stage(V v, const BitonicStage& stage) noexcept {
+    const __m256i perm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stage.perm));
+    const __m256i take_max = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stage.take_max));
+    const V partner = Ops::permute(v, perm);
+    return Ops::blend(Ops::min(v, partner), Ops::max(v, partner), take_max);
+}
+
+// Sort n <= 32 elements as R = 1, 2 or 4 registers of 8 lanes
+template<typename T, std::size_t R>
+CRAB_TARGET_AVX2 void sort_small_avx2(T* data, std::size_t n) noexcept {
+    using Ops = SortAvx2<T>;
+    using V = typename Ops::vec;
+
+    alignas(32) T buf[R * 8];
+    std::memcpy(buf, data, n * sizeof(T));
+    for (std::size_t i = n; i < R * 8; ++i) {
+        buf[i] = sort_padding<T>();
+    }
+
+    V r[R];
+    for (std::size_t i = 0; i < R; ++i) {
+        r[i] = Ops::load(buf + i * 8);
+        for (const BitonicStage& stage : kBitonicTables.sort) {
+            r[i] = bitonic_stage<Ops>(r[i], stage);
+        }
+    }
+
+    // Merge sorted runs of w registers into runs of 2w
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    for (std::size_t w = 1; w < R; w *= 2) {
+        for (std::size_t base = 0; base < R; base += 2 * w) {
+            // Reverse the second run so the pair forms one bitonic sequence
+            for (std::size_t t = 0; t < w / 2; ++t) {
+                std::swap(r[base + w + t], r[base + 2 * w - 1 - t]);
+            }
+            for (std::size_t t = 0; t < w; ++t) {
+                r[base + w + t] = Ops::permute(r[base + w + t], reverse);
+            }
+            for (std::size_t d = w; d >= 1; d /= 2) {
+                for (std::size_t i = base; i < base + 2 * w; ++i) {
+                    if (((i - base) & d) == 0) {
+                        const V lo = Ops::min(r[i], r[i + d]);
+                        r[i + d] = Ops::max(r[i], r[i + d]);
+                        r[i] = lo;
+                    }
+                }
+            }
+            for (std::size_t i = base; i < base + 2 * w; ++i) {
+                for (const BitonicStage& stage : kBitonicTables.merge) {
+                    r[i] = bitonic_stage<Ops>(r[i], stage);
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < R; ++i) {
+        Ops::store(buf + i * 8, r[i]);
+    }
+    std::memcpy(data, buf, n * sizeof(T));
+}
+
+template<typename T>
+inline constexpr bool has_avx2_small_sort_v =
+    std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, float>;
+
+#endif // CRAB_SIMD_X86
+
+template<std::size_t Width, typename T>
+void sort_padded(T* data, std::size_t n) noexcept {
+    T buf[Width];
+    for (std::size_t i = 0; i < n; ++i) {
+        buf[i] = data[i];
+    }
+    for (std::size_t i = n; i < Width; ++i) {
+        buf[i] = sort_padding<T>();
+    }
+    run_network<Width>(buf, std::make_index_sequence<Network<Width>::size>{});
+    for (std::size_t i = 0; i < n; ++i) {
+        data[i] = buf[i];
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// Radix Sort
+// ============================================================================
+
+/**
+ * @brief Stable LSD radix sort (8-bit digits) of integer or float keys.
+ *
+ * Passes whose digit is identical for every key are skipped, so narrow
+ * key ranges cost fewer passes. Inputs of 32 or fewer keys use insertion
+ * sort.
+ *
+ * @param keys Keys to sort in place
+ * @param scratch Work space of at least keys.size() elements
+ * @return Ok, or Err if scratch is too small (keys are untouched)
+ */
+template<typename K>
+Result<Unit, CapacityExceeded> radix_sort(Slice<K> keys, Slice<K> scratch) noexcept {
+    static_assert(!std::is_const_v<K>, "radix_sort() requires mutable Slices");
+    if (scratch.size() < keys.size()) {
+        return Err(CapacityExceeded{keys.size(), scratch.size()});
+    }
+    detail::radix_sort_impl<K, void>(keys.data(), scratch.data(), nullptr, nullptr, keys.size());
+    return Ok();
+}
+
+/**
+ * @brief Stable radix sort of keys, applying the same permutation to values.
+ *
+ * @param keys Keys to sort in place
+ * @param values One value per key (panics if sizes differ)
+ * @param key_scratch Work space of at least keys.size() keys
+ * @param value_scratch Work space of at least keys.size() values
+ * @return Ok, or Err if either scratch Slice is too small
+ */
+template<typename K, typename V>
+Result<Unit, CapacityExceeded> radix_sort_by_key(Slice<K> keys, Slice<V> values,
+                                                 Slice<K> key_scratch, Slice<V> value_scratch) noexcept {
+    static_assert(!std::is_const_v<K> && !std::is_const_v<V>, "radix_sort_by_key() requires mutable Slices");
+    CRAB_ASSERT(keys.size() == values.size(), "radix_sort_by_key() keys and values differ in length");
+    if (key_scratch.size() < keys.size()) {
+        return Err(CapacityExceeded{keys.size(), key_scratch.size()});
+    }
+    if (value_scratch.size() < keys.size()) {
+        return Err(CapacityExceeded{keys.size(), value_scratch.size()});
+    }
+    detail::radix_sort_impl<K, V>(keys.data(), key_scratch.data(), values.data(), value_scratch.data(), keys.size());
+    return Ok();
+}
+
+// ============================================================================
+// Small Sorts
+// ============================================================================
+
+/**
+ * @brief Sort exactly N elements with a branch-free sorting network.
+ *
+ * The network is generated at compile time and fully unrolled; every
+ * comparator is a conditional move, so running time does not depend on
+ * the data. Not stable.
+ *
+ * @tparam N Number of elements (1..32); panics if s.size() != N
+ */
+template<std::size_t N, typename T>
+void sort_network(Slice<T> s) noexcept {
+    static_assert(N >= 1 && N <= 32, "sort_network supports 1..32 elements");
+    static_assert(!std::is_const_v<T>, "sort_network() requires a mutable Slice");
+    CRAB_ASSERT(s.size() == N, "sort_network<N>() called with a Slice of a different size");
+    detail::run_network<N>(s.data(), std::make_index_sequence<detail::Network<N>::size>{});
+}
+
+/**
+ * @brief Sort up to 32 arithmetic elements without branches on the data.
+ *
+ * int32/uint32/float above 4 elements use an in-register AVX2 bitonic sort
+ * when available; everything else pads to 4/8/16/32 elements and runs sort_network().
+ * Not stable; NaN is not supported.
+ *
+ * @note Panics if s.size() > 32.
+ */
+template<typename T>
+void sort_small(Slice<T> s) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_const_v<T>, "sort_small() requires mutable arithmetic elements");
+    const std::size_t n = s.size();
+    CRAB_ASSERT(n <= 32, "sort_small() supports at most 32 elements");
+    if (n < 2) {
+        return;
+    }
+    T* p = s.data();
+#if CRAB_SIMD_X86
+    if constexpr (detail::has_avx2_small_sort_v<T>) {
+        // Four elements are cheaper as five scalar comparators
+        if (n > 4 && simd::active_level() >= simd::Level::Avx2) {
+            if (n <= 8) {
+                detail::sort_small_avx2<T, 1>(p, n);
+            } else if (n <= 16) {
+                detail::sort_small_avx2<T, 2>(p, n);
+            } else {
+                detail::sort_small_avx2<T, 4>(p, n);
+            }
+            return;
+        }
+    }
+#endif
+    if (n <= 4) {
+        detail::sort_padded<4>(p, n);
+    } else if (n <= 8) {
+        detail::sort_padded<8>(p, n);
+    } else if (n <= 16) {
+        detail::sort_padded<16>(p, n);
+    } else {
+        detail::sort_padded<32>(p, n);
+    }
+}
+
+/**
+ * @brief Stable insertion sort; the right choice below ~16 elements when
+ *        equal keys must keep their order.
+ */
+template<typename T>
+void sort_small_stable(Slice<T> s) noexcept {
+    static_assert(!std::is_const_v<T>, "sort_small_stable() requires a mutable Slice");
+    T* p = s.data();
+    for (std::size_t i = 1; i < s.size(); ++i) {
+        T value = static_cast<T&&>(p[i]);
+        std::size_t j = i;
+        for (; j > 0 && value < p[j - 1]; --j) {
+            p[j] = static_cast<T&&>(p[j - 1]);
+        }
+        p[j] = static_cast<T&&>(value);
+    }
+}
+
+} // namespace crab
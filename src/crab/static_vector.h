@@ -30,9 +30,13 @@ namespace crab {
  * 
  * @tparam T Element type
  * @tparam Capacity Maximum number of elements
+ * @tparam Align Storage alignment in bytes (e.g. 32/64 for SIMD loads)
  */
-template <typename T, std::size_t Capacity>
+template <typename T, std::size_t Capacity, std::size_t Align = alignof(T)>
 class StaticVector {
+    static_assert(Align >= alignof(T), "StaticVector alignment must be at least alignof(T)");
+    static_assert((Align & (Align - 1)) == 0, "StaticVector alignment must be a power of two");
+
 public:
     using value_type = T;
     using size_type = std::size_t;
@@ -129,6 +133,7 @@ public:
 
     [[nodiscard]] size_type size() const noexcept { return m_size; }
     [[nodiscard]] constexpr size_type capacity() const noexcept { return Capacity; }
+    [[nodiscard]] static constexpr size_type alignment() noexcept { return Align; }
     [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
     [[nodiscard]] bool is_full() const noexcept { return m_size >= Capacity; }
     [[nodiscard]] size_type remaining() const noexcept { return Capacity - m_size; }
@@ -384,7 +389,7 @@ private:
         return *slot;
     }
 
-    alignas(T) unsigned char m_storage[sizeof(T) * Capacity]{};
+    alignas(Align) unsigned char m_storage[sizeof(T) * Capacity]{};
     size_type m_size{0};
 };
 
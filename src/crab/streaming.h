@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file streaming.h
+ * @brief Non-temporal (cache-bypassing) bulk copy and fill for Slices.
+ *
+ * Large snapshot copies through memmove pull both buffers into cache and
+ * evict the working set of latency-sensitive threads. These variants use
+ * non-temporal stores above a size threshold so the destination goes
+ * straight to memory.
+ *
+ * ## Customization
+ *
+ * - `CRAB_STREAMING_THRESHOLD`: Minimum size in bytes before non-temporal
+ *   stores are used (default 256 KiB). Smaller copies use memmove/fill.
+ *
+ * @note Non-temporal stores are implemented for x86 (SSE2/AVX2). Other
+ *       targets fall back to memmove / element-wise fill.
+ */
+
+#include "crab/macros.h"
+#include "crab/result.h"
+#include "crab/slice.h"
+#include "crab/simd.h"
+#include "crab/error_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifndef CRAB_STREAMING_THRESHOLD
+    #define CRAB_STREAMING_THRESHOLD (256u * 1024u)
+#endif
+
+namespace crab {
+
+namespace detail {
+
+#if CRAB_SIMD_X86
+
+// Copy bytes with 16-byte streaming stores; dst must be 16-byte aligned
+inline void stream_copy_sse2(uint8_t* dst, const uint8_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 48), d);
+    }
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), a);
+    }
+    std::memcpy(dst + i, src + i, n - i);
+}
+
+// Copy bytes with 32-byte streaming stores; dst must be 32-byte aligned
+CRAB_TARGET_AVX2
+inline void stream_copy_avx2(uint8_t* dst, const uint8_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 128 <= n; i += 128) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 64));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 32), b);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 64), c);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 96), d);
+    }
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), a);
+    }
+    std::memcpy(dst + i, src + i, n - i);
+}
+
+// Fill bytes with a repeating 16-byte pattern; dst must be 16-byte aligned
+inline void stream_fill_sse2(uint8_t* dst, __m128i pattern, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), pattern);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), pattern);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 32), pattern);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 48), pattern);
+    }
+    for (; i + 16 <= n; i += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), pattern);
+    }
+}
+
+#endif // CRAB_SIMD_X86
+
+inline bool ranges_overlap(const void* a, const void* b, std::size_t n) noexcept {
+    const auto pa = reinterpret_cast<std::uintptr_t>(a);
+    const auto pb = reinterpret_cast<std::uintptr_t>(b);
+    return pa < pb + n && pb < pa + n;
+}
+
+} // namespace detail
+
+/**
+ * @brief Copy src into the front of dest, bypassing the cache for large copies.
+ *
+ * Above CRAB_STREAMING_THRESHOLD bytes (and for non-overlapping ranges),
+ * the destination is written with non-temporal stores followed by an
+ * sfence, so the copy does not evict the caller's working set and is
+ * visible to other threads once this returns. Small or overlapping copies
+ * use memmove, exactly like Slice::copy_to().
+ *
+ * @param src Source elements
+ * @param dest Destination (must be at least src.size() elements)
+ * @return Ok on success, Err if dest is too small
+ */
+template<typename T>
+Result<Unit, OutOfBounds> copy_streaming(Slice<const T> src, Slice<T> dest) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "copy_streaming requires trivially copyable T");
+    if (dest.size() < src.size()) {
+        return Err(OutOfBounds{src.size(), dest.size()});
+    }
+    const std::size_t bytes = src.size() * sizeof(T);
+    auto* out = reinterpret_cast<uint8_t*>(dest.data());
+    const auto* in = reinterpret_cast<const uint8_t*>(src.data());
+
+#if CRAB_SIMD_X86
+    if (bytes >= CRAB_STREAMING_THRESHOLD && !detail::ranges_overlap(out, in, bytes)) {
+        const bool avx2 = simd::active_level() >= simd::Level::Avx2;
+        const std::size_t align = avx2 ? 32 : 16;
+        const std::size_t head = (align - (reinterpret_cast<std::uintptr_t>(out) & (align - 1))) & (align - 1);
+        std::memcpy(out, in, head);
+        if (avx2) {
+            detail::stream_copy_avx2(out + head, in + head, bytes - head);
+        } else {
+            detail::stream_copy_sse2(out + head, in + head, bytes - head);
+        }
+        _mm_sfence();
+        return Ok();
+    }
+#endif
+
+    if (bytes != 0) {
+        std::memmove(out, in, bytes);
+    }
+    return Ok();
+}
+
+/**
+ * @brief Overload accepting a mutable source slice.
+ */
+template<typename T, typename = std::enable_if_t<!std::is_const_v<T>>>
+Result<Unit, OutOfBounds> copy_streaming(Slice<T> src, Slice<T> dest) noexcept {
+    return copy_streaming(Slice<const T>(src.data(), src.size()), dest);
+}
+
+/**
+ * @brief Set every element of dest to value, bypassing the cache when large.
+ *
+ * Non-temporal stores are used above CRAB_STREAMING_THRESHOLD bytes when
+ * sizeof(T) is 1, 2, 4, 8 or 16; otherwise this is a plain element loop.
+ *
+ * @param dest Elements to overwrite
+ * @param value Fill value
+ */
+template<typename T>
+void fill_streaming(Slice<T> dest, const T& value) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "fill_streaming requires trivially copyable T");
+    static_assert(!std::is_const_v<T>, "fill_streaming requires a mutable Slice");
+
+#if CRAB_SIMD_X86
+    if constexpr ((16 % sizeof(T)) == 0) {
+        const std::size_t bytes = dest.size() * sizeof(T);
+        auto* out = reinterpret_cast<uint8_t*>(dest.data());
+        const std::size_t head = (16 - (reinterpret_cast<std::uintptr_t>(out) & 15)) & 15;
+        if (bytes >= CRAB_STREAMING_THRESHOLD && head % sizeof(T) == 0) {
+            alignas(16) uint8_t lanes[16];
+            for (std::size_t i = 0; i < 16; i += sizeof(T)) {
+                std::memcpy(lanes + i, &value, sizeof(T));
+            }
+            const std::size_t head_elems = head / sizeof(T);
+            for (std::size_t i = 0; i < head_elems; ++i) {
+                dest.unchecked(i) = value;
+            }
+            const std::size_t body = (bytes - head) & ~static_cast<std::size_t>(15);
+            detail::stream_fill_sse2(out + head, _mm_load_si128(reinterpret_cast<const __m128i*>(lanes)), body);
+            for (std::size_t i = (head + body) / sizeof(T); i < dest.size(); ++i) {
+                dest.unchecked(i) = value;
+            }
+            _mm_sfence();
+            return;
+        }
+    }
+#endif
+
+    for (std::size_t i = 0; i < dest.size(); ++i) {
+        dest.unchecked(i) = value;
+    }
+}
+
+} // namespace crab
@@ -0,0 +1,388 @@
+#pragma once
+
+/**
+ * @file window.h
+ * @brief O(1) sliding-window aggregators over fixed ring storage.
+ *
+ * Each aggregator keeps the last Window samples (or the running state for
+ * exponentially weighted ones) inline, with no heap:
+ *
+ * - WindowMin / WindowMax: monotonic deque, amortized O(1) per sample
+ * - WindowStats: mean and variance with Welford updates and removal
+ * - EwmaStats: exponentially weighted mean and variance
+ *
+ * Rings are sized to the next power of two and indexed by free-running
+ * 64-bit counters masked on access, so pushes never compare against the
+ * capacity. Every aggregator takes single samples via push() and batches
+ * via push_batch(Slice<const T>).
+ */
+
+#include "crab/macros.h"
+#include "crab/option.h"
+#include "crab/slice.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace crab {
+
+namespace detail {
+
+constexpr std::size_t next_pow2(std::size_t n) noexcept {
+    std::size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+} // namespace detail
+
+// ============================================================================
+// Monotonic Window Extremum
+// ============================================================================
+
+/**
+ * @brief Extremum of the last Window samples.
+ *
+ * Keeps a deque of candidates whose values are strictly ordered by Compare;
+ * a new sample evicts every candidate it beats, so each sample is pushed
+ * and popped at most once. value() is the front of the deque.
+ *
+ * @tparam T Sample type (trivially copyable)
+ * @tparam Window Number of most recent samples covered
+ * @tparam Compare less for a minimum, greater for a maximum
+ *
+ * @code{cpp}
+ *   crab::WindowMax<float, 64> hi;
+ *   hi.push_batch(crab::Slice<const float>(ticks, n));
+ *   float peak = hi.value().unwrap_or(0.0f);
+ * @endcode
+ */
+template<typename T, std::size_t Window, typename Compare = std::less<T>>
+class MonotonicWindow {
+    static_assert(Window > 0, "MonotonicWindow window must be non-zero");
+    static_assert(std::is_trivially_copyable_v<T>, "MonotonicWindow requires a trivially copyable T");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    MonotonicWindow() = default;
+    explicit MonotonicWindow(Compare cmp) noexcept : m_cmp(static_cast<Compare&&>(cmp)) {}
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    /**
+     * @brief Add the newest sample, dropping the one that leaves the window.
+     */
+    void push(const T& value) noexcept {
+        const uint64_t seq = m_count++;
+        // Expire first so the deque never holds more than Window entries;
+        // seqs advance by one per push, so at most one candidate leaves
+        if (m_tail != m_head && m_seqs[m_head & kMask] + Window <= seq) {
+            ++m_head;
+        }
+        // Candidates the new sample beats (or ties) can never be the answer again
+        while (m_tail != m_head && !m_cmp(m_values[(m_tail - 1) & kMask], value)) {
+            --m_tail;
+        }
+        m_values[m_tail & kMask] = value;
+        m_seqs[m_tail & kMask] = seq;
+        ++m_tail;
+    }
+
+    /**
+     * @brief Add every sample of a batch, oldest first.
+     */
+    template<typename U>
+    void push_batch(Slice<U> batch) noexcept {
+        static_assert(std::is_same_v<std::remove_const_t<U>, T>, "MonotonicWindow::push_batch() element type mismatch");
+        // Only the last Window samples can still matter; everything older expires
+        size_type i = 0;
+        if (batch.size() > Window) {
+            i = batch.size() - Window;
+            m_count += i;
+            m_head = m_tail;
+        }
+        for (; i < batch.size(); ++i) {
+            push(batch.unchecked(i));
+        }
+    }
+
+    void reset() noexcept {
+        m_head = 0;
+        m_tail = 0;
+        m_count = 0;
+    }
+
+    // ========================================================================
+    // Query
+    // ========================================================================
+
+    /**
+     * @brief Extremum of the samples in the window, or None before the first push.
+     */
+    [[nodiscard]] Option<T> value() const noexcept {
+        if (m_head == m_tail) {
+            return None;
+        }
+        return Some(m_values[m_head & kMask]);
+    }
+
+    /**
+     * @brief Samples currently covered (at most Window).
+     */
+    [[nodiscard]] size_type count() const noexcept {
+        return m_count < Window ? static_cast<size_type>(m_count) : Window;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept { return m_count == 0; }
+    [[nodiscard]] static constexpr size_type window() noexcept { return Window; }
+
+private:
+    static constexpr size_type kSlots = detail::next_pow2(Window);
+    static constexpr uint64_t kMask = kSlots - 1;
+
+    T m_values[kSlots]{};
+    uint64_t m_seqs[kSlots]{};
+    uint64_t m_head = 0;    // First live candidate (free-running, masked on access)
+    uint64_t m_tail = 0;    // One past the last candidate
+    uint64_t m_count = 0;   // Samples pushed since reset
+    Compare m_cmp{};
+};
+
+template<typename T, std::size_t Window>
+using WindowMin = MonotonicWindow<T, Window, std::less<T>>;
+
+template<typename T, std::size_t Window>
+using WindowMax = MonotonicWindow<T, Window, std::greater<T>>;
+
+// ============================================================================
+// Window Mean / Variance
+// ============================================================================
+
+/**
+ * @brief Mean and variance of the last Window samples.
+ *
+ * Welford's update runs in double. Once the window is full, each push
+ * folds "add newest, remove oldest" into a single step, so cost stays
+ * O(1) and there is no running sum of squares to cancel catastrophically.
+ *
+ * @tparam T Arithmetic sample type
+ * @tparam Window Number of most recent samples covered
+ */
+template<typename T, std::size_t Window>
+class WindowStats {
+    static_assert(Window > 0, "WindowStats window must be non-zero");
+    static_assert(std::is_arithmetic_v<T>, "WindowStats requires an arithmetic sample type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    WindowStats() = default;
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    void push(const T& value) noexcept {
+        const double x = static_cast<double>(value);
+        if (m_count < Window) {
+            const double n = static_cast<double>(m_count + 1);
+            const double delta = x - m_mean;
+            m_mean += delta / n;
+            m_m2 += delta * (x - m_mean);
+        } else {
+            // Replace the oldest sample in one step
+            const double old = static_cast<double>(m_samples[(m_count - Window) & kMask]);
+            const double prev_mean = m_mean;
+            m_mean += (x - old) / static_cast<double>(Window);
+            m_m2 += (x - old) * ((x - m_mean) + (old - prev_mean));
+            // Rounding can push a zero-variance window slightly negative
+            m_m2 = m_m2 < 0.0 ? 0.0 : m_m2;
+        }
+        m_samples[m_count & kMask] = value;
+        ++m_count;
+    }
+
+    template<typename U>
+    void push_batch(Slice<U> batch) noexcept {
+        static_assert(std::is_same_v<std::remove_const_t<U>, T>, "WindowStats::push_batch() element type mismatch");
+        for (size_type i = 0; i < batch.size(); ++i) {
+            push(batch.unchecked(i));
+        }
+    }
+
+    void reset() noexcept {
+        m_count = 0;
+        m_mean = 0.0;
+        m_m2 = 0.0;
+    }
+
+    // ========================================================================
+    // Query
+    // ========================================================================
+
+    [[nodiscard]] size_type count() const noexcept {
+        return m_count < Window ? static_cast<size_type>(m_count) : Window;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept { return m_count == 0; }
+    [[nodiscard]] static constexpr size_type window() noexcept { return Window; }
+
+    /**
+     * @brief Mean of the window, or None if empty.
+     */
+    [[nodiscard]] Option<double> mean() const noexcept {
+        if (m_count == 0) {
+            return None;
+        }
+        return Some(m_mean);
+    }
+
+    /**
+     * @brief Population variance (divide by n), or None if empty.
+     */
+    [[nodiscard]] Option<double> variance() const noexcept {
+        if (m_count == 0) {
+            return None;
+        }
+        return Some(m_m2 / static_cast<double>(count()));
+    }
+
+    /**
+     * @brief Sample variance (divide by n - 1), or None with fewer than two samples.
+     */
+    [[nodiscard]] Option<double> sample_variance() const noexcept {
+        if (count() < 2) {
+            return None;
+        }
+        return Some(m_m2 / static_cast<double>(count() - 1));
+    }
+
+    /**
+     * @brief Oldest sample still in the window, or None if empty.
+     */
+    [[nodiscard]] Option<T> oldest() const noexcept {
+        if (m_count == 0) {
+            return None;
+        }
+        return Some(m_samples[(m_count - count()) & kMask]);
+    }
+
+private:
+    static constexpr size_type kSlots = detail::next_pow2(Window);
+    static constexpr uint64_t kMask = kSlots - 1;
+
+    T m_samples[kSlots]{};
+    uint64_t m_count = 0;
+    double m_mean = 0.0;
+    double m_m2 = 0.0;    // Sum of squared deviations from m_mean
+};
+
+// ============================================================================
+// Exponentially Weighted Statistics
+// ============================================================================
+
+/**
+ * @brief Exponentially weighted moving mean and variance.
+ *
+ * Each sample moves the estimate by alpha of its deviation; older samples
+ * decay geometrically, so no history is stored. The variance recurrence
+ * is the incremental form from West (1979), stable for small alpha.
+ */
+class EwmaStats {
+public:
+    /**
+     * @param alpha Weight of the newest sample, in (0, 1]
+     */
+    explicit EwmaStats(double alpha) noexcept : m_alpha(alpha) {
+        CRAB_ASSERT(alpha > 0.0 && alpha <= 1.0, "EwmaStats alpha must be in (0, 1]");
+    }
+
+    /**
+     * @brief alpha = 2 / (span + 1): the convention used for an "N-sample EMA".
+     */
+    [[nodiscard]] static EwmaStats from_span(std::size_t span) noexcept {
+        CRAB_ASSERT(span > 0, "EwmaStats span must be non-zero");
+        return EwmaStats(2.0 / (static_cast<double>(span) + 1.0));
+    }
+
+    /**
+     * @brief Weight of a sample halves after half_life further samples.
+     */
+    [[nodiscard]] static EwmaStats from_half_life(double half_life) noexcept {
+        CRAB_ASSERT(half_life > 0.0, "EwmaStats half-life must be positive");
+        return EwmaStats(1.0 - std::exp2(-1.0 / half_life));
+    }
+
+    // ========================================================================
+    // Ingest
+    // ========================================================================
+
+    /**
+     * @brief Add a sample; the first one initializes the mean.
+     */
+    void push(double x) noexcept {
+        if (m_count == 0) {
+            m_mean = x;
+            m_var = 0.0;
+        } else {
+            const double diff = x - m_mean;
+            const double incr = m_alpha * diff;
+            m_mean += incr;
+            m_var = (1.0 - m_alpha) * (m_var + diff * incr);
+        }
+        ++m_count;
+    }
+
+    template<typename U>
+    void push_batch(Slice<U> batch) noexcept {
+        static_assert(std::is_arithmetic_v<std::remove_const_t<U>>, "EwmaStats::push_batch() needs arithmetic samples");
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            push(static_cast<double>(batch.unchecked(i)));
+        }
+    }
+
+    void reset() noexcept {
+        m_count = 0;
+        m_mean = 0.0;
+        m_var = 0.0;
+    }
+
+    // ========================================================================
+    // Query
+    // ========================================================================
+
+    [[nodiscard]] Option<double> mean() const noexcept {
+        if (m_count == 0) {
+            return None;
+        }
+        return Some(m_mean);
+    }
+
+    [[nodiscard]] Option<double> variance() const noexcept {
+        if (m_count == 0) {
+            return None;
+        }
+        return Some(m_var);
+    }
+
+    [[nodiscard]] double alpha() const noexcept { return m_alpha; }
+    [[nodiscard]] uint64_t count() const noexcept { return m_count; }
+
+private:
+    double m_alpha;
+    double m_mean = 0.0;
+    double m_var = 0.0;
+    uint64_t m_count = 0;
+};
+
+} // namespace crab
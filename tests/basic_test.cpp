@@ -7,9 +7,18 @@
  */
 
 #include <crab/prelude.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
 #include <vector>
 #include <cassert>
 
+#if CRAB_HAS_POSIX_IO
+#include <unistd.h>
+#endif
+
 // ============================================================================
 // Result Tests
 // ============================================================================
@@ -75,6 +84,232 @@ void slice_tests() {
     assert(dest[2] == 3);
 }
 
+// ============================================================================
+// Slice2D Tests
+// ============================================================================
+
+void slice2d_tests() {
+    // 3 rows x 4 cols, pitch 5 (one padding element per row)
+    int buffer[15];
+    for (int i = 0; i < 15; ++i) {
+        buffer[i] = i;
+    }
+    auto made = crab::Slice2D<int>::from_slice(crab::Slice<int>(buffer), 3, 4, 5);
+    assert(made.is_ok());
+    auto img = made.unwrap();
+    assert(crab::Slice2D<int>::from_slice(crab::Slice<int>(buffer), 4, 4, 5).is_err());
+    assert(crab::Slice2D<int>::from_slice(crab::Slice<int>(buffer), 3, 6, 5).is_err());
+    
+    // Rows never include padding
+    assert(img.row(1).size() == 4);
+    assert(img.row(1)[0] == 5);
+    assert(img.at(2, 3).unwrap().get() == 13);
+    assert(img.at(2, 4).is_err());
+    assert(img.at(3, 0).is_err());
+    assert(img.as_contiguous().is_err());
+    
+    // Column view
+    auto col = img.column(1).unwrap();
+    assert(col.size() == 3);
+    assert(col[2] == 11);
+    int col_sum = 0;
+    for (int v : col) {
+        col_sum += v;
+    }
+    assert(col_sum == 1 + 6 + 11);
+    assert(img.column(4).is_err());
+    
+    // Sub-rectangle keeps the parent pitch
+    auto sub = img.subview(1, 1, 2, 2).unwrap();
+    assert(sub(0, 0) == 6);
+    assert(sub(1, 1) == 12);
+    assert(img.subview(2, 0, 2, 1).is_err());
+    
+    // Row traversal: one check per row, unchecked inner loop
+    img.for_each_row([](size_t, crab::Slice<int> row) {
+        for (auto& v : row) {
+            v *= 2;
+        }
+    });
+    assert(buffer[4] == 4);   // Padding untouched
+    assert(buffer[5] == 10);
+    
+    // Tiled traversal clips edge tiles
+    size_t tiles = 0;
+    size_t covered = 0;
+    img.for_each_tile(2, 3, [&](size_t, size_t, crab::Slice2D<int> tile) {
+        ++tiles;
+        covered += tile.rows() * tile.cols();
+    });
+    assert(tiles == 4);
+    assert(covered == 12);
+    
+    crab::Slice2D<const int> view = img;
+    assert(view.row(0).size() == 4);
+    
+    // Strided view over interleaved samples
+    auto right = crab::StridedSlice<int>::from_slice(crab::Slice<int>(buffer), 1, 7, 2);
+    assert(right.is_ok());
+    assert(right.unwrap()[1] == buffer[3]);
+    assert(crab::StridedSlice<int>::from_slice(crab::Slice<int>(buffer), 1, 8, 2).is_err());
+}
+
+// ============================================================================
+// AlignedSlice Tests
+// ============================================================================
+
+void aligned_slice_tests() {
+    crab::StaticVector<float, 64, 32> samples;
+    static_assert(alignof(decltype(samples)) >= 32, "over-aligned storage");
+    for (int i = 0; i < 37; ++i) {
+        samples.push_back(static_cast<float>(i));
+    }
+    
+    // Alignment proven by the container type
+    crab::AlignedSlice<float, 32> whole(samples);
+    assert(whole.size() == 37);
+    assert(reinterpret_cast<uintptr_t>(whole.data()) % 32 == 0);
+    crab::AlignedSlice<const float, 16> weaker = whole;
+    assert(weaker.size() == 37);
+    
+    // Checked conversion
+    crab::Slice<float> slice(samples);
+    assert((crab::AlignedSlice<float, 32>::from_slice(slice).is_ok()));
+    auto misaligned = crab::AlignedSlice<float, 32>::from_slice(slice.skip(1));
+    assert(misaligned.is_err());
+    assert(misaligned.unwrap_err().alignment == 32);
+    
+    // prologue / body / epilogue
+    auto parts = crab::split_aligned<32>(slice.skip(3));
+    assert(parts.prologue.size() == 5);
+    assert(parts.body.size() == 24);
+    assert(parts.epilogue.size() == 5);
+    assert(parts.body[0] == 8.0f);
+    assert(reinterpret_cast<uintptr_t>(parts.body.data()) % 32 == 0);
+    
+    // Too short for an aligned block
+    auto tiny = crab::split_aligned<32>(slice.subslice(1, 4).unwrap());
+    assert(tiny.prologue.size() == 3);
+    assert(tiny.body.empty() && tiny.epilogue.empty());
+}
+
+// ============================================================================
+// Streaming Copy Tests
+// ============================================================================
+
+void streaming_tests() {
+    // Large enough to take the non-temporal path, odd length and offset
+    const size_t n = CRAB_STREAMING_THRESHOLD / sizeof(uint32_t) + 37;
+    std::vector<uint32_t> src(n + 1);
+    std::vector<uint32_t> dst(n + 1, 0);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    crab::Slice<uint32_t> from(src.data() + 1, n);
+    crab::Slice<uint32_t> to(dst.data() + 1, n);
+    
+    const crab::simd::Level levels[] = {crab::simd::Level::Sse2, crab::simd::Level::Avx512};
+    for (auto level : levels) {
+        crab::simd::set_level_cap(level);
+        std::fill(dst.begin(), dst.end(), 0u);
+        assert(crab::copy_streaming(from, to).is_ok());
+        assert(dst[0] == 0);
+        assert(std::equal(src.begin() + 1, src.end(), dst.begin() + 1));
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+    
+    // Destination too small
+    assert(crab::copy_streaming(from, to.first(n - 1)).is_err());
+    
+    // Overlapping ranges fall back to memmove
+    std::vector<uint8_t> bytes(CRAB_STREAMING_THRESHOLD * 2);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+    crab::ByteSlice all(bytes);
+    assert(crab::copy_streaming(all.first(CRAB_STREAMING_THRESHOLD + 3), all.skip(5)).is_ok());
+    assert(bytes[5] == 0 && bytes[6] == 1 && bytes[5 + 300] == static_cast<uint8_t>(300));
+    
+    // Fill: unaligned start, ragged tail
+    crab::fill_streaming(to.skip(1), 0xDEADBEEFu);
+    assert(dst[1] == src[1]);
+    assert(dst[2] == 0xDEADBEEFu && dst[n] == 0xDEADBEEFu);
+    
+    // Small fills take the plain path
+    uint16_t small[5] = {};
+    crab::fill_streaming(crab::Slice<uint16_t>(small), uint16_t{7});
+    assert(small[0] == 7 && small[4] == 7);
+}
+
+// ============================================================================
+// Iterator Adapter Tests
+// ============================================================================
+
+crab::Result<int, crab::ParseError> parse_digit(char c) {
+    if (c < '0' || c > '9') {
+        return crab::Err(crab::ParseError{0, '0', static_cast<uint8_t>(c)});
+    }
+    return crab::Ok(c - '0');
+}
+
+void iter_tests() {
+    std::vector<int> vec = {1, -2, 3, -4, 5, 6};
+    crab::Slice<int> slice(vec);
+    
+    // filter -> map -> fold
+    int total = crab::iter(slice)
+        .filter([](int v) { return v > 0; })
+        .map([](int v) { return v * 10; })
+        .fold(0, [](int acc, int v) { return acc + v; });
+    assert(total == 150);
+    
+    // zip (shorter length wins)
+    int other[] = {2, 2, 2};
+    int dot = crab::zip(slice, crab::Slice<int>(other))
+        .fold(0, [](int acc, auto p) { return acc + p.first * p.second; });
+    assert(dot == 4);
+    
+    // enumerate + take
+    size_t index_sum = crab::iter(slice).enumerate().take(3)
+        .fold(size_t{0}, [](size_t acc, auto p) { return acc + p.first; });
+    assert(index_sum == 3);
+    
+    // chunks / windows
+    assert(crab::chunks(slice, 4).count() == 2);
+    assert(crab::windows(slice, 4).count() == 3);
+    int window_max = crab::windows(slice, 2)
+        .map([](crab::Slice<int> w) { return w[0] + w[1]; })
+        .fold(0, [](int acc, int v) { return v > acc ? v : acc; });
+    assert(window_max == 11);
+    
+    // collect_into a StaticVector
+    crab::StaticVector<int, 4> positives;
+    auto collected = crab::iter(slice).filter([](int v) { return v > 0; })
+        .collect_into(positives);
+    assert(collected.is_ok());
+    assert(collected.unwrap() == 4);
+    auto overflow = crab::iter(slice).collect_into(positives);
+    assert(overflow.is_err());
+    assert(overflow.unwrap_err().capacity == 4);
+    
+    // try_map short-circuits on Err
+    char good[] = {'1', '2', '3'};
+    auto sum = crab::iter(crab::Slice<char>(good)).try_map(parse_digit)
+        .fold(0, [](int acc, int v) { return acc + v; });
+    assert(sum.is_ok() && sum.unwrap() == 6);
+    
+    char bad[] = {'1', 'x', '3'};
+    int visited = 0;
+    auto failed = crab::iter(crab::Slice<char>(bad)).try_map(parse_digit)
+        .for_each([&](int) { ++visited; });
+    assert(failed.is_err());
+    assert(failed.unwrap_err().found == 'x');
+    assert(visited == 1);
+    
+    // Works directly on StaticVector
+    assert(crab::iter(positives).count() == 4);
+}
+
 // ============================================================================
 // Option Tests
 // ============================================================================
@@ -132,6 +367,52 @@ void static_vector_tests() {
     assert(r2.is_err());
 }
 
+// ============================================================================
+// PacketBuffer Tests
+// ============================================================================
+
+void packet_buffer_tests() {
+    crab::PacketBuffer<64> pkt(16);
+    assert(pkt.headroom() == 16);
+    assert(pkt.tailroom() == 48);
+    
+    // Payload
+    auto payload = pkt.put_tail(4);
+    assert(payload.is_ok());
+    payload.unwrap()[0] = 0xAA;
+    
+    // Encapsulate without moving the payload
+    const uint8_t* payload_ptr = pkt.data().data();
+    auto hdr = pkt.push_header(8);
+    assert(hdr.is_ok());
+    hdr.unwrap()[0] = 0x45;
+    assert(pkt.size() == 12);
+    assert(pkt.data()[0] == 0x45);
+    assert(pkt.data().data() + 8 == payload_ptr);
+    
+    // Headroom exhaustion
+    auto too_big = pkt.push_header(9);
+    assert(too_big.is_err());
+    assert(too_big.unwrap_err().capacity == 8);
+    
+    // Decapsulate
+    auto pulled = pkt.pull_header(8);
+    assert(pulled.is_ok());
+    assert(pulled.unwrap()[0] == 0x45);
+    assert(pkt.data()[0] == 0xAA);
+    assert(pkt.pull_header(5).is_err());
+    
+    // Trim padding
+    auto trimmed = pkt.trim(1);
+    assert(trimmed.is_ok());
+    assert(trimmed.unwrap().size() == 1);
+    assert(pkt.trim(2).is_err());
+    
+    assert(crab::PacketBuffer<8>::with_headroom(9).is_err());
+    assert(pkt.reset(32).is_ok());
+    assert(pkt.empty() && pkt.headroom() == 32);
+}
+
 // ============================================================================
 // Mutex Tests
 // ============================================================================
@@ -181,6 +462,644 @@ void ring_buffer_tests() {
     assert(empty.is_none());
 }
 
+void ring_buffer_view_tests() {
+    crab::StaticRingBuffer<int, 8> ring;
+    
+    // Whole free region is writable in place
+    auto space = ring.write_view();
+    assert(space.size() == 7 && space.second.is_empty());
+    for (size_t i = 0; i < 5; ++i) {
+        space.first[i] = static_cast<int>(i);
+    }
+    ring.commit(5);
+    assert(ring.size_approx() == 5);
+    
+    auto view = ring.read_view();
+    assert(view.size() == 5 && view.first[4] == 4);
+    ring.consume(3);
+    
+    // Wrapped: free space and readable data both split in two
+    space = ring.write_view();
+    assert(space.first.size() == 3 && space.second.size() == 2);
+    space.first[0] = 5;
+    space.first[1] = 6;
+    space.first[2] = 7;
+    space.second[0] = 8;
+    ring.commit(4);
+    view = ring.read_view();
+    assert(view.first.size() == 5 && view.second.size() == 1);
+    assert(view.first[0] == 3 && view.second[0] == 8);
+    ring.consume(view.size());
+    assert(ring.is_empty());
+}
+
+#if CRAB_HAS_POSIX_IO
+void ring_buffer_fd_tests() {
+    int fds[2];
+    const int piped = ::pipe(fds);
+    assert(piped == 0);
+    
+    crab::StaticRingBuffer<uint8_t, 8> ring;
+    
+    // Move head/tail near the end so the next fill wraps
+    for (uint8_t i = 0; i < 5; ++i) {
+        assert(ring.try_push(i));
+    }
+    for (int i = 0; i < 5; ++i) {
+        assert(ring.try_pop().is_some());
+    }
+    
+    const uint8_t msg[] = {10, 11, 12, 13, 14, 15, 16, 17, 18};
+    const ssize_t sent = ::write(fds[1], msg, sizeof(msg));
+    assert(sent == static_cast<ssize_t>(sizeof(msg)));
+    
+    // Wrapped fill: one readv covering both segments, capped at capacity
+    auto filled = ring.fill_from_fd(fds[0]);
+    assert(filled.is_ok());
+    assert(filled.unwrap() == 7);
+    assert(ring.is_full());
+    
+    auto full = ring.fill_from_fd(fds[0]);
+    assert(full.is_err());
+    assert(full.unwrap_err().code == ENOBUFS);
+    
+    // Wrapped drain back into the pipe
+    auto drained = ring.drain_to_fd(fds[1]);
+    assert(drained.is_ok());
+    assert(drained.unwrap() == 7);
+    assert(ring.is_empty());
+    
+    uint8_t out[9] = {};
+    const ssize_t received = ::read(fds[0], out, sizeof(out));
+    assert(received == 9);
+    assert(out[0] == 17 && out[1] == 18);  // Left in the pipe by the capped fill
+    assert(out[2] == 10 && out[8] == 16);
+    
+    ::close(fds[0]);
+    ::close(fds[1]);
+    
+    // Empty ring never touches the fd; a bad fd surfaces its errno
+    auto empty_drain = ring.drain_to_fd(-1);
+    assert(empty_drain.is_ok());
+    auto bad_fill = ring.fill_from_fd(-1);
+    assert(bad_fill.is_err());
+    assert(bad_fill.unwrap_err().code == EBADF);
+}
+#endif
+
+// ============================================================================
+// BufferPool Tests
+// ============================================================================
+
+void buffer_pool_tests() {
+    using Pool = crab::BufferPool<32, 2>;
+    static_assert(sizeof(Pool::Handle) == sizeof(void*), "Handle is one pointer");
+    Pool pool;
+    
+    auto frame = pool.try_acquire().unwrap();
+    assert(frame.is_unique());
+    auto writable = frame.bytes_mut();
+    assert(writable.is_some());
+    writable.unwrap()[0] = 7;
+    assert(frame.set_len(3).is_ok());
+    assert(frame.set_len(33).is_err());
+    
+    // Fan-out through ring slots: refcount bump instead of a copy
+    crab::StaticRingBuffer<Pool::Handle, 4> queue_a;
+    crab::StaticRingBuffer<Pool::Handle, 4> queue_b;
+    const bool pushed_a = queue_a.try_push(frame);
+    const bool pushed_b = queue_b.try_push(frame.clone());
+    assert(pushed_a && pushed_b);
+    (void)pushed_a;
+    (void)pushed_b;
+    assert(frame.use_count() == 3);
+    assert(frame.bytes_mut().is_none());  // Shared: read-only
+    
+    auto received = queue_a.try_pop().unwrap();
+    assert(received.bytes().size() == 3);
+    assert(received.bytes()[0] == 7);
+    assert(received.bytes().data() == frame.bytes().data());
+    
+    // Exhaust, then release everything back to the pool
+    auto other = pool.try_acquire();
+    assert(other.is_some());
+    assert(pool.try_acquire().is_none());
+    
+    frame.reset();
+    received.reset();
+    assert(pool.count_free_unsafe() == 0);
+    queue_b.clear_unsafe();  // Last reference returns the buffer
+    assert(pool.count_free_unsafe() == 1);
+    other.unwrap().reset();
+    assert(pool.count_free_unsafe() == 2);
+}
+
+// ============================================================================
+// PrefixTrie Tests
+// ============================================================================
+
+namespace {
+
+struct Rule {
+    uint32_t prefix;
+    size_t len;
+    int value;
+};
+
+// The linear scan PrefixTrie replaces
+int scan_lookup(const std::vector<Rule>& rules, uint32_t key) {
+    int best = -1;
+    size_t best_len = 0;
+    for (const auto& r : rules) {
+        const uint32_t mask = r.len == 0 ? 0u : ~0u << (32 - r.len);
+        if ((key & mask) == r.prefix && (best < 0 || r.len >= best_len)) {
+            best = r.value;
+            best_len = r.len;
+        }
+    }
+    return best;
+}
+
+crab::ConstByteSlice topic(const char* s) {
+    return crab::ConstByteSlice(reinterpret_cast<const uint8_t*>(s), std::strlen(s));
+}
+
+} // namespace
+
+void prefix_trie_tests() {
+    using Table = crab::PrefixTrie<int, 4096, 512>;
+    static Table trie;    // Inline pools: keep it off the stack
+    assert(trie.empty() && trie.node_count() == 1);
+    assert(trie.longest_prefix(uint32_t{42}).is_none());
+
+    // Random IPv4-style rules, including /0 and host routes
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>(state >> 32);
+    };
+    std::vector<Rule> rules;
+    for (int i = 0; i < 400; ++i) {
+        const size_t len = i == 0 ? 0 : next() % 33;
+        const uint32_t mask = len == 0 ? 0u : ~0u << (32 - len);
+        const Rule r{next() & mask, len, i};
+        auto added = trie.insert(r.prefix, r.len, r.value);
+        assert(added.is_ok());
+        // Duplicates replace the older value, as the later scan entry wins
+        rules.push_back(r);
+        (void)added;
+    }
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t key = next();
+        if (i % 2) {
+            // Land inside a stored prefix half the time
+            const Rule& r = rules[next() % rules.size()];
+            const uint32_t mask = r.len == 0 ? 0u : ~0u << (32 - r.len);
+            key = r.prefix | (key & ~mask);
+        }
+        const auto got = trie.longest_prefix(key);
+        const int want = scan_lookup(rules, key);
+        assert(got.is_some() && got.unwrap().get() == want);
+    }
+
+    // Batch lookup matches single lookups
+    std::vector<uint32_t> keys(1000);
+    for (auto& k : keys) {
+        k = next();
+    }
+    std::vector<int> out(keys.size());
+    assert(trie.longest_prefix_batch(crab::Slice<const uint32_t>(keys), crab::Slice<int>(out), -1).is_ok());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        assert(out[i] == trie.longest_prefix(keys[i]).unwrap().get());
+    }
+    assert(trie.longest_prefix_batch(crab::Slice<const uint32_t>(keys), crab::Slice<int>(out.data(), 3), -1).is_err());
+
+    // Replacing keeps the size; values are mutable in place
+    const size_t before = trie.size();
+    assert(trie.insert(uint32_t{0xC0A80000}, 16, 7).unwrap());
+    assert(!trie.insert(uint32_t{0xC0A80000}, 16, 8).unwrap());
+    assert(trie.size() == before + 1);
+    trie.longest_prefix(uint32_t{0xC0A80101}).unwrap().get() = 9;
+    assert(trie.longest_prefix(uint32_t{0xC0A80101}).unwrap().get() == 9);
+
+    // Byte keys: topics with bit lengths and a 16-byte address
+    crab::PrefixTrie<int, 256, 16> topics;
+    assert(topics.insert(topic("orders/"), 56, 1).is_ok());
+    assert(topics.insert(topic("orders/eu/"), 80, 2).is_ok());
+    assert(topics.insert(topic("o"), 4, 3).is_ok());    // Any key starting with nibble 0x6
+    assert(topics.longest_prefix(topic("orders/eu/fr")).unwrap().get() == 2);
+    assert(topics.longest_prefix(topic("orders/us")).unwrap().get() == 1);
+    assert(topics.longest_prefix(topic("orders")).unwrap().get() == 3);
+    assert(topics.longest_prefix(topic("quotes")).is_none());
+    assert(topics.longest_prefix(topic("")).is_none());
+    const uint8_t v6[16] = {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    assert(topics.insert(crab::ConstByteSlice(v6), 32, 4).is_ok());
+    assert(topics.longest_prefix(crab::ConstByteSlice(v6)).unwrap().get() == 4);
+
+    // Exhausting either pool reports CapacityExceeded; clear() reclaims everything
+    crab::PrefixTrie<int, 9, 4> tiny;
+    assert(tiny.insert(uint32_t{0x12345678}, 32, 1).is_ok());
+    auto full = tiny.insert(uint32_t{0x87654321}, 32, 2);
+    assert(full.is_err() && full.unwrap_err().capacity == 9);
+    for (int i = 0; i < 3; ++i) {
+        assert(tiny.insert(uint32_t{0x12345678}, static_cast<size_t>(i), i).is_ok());
+    }
+    assert(tiny.insert(uint32_t{0}, 3, 5).unwrap_err().capacity == 4);
+    // Tight pools force compaction; every slot must remain usable
+    static crab::PrefixTrie<int, 40, 48> tight;
+    std::vector<Rule> kept;
+    size_t node_failures = 0;
+    size_t value_failures = 0;
+    for (int i = 0; i < 3000; ++i) {
+        const size_t len = next() % 25;
+        const uint32_t mask = len == 0 ? 0u : ~0u << (32 - len);
+        const Rule r{next() & mask, len, i};
+        auto added = tight.insert(r.prefix, r.len, r.value);
+        if (added.is_err()) {
+            (added.unwrap_err().capacity == 40 ? node_failures : value_failures) += 1;
+            continue;
+        }
+        kept.push_back(r);
+        for (const auto& k : kept) {
+            assert(tight.longest_prefix(k.prefix).unwrap().get() == scan_lookup(kept, k.prefix));
+        }
+    }
+    assert(node_failures > 0 && value_failures > 0);
+    assert(tight.node_count() == 40 && tight.size() == 48);
+    // Full, yet replacing an existing rule needs no space
+    assert(!tight.insert(kept[0].prefix, kept[0].len, -1).unwrap());
+
+    // Fuzz small pools against the scan: compaction must also move parents
+    // whose own child run is being regrown
+    auto fuzz = [](auto& table, uint64_t seed) {
+        uint64_t s = seed * 0x9E3779B97F4A7C15ull + 1;
+        auto rnd = [&s] {
+            s ^= s << 13;
+            s ^= s >> 7;
+            s ^= s << 17;
+            return static_cast<uint32_t>(s >> 32);
+        };
+        table.clear();
+        std::vector<Rule> stored;
+        for (int i = 0; i < 3000; ++i) {
+            const size_t len = rnd() % 33;
+            const uint32_t mask = len == 0 ? 0u : ~0u << (32 - len);
+            const Rule r{rnd() & mask, len, i};
+            if (table.insert(r.prefix, r.len, r.value).is_ok()) {
+                stored.push_back(r);
+            }
+        }
+        for (int i = 0; i < 4000; ++i) {
+            uint32_t key = rnd();
+            if (i % 2) {
+                const Rule& r = stored[rnd() % stored.size()];
+                const uint32_t mask = r.len == 0 ? 0u : ~0u << (32 - r.len);
+                key = r.prefix | (key & ~mask);
+            }
+            const auto got = table.longest_prefix(key);
+            const int want = scan_lookup(stored, key);
+            assert(want < 0 ? got.is_none() : got.is_some() && got.unwrap().get() == want);
+            (void)got;
+            (void)want;
+        }
+    };
+    static crab::PrefixTrie<int, 512, 256> small;
+    static crab::PrefixTrie<int, 2048, 1024> medium;
+    for (uint64_t seed = 0; seed < 30; ++seed) {
+        fuzz(small, seed);
+        fuzz(medium, seed);
+    }
+
+    tiny.clear();
+    assert(tiny.empty() && tiny.node_count() == 1);
+    assert(tiny.insert(uint32_t{0x87654321}, 32, 2).is_ok());
+    assert(tiny.longest_prefix(uint32_t{0x87654321}).unwrap().get() == 2);
+}
+
+// ============================================================================
+// StringInterner Tests
+// ============================================================================
+
+void interner_tests() {
+    static crab::StringInterner<256, 16> names;
+    assert(names.empty());
+    const uint32_t a = names.intern(topic("orders/eu")).unwrap();
+    const uint32_t b = names.intern(topic("orders/us")).unwrap();
+    assert(a == 0 && b == 1);
+    assert(names.intern(topic("orders/eu")).unwrap() == a);    // Dedup: same id
+    assert(names.size() == 2 && names.arena_used() == 18);
+    assert(names.find(topic("orders/us")).unwrap() == b);
+    assert(names.find(topic("orders")).is_none());
+
+    auto bytes = names.resolve(a);
+    assert(bytes.size() == 9 && std::memcmp(bytes.data(), "orders/eu", 9) == 0);
+    assert(names.get(7).is_err() && names.get(b).is_ok());
+
+    // Empty string and embedded NULs are ordinary keys
+    const uint32_t empty = names.intern(topic("")).unwrap();
+    assert(names.resolve(empty).size() == 0);
+    const uint8_t nul[2] = {'a', 0};
+    assert(names.intern(crab::ConstByteSlice(nul)).unwrap() != names.intern(topic("a")).unwrap());
+
+    // Either limit reports CapacityExceeded and leaves the table intact
+    char big[300] = {};
+    auto too_long = names.intern(crab::ConstByteSlice(reinterpret_cast<const uint8_t*>(big), sizeof(big)));
+    assert(too_long.is_err() && too_long.unwrap_err().capacity == 256);
+    char key[4] = {'k', 0, 0, 0};
+    for (int i = 0; names.size() < 16; ++i) {
+        key[1] = static_cast<char>('a' + i);
+        auto interned = names.intern(crab::ConstByteSlice(reinterpret_cast<const uint8_t*>(key), 2));
+        assert(interned.is_ok());
+        (void)interned;
+    }
+    auto too_many = names.intern(topic("one more"));
+    assert(too_many.is_err() && too_many.unwrap_err().capacity == 16);
+    assert(names.find(topic("orders/eu")).unwrap() == a);
+
+    // Readers run lock-free against a live writer: anything they find resolves
+    static crab::StringInterner<64 * 1024, 4096> shared;
+    std::atomic<bool> done{false};
+    auto key_of = [](uint32_t i, char* buf) {
+        return crab::ConstByteSlice(reinterpret_cast<const uint8_t*>(buf),
+                                    static_cast<size_t>(std::snprintf(buf, 16, "sym%u", i)));
+    };
+    std::thread readers[2];
+    for (auto& t : readers) {
+        t = std::thread([&] {
+            char buf[16];
+            while (!done.load(std::memory_order_acquire)) {
+                const uint32_t seen = static_cast<uint32_t>(shared.size());
+                for (uint32_t i = 0; i < seen; ++i) {
+                    auto id = shared.find(key_of(i, buf));
+                    assert(id.is_some() && id.unwrap() == i);
+                    auto back = shared.resolve(id.unwrap());
+                    assert(back.size() == key_of(i, buf).size());
+                    (void)back;
+                }
+            }
+        });
+    }
+    char buf[16];
+    for (uint32_t i = 0; i < 4096; ++i) {
+        auto interned = shared.intern(key_of(i, buf));
+        assert(interned.is_ok() && interned.unwrap() == i);
+        (void)interned;
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) {
+        t.join();
+    }
+    assert(shared.size() == 4096);
+}
+
+// ============================================================================
+// RateLimiter Tests
+// ============================================================================
+
+namespace {
+
+// Millisecond ticks under test control
+struct ManualClock {
+    static std::atomic<uint64_t> ticks;
+    static uint64_t now() noexcept { return ticks.load(std::memory_order_relaxed); }
+    static double ticks_per_second() noexcept { return 1000.0; }
+};
+std::atomic<uint64_t> ManualClock::ticks{1000};
+
+} // namespace
+
+void rate_limiter_tests() {
+    // 100 tokens/s (one per 10 ms), bursts of 10; starts full
+    crab::RateLimiter<ManualClock> limiter(100.0, 10);
+    assert(limiter.available() == 10);
+    for (int i = 0; i < 10; ++i) {
+        assert(limiter.try_acquire());
+    }
+    assert(!limiter.try_acquire() && limiter.available() == 0);
+
+    // Refill is proportional to elapsed time and capped at the burst
+    ManualClock::ticks += 35;
+    assert(limiter.available() == 3);
+    assert(!limiter.try_acquire(4));                 // All-or-nothing
+    assert(limiter.try_acquire(3) && !limiter.try_acquire());
+    ManualClock::ticks += 10'000;
+    assert(limiter.available() == 10);
+    assert(!limiter.try_acquire(11));                // Never satisfiable
+    assert(limiter.try_acquire(10));
+    limiter.reset();
+    assert(limiter.available() == 10);
+
+    // A reading from before construction clamps to the start, not wraps
+    crab::RateLimiter<ManualClock> late(100.0, 10);
+    assert(late.try_acquire_at(0) && late.available() == 9);
+
+    // Under contention at a frozen clock, exactly `burst` tokens are granted
+    crab::RateLimiter<ManualClock> shared(1.0, 1000);
+    crab::ShardedRateLimiter<4, ManualClock> sharded(1.0, 1002);
+    assert(sharded.available() == 1002);
+    std::atomic<uint32_t> granted{0};
+    std::atomic<uint32_t> granted_sharded{0};
+    std::thread workers[4];
+    for (auto& t : workers) {
+        t = std::thread([&] {
+            for (int i = 0; i < 1000; ++i) {
+                granted += shared.try_acquire() ? 1 : 0;
+                granted_sharded += sharded.try_acquire(1 + i % 2) ? 1 + i % 2 : 0;
+            }
+        });
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    assert(granted == 1000 && shared.available() == 0);
+    // Stealing drains every shard; at most one odd token per shard is stranded
+    assert(granted_sharded + sharded.available() == 1002);
+    assert(sharded.available() <= 4);
+
+    // Shards refill together at the aggregate rate (0.25 tokens/s each)
+    sharded.reset();
+    while (sharded.try_acquire()) {
+    }
+    ManualClock::ticks += 8'000;
+    assert(sharded.available() == 8);
+    for (int i = 0; i < 8; ++i) {
+        assert(sharded.try_acquire());
+    }
+    assert(!sharded.try_acquire());
+}
+
+// ============================================================================
+// AppendVector Tests
+// ============================================================================
+
+void append_vector_tests() {
+    crab::AppendVector<int, 4> small;
+    assert(small.empty() && small.published().size() == 0);
+    assert(small.try_push(10).unwrap() == 0);
+    assert(small.try_emplace(20).unwrap() == 1);
+    assert(small.size() == 2 && small[1] == 20);
+    assert(small.get(1).unwrap().get() == 20 && small.get(2).is_err());
+    assert(small.try_push(30).is_ok() && small.try_push(40).is_ok());
+    auto full = small.try_push(50);
+    assert(full.is_err() && full.unwrap_err().capacity == 4);
+    int sum = 0;
+    for (int v : small.published()) {
+        sum += v;
+    }
+    assert(sum == 100);
+    small.clear();
+    assert(small.empty() && small.try_push(1).unwrap() == 0);
+
+    // Many writers, one scanning reader: the published prefix only grows,
+    // every element in it is fully written, and each writer's entries
+    // appear in the order it pushed them
+    struct Event {
+        uint32_t writer;
+        uint32_t seq;
+        uint64_t check;
+    };
+    constexpr uint32_t kWriters = 4;
+    constexpr uint32_t kPerWriter = 5000;
+    static crab::AppendVector<Event, kWriters * kPerWriter> journal;
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        size_t last = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            auto view = journal.published();
+            assert(view.size() >= last);
+            uint32_t next[kWriters] = {};
+            for (const Event& e : view) {
+                assert(e.writer < kWriters && e.check == (uint64_t{e.writer} << 32 | e.seq));
+                assert(e.seq >= next[e.writer]);
+                next[e.writer] = e.seq + 1;
+            }
+            last = view.size();
+        }
+    });
+    std::thread writers[kWriters];
+    for (uint32_t w = 0; w < kWriters; ++w) {
+        writers[w] = std::thread([w] {
+            for (uint32_t i = 0; i < kPerWriter; ++i) {
+                auto pushed = journal.try_push(Event{w, i, uint64_t{w} << 32 | i});
+                assert(pushed.is_ok());
+                (void)pushed;
+            }
+        });
+    }
+    for (auto& t : writers) {
+        t.join();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    assert(journal.size() == kWriters * kPerWriter);
+    assert(journal.try_push(Event{0, 0, 0}).is_err());
+    uint32_t count[kWriters] = {};
+    for (const Event& e : journal.published()) {
+        ++count[e.writer];
+    }
+    for (uint32_t c : count) {
+        assert(c == kPerWriter);
+    }
+}
+
+// ============================================================================
+// ConcurrentHashMap Tests
+// ============================================================================
+
+void concurrent_hash_map_tests() {
+    struct Quote {
+        int64_t bid;
+        int64_t ask;
+    };
+    static crab::ConcurrentHashMap<uint64_t, Quote, 8> quotes;
+    assert(quotes.empty() && quotes.find(1).is_none());
+    assert(quotes.insert(1, Quote{100, 101}).unwrap());
+    assert(!quotes.insert(1, Quote{0, 0}).unwrap());             // Present: unchanged
+    assert(quotes.find(1).unwrap().bid == 100);
+    assert(!quotes.insert_or_assign(1, Quote{102, 103}).unwrap());
+    assert(quotes.find(1).unwrap().ask == 103);
+    assert(quotes.update(1, [](Quote& q) { q.bid += 1; }));
+    assert(quotes.find(1).unwrap().bid == 103);
+    assert(!quotes.update(2, [](Quote&) {}));
+
+    // Erase leaves a tombstone; the same key reuses its slot
+    assert(quotes.erase(1) && !quotes.erase(1));
+    assert(quotes.find(1).is_none() && quotes.size() == 0 && quotes.keys_used() == 1);
+    assert(!quotes.update(1, [](Quote&) {}));
+    assert(quotes.insert(1, Quote{1, 2}).unwrap());
+    assert(quotes.size() == 1 && quotes.keys_used() == 1);
+
+    for (uint64_t k = 2; k <= 8; ++k) {
+        assert(quotes.insert(k, Quote{0, 0}).is_ok());
+    }
+    auto full = quotes.insert(9, Quote{0, 0});
+    assert(full.is_err() && full.unwrap_err().capacity == 8);
+    assert(quotes.insert_or_assign(8, Quote{8, 8}).is_ok());     // Existing keys still writable
+    quotes.clear();
+    assert(quotes.empty() && quotes.insert(9, Quote{0, 0}).is_ok());
+
+    // Byte-string keys hash over their bytes
+    struct Symbol {
+        char name[8];
+    };
+    crab::ConcurrentHashMap<Symbol, uint32_t, 4> ids;
+    assert(ids.insert(Symbol{"AAPL"}, 1).unwrap() && ids.insert(Symbol{"MSFT"}, 2).unwrap());
+    assert(ids.find(Symbol{"MSFT"}).unwrap() == 2 && ids.find(Symbol{"MSF"}).is_none());
+
+    // Writers race readers: a reader never sees a torn value, and keys
+    // inserted concurrently from several threads all land
+    static crab::ConcurrentHashMap<uint64_t, Quote, 1024> book;
+    std::atomic<bool> done{false};
+    std::thread readers[2];
+    for (auto& t : readers) {
+        t = std::thread([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                for (uint64_t k = 0; k < 64; ++k) {
+                    auto q = book.find(k);
+                    assert(q.is_none() || q.unwrap().ask == ~q.unwrap().bid);
+                    (void)q;
+                }
+            }
+        });
+    }
+    std::thread writers[4];
+    for (uint64_t w = 0; w < 4; ++w) {
+        writers[w] = std::thread([w] {
+            for (int64_t i = 0; i < 2000; ++i) {
+                const uint64_t k = static_cast<uint64_t>(i) % 64;
+                if (w % 2 == 0) {
+                    auto put = book.insert_or_assign(k, Quote{i, ~i});
+                    assert(put.is_ok());
+                    (void)put;
+                } else {
+                    book.update(k, [](Quote& q) {
+                        q.bid += 1;
+                        q.ask = ~q.bid;
+                    });
+                }
+                auto fresh = book.insert(1000 + w * 2000 + static_cast<uint64_t>(i) % 200, Quote{0, ~int64_t{0}});
+                assert(fresh.is_ok());
+                (void)fresh;
+            }
+        });
+    }
+    for (auto& t : writers) {
+        t.join();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) {
+        t.join();
+    }
+    assert(book.size() == 64 + 4 * 200);
+    for (uint64_t w = 0; w < 4; ++w) {
+        for (uint64_t i = 0; i < 200; ++i) {
+            assert(book.contains(1000 + w * 2000 + i));
+        }
+    }
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -188,10 +1107,25 @@ void ring_buffer_tests() {
 int main() {
     result_tests();
     slice_tests();
+    slice2d_tests();
+    aligned_slice_tests();
+    streaming_tests();
     option_tests();
     static_vector_tests();
+    iter_tests();
+    packet_buffer_tests();
     mutex_tests();
     ring_buffer_tests();
+    ring_buffer_view_tests();
+#if CRAB_HAS_POSIX_IO
+    ring_buffer_fd_tests();
+#endif
+    buffer_pool_tests();
+    prefix_trie_tests();
+    interner_tests();
+    rate_limiter_tests();
+    append_vector_tests();
+    concurrent_hash_map_tests();
     
     return 0;
 }
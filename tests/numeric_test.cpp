@@ -0,0 +1,1698 @@
+/**
+ * @file numeric_test.cpp
+ * @brief Tests for the SIMD numeric and algorithm kernels.
+ *
+ * Kernels are run with runtime dispatch capped at Scalar and at the best
+ * level the CPU supports, so both paths are checked against a reference.
+ */
+
+#include <crab/prelude.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Every dispatch level, checked against scalar (Sse2 is Neon on ARM).
+// Levels above what the host supports fall back to the best it has.
+const crab::simd::Level kLevels[] = {crab::simd::Level::Scalar, crab::simd::Level::Sse2,
+                                     crab::simd::Level::Avx2, crab::simd::Level::Avx512};
+
+// Deterministic xorshift so failures reproduce
+struct TestRng {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Uniform in [-1, 1)
+    double unit() { return static_cast<double>(next() >> 11) * 0x1.0p-52 - 1.0; }
+};
+
+bool close(double a, double b, double tol) {
+    return std::fabs(a - b) <= tol * (1.0 + std::fabs(b));
+}
+
+} // namespace
+
+// ============================================================================
+// Numeric Reduction Tests
+// ============================================================================
+
+void numeric_tests() {
+    TestRng rng;
+    const size_t lengths[] = {1, 3, 7, 8, 9, 31, 33, 257, 1000, 4099};
+
+    for (size_t n : lengths) {
+        std::vector<float> f(n);
+        std::vector<double> d(n);
+        std::vector<int32_t> i32(n);
+        for (size_t k = 0; k < n; ++k) {
+            d[k] = rng.unit() * 100.0;
+            f[k] = static_cast<float>(d[k]);
+            i32[k] = static_cast<int32_t>(rng.next() % 2000001) - 1000000;
+        }
+        // Duplicate the extremes to check first-index tie breaking
+        if (n > 4) {
+            f[n / 2] = f[n - 1] = 1000.0f;
+            d[n / 3] = d[n - 2] = -1000.0;
+            i32[1] = i32[n - 1] = -2000000;
+        }
+
+        int64_t int_sum = 0;
+        int64_t int_dot = 0;
+        double float_sum = 0;
+        double double_dot = 0;
+        for (size_t k = 0; k < n; ++k) {
+            int_sum += i32[k];
+            int_dot += static_cast<int64_t>(i32[k]) * i32[k];
+            float_sum += static_cast<double>(f[k]);
+            double_dot += d[k] * d[k];
+        }
+
+        for (auto level : kLevels) {
+            crab::simd::set_level_cap(level);
+            crab::Slice<const float> fs(f.data(), n);
+            crab::Slice<const double> ds(d.data(), n);
+            crab::Slice<const int32_t> is(i32.data(), n);
+
+            for (auto mode : {crab::Summation::Fast, crab::Summation::Pairwise, crab::Summation::Kahan}) {
+                assert(close(crab::sum(fs, mode).unwrap(), float_sum, 1e-4));
+            }
+            assert(crab::sum(is).unwrap() == int_sum);
+            assert(crab::dot(is, is).unwrap() == int_dot);
+            assert(close(crab::dot(ds, ds).unwrap(), double_dot, 1e-12));
+
+            assert(crab::min_value(fs).unwrap() == *std::min_element(f.begin(), f.end()));
+            assert(crab::max_value(ds).unwrap() == *std::max_element(d.begin(), d.end()));
+            assert(crab::min_value(is).unwrap() == *std::min_element(i32.begin(), i32.end()));
+            assert(crab::argmax(fs).unwrap() == size_t(std::max_element(f.begin(), f.end()) - f.begin()));
+            assert(crab::argmin(ds).unwrap() == size_t(std::min_element(d.begin(), d.end()) - d.begin()));
+            assert(crab::argmin(is).unwrap() == size_t(std::min_element(i32.begin(), i32.end()) - i32.begin()));
+            assert(crab::argmax(is).unwrap() == size_t(std::max_element(i32.begin(), i32.end()) - i32.begin()));
+        }
+    }
+
+    // Empty input has no sum / extreme
+    crab::Slice<const float> none;
+    assert(crab::sum(none).is_none());
+    assert(crab::min_value(none).is_none());
+    assert(crab::argmax(none).is_none());
+    assert(crab::dot(none, none).is_none());
+
+    // Kahan keeps small terms that a running float sum drops
+    std::vector<float> skewed(1 << 16, 1e-4f);
+    skewed[0] = 1e4f;
+    const double skewed_exact = 1e4 + 1e-4 * ((1 << 16) - 1);
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        crab::Slice<const float> s(skewed.data(), skewed.size());
+        assert(std::fabs(crab::sum(s, crab::Summation::Kahan).unwrap() - skewed_exact) < 2e-3);
+    }
+
+    // NaN anywhere (first lane, vector body, tail) makes min and max NaN
+    for (size_t n : lengths) {
+        for (size_t at : {size_t{0}, n / 2, n - 1}) {
+            std::vector<float> f(n, 1.0f);
+            std::vector<double> d(n, -1.0);
+            f[at] = std::numeric_limits<float>::quiet_NaN();
+            d[at] = std::numeric_limits<double>::quiet_NaN();
+            for (auto level : kLevels) {
+                crab::simd::set_level_cap(level);
+                crab::Slice<const float> fs(f.data(), n);
+                crab::Slice<const double> ds(d.data(), n);
+                assert(std::isnan(crab::min_value(fs).unwrap()) && std::isnan(crab::max_value(fs).unwrap()));
+                assert(std::isnan(crab::min_value(ds).unwrap()) && std::isnan(crab::max_value(ds).unwrap()));
+            }
+        }
+    }
+
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+}
+
+void elementwise_tests() {
+    TestRng rng;
+    const size_t n = 1003;
+    std::vector<float> x(n);
+    std::vector<float> y(n);
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = static_cast<float>(rng.unit());
+        y[k] = static_cast<float>(rng.unit());
+    }
+
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        std::vector<float> out = y;
+        crab::Slice<float> ys(out);
+        assert(crab::axpy(2.0f, crab::Slice<const float>(x.data(), n), ys).is_ok());
+        for (size_t k = 0; k < n; ++k) {
+            assert(close(out[k], 2.0f * x[k] + y[k], 1e-6));
+        }
+
+        crab::scale(ys, 0.5f);
+        crab::clamp(ys, -0.25f, 0.25f);
+        for (size_t k = 0; k < n; ++k) {
+            const float expect = std::min(std::max((2.0f * x[k] + y[k]) * 0.5f, -0.25f), 0.25f);
+            assert(close(out[k], expect, 1e-6));
+        }
+
+        std::vector<int32_t> ints = {5, -7, 100, 3, 9, -1, 0, 42, 17};
+        crab::Slice<int32_t> is(ints);
+        crab::scale(is, 3);
+        crab::clamp(is, -10, 50);
+        const int32_t expect[] = {15, -10, 50, 9, 27, -3, 0, 50, 50};
+        assert(std::equal(ints.begin(), ints.end(), expect));
+
+        // NaN passes through clamp in the vector body and the tail alike
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        std::vector<float> mixed = {nan, -3.0f, 0.5f, 9.0f, nan, 2.0f, -0.0f, 1.0f, 7.0f, nan, -5.0f};
+        crab::clamp(crab::Slice<float>(mixed), -1.0f, 1.0f);
+        const float clamped[] = {nan, -1.0f, 0.5f, 1.0f, nan, 1.0f, -0.0f, 1.0f, 1.0f, nan, -1.0f};
+        for (size_t k = 0; k < mixed.size(); ++k) {
+            assert(std::isnan(clamped[k]) ? std::isnan(mixed[k]) : mixed[k] == clamped[k]);
+        }
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+
+    // Length mismatch is an error, not a partial update
+    std::vector<double> a(4, 1.0);
+    std::vector<double> b(3, 1.0);
+    auto r = crab::axpy(1.0, crab::Slice<double>(a), crab::Slice<double>(b));
+    assert(r.is_err());
+    assert(b[0] == 1.0);
+}
+
+// ============================================================================
+// Gather / Scatter / Compaction Tests
+// ============================================================================
+
+template<typename T>
+void check_gather_scatter(TestRng& rng, size_t n) {
+    std::vector<T> src(n + 5);
+    for (size_t k = 0; k < src.size(); ++k) {
+        src[k] = static_cast<T>(k * 3 + 1);
+    }
+    std::vector<uint32_t> idx(n);
+    for (auto& i : idx) {
+        i = static_cast<uint32_t>(rng.next() % src.size());
+    }
+    crab::Slice<const uint32_t> is(idx.data(), n);
+
+    std::vector<T> out(n);
+    assert(crab::gather(crab::Slice<const T>(src.data(), src.size()), is, crab::Slice<T>(out)).is_ok());
+    for (size_t k = 0; k < n; ++k) {
+        assert(out[k] == src[idx[k]]);
+    }
+
+    // Scatter: sequential semantics, so the last write to a slot wins
+    std::vector<T> dst(src.size(), T{});
+    std::vector<T> expect(src.size(), T{});
+    for (size_t k = 0; k < n; ++k) {
+        expect[idx[k]] = out[k];
+    }
+    assert(crab::scatter(crab::Slice<const T>(out.data(), n), is, crab::Slice<T>(dst)).is_ok());
+    assert(dst == expect);
+
+    // Selection by mask and by predicate agree with a plain loop
+    std::vector<uint8_t> mask(n);
+    std::vector<T> kept;
+    for (size_t k = 0; k < n; ++k) {
+        mask[k] = static_cast<uint8_t>(rng.next() % 3 == 0 ? 0 : 1 + rng.next() % 255);
+        if (mask[k] != 0) {
+            kept.push_back(out[k]);
+        }
+    }
+    // A sentinel-filled output shows nothing past the count is written
+    const T sentinel = static_cast<T>(-3);
+    std::vector<T> sel(n, sentinel);
+    auto picked = crab::select_by_mask(crab::Slice<const T>(out.data(), n),
+                                       crab::Slice<const uint8_t>(mask.data(), n), crab::Slice<T>(sel));
+    assert(picked.unwrap() == kept.size());
+    assert(std::equal(kept.begin(), kept.end(), sel.begin()));
+    assert(std::all_of(sel.begin() + static_cast<std::ptrdiff_t>(kept.size()), sel.end(),
+                       [&](T v) { return v == sentinel; }));
+
+    auto odd = [](T v) { return static_cast<int64_t>(v) % 2 != 0; };
+    auto compacted = crab::compact_if(crab::Slice<const T>(out.data(), n), crab::Slice<T>(sel), odd);
+    const size_t odd_count = static_cast<size_t>(std::count_if(out.begin(), out.end(), odd));
+    assert(compacted.unwrap() == odd_count);
+    assert(std::all_of(sel.begin(), sel.begin() + static_cast<std::ptrdiff_t>(odd_count), odd));
+}
+
+void gather_tests() {
+    TestRng rng;
+    const size_t lengths[] = {0, 1, 5, 8, 17, 64, 1001};
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        for (size_t n : lengths) {
+            check_gather_scatter<float>(rng, n);
+            check_gather_scatter<int32_t>(rng, n);
+            check_gather_scatter<double>(rng, n);
+            check_gather_scatter<uint64_t>(rng, n);
+            check_gather_scatter<int16_t>(rng, n);
+        }
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+
+    // One bad index among many fails before anything is written
+    std::vector<int> src(10, 7);
+    std::vector<uint32_t> idx(100, 3);
+    idx[77] = 10;
+    std::vector<int> out(100, 0);
+    auto r = crab::gather(crab::Slice<const int>(src.data(), src.size()),
+                          crab::Slice<const uint32_t>(idx.data(), idx.size()), crab::Slice<int>(out));
+    assert(r.is_err());
+    assert(r.unwrap_err() == (crab::OutOfBounds{10, 10}));
+    assert(out[0] == 0);
+    assert(crab::scatter(crab::Slice<const int>(out.data(), out.size()),
+                         crab::Slice<const uint32_t>(idx.data(), idx.size()), crab::Slice<int>(src)).is_err());
+    assert(src[3] == 7);
+
+    // Output too small
+    assert(crab::gather(crab::Slice<const int>(src.data(), src.size()),
+                        crab::Slice<const uint32_t>(idx.data(), idx.size()),
+                        crab::Slice<int>(out).first(99)).is_err());
+    std::vector<uint8_t> all(100, 1);
+    auto sel = crab::select_by_mask(crab::Slice<const int>(out.data(), out.size()),
+                                    crab::Slice<const uint8_t>(all.data(), all.size()), crab::Slice<int>(src));
+    assert(sel.unwrap_err() == crab::SelectError(crab::CapacityExceeded{100, 10}));
+    auto short_mask = crab::select_by_mask(crab::Slice<const int>(out.data(), out.size()),
+                                           crab::Slice<const uint8_t>(all.data(), 99), crab::Slice<int>(out));
+    assert(short_mask.unwrap_err() == crab::SelectError(crab::OutOfBounds{99, 100}));
+    auto many = crab::compact_if(crab::Slice<const int>(out.data(), out.size()), crab::Slice<int>(src),
+                                 [](int) { return true; });
+    assert(many.unwrap_err() == (crab::CapacityExceeded{100, 10}));
+}
+
+// ============================================================================
+// Sort Tests
+// ============================================================================
+
+template<typename K>
+void check_radix(TestRng& rng, size_t n, uint64_t key_mask) {
+    std::vector<K> keys(n);
+    for (auto& k : keys) {
+        if constexpr (std::is_floating_point_v<K>) {
+            k = static_cast<K>(rng.unit() * static_cast<double>(key_mask));
+        } else {
+            k = static_cast<K>(rng.next() & key_mask);
+        }
+    }
+    std::vector<K> expect = keys;
+    std::sort(expect.begin(), expect.end());
+    std::vector<K> scratch(n);
+    assert(crab::radix_sort(crab::Slice<K>(keys), crab::Slice<K>(scratch)).is_ok());
+    assert(keys == expect);
+}
+
+void sort_tests() {
+    TestRng rng;
+    for (size_t n : {0, 1, 2, 31, 33, 1000, 5000}) {
+        check_radix<uint32_t>(rng, n, ~0ull);
+        check_radix<uint32_t>(rng, n, 0xFF00);   // skipped passes
+        check_radix<int32_t>(rng, n, ~0ull);
+        check_radix<int64_t>(rng, n, ~0ull);
+        check_radix<uint8_t>(rng, n, 0xFF);
+        check_radix<int16_t>(rng, n, 0xFFFF);
+        check_radix<float>(rng, n, 1000);
+        check_radix<double>(rng, n, 1u << 30);
+    }
+
+    // Signed zero and infinities follow IEEE total order
+    float special[] = {0.0f, -0.0f, INFINITY, -1.5f, -INFINITY, 2.0f};
+    float scratch[6];
+    assert(crab::radix_sort(crab::Slice<float>(special), crab::Slice<float>(scratch)).is_ok());
+    assert(special[0] == -INFINITY && special[1] == -1.5f && std::signbit(special[2]));
+    assert(special[3] == 0.0f && !std::signbit(special[3]) && special[5] == INFINITY);
+    assert(crab::radix_sort(crab::Slice<float>(special), crab::Slice<float>(scratch).first(5)).is_err());
+
+    // By key: stable, values follow their keys
+    const size_t n = 4000;
+    std::vector<uint16_t> keys(n);
+    std::vector<uint32_t> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = static_cast<uint16_t>(rng.next() % 50);
+        values[i] = static_cast<uint32_t>(i);
+    }
+    std::vector<uint16_t> key_scratch(n);
+    std::vector<uint32_t> value_scratch(n);
+    assert(crab::radix_sort_by_key(crab::Slice<uint16_t>(keys), crab::Slice<uint32_t>(values),
+                                   crab::Slice<uint16_t>(key_scratch), crab::Slice<uint32_t>(value_scratch)).is_ok());
+    for (size_t i = 1; i < n; ++i) {
+        assert(keys[i - 1] < keys[i] || (keys[i - 1] == keys[i] && values[i - 1] < values[i]));
+    }
+
+    // Fixed-size networks, including non-power-of-two sizes
+    int net5[] = {4, 1, 3, 5, 2};
+    crab::sort_network<5>(crab::Slice<int>(net5));
+    assert(std::is_sorted(std::begin(net5), std::end(net5)));
+    std::vector<double> net13(13);
+    for (auto& v : net13) {
+        v = rng.unit();
+    }
+    crab::sort_network<13>(crab::Slice<double>(net13));
+    assert(std::is_sorted(net13.begin(), net13.end()));
+
+    // Small sorts: every size on both dispatch paths
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        for (size_t len = 0; len <= 32; ++len) {
+            for (int rep = 0; rep < 20; ++rep) {
+                std::vector<int32_t> a(len);
+                std::vector<float> f(len);
+                std::vector<uint32_t> u(len);
+                std::vector<int16_t> h(len);
+                for (size_t k = 0; k < len; ++k) {
+                    a[k] = static_cast<int32_t>(rng.next() % 21) - 10;
+                    f[k] = static_cast<float>(rng.unit());
+                    u[k] = static_cast<uint32_t>(rng.next());
+                    h[k] = static_cast<int16_t>(rng.next());
+                }
+                crab::sort_small(crab::Slice<int32_t>(a));
+                crab::sort_small(crab::Slice<float>(f));
+                crab::sort_small(crab::Slice<uint32_t>(u));
+                crab::sort_small(crab::Slice<int16_t>(h));
+                assert(std::is_sorted(a.begin(), a.end()) && std::is_sorted(f.begin(), f.end()));
+                assert(std::is_sorted(u.begin(), u.end()) && std::is_sorted(h.begin(), h.end()));
+            }
+        }
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+
+    // Stable small sort keeps equal keys in order
+    std::pair<int, int> items[] = {{2, 0}, {1, 1}, {2, 2}, {1, 3}, {0, 4}};
+    struct ByFirst {
+        std::pair<int, int> p;
+        bool operator<(const ByFirst& o) const { return p.first < o.p.first; }
+    };
+    ByFirst wrapped[5];
+    for (int i = 0; i < 5; ++i) {
+        wrapped[i].p = items[i];
+    }
+    crab::sort_small_stable(crab::Slice<ByFirst>(wrapped));
+    assert(wrapped[0].p.second == 4 && wrapped[1].p.second == 1 && wrapped[2].p.second == 3);
+    assert(wrapped[3].p.second == 0 && wrapped[4].p.second == 2);
+}
+
+// ============================================================================
+// Set Operation Tests
+// ============================================================================
+
+template<typename T>
+std::vector<T> random_set(TestRng& rng, size_t n, uint64_t universe) {
+    std::vector<T> v(n);
+    for (auto& x : v) {
+        x = static_cast<T>(rng.next() % universe);
+    }
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+    return v;
+}
+
+template<typename T>
+void check_set_ops(TestRng& rng, size_t na, size_t nb, uint64_t universe) {
+    const std::vector<T> a = random_set<T>(rng, na, universe);
+    const std::vector<T> b = random_set<T>(rng, nb, universe);
+    crab::Slice<const T> sa(a.data(), a.size());
+    crab::Slice<const T> sb(b.data(), b.size());
+
+    std::vector<T> inter, uni, diff;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(inter));
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(uni));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(diff));
+
+    // A sentinel-filled output shows nothing past the count is written
+    const T sentinel = static_cast<T>(-3);
+    std::vector<T> out(a.size() + b.size(), sentinel);
+    crab::Slice<T> so(out);
+    size_t k = crab::set_intersection(sa, sb, so).unwrap();
+    assert(k == inter.size() && std::equal(inter.begin(), inter.end(), out.begin()));
+    assert(std::all_of(out.begin() + static_cast<std::ptrdiff_t>(k), out.end(), [&](T v) { return v == sentinel; }));
+    assert(crab::set_intersection_count(sa, sb) == inter.size());
+
+    k = crab::set_union(sa, sb, so).unwrap();
+    assert(k == uni.size() && std::equal(uni.begin(), uni.end(), out.begin()));
+    assert(crab::set_union_count(sa, sb) == uni.size());
+
+    k = crab::set_difference(sa, sb, so).unwrap();
+    assert(k == diff.size() && std::equal(diff.begin(), diff.end(), out.begin()));
+    assert(crab::set_difference_count(sa, sb) == diff.size());
+
+    // A short output holds a prefix and reports the full size
+    if (!inter.empty()) {
+        auto r = crab::set_intersection(sa, sb, so.first(inter.size() - 1));
+        assert(r.unwrap_err() == (crab::CapacityExceeded{inter.size(), inter.size() - 1}));
+        assert(std::equal(inter.begin(), inter.end() - 1, out.begin()));
+    }
+}
+
+void set_ops_tests() {
+    TestRng rng;
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        for (size_t na : {0, 1, 7, 100, 3000}) {
+            for (size_t nb : {0, 5, 100, 3000}) {
+                check_set_ops<uint32_t>(rng, na, nb, 4000);      // dense: many matches
+                check_set_ops<uint32_t>(rng, na, nb, 1u << 30);  // sparse
+                check_set_ops<uint64_t>(rng, na, nb, 5000);
+                check_set_ops<int32_t>(rng, na, nb, 5000);
+            }
+        }
+        check_set_ops<uint32_t>(rng, 20, 100000, 200000);  // galloping both ways
+        check_set_ops<uint32_t>(rng, 100000, 20, 200000);
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+
+    // Merge keeps duplicates, a before b on ties
+    const int a[] = {1, 3, 3, 7};
+    const int b[] = {2, 3, 8};
+    int out[7];
+    assert(crab::merge(crab::Slice<const int>(a), crab::Slice<const int>(b), crab::Slice<int>(out)).unwrap() == 7);
+    const int expect[] = {1, 2, 3, 3, 3, 7, 8};
+    assert(std::equal(std::begin(out), std::end(out), expect));
+    assert(crab::merge(crab::Slice<const int>(a), crab::Slice<const int>(b),
+                       crab::Slice<int>(out).first(6)).is_err());
+}
+
+// ============================================================================
+// Selection Tests
+// ============================================================================
+
+void select_tests() {
+    TestRng rng;
+    std::vector<int> data(5000);
+    for (auto& v : data) {
+        v = static_cast<int>(rng.next() % 1000);
+    }
+    std::vector<int> sorted_desc = data;
+    std::sort(sorted_desc.begin(), sorted_desc.end(), std::greater<int>());
+    crab::Slice<const int> src(data.data(), data.size());
+
+    // Into a caller Slice
+    int best[10];
+    auto view = crab::top_k(src, crab::Slice<int>(best));
+    assert(view.size() == 10);
+    assert(std::equal(view.begin(), view.end(), sorted_desc.begin()));
+
+    // Smallest three via std::greater, into a StaticVector
+    crab::StaticVector<int, 8> low;
+    auto lows = crab::top_k(src, 3, low, std::greater<int>()).unwrap();
+    assert(lows.size() == 3 && low.size() == 3);
+    assert(lows[0] == sorted_desc.back() && lows[2] == sorted_desc[sorted_desc.size() - 3]);
+    assert(crab::top_k(src, 9, low).is_err());
+
+    // k larger than the input
+    int few[] = {3, 1, 2};
+    int room[5];
+    auto all = crab::top_k(crab::Slice<const int>(few), crab::Slice<int>(room));
+    assert(all.size() == 3 && room[0] == 3 && room[2] == 1);
+
+    // Streaming: batches plus single pushes match one big top_k
+    crab::TopK<int, 16> stream;
+    assert(stream.threshold().is_none());
+    for (size_t off = 0; off < data.size(); off += 700) {
+        const size_t len = std::min<size_t>(700, data.size() - off);
+        stream.push_batch(src.subslice(off, off + len).unwrap());
+        (void)stream.sorted();  // reading mid-stream must not lose the heap
+    }
+    stream.push(5000);
+    auto top = stream.sorted();
+    assert(top.size() == 16 && top[0] == 5000);
+    assert(std::equal(top.begin() + 1, top.end(), sorted_desc.begin()));
+    assert(stream.threshold().unwrap() == sorted_desc[14]);
+
+    // select_nth on random, all-equal and adversarial (sorted) inputs
+    for (int pattern = 0; pattern < 3; ++pattern) {
+        std::vector<int> v(3001);
+        for (size_t i = 0; i < v.size(); ++i) {
+            v[i] = pattern == 0 ? static_cast<int>(rng.next() % 500)
+                 : pattern == 1 ? 7
+                 : static_cast<int>(i);
+        }
+        std::vector<int> ref = v;
+        std::sort(ref.begin(), ref.end());
+        for (size_t nth : {size_t(0), size_t(1500), size_t(3000)}) {
+            std::vector<int> work = v;
+            crab::Slice<int> w(work);
+            const int got = crab::select_nth(w, nth).unwrap().get();
+            assert(got == ref[nth]);
+            assert(std::all_of(work.begin(), work.begin() + static_cast<std::ptrdiff_t>(nth),
+                               [&](int x) { return x <= got; }));
+            assert(std::all_of(work.begin() + static_cast<std::ptrdiff_t>(nth), work.end(),
+                               [&](int x) { return x >= got; }));
+        }
+    }
+    int one[1] = {4};
+    assert(crab::select_nth(crab::Slice<int>(one), 1).is_err());
+}
+
+// ============================================================================
+// Prefetch Traversal Tests
+// ============================================================================
+
+namespace {
+
+struct ChainNode {
+    int value;
+    const ChainNode* next;
+};
+
+// Sums each chain and records the order lookups finish in
+struct ChainSum {
+    struct State {
+        const ChainNode* node;
+        int sum;
+    };
+    std::vector<int> sums;
+
+    const void* start(State& s, const ChainNode* const& head) {
+        s.node = head;
+        s.sum = 0;
+        if (head == nullptr) {
+            sums.push_back(0);
+        }
+        return head;
+    }
+    const void* step(State& s) {
+        s.sum += s.node->value;
+        s.node = s.node->next;
+        if (s.node == nullptr) {
+            sums.push_back(s.sum);
+        }
+        return s.node;
+    }
+};
+
+} // namespace
+
+void prefetch_tests() {
+    TestRng rng;
+    std::vector<int> table(1000);
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = static_cast<int>(i * 3);
+    }
+    std::vector<uint32_t> idx(257);
+    for (auto& x : idx) {
+        x = static_cast<uint32_t>(rng.next() % table.size());
+    }
+    crab::Slice<const uint32_t> sidx(idx.data(), idx.size());
+
+    // Linear and indexed walks visit in order, for every distance
+    for (size_t distance : {0u, 1u, 8u, 300u}) {
+        std::vector<int> seen;
+        crab::for_each_prefetch(crab::Slice<const int>(table.data(), table.size()), distance,
+                                [&](int v) { seen.push_back(v); });
+        assert(seen == table);
+
+        seen.clear();
+        assert(crab::for_each_indexed(crab::Slice<const int>(table.data(), table.size()), sidx,
+                                      distance, [&](int v) { seen.push_back(v); }).is_ok());
+        assert(seen.size() == idx.size());
+        for (size_t i = 0; i < idx.size(); ++i) {
+            assert(seen[i] == table[idx[i]]);
+        }
+    }
+
+    // Mutable table; a bad index is reported before anything runs
+    crab::Slice<int> mut(table.data(), table.size());
+    assert(crab::for_each_indexed(mut, sidx, 4, [](int& v) { v += 1; }).is_ok());
+    assert(table[idx[0]] > static_cast<int>(idx[0] * 3));
+    idx[100] = 1000;
+    int calls = 0;
+    auto bad = crab::for_each_indexed(mut, sidx, 4, [&](int&) { ++calls; });
+    assert(bad.is_err() && bad.unwrap_err().index == 1000 && calls == 0);
+    assert(crab::for_each_indexed(mut, crab::Slice<const uint32_t>(), 4, [&](int&) { ++calls; }).is_ok());
+
+    // Group prefetching: every key probed once, in order, with its own target
+    std::vector<uint32_t> keys(37);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<uint32_t>(rng.next() % table.size());
+    }
+    std::vector<uint32_t> probed;
+    crab::for_each_group<8>(
+        crab::Slice<const uint32_t>(keys.data(), keys.size()),
+        [&](uint32_t k) { return &table[k]; },
+        [&](uint32_t k, int* target) {
+            assert(target == &table[k]);
+            probed.push_back(k);
+        });
+    assert(probed == keys);
+
+    // AMAC: chains of varying length (including empty) all complete
+    std::vector<ChainNode> pool(200);
+    std::vector<const ChainNode*> heads;
+    std::vector<int> expect;
+    size_t used = 0;
+    while (used < pool.size()) {
+        const size_t len = std::min<size_t>(rng.next() % 9, pool.size() - used);
+        int sum = 0;
+        for (size_t j = 0; j < len; ++j) {
+            pool[used + j].value = static_cast<int>(rng.next() % 100);
+            pool[used + j].next = j + 1 < len ? &pool[used + j + 1] : nullptr;
+            sum += pool[used + j].value;
+        }
+        heads.push_back(len ? &pool[used] : nullptr);
+        expect.push_back(sum);
+        used += len;
+    }
+    crab::Slice<const ChainNode* const> sheads(heads.data(), heads.size());
+
+    ChainSum wide;
+    crab::amac<4>(sheads, wide);
+    ChainSum narrow;
+    crab::amac<1>(sheads, narrow);
+    assert(narrow.sums == expect);
+    std::sort(wide.sums.begin(), wide.sums.end());
+    std::sort(expect.begin(), expect.end());
+    assert(wide.sums == expect);
+}
+
+// ============================================================================
+// Small Matrix Tests
+// ============================================================================
+
+void matrix_tests() {
+    using crab::StaticMatrix;
+    using crab::StaticVec;
+
+    // Compile-time construction and arithmetic
+    constexpr StaticVec<float, 3> v(1.0f, 2.0f, 3.0f);
+    static_assert(v.dot(v) == 14.0f, "constexpr dot");
+    static_assert(crab::cross(v, StaticVec<float, 3>(0.0f, 0.0f, 1.0f)) == StaticVec<float, 3>(2.0f, -1.0f, 0.0f),
+                  "constexpr cross");
+    constexpr StaticMatrix<int, 2, 3> a(1, 2, 3,
+                                        4, 5, 6);
+    constexpr auto at = a.transpose();
+    static_assert(at(2, 0) == 3 && at(0, 1) == 4, "constexpr transpose");
+    constexpr auto aat = a * at;
+    static_assert(aat(0, 0) == 14 && aat(0, 1) == 32 && aat(1, 1) == 77, "constexpr multiply");
+    static_assert(crab::determinant(aat) == 14 * 77 - 32 * 32, "constexpr 2x2 determinant");
+    static_assert(StaticMatrix<float, 3, 3>::kPitch == 4 && StaticMatrix<double, 3, 3>::kPitch == 4,
+                  "rows padded to 16 bytes");
+
+    // Padding stays zero and is never exposed through views
+    StaticMatrix<float, 3, 3> m(4.0f, 1.0f, 2.0f,
+                                1.0f, 5.0f, 3.0f,
+                                2.0f, 3.0f, 6.0f);
+    auto m2 = m * m + m * 2.0f - m;
+    for (size_t r = 0; r < 3; ++r) {
+        assert(m2.data()[r * 4 + 3] == 0.0f);
+    }
+    assert(m.row(1).size() == 3 && m.row(1)[2] == 3.0f);
+    auto view = m.view();
+    assert(view.rows() == 3 && view.cols() == 3 && view.pitch() == 4);
+    assert(view.at(2, 1).unwrap().get() == 3.0f);
+    auto copy = StaticMatrix<float, 3, 3>::from_view(view);
+    assert(copy.is_ok() && copy.unwrap() == m);
+    assert((StaticMatrix<float, 2, 3>::from_view(view).is_err()));
+    assert(m.get(3, 0).is_err() && m.get(0, 2).unwrap().get() == 2.0f);
+    assert(v.as_slice().size() == 3);
+    float raw[] = {1.0f, 2.0f, 3.0f};
+    assert((StaticVec<float, 3>::from_slice(crab::Slice<const float>(raw)).unwrap() == v));
+    assert((StaticVec<float, 4>::from_slice(crab::Slice<const float>(raw)).is_err()));
+
+    // Matrix-vector product matches the naive loop
+    auto mv = m * v;
+    for (size_t r = 0; r < 3; ++r) {
+        assert(mv[r] == m(r, 0) * v[0] + m(r, 1) * v[1] + m(r, 2) * v[2]);
+    }
+
+    // Inverse, determinant and Cholesky on random SPD 6x6 systems
+    TestRng rng;
+    for (int trial = 0; trial < 20; ++trial) {
+        StaticMatrix<double, 6, 6> g;
+        for (size_t r = 0; r < 6; ++r) {
+            for (size_t c = 0; c < 6; ++c) {
+                g(r, c) = rng.unit();
+            }
+        }
+        const auto spd = g * g.transpose() + StaticMatrix<double, 6, 6>::identity() * 0.5;
+        const auto inv = crab::inverse(spd);
+        assert(inv.is_ok());
+        const auto eye = spd * inv.unwrap();
+        for (size_t r = 0; r < 6; ++r) {
+            for (size_t c = 0; c < 6; ++c) {
+                assert(std::fabs(eye(r, c) - (r == c ? 1.0 : 0.0)) < 1e-9);
+            }
+        }
+
+        StaticVec<double, 6> b;
+        for (size_t i = 0; i < 6; ++i) {
+            b[i] = rng.unit();
+        }
+        const auto l = crab::cholesky(spd).unwrap();
+        const auto llt = l * l.transpose();
+        for (size_t r = 0; r < 6; ++r) {
+            for (size_t c = 0; c < 6; ++c) {
+                assert(close(llt(r, c), spd(r, c), 1e-12));
+                assert(c <= r || l(r, c) == 0.0);
+            }
+        }
+        const auto x = crab::solve_spd(spd, b).unwrap();
+        assert((spd * x - b).norm() < 1e-9);
+
+        double prod = 1.0;
+        for (size_t i = 0; i < 6; ++i) {
+            prod *= l(i, i) * l(i, i);
+        }
+        assert(close(crab::determinant(spd), prod, 1e-9));
+    }
+
+    // Singular and indefinite matrices are reported, not divided by
+    const StaticMatrix<double, 3, 3> singular(1.0, 2.0, 3.0,
+                                              2.0, 4.0, 6.0,
+                                              1.0, 0.0, 1.0);
+    auto bad = crab::inverse(singular);
+    assert(bad.is_err() && bad.unwrap_err().column == 2);
+    assert(crab::determinant(singular) == 0.0);
+    const StaticMatrix<double, 2, 2> indefinite(1.0, 2.0,
+                                                2.0, 1.0);
+    auto nope = crab::cholesky(indefinite);
+    assert(nope.is_err() && nope.unwrap_err().column == 1);
+    assert(crab::inverse(indefinite).is_ok());
+    const auto f_inv = crab::inverse(crab::Mat4f::identity() * 2.0f).unwrap();
+    assert(f_inv == crab::Mat4f::identity() * 0.5f);
+}
+
+// ============================================================================
+// DSP Tests
+// ============================================================================
+
+namespace {
+
+// Direct-form reference: y[t] = sum_k h[k] * x[t - k], zero initial state
+std::vector<float> fir_reference(const std::vector<float>& x, const float* h, size_t taps) {
+    std::vector<float> y(x.size());
+    for (size_t t = 0; t < x.size(); ++t) {
+        double acc = 0.0;
+        for (size_t k = 0; k < taps && k <= t; ++k) {
+            acc += static_cast<double>(h[k]) * x[t - k];
+        }
+        y[t] = static_cast<float>(acc);
+    }
+    return y;
+}
+
+// Feeds x to process() in irregular blocks
+template<typename F>
+void in_blocks(TestRng& rng, size_t n, F&& process) {
+    size_t pos = 0;
+    while (pos < n) {
+        const size_t len = std::min<size_t>(n - pos, rng.next() % 700);
+        process(pos, len);
+        pos += len;
+    }
+}
+
+} // namespace
+
+void dsp_tests() {
+    TestRng rng;
+    std::vector<float> x(3000);
+    for (auto& v : x) {
+        v = static_cast<float>(rng.unit());
+    }
+
+    float h[37];
+    for (auto& v : h) {
+        v = static_cast<float>(rng.unit()) * 0.2f;
+    }
+    const std::vector<float> ref = fir_reference(x, h, 37);
+
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+
+        // FIR in arbitrary blocks matches the one-shot reference
+        crab::FirFilter<37, 64> fir(h);
+        std::vector<float> y(x.size());
+        in_blocks(rng, x.size(), [&](size_t pos, size_t len) {
+            assert(fir.process(crab::Slice<const float>(x.data() + pos, len),
+                               crab::Slice<float>(y.data() + pos, len)).is_ok());
+        });
+        for (size_t i = 0; i < x.size(); ++i) {
+            assert(close(y[i], ref[i], 1e-5));
+        }
+
+        // In place, and short outputs are rejected
+        fir.reset();
+        std::vector<float> inplace = x;
+        crab::Slice<float> io(inplace.data(), inplace.size());
+        assert(fir.process(io, io).is_ok());
+        for (size_t i = 0; i < x.size(); ++i) {
+            assert(close(inplace[i], y[i], 1e-5));
+        }
+        assert(fir.process(io, io.first(10)).is_err());
+
+        // Decimation equals every Factor-th sample of the full-rate FIR
+        crab::FirDecimator<37, 3, 64> dec(h);
+        std::vector<float> d(x.size() / 3 + 1);
+        size_t produced = 0;
+        in_blocks(rng, x.size(), [&](size_t pos, size_t len) {
+            const size_t expect = dec.output_count(len);
+            auto r = dec.process(crab::Slice<const float>(x.data() + pos, len),
+                                 crab::Slice<float>(d.data() + produced, d.size() - produced));
+            assert(r.is_ok() && r.unwrap() == expect);
+            produced += expect;
+        });
+        assert(produced == (x.size() + 2) / 3);
+        for (size_t j = 0; j < produced; ++j) {
+            assert(close(d[j], ref[j * 3], 1e-5));
+        }
+        crab::FirDecimator<37, 3, 64> tight(h);
+        assert(tight.process(crab::Slice<const float>(x.data(), 9),
+                             crab::Slice<float>(d.data(), 2)).is_err());
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+
+    // Biquad cascade against a double-precision direct form I reference
+    const crab::Biquad sections[2] = {crab::Biquad::lowpass(48000.0, 2000.0, 0.7071),
+                                      crab::Biquad::highpass(48000.0, 50.0, 0.7071)};
+    crab::BiquadCascade<2> iir(sections);
+    std::vector<float> y(x.size());
+    in_blocks(rng, x.size(), [&](size_t pos, size_t len) {
+        assert(iir.process(crab::Slice<const float>(x.data() + pos, len),
+                           crab::Slice<float>(y.data() + pos, len)).is_ok());
+    });
+    std::vector<double> stage(x.begin(), x.end());
+    for (const auto& c : sections) {
+        double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (auto& v : stage) {
+            const double out = c.b0 * v + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+            x2 = x1;
+            x1 = v;
+            y2 = y1;
+            y1 = out;
+            v = out;
+        }
+    }
+    for (size_t i = 0; i < x.size(); ++i) {
+        assert(std::fabs(y[i] - stage[i]) < 1e-4);
+    }
+
+    // Low-pass passes DC with unit gain
+    const crab::Biquad low[1] = {sections[0]};
+    crab::BiquadCascade<1> lp(low);
+    std::vector<float> ones(4000, 1.0f);
+    crab::Slice<float> so(ones.data(), ones.size());
+    assert(lp.process(so, so).is_ok());
+    assert(std::fabs(ones.back() - 1.0f) < 1e-4f);
+
+    // Moving average: window mean including the zero prefix
+    crab::MovingAverage<16> avg;
+    in_blocks(rng, x.size(), [&](size_t pos, size_t len) {
+        assert(avg.process(crab::Slice<const float>(x.data() + pos, len),
+                           crab::Slice<float>(y.data() + pos, len)).is_ok());
+    });
+    for (size_t t = 0; t < x.size(); ++t) {
+        double acc = 0.0;
+        for (size_t k = 0; k < 16 && k <= t; ++k) {
+            acc += x[t - k];
+        }
+        assert(std::fabs(y[t] - acc / 16.0) < 1e-5);
+    }
+
+    // Blocks straight from a ring buffer's wrapped read view
+    crab::StaticRingBuffer<float, 64> ring;
+    crab::FirFilter<37, 64> fir(h);
+    std::vector<float> streamed;
+    size_t fed = 0;
+    while (streamed.size() < 1000) {
+        auto space = ring.write_view();
+        size_t wrote = 0;
+        for (auto seg : {space.first, space.second}) {
+            for (size_t i = 0; i < seg.size() && fed < 1000; ++i) {
+                seg[i] = x[fed++];
+                ++wrote;
+            }
+        }
+        ring.commit(wrote);
+        auto view = ring.read_view();
+        for (auto seg : {view.first, view.second}) {
+            float block[64];
+            assert(fir.process(seg, crab::Slice<float>(block)).is_ok());
+            streamed.insert(streamed.end(), block, block + seg.size());
+        }
+        ring.consume(view.size());
+    }
+    for (size_t i = 0; i < streamed.size(); ++i) {
+        assert(close(streamed[i], ref[i], 1e-5));
+    }
+}
+
+// ============================================================================
+// FFT Tests
+// ============================================================================
+
+namespace {
+
+template<size_t N>
+void check_fft(TestRng& rng) {
+    using C = std::complex<float>;
+    std::vector<C> x(N);
+    std::vector<float> r(N);
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = C(static_cast<float>(rng.unit()), static_cast<float>(rng.unit()));
+        r[i] = static_cast<float>(rng.unit());
+    }
+    // Naive DFT in double as the reference
+    std::vector<std::complex<double>> ref(N);
+    std::vector<std::complex<double>> rref(N);
+    for (size_t k = 0; k < N; ++k) {
+        for (size_t j = 0; j < N; ++j) {
+            const double t = -2.0 * 3.14159265358979323846 * static_cast<double>((j * k) % N) / N;
+            const std::complex<double> w(std::cos(t), std::sin(t));
+            ref[k] += std::complex<double>(x[j]) * w;
+            rref[k] += static_cast<double>(r[j]) * w;
+        }
+    }
+    const double tol = 1e-6 * std::sqrt(static_cast<double>(N)) * std::log2(static_cast<double>(N));
+
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+
+        std::vector<C> y = x;
+        crab::Slice<C> sy(y.data(), y.size());
+        assert(crab::Fft<N>::forward(sy).is_ok());
+        for (size_t k = 0; k < N; ++k) {
+            assert(std::abs(std::complex<double>(y[k]) - ref[k]) < tol * std::sqrt(static_cast<double>(N)));
+        }
+        assert(crab::Fft<N>::inverse(sy).is_ok());
+        for (size_t i = 0; i < N; ++i) {
+            assert(std::abs(y[i] - x[i]) < 1e-5f);
+        }
+
+        std::vector<C> bins(N / 2 + 1);
+        std::vector<C> scratch(N / 2);
+        std::vector<float> back(N);
+        assert(crab::Fft<N>::forward_real(crab::Slice<const float>(r.data(), N),
+                                          crab::Slice<C>(bins.data(), bins.size())).is_ok());
+        for (size_t k = 0; k <= N / 2; ++k) {
+            assert(std::abs(std::complex<double>(bins[k]) - rref[k]) < tol * std::sqrt(static_cast<double>(N)));
+        }
+        assert(bins[0].imag() == 0.0f && bins[N / 2].imag() == 0.0f);
+        assert(crab::Fft<N>::inverse_real(crab::Slice<const C>(bins.data(), bins.size()),
+                                          crab::Slice<float>(back.data(), N),
+                                          crab::Slice<C>(scratch.data(), scratch.size())).is_ok());
+        for (size_t i = 0; i < N; ++i) {
+            assert(std::fabs(back[i] - r[i]) < 1e-5f);
+        }
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+}
+
+} // namespace
+
+void fft_tests() {
+    TestRng rng;
+    check_fft<8>(rng);
+    check_fft<64>(rng);
+    check_fft<1024>(rng);
+
+    // A pure tone lands in exactly one bin
+    using C = std::complex<float>;
+    std::vector<C> tone(256);
+    for (size_t i = 0; i < tone.size(); ++i) {
+        const double t = 2.0 * 3.14159265358979323846 * 5.0 * static_cast<double>(i) / 256.0;
+        tone[i] = C(static_cast<float>(std::cos(t)), static_cast<float>(std::sin(t)));
+    }
+    assert(crab::Fft<256>::forward(crab::Slice<C>(tone.data(), tone.size())).is_ok());
+    for (size_t k = 0; k < tone.size(); ++k) {
+        assert(std::abs(tone[k] - C(k == 5 ? 256.0f : 0.0f, 0.0f)) < 1e-3f);
+    }
+
+    // Past kMaxConstexprFft the tables are built at first use: a shifted
+    // impulse transforms to the twiddles, and inverse() undoes it
+    constexpr size_t kBig = 2 * crab::detail::kMaxConstexprFft;
+    std::vector<C> impulse(kBig);
+    impulse[3] = C(1.0f, 0.0f);
+    crab::Slice<C> big(impulse.data(), impulse.size());
+    assert(crab::Fft<kBig>::forward(big).is_ok());
+    for (size_t k = 0; k < kBig; ++k) {
+        const double t = -2.0 * 3.14159265358979323846 * static_cast<double>((3 * k) % kBig) / kBig;
+        assert(std::abs(std::complex<double>(impulse[k]) - std::complex<double>(std::cos(t), std::sin(t))) < 1e-5);
+    }
+    assert(crab::Fft<kBig>::inverse(big).is_ok());
+    for (size_t k = 0; k < kBig; ++k) {
+        assert(std::abs(impulse[k] - C(k == 3 ? 1.0f : 0.0f, 0.0f)) < 1e-5f);
+    }
+
+    // Wrong lengths are rejected before anything is touched
+    auto bad = crab::Fft<256>::forward(crab::Slice<C>(tone.data(), 128));
+    assert(bad.is_err() && bad.unwrap_err().index == 128 && bad.unwrap_err().size == 256);
+    float real[16] = {};
+    C bins[9];
+    C scratch[8];
+    assert(crab::Fft<16>::forward_real(crab::Slice<const float>(real), crab::Slice<C>(bins).first(8)).is_err());
+    assert(crab::Fft<16>::inverse_real(crab::Slice<const C>(bins), crab::Slice<float>(real),
+                                       crab::Slice<C>(scratch).first(4)).is_err());
+}
+
+// ============================================================================
+// Fixed-Point Tests
+// ============================================================================
+
+namespace {
+
+// Scalar Fixed operations are the reference for every bulk kernel
+template<typename Fx>
+void check_fixed_kernels(TestRng& rng, size_t n) {
+    std::vector<Fx> a(n), b(n);
+    std::vector<float> f(n);
+    for (size_t i = 0; i < n; ++i) {
+        // Mix in the extremes so saturation paths are exercised
+        const uint64_t pick = rng.next() % 8;
+        a[i] = pick == 0 ? Fx::min() : (pick == 1 ? Fx::max() : Fx::from_float(rng.unit() * Fx::max().to_double()));
+        b[i] = pick == 2 ? Fx::min() : Fx::from_float(rng.unit() * Fx::max().to_double());
+        f[i] = static_cast<float>(rng.unit() * Fx::max().to_double() * 1.25);
+    }
+    if (n > 3) {
+        f[0] = std::nanf("");
+        f[1] = 1e30f;
+        // Exact tie: must round up under Nearest, down under Floor
+        f[2] = static_cast<float>(Fx::epsilon().to_double() * 2.5);
+        f[3] = -f[2];
+        f[n - 1] = -1e30f;
+    }
+    crab::Slice<const Fx> sa(a.data(), n);
+    crab::Slice<const Fx> sb(b.data(), n);
+
+    for (auto mode : {crab::Rounding::Nearest, crab::Rounding::Floor}) {
+        std::vector<Fx> sum(n), prod(n), acc = a, scaled = a, fixed(n);
+        std::vector<float> back(n);
+        const Fx k = Fx::from_float(-0.75 * Fx::max().to_double());
+
+        for (auto level : kLevels) {
+            crab::simd::set_level_cap(level);
+            assert(crab::add_sat(sa, sb, crab::Slice<Fx>(sum)).is_ok());
+            assert(crab::mul_sat(sa, sb, crab::Slice<Fx>(prod), mode).is_ok());
+            std::copy(a.begin(), a.end(), acc.begin());
+            assert(crab::mac_sat(crab::Slice<Fx>(acc), sa, sb, mode).is_ok());
+            std::copy(a.begin(), a.end(), scaled.begin());
+            crab::scale_sat(crab::Slice<Fx>(scaled), k, mode);
+            assert(crab::to_fixed(crab::Slice<const float>(f.data(), n), crab::Slice<Fx>(fixed), mode).is_ok());
+            assert(crab::to_float(sa, crab::Slice<float>(back)).is_ok());
+
+            for (size_t i = 0; i < n; ++i) {
+                assert(sum[i] == a[i] + b[i]);
+                assert(prod[i] == Fx::mul(a[i], b[i], mode));
+                assert(acc[i] == a[i] + Fx::mul(a[i], b[i], mode));
+                assert(scaled[i] == Fx::mul(a[i], k, mode));
+                assert(fixed[i] == Fx::from_float(f[i], mode));
+                assert(back[i] == a[i].to_float());
+            }
+            if constexpr (Fx::kBits <= 16) {
+                int64_t exact = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    exact += int64_t{a[i].raw()} * b[i].raw();
+                }
+                assert(crab::dot_sat(sa, sb, mode) == Fx::saturate(crab::detail::round_shift(exact, Fx::kFracBits, mode)));
+            }
+        }
+        if (n > 3) {
+            assert(fixed[0] == Fx::min() && fixed[1] == Fx::max());
+            assert(fixed[2].raw() == (mode == crab::Rounding::Nearest ? 3 : 2));
+        }
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+}
+
+} // namespace
+
+void fixed_tests() {
+    using crab::Q15;
+    using crab::Rounding;
+
+    // Conversions are constexpr and exact where representable
+    static_assert(Q15::from_float(0.5).raw() == 16384);
+    static_assert(Q15::from_float(-1.0) == Q15::min());
+    static_assert(Q15::from_float(1.0) == Q15::max());
+    static_assert(crab::Fixed<7, 8>::from_int(3).to_double() == 3.0);
+    static_assert(crab::Fixed<7, 8>::from_int(1000) == crab::Fixed<7, 8>::max());
+    static_assert(sizeof(crab::Q7) == 1 && sizeof(Q15) == 2 && sizeof(crab::Q31) == 4);
+    static_assert(sizeof(crab::Fixed<3, 4>) == 1 && sizeof(crab::Fixed<8, 8>) == 4);
+
+    // Saturation: -1 * -1 is the classic Q15 overflow
+    static_assert(Q15::min() * Q15::min() == Q15::max());
+    static_assert(-Q15::min() == Q15::max());
+    static_assert(Q15::max() + Q15::epsilon() == Q15::max());
+    static_assert(Q15::min() - Q15::epsilon() == Q15::min());
+    // 9-bit formats saturate at their own range, not the int16 storage range
+    static_assert(crab::Fixed<4, 4>::from_int(15) + crab::Fixed<4, 4>::from_int(15) == crab::Fixed<4, 4>::max());
+    static_assert(crab::Fixed<4, 4>::max().raw() == 255);
+
+    // Rounding: 0.75 * 0.75 = 0.5625 needs one extra bit in Q1.1
+    using Q2 = crab::Fixed<1, 1>;
+    static_assert(Q2::from_float(0.25, Rounding::Nearest).raw() == 1);
+    static_assert(Q2::from_float(0.25, Rounding::Floor).raw() == 0);
+    static_assert(Q2::from_float(-0.25, Rounding::Nearest).raw() == 0);
+    static_assert(Q2::from_float(-0.25, Rounding::Floor).raw() == -1);
+    static_assert(Q2::mul(Q2::from_float(1.5), Q2::from_float(0.5), Rounding::Floor).raw() == 1);
+    static_assert(Q2::mul(Q2::from_float(1.5), Q2::from_float(0.5), Rounding::Nearest).raw() == 2);
+
+    // Checked arithmetic reports instead of clamping
+    assert(Q15::checked_from_float(1.0).is_err());
+    assert(Q15::checked_from_float(std::nan("")).is_err());
+    assert(Q15::checked_from_float(0.25).unwrap().raw() == 8192);
+    assert(Q15::checked_mul(Q15::min(), Q15::min()).is_err());
+    assert(Q15::checked_add(Q15::max(), Q15::epsilon()).unwrap_err() == crab::Overflow{0});
+    assert(Q15::checked_sub(Q15::from_float(0.5), Q15::from_float(0.25)).unwrap() == Q15::from_float(0.25));
+
+    TestRng rng;
+    for (size_t n : {0u, 3u, 16u, 17u, 100u, 1027u}) {
+        check_fixed_kernels<Q15>(rng, n);
+        check_fixed_kernels<crab::Fixed<3, 12>>(rng, n);
+        check_fixed_kernels<crab::Fixed<4, 4>>(rng, n);
+        check_fixed_kernels<crab::Q7>(rng, n);
+        check_fixed_kernels<crab::Q31>(rng, n);
+    }
+
+    // Length mismatches are errors before anything is written
+    Q15 x[4] = {}, y[3] = {}, z[4] = {};
+    auto bad = crab::add_sat(crab::Slice<const Q15>(x), crab::Slice<const Q15>(y), crab::Slice<Q15>(z));
+    assert(bad.is_err() && bad.unwrap_err().index == 3 && bad.unwrap_err().size == 4);
+    assert(crab::mac_sat(crab::Slice<Q15>(z), crab::Slice<const Q15>(x), crab::Slice<const Q15>(y)).is_err());
+
+    // Checked kernels stop at the first overflow and keep the prefix
+    Q15 a[4] = {Q15::from_float(0.5), Q15::from_float(0.5), Q15::max(), Q15::from_float(0.25)};
+    Q15 b[4] = {Q15::from_float(0.25), Q15::from_float(0.25), Q15::epsilon(), Q15::from_float(0.25)};
+    Q15 out[4] = {};
+    auto r = crab::add_checked(crab::Slice<const Q15>(a), crab::Slice<const Q15>(b), crab::Slice<Q15>(out));
+    assert(r.unwrap_err().index == 2);
+    assert(out[0] == Q15::from_float(0.75) && out[1] == Q15::from_float(0.75) && out[2] == Q15() && out[3] == Q15());
+    assert(crab::mul_checked(crab::Slice<const Q15>(a), crab::Slice<const Q15>(b), crab::Slice<Q15>(out)).is_ok());
+    assert(out[0] == Q15::from_float(0.125));
+    Q15 acc[4] = {Q15::max(), Q15(), Q15(), Q15()};
+    assert(crab::mac_checked(crab::Slice<Q15>(acc), crab::Slice<const Q15>(a), crab::Slice<const Q15>(b)).unwrap_err().index == 0);
+    float in[3] = {0.5f, -1.0f, 1.0f};
+    assert(crab::to_fixed_checked(crab::Slice<const float>(in), crab::Slice<Q15>(out).first(3)).unwrap_err().index == 2);
+    assert(out[1] == Q15::min());
+}
+
+// ============================================================================
+// Fast Math Tests
+// ============================================================================
+
+namespace {
+
+// Distance in representable floats (both finite or equal)
+int64_t ulp_distance(float a, float b) {
+    if (a == b) {
+        return 0;
+    }
+    auto ordered = [](float f) {
+        int32_t i;
+        std::memcpy(&i, &f, sizeof(i));
+        return i < 0 ? int64_t{INT32_MIN} - i : int64_t{i};
+    };
+    const int64_t d = ordered(a) - ordered(b);
+    return d < 0 ? -d : d;
+}
+
+using BulkMath = crab::Result<crab::Unit, crab::OutOfBounds> (*)(crab::Slice<const float>, crab::Slice<float>);
+
+// Checks scalar reference and bulk kernel against double-precision libm
+void check_accuracy(TestRng& rng, BulkMath bulk, float (*scalar)(float), double (*ref)(double),
+                    const std::vector<float>& extra, float lo, float hi, int64_t max_ulp, double max_abs) {
+    std::vector<float> x = extra;
+    for (size_t i = 0; i < 20000; ++i) {
+        x.push_back(lo + (hi - lo) * static_cast<float>(0.5 * (rng.unit() + 1.0)));
+    }
+    std::vector<float> y(x.size());
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        assert(bulk(crab::Slice<const float>(x.data(), x.size()), crab::Slice<float>(y.data(), y.size())).is_ok());
+        for (size_t i = 0; i < x.size(); ++i) {
+            const double exact = ref(static_cast<double>(x[i]));
+            for (float got : {y[i], scalar(x[i])}) {
+                const bool ok = ulp_distance(got, static_cast<float>(exact)) <= max_ulp ||
+                                std::fabs(static_cast<double>(got) - exact) <= max_abs;
+                assert(ok);
+                (void)ok;
+            }
+        }
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+}
+
+double sigmoid_ref(double x) {
+    return 1.0 / (1.0 + std::exp(-x));
+}
+
+} // namespace
+
+void fast_math_tests() {
+    TestRng rng;
+    const float denorm = std::numeric_limits<float>::denorm_min();
+    const float fmin = std::numeric_limits<float>::min();
+
+    check_accuracy(rng, crab::fast_exp, crab::fast_exp, [](double v) { return std::exp(v); },
+                   {0.0f, -0.0f, 1.0f, -1.0f, 88.7f, -87.3f, 1e-8f}, -87.3f, 88.7f, 2, 0.0);
+    check_accuracy(rng, crab::fast_log, crab::fast_log, [](double v) { return std::log(v); },
+                   {1.0f, 2.0f, 0.5f, denorm, fmin, fmin * 0.75f, 3e38f, 0.70710677f, 1.0000001f},
+                   1e-3f, 1e3f, 2, 0.0);
+    check_accuracy(rng, crab::fast_log, crab::fast_log, [](double v) { return std::log(v); },
+                   {}, 1e-37f, 1e37f, 2, 0.0);
+    check_accuracy(rng, crab::fast_sin, crab::fast_sin, [](double v) { return std::sin(v); },
+                   {0.0f, -0.0f, 3.1415927f, 1.5707964f, -8192.0f, 1e-20f}, -8192.0f, 8192.0f, 2, 1e-7);
+    check_accuracy(rng, crab::fast_cos, crab::fast_cos, [](double v) { return std::cos(v); },
+                   {0.0f, 3.1415927f, 1.5707964f, 8192.0f}, -8192.0f, 8192.0f, 2, 1e-7);
+    check_accuracy(rng, crab::fast_tanh, crab::fast_tanh, [](double v) { return std::tanh(v); },
+                   {0.0f, 0.625f, -0.625f, 0.62499994f, 1e-30f, 9.0f, -50.0f, 1e30f}, -12.0f, 12.0f, 2, 0.0);
+    check_accuracy(rng, crab::fast_sigmoid, crab::fast_sigmoid, sigmoid_ref,
+                   {0.0f, -87.0f, 30.0f, 1e30f}, -87.0f, 40.0f, 3, 0.0);
+
+    // Special values classify the same in the reference and every dispatch level
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    float special[9] = {nan, inf, -inf, 0.0f, -0.0f, -1.0f, 100.0f, -200.0f, 2e9f};
+    BulkMath bulks[6] = {crab::fast_exp, crab::fast_log, crab::fast_sin,
+                         crab::fast_cos, crab::fast_tanh, crab::fast_sigmoid};
+    float (*scalars[6])(float) = {crab::fast_exp, crab::fast_log, crab::fast_sin,
+                                  crab::fast_cos, crab::fast_tanh, crab::fast_sigmoid};
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        for (size_t f = 0; f < 6; ++f) {
+            float out[9];
+            assert(bulks[f](crab::Slice<const float>(special), crab::Slice<float>(out)).is_ok());
+            for (size_t i = 0; i < 9; ++i) {
+                const float want = scalars[f](special[i]);
+                // Finite results may differ by FMA contraction, classes may not
+                assert(std::isnan(want) == std::isnan(out[i]) && std::isinf(want) == std::isinf(out[i]));
+                assert(std::isnan(want) || ulp_distance(out[i], want) <= 2 || std::fabs(out[i] - want) <= 1e-7f);
+            }
+        }
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+    assert(std::isnan(crab::fast_exp(nan)) && crab::fast_exp(100.0f) == inf && crab::fast_exp(-200.0f) == 0.0f);
+    assert(crab::fast_exp(-inf) == 0.0f && crab::fast_exp(inf) == inf);
+    assert(crab::fast_log(0.0f) == -inf && std::isnan(crab::fast_log(-1.0f)) && crab::fast_log(inf) == inf);
+    assert(crab::fast_log(1.0f) == 0.0f && crab::fast_exp(0.0f) == 1.0f);
+    assert(std::isnan(crab::fast_sin(inf)) && std::isnan(crab::fast_cos(2e9f)));
+    assert(crab::fast_tanh(50.0f) == 1.0f && crab::fast_tanh(-50.0f) == -1.0f && crab::fast_tanh(-0.0f) == 0.0f);
+    assert(crab::fast_sigmoid(0.0f) == 0.5f && crab::fast_sigmoid(200.0f) == 1.0f);
+
+    // In-place and odd lengths (the tail goes through the vector path)
+    std::vector<float> v(13);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = static_cast<float>(i) * 0.25f;
+    }
+    const std::vector<float> orig = v;
+    assert(crab::fast_exp(crab::Slice<const float>(v.data(), v.size()), crab::Slice<float>(v)).is_ok());
+    for (size_t i = 0; i < v.size(); ++i) {
+        assert(ulp_distance(v[i], static_cast<float>(std::exp(static_cast<double>(orig[i])))) <= 2);
+    }
+
+    // Length mismatch is rejected before anything is written
+    float out[4] = {7.0f, 7.0f, 7.0f, 7.0f};
+    auto bad = crab::fast_tanh(crab::Slice<const float>(v.data(), 3), crab::Slice<float>(out));
+    assert(bad.is_err() && bad.unwrap_err().index == 4 && bad.unwrap_err().size == 3 && out[0] == 7.0f);
+}
+
+// ============================================================================
+// Sliding Window Tests
+// ============================================================================
+
+namespace {
+
+// Brute-force rescans of the same window are the reference
+template<size_t W>
+void check_window(TestRng& rng, size_t n) {
+    crab::WindowMin<int32_t, W> lo;
+    crab::WindowMax<int32_t, W> hi;
+    crab::WindowStats<int32_t, W> stats;
+    std::vector<int32_t> xs;
+    assert(lo.value().is_none() && stats.mean().is_none() && stats.sample_variance().is_none());
+    for (size_t i = 0; i < n; ++i) {
+        // Small range so ties and long monotone runs both occur
+        const int32_t x = (i % 97 < 40) ? static_cast<int32_t>(i % 97) : static_cast<int32_t>(rng.next() % 16) - 8;
+        xs.push_back(x);
+        lo.push(x);
+        hi.push(x);
+        stats.push(x);
+
+        const size_t first = xs.size() > W ? xs.size() - W : 0;
+        int32_t mn = xs[first], mx = xs[first];
+        double sum = 0.0;
+        for (size_t k = first; k < xs.size(); ++k) {
+            mn = std::min(mn, xs[k]);
+            mx = std::max(mx, xs[k]);
+            sum += xs[k];
+        }
+        const double count = static_cast<double>(xs.size() - first);
+        const double mean = sum / count;
+        double m2 = 0.0;
+        for (size_t k = first; k < xs.size(); ++k) {
+            m2 += (xs[k] - mean) * (xs[k] - mean);
+        }
+        assert(lo.value().unwrap() == mn && hi.value().unwrap() == mx);
+        assert(lo.count() == xs.size() - first && stats.count() == xs.size() - first);
+        assert(std::fabs(stats.mean().unwrap() - mean) < 1e-9);
+        assert(std::fabs(stats.variance().unwrap() - m2 / count) < 1e-8);
+        assert(stats.oldest().unwrap() == xs[first]);
+        if (count >= 2) {
+            assert(std::fabs(stats.sample_variance().unwrap() - m2 / (count - 1)) < 1e-8);
+        }
+    }
+
+    // A batch lands in the same state as pushing one by one
+    crab::WindowMin<int32_t, W> batched;
+    crab::WindowStats<int32_t, W> batched_stats;
+    batched.push(1000);
+    batched.push_batch(crab::Slice<const int32_t>(xs.data(), xs.size()));
+    batched_stats.push_batch(crab::Slice<const int32_t>(xs.data(), xs.size()));
+    if (n > 0) {
+        assert(batched.value().unwrap() == lo.value().unwrap() && batched.count() == lo.count());
+        assert(std::fabs(batched_stats.mean().unwrap() - stats.mean().unwrap()) < 1e-12);
+        for (int32_t extra : {5, -9, 3}) {
+            batched.push(extra);
+            lo.push(extra);
+            assert(batched.value().unwrap() == lo.value().unwrap());
+        }
+    }
+}
+
+} // namespace
+
+void window_tests() {
+    TestRng rng;
+    check_window<1>(rng, 50);
+    check_window<4>(rng, 300);
+    check_window<5>(rng, 300);
+    check_window<64>(rng, 1000);
+    check_window<100>(rng, 1000);
+    check_window<16>(rng, 0);
+
+    crab::WindowMin<int32_t, 8> lo;
+    lo.push(3);
+    lo.reset();
+    assert(lo.value().is_none() && lo.is_empty());
+
+    // Constant input: variance stays exactly zero despite removals
+    crab::WindowStats<double, 32> flat;
+    for (int i = 0; i < 1000; ++i) {
+        flat.push(1e9 + 0.1);
+    }
+    assert(flat.variance().unwrap() >= 0.0 && flat.variance().unwrap() < 1e-6);
+    assert(std::fabs(flat.mean().unwrap() - (1e9 + 0.1)) < 1e-6);
+
+    // EWMA converges to a constant input and tracks a step at rate alpha
+    crab::EwmaStats ew(0.5);
+    assert(ew.mean().is_none());
+    ew.push(4.0);
+    assert(ew.mean().unwrap() == 4.0 && ew.variance().unwrap() == 0.0);
+    ew.push(8.0);
+    assert(ew.mean().unwrap() == 6.0);
+    assert(ew.variance().unwrap() == 0.5 * (0.0 + 4.0 * 2.0));
+    assert(std::fabs(crab::EwmaStats::from_span(19).alpha() - 0.1) < 1e-15);
+    assert(std::fabs(crab::EwmaStats::from_half_life(1.0).alpha() - 0.5) < 1e-15);
+    auto slow = crab::EwmaStats::from_half_life(10.0);
+    const double ones[3] = {1.0, 1.0, 1.0};
+    for (int i = 0; i < 100; ++i) {
+        slow.push_batch(crab::Slice<const double>(ones));
+    }
+    assert(std::fabs(slow.mean().unwrap() - 1.0) < 1e-12 && slow.count() == 300);
+    slow.push(2.0);
+    assert(std::fabs(slow.mean().unwrap() - (1.0 + slow.alpha())) < 1e-12);
+}
+
+// ============================================================================
+// Sketch Tests
+// ============================================================================
+
+template<typename Sketch>
+std::vector<uint8_t> save_sketch(const Sketch& s, size_t size) {
+    std::vector<uint8_t> buf(size);
+    auto written = s.save(crab::ByteSlice(buf));
+    assert(written.is_ok() && written.unwrap() == size);
+    return buf;
+}
+
+void hll_tests() {
+    for (auto level : kLevels) {
+        crab::simd::set_level_cap(level);
+        const size_t counts[] = {0, 1, 10, 1000, 20000, 300000};
+        for (size_t n : counts) {
+            crab::HyperLogLog<12> hll;
+            for (uint64_t i = 0; i < n; ++i) {
+                hll.add(i);
+                hll.add(i);
+            }
+            // 1.04 / sqrt(4096) = 1.6%; allow four sigma
+            const double est = hll.estimate();
+            assert(std::fabs(est - static_cast<double>(n)) <= 0.065 * static_cast<double>(n) + 0.5);
+            assert(hll.is_empty() == (n == 0));
+        }
+
+        // Union of overlapping shards matches one sketch over everything
+        crab::HyperLogLog<12> a, b, all;
+        for (uint64_t i = 0; i < 60000; ++i) {
+            a.add(i);
+            all.add(i);
+        }
+        for (uint64_t i = 30000; i < 90000; ++i) {
+            b.add(i);
+            all.add(i);
+        }
+        a.merge(b);
+        assert(a.estimate() == all.estimate());
+        assert(std::fabs(all.estimate() - 90000.0) <= 0.065 * 90000.0);
+    }
+    crab::simd::set_level_cap(crab::simd::Level::Avx512);
+
+    crab::HyperLogLog<10> words;
+    const char* names[] = {"alpha", "beta", "gamma", "beta", "alpha"};
+    for (const char* w : names) {
+        words.add_bytes(crab::ConstByteSlice(reinterpret_cast<const uint8_t*>(w), std::strlen(w)));
+    }
+    assert(std::fabs(words.estimate() - 3.0) < 0.1);
+
+    // Round trip and rejection of malformed input
+    auto buf = save_sketch(words, crab::HyperLogLog<10>::kSerializedSize);
+    crab::HyperLogLog<10> back;
+    assert(back.load(crab::ConstByteSlice(buf)).is_ok());
+    assert(back.estimate() == words.estimate());
+    crab::HyperLogLog<11> wrong_p;
+    auto padded = buf;
+    padded.resize(crab::HyperLogLog<11>::kSerializedSize);
+    assert(wrong_p.load(crab::ConstByteSlice(buf)).unwrap_err().offset == buf.size());  // Too short
+    auto err = wrong_p.load(crab::ConstByteSlice(padded));
+    assert(err.is_err() && err.unwrap_err().offset == 8 && err.unwrap_err().expected == 11);
+    assert(back.load(crab::ConstByteSlice(buf.data(), buf.size() - 1)).is_err());
+    buf[0] = 'X';
+    err = back.load(crab::ConstByteSlice(buf));
+    assert(err.is_err() && err.unwrap_err().offset == 0 && err.unwrap_err().found == 'X');
+    assert(back.estimate() == words.estimate());
+    uint8_t tiny[4];
+    assert(words.save(crab::ByteSlice(tiny)).is_err());
+}
+
+void count_min_tests() {
+    TestRng rng;
+    crab::CountMinSketch<1024, 4> cms, left, right;
+    std::vector<uint32_t> truth(5000, 0);
+    for (int i = 0; i < 100000; ++i) {
+        // Skewed: small keys dominate
+        const uint64_t u = rng.next() >> 11;
+        const uint64_t key = (u % 5000) * (u % 5000) / 5000;
+        ++truth[key];
+        cms.add(key);
+        (i % 2 ? left : right).add(key);
+    }
+    assert(cms.total() == 100000);
+    left.merge(right);
+    assert(left.total() == cms.total());
+    size_t over_bound = 0;
+    for (uint64_t key = 0; key < truth.size(); ++key) {
+        const uint32_t est = cms.estimate(key);
+        assert(est >= truth[key]);
+        assert(left.estimate(key) == est);
+        // e / Width * total per key, exceeded with probability e^-4
+        if (est - truth[key] > 2.72 * 100000 / 1024) {
+            ++over_bound;
+        }
+    }
+    assert(over_bound < truth.size() / 20);
+
+    // Counters saturate rather than wrap
+    crab::CountMinSketch<16, 1> sat;
+    sat.add(7, 0xFFFFFFF0u);
+    sat.add(7, 0x100u);
+    assert(sat.estimate(7) == 0xFFFFFFFFu);
+
+    auto buf = save_sketch(cms, crab::CountMinSketch<1024, 4>::kSerializedSize);
+    crab::CountMinSketch<1024, 4> back;
+    assert(back.load(crab::ConstByteSlice(buf)).is_ok());
+    assert(back.total() == cms.total() && back.estimate(0) == cms.estimate(0));
+    crab::CountMinSketch<1024, 2> shallow;
+    assert(shallow.load(crab::ConstByteSlice(buf)).is_err());
+}
+
+void ddsketch_tests() {
+    TestRng rng;
+    const size_t n = 50000;
+    std::vector<double> xs(n);
+    crab::DDSketch<> dd, lo_half, hi_half;
+    for (size_t i = 0; i < n; ++i) {
+        // Log-uniform over ~9 decades
+        xs[i] = std::exp(rng.unit() * 10.0);
+        dd.add(xs[i]);
+        (i < n / 2 ? lo_half : hi_half).add(xs[i]);
+    }
+    assert(dd.quantile(0.5).is_some() && dd.quantile(1.5).is_none() && dd.quantile(-0.1).is_none());
+    lo_half.merge(hi_half);
+    std::vector<double> sorted = xs;
+    std::sort(sorted.begin(), sorted.end());
+    const double qs[] = {0.0, 0.001, 0.1, 0.25, 0.5, 0.9, 0.99, 0.999, 1.0};
+    for (double q : qs) {
+        const double exact = sorted[static_cast<size_t>(q * static_cast<double>(n - 1))];
+        const double got = dd.quantile(q).unwrap();
+        assert(std::fabs(got - exact) <= 0.01 * exact * (1.0 + 1e-9));
+        assert(lo_half.quantile(q).unwrap() == got);
+    }
+    assert(dd.min().unwrap() == sorted.front() && dd.max().unwrap() == sorted.back());
+    assert(dd.count() == n && lo_half.count() == n);
+
+    // Non-positive values share the zero bucket; NaN and infinities are ignored
+    crab::DDSketch<> mixed;
+    assert(mixed.quantile(0.5).is_none() && mixed.min().is_none());
+    for (int i = 0; i < 10; ++i) {
+        mixed.add(-1.0);
+    }
+    mixed.add(std::nan(""));
+    mixed.add(std::numeric_limits<double>::infinity());
+    mixed.add(-std::numeric_limits<double>::infinity());
+    for (int i = 0; i < 10; ++i) {
+        mixed.add(100.0);
+    }
+    assert(mixed.count() == 20);
+    assert(mixed.quantile(0.0).unwrap() == -1.0 && mixed.quantile(0.25).unwrap() == 0.0);
+    assert(std::fabs(mixed.quantile(0.75).unwrap() - 100.0) <= 1.0);
+
+    // A narrow window collapses low buckets but keeps the top accurate
+    crab::DDSketch<64, 100> narrow;
+    for (size_t i = 0; i < n; ++i) {
+        narrow.add(xs[i]);
+    }
+    const double p99 = sorted[static_cast<size_t>(0.99 * (n - 1))];
+    assert(std::fabs(narrow.quantile(0.99).unwrap() - p99) <= 0.01 * p99 * (1.0 + 1e-9));
+    // Same when the window has to move down first and then collapse
+    crab::DDSketch<64, 100> descending;
+    std::vector<double> desc;
+    for (double x = 1e6; x > 1e-6; x *= 0.9) {
+        descending.add(x);
+        desc.insert(desc.begin(), x);
+    }
+    const double d97 = desc[static_cast<size_t>(0.97 * static_cast<double>(desc.size() - 1))];
+    assert(std::fabs(descending.quantile(0.97).unwrap() - d97) <= 0.01 * d97 * (1.0 + 1e-9));
+
+    // Round trip stores only the occupied range
+    auto buf = save_sketch(dd, dd.serialized_size());
+    assert(dd.serialized_size() < crab::DDSketch<>::kMaxSerializedSize);
+    crab::DDSketch<> back;
+    assert(back.load(crab::ConstByteSlice(buf)).is_ok());
+    for (double q : qs) {
+        assert(back.quantile(q).unwrap() == dd.quantile(q).unwrap());
+    }
+    buf[16] ^= 1;    // Count no longer matches the buckets
+    assert(back.load(crab::ConstByteSlice(buf)).is_err());
+    assert(back.count() == n);
+    crab::DDSketch<> empty_back;
+    auto empty = save_sketch(crab::DDSketch<>(), crab::DDSketch<>().serialized_size());
+    assert(empty_back.load(crab::ConstByteSlice(empty)).is_ok() && empty_back.is_empty());
+}
+
+template<typename T>
+double rank_of(const std::vector<T>& sorted, T v) {
+    return static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), v) - sorted.begin()) /
+           static_cast<double>(sorted.size());
+}
+
+void quantile_sketch_tests() {
+    TestRng rng;
+    const size_t n = 200000;
+    std::vector<float> xs(n);
+    crab::QuantileSketch<float> qs;
+    crab::QuantileSketch<float> shards[4];
+    for (size_t i = 0; i < n; ++i) {
+        xs[i] = static_cast<float>(rng.unit());
+        shards[i % 4].add(xs[i]);
+    }
+    qs.add_batch(crab::Slice<const float>(xs));
+    for (int s = 1; s < 4; ++s) {
+        shards[0].merge(shards[s]);
+    }
+    std::vector<float> sorted = xs;
+    std::sort(sorted.begin(), sorted.end());
+    assert(qs.quantile(0.0).unwrap() == sorted.front() && qs.quantile(1.0).unwrap() == sorted.back());
+    assert(qs.quantile(2.0).is_none());
+    for (double q = 0.01; q < 1.0; q += 0.049) {
+        assert(std::fabs(rank_of(sorted, qs.quantile(q).unwrap()) - q) < 0.02);
+        assert(std::fabs(rank_of(sorted, shards[0].quantile(q).unwrap()) - q) < 0.02);
+    }
+    assert(shards[0].count() == n);
+
+    // Small streams are exact
+    crab::QuantileSketch<int32_t, 16> small;
+    assert(small.quantile(0.5).is_none());
+    for (int32_t i = 10; i >= 1; --i) {
+        small.add(i);
+    }
+    assert(small.quantile(0.5).unwrap() == 6 && small.quantile(0.05).unwrap() == 1);
+
+    // quantile() is a pure read: the serialized state does not change
+    auto buf = save_sketch(qs, qs.serialized_size());
+    const crab::QuantileSketch<float>& frozen = qs;
+    (void)frozen.quantile(0.5);
+    assert(save_sketch(qs, qs.serialized_size()) == buf);
+    crab::QuantileSketch<float> back;
+    assert(back.load(crab::ConstByteSlice(buf)).is_ok());
+    for (double q = 0.0; q <= 1.0; q += 0.125) {
+        assert(back.quantile(q).unwrap() == qs.quantile(q).unwrap());
+    }
+    crab::QuantileSketch<int32_t> as_int;
+    auto err = as_int.load(crab::ConstByteSlice(buf));
+    assert(err.is_err() && err.unwrap_err().offset == 16);
+    assert(back.load(crab::ConstByteSlice(buf.data(), buf.size() - 2)).is_err());
+    assert(back.count() == n);
+}
+
+void sketch_tests() {
+    hll_tests();
+    count_min_tests();
+    ddsketch_tests();
+    quantile_sketch_tests();
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    numeric_tests();
+    elementwise_tests();
+    gather_tests();
+    sort_tests();
+    set_ops_tests();
+    select_tests();
+    prefetch_tests();
+    matrix_tests();
+    dsp_tests();
+    fft_tests();
+    fixed_tests();
+    fast_math_tests();
+    window_tests();
+    sketch_tests();
+
+    return 0;
+}